@@ -46,6 +46,9 @@ void rf::EditorCompressorPlugin::Edit(bool* open, MixerSystem* mixerSystem, MixG
         "Make Up Gain db", 0.01f, RF_MIN_DECIBELS, RF_MAX_DECIBELS, plugin->GetMakeUpGainDb, plugin->SetMakeUpGainDb, Compressor_SetMakeUpGain);
     RF_PLUGIN_GUI_FLOAT_SLIDER("Attack ms", 0.01f, 0.0f, 500.0f, plugin->GetAttack, plugin->SetAttack, Compressor_SetAttack);
     RF_PLUGIN_GUI_FLOAT_SLIDER("Release ms", 0.01f, 0.0f, 5000.0f, plugin->GetRelease, plugin->SetRelease, Compressor_SetRelease);
+    RF_PLUGIN_GUI_FLOAT_SLIDER("Knee dB", 0.01f, 0.0f, 24.0f, plugin->GetKnee, plugin->SetKnee, Compressor_SetKnee);
+    RF_PLUGIN_GUI_BOOL("RMS", plugin->GetDetectRMS, Compressor_SetDetectRMS);
+    RF_PLUGIN_GUI_SIDECHAIN("Sidechain", plugin->GetSidechainMixGroupHandle, Compressor_SetSidechain);
 
     RF_EDITOR_PLUGIN_GUI_END;
 }
@@ -58,6 +61,9 @@ void rf::EditorCompressorPlugin::InitializeState(void* buffer, MixerSystem* mixe
     state->m_makeUpGainDb = plugin->GetMakeUpGainDb();
     state->m_attackMs = plugin->GetAttack();
     state->m_releaseMs = plugin->GetRelease();
+    state->m_kneeDb = plugin->GetKnee();
+    state->m_detectRMS = plugin->GetDetectRMS();
+    state->m_sidechain = plugin->GetSidechainMixGroupHandle();
 }
 
 void rf::EditorCompressorPlugin::SetFromState(const void* buffer, MixerSystem* mixerSystem, MixGroupHandle mixGroupHandle, int slot)
@@ -68,4 +74,7 @@ void rf::EditorCompressorPlugin::SetFromState(const void* buffer, MixerSystem* m
     plugin->SetMakeUpGainDb(state->m_makeUpGainDb);
     plugin->SetAttack(state->m_attackMs);
     plugin->SetRelease(state->m_releaseMs);
+    plugin->SetKnee(state->m_kneeDb);
+    plugin->SetDetectRMS(state->m_detectRMS);
+    plugin->SetSidechain(state->m_sidechain ? mixerSystem->GetMixGroup(state->m_sidechain) : nullptr);
 }
@@ -42,6 +42,9 @@ public:
         float m_makeUpGainDb = 0.0f;
         float m_attackMs = 0.0f;
         float m_releaseMs = 0.0f;
+        float m_kneeDb = 0.0f;
+        bool m_detectRMS = false;
+        MixGroupHandle m_sidechain;
     };
     static_assert(sizeof(State) < k_pluginStateSize, "struct too big");
 };
@@ -48,6 +48,64 @@ void rf::EditorDelayPlugin::Edit(bool* open, MixerSystem* mixerSystem, MixGroupH
                                plugin->GetFeedback,
                                plugin->SetFeedback,
                                Delay_SetFeedback);
+    RF_PLUGIN_GUI_BOOL("Tempo Sync", plugin->GetTempoSync, Delay_SetTempoSync);
+
+    if (plugin->GetTempoSync())
+    {
+        static constexpr int k_numSyncValues = 15;
+        static const Sync::Value s_syncValues[k_numSyncValues] = {
+            Sync::Value::Bar,
+            Sync::Value::Whole,
+            Sync::Value::Half,
+            Sync::Value::Quarter,
+            Sync::Value::Eigth,
+            Sync::Value::Sixteenth,
+            Sync::Value::ThirtySecond,
+            Sync::Value::HalfDotted,
+            Sync::Value::QuarterDotted,
+            Sync::Value::EigthDotted,
+            Sync::Value::SixteenthDotted,
+            Sync::Value::HalfTriplet,
+            Sync::Value::QuarterTriplet,
+            Sync::Value::EigthTriplet,
+            Sync::Value::SixteenthTriplet,
+        };
+        static const char* s_syncNames[k_numSyncValues] = {
+            "Bar",
+            "1/1",
+            "1/2",
+            "1/4",
+            "1/8",
+            "1/16",
+            "1/32",
+            "1/2 Dotted",
+            "1/4 Dotted",
+            "1/8 Dotted",
+            "1/16 Dotted",
+            "1/2 Triplet",
+            "1/4 Triplet",
+            "1/8 Triplet",
+            "1/16 Triplet",
+        };
+
+        int current = 0;
+        for (int i = 0; i < k_numSyncValues; ++i)
+        {
+            if (s_syncValues[i] == plugin->GetSyncValue())
+            {
+                current = i;
+                break;
+            }
+        }
+
+        int selected = current;
+        if (ImGui::Combo("Note", &selected, s_syncNames, k_numSyncValues) && selected != current)
+        {
+            const int before = static_cast<int>(s_syncValues[current]);
+            const int after = static_cast<int>(s_syncValues[selected]);
+            actions->DoAction(new Delay_SetSyncValue(this, mixerSystem, mixGroup->GetMixGroupHandle(), slot, before, after));
+        }
+    }
 
     RF_EDITOR_PLUGIN_GUI_END;
 }
@@ -57,6 +115,8 @@ void rf::EditorDelayPlugin::InitializeState(void* buffer, MixerSystem* mixerSyst
     RF_INIT_STATE(DelayPlugin);
     state->m_delayMs = plugin->GetDelay();
     state->m_feedback = plugin->GetFeedback();
+    state->m_syncValue = static_cast<int>(plugin->GetSyncValue());
+    state->m_tempoSync = plugin->GetTempoSync();
 }
 
 void rf::EditorDelayPlugin::SetFromState(const void* buffer, MixerSystem* mixerSystem, MixGroupHandle mixGroupHandle, int slot)
@@ -64,4 +124,6 @@ void rf::EditorDelayPlugin::SetFromState(const void* buffer, MixerSystem* mixerS
     RF_SET_FROM_STATE(DelayPlugin);
     plugin->SetDelay(state->m_delayMs);
     plugin->SetFeedback(state->m_feedback);
+    plugin->SetSyncValue(static_cast<Sync::Value>(state->m_syncValue));
+    plugin->SetTempoSync(state->m_tempoSync);
 }
@@ -39,6 +39,8 @@ public:
     {
         float m_delayMs = 0.0f;
         float m_feedback = 0.0f;
+        int m_syncValue = 0;
+        bool m_tempoSync = false;
     };
     static_assert(sizeof(State) < k_pluginStateSize, "struct too big");
 };
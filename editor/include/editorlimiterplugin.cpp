@@ -41,6 +41,21 @@ void rf::EditorLimiterPlugin::Edit(bool* open, MixerSystem* mixerSystem, MixGrou
 
     RF_PLUGIN_GUI_FLOAT_SLIDER(
         "Threshold", 0.01f, RF_MIN_DECIBELS, RF_MAX_DECIBELS, plugin->GetThreshold, plugin->SetThreshold, Limiter_SetThreshold);
+    RF_PLUGIN_GUI_FLOAT_SLIDER("Lookahead ms",
+                               0.01f,
+                               0.0f,
+                               PluginUtils::k_maxLimiterLookahead,
+                               plugin->GetLookahead,
+                               plugin->SetLookahead,
+                               Limiter_SetLookahead);
+    RF_PLUGIN_GUI_FLOAT_SLIDER("Release ms",
+                               0.1f,
+                               PluginUtils::k_minLimiterRelease,
+                               PluginUtils::k_maxLimiterRelease,
+                               plugin->GetRelease,
+                               plugin->SetRelease,
+                               Limiter_SetRelease);
+    RF_PLUGIN_GUI_BOOL("True Peak", plugin->GetTruePeak, Limiter_SetTruePeak);
 
     RF_EDITOR_PLUGIN_GUI_END;
 }
@@ -49,10 +64,16 @@ void rf::EditorLimiterPlugin::InitializeState(void* buffer, MixerSystem* mixerSy
 {
     RF_INIT_STATE(LimiterPlugin);
     state->m_threshold = plugin->GetThreshold();
+    state->m_lookahead = plugin->GetLookahead();
+    state->m_release = plugin->GetRelease();
+    state->m_truePeak = plugin->GetTruePeak();
 }
 
 void rf::EditorLimiterPlugin::SetFromState(const void* buffer, MixerSystem* mixerSystem, MixGroupHandle mixGroupHandle, int slot)
 {
     RF_SET_FROM_STATE(LimiterPlugin);
     plugin->SetThreshold(state->m_threshold);
+    plugin->SetLookahead(state->m_lookahead);
+    plugin->SetRelease(state->m_release);
+    plugin->SetTruePeak(state->m_truePeak);
 }
\ No newline at end of file
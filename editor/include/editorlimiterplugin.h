@@ -38,6 +38,9 @@ public:
     struct State final : public StateBase
     {
         float m_threshold = 0.0f;
+        float m_lookahead = 0.0f;
+        float m_release = 0.0f;
+        bool m_truePeak = false;
     };
     static_assert(sizeof(State) < k_pluginStateSize, "struct too big");
 };
@@ -41,6 +41,14 @@ void rf::EditorPanPlugin::Edit(bool* open, MixerSystem* mixerSystem, MixGroupHan
 
     RF_PLUGIN_GUI_FLOAT_SLIDER("Angle", 0.01f, -1.0f, 1.0f, plugin->GetAngle, plugin->SetAngle, Pan_SetAngle);
 
+    static const char* s_panLawNames[] = {"-3 dB", "-4.5 dB", "-6 dB"};
+    const int current = static_cast<int>(plugin->GetPanLaw());
+    int selected = current;
+    if (ImGui::Combo("Pan Law", &selected, s_panLawNames, 3) && selected != current)
+    {
+        actions->DoAction(new Pan_SetPanLaw(this, mixerSystem, mixGroup->GetMixGroupHandle(), slot, current, selected));
+    }
+
     RF_EDITOR_PLUGIN_GUI_END;
 }
 
@@ -48,10 +56,12 @@ void rf::EditorPanPlugin::InitializeState(void* buffer, MixerSystem* mixerSystem
 {
     RF_INIT_STATE(PanPlugin);
     state->m_angle = plugin->GetAngle();
+    state->m_panLaw = static_cast<int>(plugin->GetPanLaw());
 }
 
 void rf::EditorPanPlugin::SetFromState(const void* buffer, MixerSystem* mixerSystem, MixGroupHandle mixGroupHandle, int slot)
 {
     RF_SET_FROM_STATE(PanPlugin);
     plugin->SetAngle(state->m_angle);
+    plugin->SetPanLaw(static_cast<PanLaw>(state->m_panLaw));
 }
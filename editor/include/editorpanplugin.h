@@ -38,6 +38,7 @@ public:
     struct State final : public StateBase
     {
         float m_angle = 0.0f;
+        int m_panLaw = 0;
     };
     static_assert(sizeof(State) < k_pluginStateSize, "struct too big");
 };
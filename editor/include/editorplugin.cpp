@@ -37,7 +37,7 @@ rf::EditorPlugin::EditorPlugin(EditorPlugin::Type type)
 
 const char* rf::EditorPlugin::GetPluginName(Type type)
 {
-    static_assert(static_cast<int>(EditorPlugin::Type::Version) == 1, "Update this");
+    static_assert(static_cast<int>(EditorPlugin::Type::Version) == 2, "Update this");
 
     switch (type)
     {
@@ -46,6 +46,7 @@ const char* rf::EditorPlugin::GetPluginName(Type type)
         case Type::Compressor: return "Compressor";
         case Type::Convolver: return "Convolver";
         case Type::Delay: return "Delay";
+        case Type::Ducker: return "Ducker";
         case Type::Gain: return "Gain";
         case Type::IIR2HighpassFilter: return "IIR2 HP Filter";
         case Type::IIR2LowpassFilter: return "IIR2 LP Filter";
@@ -76,8 +76,9 @@ public:
         Limiter,
         Pan,
         Positioning,
+        Ducker,
 
-        Version = 1,
+        Version = 2,
     };
 
     EditorPlugin(Type type);
@@ -48,6 +48,10 @@ void rf::EditorPositioningPlugin::Edit(bool* open, MixerSystem* mixerSystem, Mix
 
     active = ImGui::DragFloat("Pan", &value.m_panAngle, 0.001f, -1.0f, 1.0f) || active;
     end = ImGui::IsItemDeactivatedAfterEdit() || end;
+    active = ImGui::DragFloat("Azimuth", &value.m_azimuth, 1.0f, -180.0f, 180.0f) || active;
+    end = ImGui::IsItemDeactivatedAfterEdit() || end;
+    active = ImGui::DragFloat("Elevation", &value.m_elevation, 1.0f, -90.0f, 90.0f) || active;
+    end = ImGui::IsItemDeactivatedAfterEdit() || end;
     active = ImGui::DragFloat("Current Distance", &value.m_currentDistance, 1.0f, 0.0f, 1000.0f) || active;
     end = ImGui::IsItemDeactivatedAfterEdit() || end;
     active = ImGui::DragFloat("Min Distance", &value.m_minDistance, 1.0f, 0.0f, 1000.0f) || active;
@@ -60,6 +64,14 @@ void rf::EditorPositioningPlugin::Edit(bool* open, MixerSystem* mixerSystem, Mix
     end = ImGui::IsItemDeactivatedAfterEdit() || end;
     active = ImGui::DragFloat("Max LPF Cutoff", &value.m_maxLpfCutoff, 1.0f, 20.0f, 20000.0f) || active;
     end = ImGui::IsItemDeactivatedAfterEdit() || end;
+    active = ImGui::DragFloat("Air Absorption", &value.m_airAbsorption, 0.0001f, 0.0f, 1.0f, "%.4f") || active;
+    end = ImGui::IsItemDeactivatedAfterEdit() || end;
+    active = ImGui::DragFloat("Occlusion", &value.m_occlusion, 0.001f, 0.0f, 1.0f) || active;
+    end = ImGui::IsItemDeactivatedAfterEdit() || end;
+    active = ImGui::DragFloat("Occlusion Attenuation dB", &value.m_occlusionAttenuationDb, 1.0f, -60.0f, 0.0f) || active;
+    end = ImGui::IsItemDeactivatedAfterEdit() || end;
+    active = ImGui::DragFloat("Occlusion LPF Cutoff", &value.m_occlusionLpfCutoff, 1.0f, 20.0f, 20000.0f) || active;
+    end = ImGui::IsItemDeactivatedAfterEdit() || end;
 
     value.m_enable = true;
     plugin->SetPositioningParameters(value);
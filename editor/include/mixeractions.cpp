@@ -27,6 +27,7 @@
 #include <redfish/compressorplugin.h>
 #include <redfish/convolverplugin.h>
 #include <redfish/delayplugin.h>
+#include <redfish/duckerplugin.h>
 #include <redfish/gainplugin.h>
 #include <redfish/iir2highpassfilterplugin.h>
 #include <redfish/iir2lowpassfilterplugin.h>
@@ -41,6 +42,7 @@
 #include "editorcompressorplugin.h"
 #include "editorconvolverplugin.h"
 #include "editordelayplugin.h"
+#include "editorduckerplugin.h"
 #include "editorgainplugin.h"
 #include "editoriir2highpasfilterplugin.h"
 #include "editoriir2lowpasfilterplugin.h"
@@ -267,7 +269,7 @@ static void DestroyPlugin(std::vector<rf::MixGroupEditorState>* editorState,
         break;                                                                   \
     }
 
-    static_assert(static_cast<int>(rf::EditorPlugin::Type::Version) == 1, "Update this");
+    static_assert(static_cast<int>(rf::EditorPlugin::Type::Version) == 2, "Update this");
 
     switch (editorPlugin->m_type)
     {
@@ -276,6 +278,7 @@ static void DestroyPlugin(std::vector<rf::MixGroupEditorState>* editorState,
         RF_DELETE_PLUGIN(Compressor)
         RF_DELETE_PLUGIN(Convolver)
         RF_DELETE_PLUGIN(Delay)
+        RF_DELETE_PLUGIN(Ducker)
         RF_DELETE_PLUGIN(Gain)
         RF_DELETE_PLUGIN(IIR2HighpassFilter)
         RF_DELETE_PLUGIN(IIR2LowpassFilter)
@@ -308,7 +311,7 @@ static rf::PluginBase* CreatePlugin(std::vector<rf::MixGroupEditorState>* editor
         return newPlugin->m_plugin;                                              \
     }
 
-    static_assert(static_cast<int>(rf::EditorPlugin::Type::Version) == 1, "Update this");
+    static_assert(static_cast<int>(rf::EditorPlugin::Type::Version) == 2, "Update this");
 
     switch (type)
     {
@@ -317,6 +320,7 @@ static rf::PluginBase* CreatePlugin(std::vector<rf::MixGroupEditorState>* editor
         case rf::EditorPlugin::Type::Compressor: RF_CREATE(CompressorPlugin);
         case rf::EditorPlugin::Type::Convolver: RF_CREATE(ConvolverPlugin);
         case rf::EditorPlugin::Type::Delay: RF_CREATE(DelayPlugin);
+        case rf::EditorPlugin::Type::Ducker: RF_CREATE(DuckerPlugin);
         case rf::EditorPlugin::Type::Gain: RF_CREATE(GainPlugin);
         case rf::EditorPlugin::Type::IIR2HighpassFilter: RF_CREATE(IIR2HighpassFilterPlugin);
         case rf::EditorPlugin::Type::IIR2LowpassFilter: RF_CREATE(IIR2LowpassFilterPlugin);
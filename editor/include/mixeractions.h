@@ -30,7 +30,7 @@
 
 namespace rf
 {
-static constexpr int k_pluginStateSize = 64;
+static constexpr int k_pluginStateSize = 96;
 
 class MixerSystem;
 class MixerView;
@@ -41,6 +41,7 @@
 #include "editorcompressorplugin.h"
 #include "editorconvolverplugin.h"
 #include "editordelayplugin.h"
+#include "editorduckerplugin.h"
 #include "editorgainplugin.h"
 #include "editoriir2highpasfilterplugin.h"
 #include "editoriir2lowpasfilterplugin.h"
@@ -178,6 +179,11 @@ void rf::MixerView::Refresh()
                             editorState.m_plugins[j] = new EditorDelayPlugin(EditorPlugin::Type::Delay);
                             break;
                         }
+                        case PluginBase::Type::Ducker:
+                        {
+                            editorState.m_plugins[j] = new EditorDuckerPlugin(EditorPlugin::Type::Ducker);
+                            break;
+                        }
                         case PluginBase::Type::Gain:
                         {
                             editorState.m_plugins[j] = new EditorGainPlugin(EditorPlugin::Type::Gain);
@@ -460,6 +466,16 @@ void rf::MixerView::VisibiltiyPane()
         ImGui::PopID();
     }
 
+    // Where the audio callback's time goes, as a share of its time budget.
+    static const char* k_stageNames[Profiler::k_numStages] = {"Commands", "Music", "Voices", "Mixing", "Output", "Total"};
+    ImGui::Separator();
+    ImGui::Text("CPU");
+    ImGui::Separator();
+    for (int i = 0; i < Profiler::k_numStages; ++i)
+    {
+        ImGui::Text("%s: %.1f%%", k_stageNames[i], m_context->GetCpuPercent(static_cast<Profiler::Stage>(i)));
+    }
+
     ImGui::EndChild();
 }
 
@@ -515,6 +531,8 @@ void rf::MixerView::Plugins(MixGroupEditorState& editorState, int index)
 
     ImGui::Separator();
     ImGui::Text("Plug-ins");
+    ImGui::SameLine();
+    ImGui::Text("%.1f%%", mixGroup->GetCpuPercent());
     ImGui::Separator();
 
     static const ImVec2 s_buttonSize = {105.0f, 0.0f};
@@ -607,8 +625,8 @@ void rf::MixerView::Plugins(MixGroupEditorState& editorState, int index)
     {
         ImGui::Text("Chose which plug-in to create.");
 
-        static_assert(static_cast<int>(EditorPlugin::Type::Version) == 1, "Update this");
-        static constexpr int k_numPlugins = 11;
+        static_assert(static_cast<int>(EditorPlugin::Type::Version) == 2, "Update this");
+        static constexpr int k_numPlugins = 12;
 
         static EditorPlugin::Type s_types[k_numPlugins] = {
             EditorPlugin::Type::ButterworthHighpassFilter,
@@ -616,6 +634,7 @@ void rf::MixerView::Plugins(MixGroupEditorState& editorState, int index)
             EditorPlugin::Type::Compressor,
             EditorPlugin::Type::Convolver,
             EditorPlugin::Type::Delay,
+            EditorPlugin::Type::Ducker,
             EditorPlugin::Type::Gain,
             EditorPlugin::Type::IIR2HighpassFilter,
             EditorPlugin::Type::IIR2LowpassFilter,
@@ -630,6 +649,7 @@ void rf::MixerView::Plugins(MixGroupEditorState& editorState, int index)
             EditorPlugin::GetPluginName(EditorPlugin::Type::Compressor),
             EditorPlugin::GetPluginName(EditorPlugin::Type::Convolver),
             EditorPlugin::GetPluginName(EditorPlugin::Type::Delay),
+            EditorPlugin::GetPluginName(EditorPlugin::Type::Ducker),
             EditorPlugin::GetPluginName(EditorPlugin::Type::Gain),
             EditorPlugin::GetPluginName(EditorPlugin::Type::IIR2HighpassFilter),
             EditorPlugin::GetPluginName(EditorPlugin::Type::IIR2LowpassFilter),
@@ -846,10 +866,11 @@ void rf::MixerView::Fader(MixGroupEditorState& editorState)
     static constexpr int k_numChannels = 2;
 
     // Meter
+    const MixGroupMeter* meter = mixGroup->GetMeter();
     float currentDb = -FLT_MAX;
     for (int i = 0; i < k_numChannels; ++i)
     {
-        const float amp = mixGroup->GetCurrentAmplitude();
+        const float amp = meter ? meter->m_peakAmplitude[i] : 0.0f;
         const float amps[1] = {amp};
         ImGui::PlotHistogram("", amps, IM_ARRAYSIZE(amps), 0, nullptr, 0.0f, 1.0f, ImVec2(k_size.x * 0.5f, k_size.y));
         ImGui::SameLine(0.0f, 0.0f);
@@ -951,6 +972,27 @@ void rf::MixerView::Fader(MixGroupEditorState& editorState)
 
     ImGui::ColorButton("peak", peakColour, ImGuiColorEditFlags_NoTooltip, ImVec2(9.0f + (k_size.x * 2.0f), 10.0f));
 
+    // RMS and clipped samples
+    if (meter)
+    {
+        ImGui::Text("RMS %.2fdb", Functions::AmplitudeToDecibel(meter->GetRmsAmplitude()));
+        ImGui::Text("Clipped %i", meter->GetNumClippedSamples());
+    }
+
+    // Loudness
+    bool loudnessMetering = mixGroup->GetLoudnessMetering();
+    if (ImGui::Checkbox("LUFS", &loudnessMetering))
+    {
+        mixGroup->SetLoudnessMetering(loudnessMetering);
+    }
+
+    if (meter && meter->m_hasLoudness)
+    {
+        ImGui::Text("M %.1f", meter->m_momentaryLufs);
+        ImGui::Text("S %.1f", meter->m_shortTermLufs);
+        ImGui::Text("I %.1f", meter->m_integratedLufs);
+    }
+
     ImGui::PopID();
 }
 
@@ -26,6 +26,7 @@
 #include <redfish/butterworthlowpassfilterplugin.h>
 #include <redfish/compressorplugin.h>
 #include <redfish/delayplugin.h>
+#include <redfish/duckerplugin.h>
 #include <redfish/gainplugin.h>
 #include <redfish/iir2highpassfilterplugin.h>
 #include <redfish/iir2lowpassfilterplugin.h>
@@ -67,6 +68,34 @@
         RF_GET_PLUGIN(pluginType)->setter(m_before);                                                                                     \
     }
 
+#define RF_IMPLEMENT_BOOL_SETTER(name, paramName, pluginType, setter)                                                                      \
+    rf::name::name(EditorPlugin* editorPlugin, MixerSystem* mixerSystem, MixGroupHandle mixGroupHandle, int slot, bool before, bool after) \
+        : SetBoolParameter(editorPlugin, paramName, mixerSystem, mixGroupHandle, slot, before, after)                                      \
+    {                                                                                                                                      \
+    }                                                                                                                                      \
+    void rf::name::Do()                                                                                                                    \
+    {                                                                                                                                      \
+        RF_GET_PLUGIN(pluginType)->setter(m_after);                                                                                        \
+    }                                                                                                                                      \
+    void rf::name::Undo()                                                                                                                  \
+    {                                                                                                                                      \
+        RF_GET_PLUGIN(pluginType)->setter(m_before);                                                                                       \
+    }
+
+#define RF_IMPLEMENT_SIDECHAIN_SETTER(name, pluginType)                                                                                                        \
+    rf::name::name(EditorPlugin* editorPlugin, MixerSystem* mixerSystem, MixGroupHandle mixGroupHandle, int slot, MixGroupHandle before, MixGroupHandle after) \
+        : SetSidechainParameter(editorPlugin, mixerSystem, mixGroupHandle, slot, before, after)                                                                \
+    {                                                                                                                                                          \
+    }                                                                                                                                                          \
+    void rf::name::Do()                                                                                                                                        \
+    {                                                                                                                                                          \
+        RF_GET_PLUGIN(pluginType)->SetSidechain(m_after ? m_mixerSystem->GetMixGroup(m_after) : nullptr);                                                      \
+    }                                                                                                                                                          \
+    void rf::name::Undo()                                                                                                                                      \
+    {                                                                                                                                                          \
+        RF_GET_PLUGIN(pluginType)->SetSidechain(m_before ? m_mixerSystem->GetMixGroup(m_before) : nullptr);                                                    \
+    }
+
 rf::SetBypassAction::SetBypassAction(EditorPlugin* editorPlugin,
                                      MixerSystem* mixerSystem,
                                      MixGroupHandle mixGroupHandle,
@@ -157,6 +186,43 @@ rf::SetIntParameter::SetIntParameter(EditorPlugin* editorPlugin,
     sprintf_s(m_name, "Set '%s' %s from %i to %i", bufferName, paramName, m_before, m_after);
 }
 
+rf::SetBoolParameter::SetBoolParameter(EditorPlugin* editorPlugin,
+                                       const char* paramName,
+                                       MixerSystem* mixerSystem,
+                                       MixGroupHandle mixGroupHandle,
+                                       int slot,
+                                       bool before,
+                                       bool after)
+    : m_mixerSystem(mixerSystem)
+    , m_mixGroupHandle(mixGroupHandle)
+    , m_slot(slot)
+    , m_before(before)
+    , m_after(after)
+{
+    char bufferName[128] = {};
+    editorPlugin->BuildName(bufferName, mixerSystem, mixGroupHandle, slot);
+    sprintf_s(m_name, "Set '%s' %s from %d to %d", bufferName, paramName, m_before, m_after);
+}
+
+rf::SetSidechainParameter::SetSidechainParameter(EditorPlugin* editorPlugin,
+                                                 MixerSystem* mixerSystem,
+                                                 MixGroupHandle mixGroupHandle,
+                                                 int slot,
+                                                 MixGroupHandle before,
+                                                 MixGroupHandle after)
+    : m_mixerSystem(mixerSystem)
+    , m_mixGroupHandle(mixGroupHandle)
+    , m_slot(slot)
+    , m_before(before)
+    , m_after(after)
+{
+    char bufferName[128] = {};
+    editorPlugin->BuildName(bufferName, mixerSystem, mixGroupHandle, slot);
+    const char* beforeName = m_before ? mixerSystem->GetMixGroup(m_before)->GetName() : "None";
+    const char* afterName = m_after ? mixerSystem->GetMixGroup(m_after)->GetName() : "None";
+    sprintf_s(m_name, "Set '%s' Sidechain from %s to %s", bufferName, beforeName, afterName);
+}
+
 RF_IMPLEMENT_FLOAT_SETTER(Gain_SetGain, "Gain dB", GainPlugin, SetGainDb);
 RF_IMPLEMENT_INT_SETTER(BWHP_SetOrder, "Order", ButterworthHighpassFilterPlugin, SetOrder);
 RF_IMPLEMENT_FLOAT_SETTER(BWHP_SetCutoff, "Cutoff", ButterworthHighpassFilterPlugin, SetCutoff);
@@ -167,15 +233,65 @@ RF_IMPLEMENT_FLOAT_SETTER(Compressor_SetRatio, "Ratio", CompressorPlugin, SetRat
 RF_IMPLEMENT_FLOAT_SETTER(Compressor_SetMakeUpGain, "Make Up Gain dB", CompressorPlugin, SetMakeUpGainDb);
 RF_IMPLEMENT_FLOAT_SETTER(Compressor_SetAttack, "Attack ms", CompressorPlugin, SetAttack);
 RF_IMPLEMENT_FLOAT_SETTER(Compressor_SetRelease, "Release ms", CompressorPlugin, SetRelease);
+RF_IMPLEMENT_FLOAT_SETTER(Compressor_SetKnee, "Knee dB", CompressorPlugin, SetKnee);
+RF_IMPLEMENT_BOOL_SETTER(Compressor_SetDetectRMS, "RMS", CompressorPlugin, SetDetectRMS);
+RF_IMPLEMENT_SIDECHAIN_SETTER(Compressor_SetSidechain, CompressorPlugin);
 RF_IMPLEMENT_FLOAT_SETTER(Delay_SetDelay, "Delay ms", DelayPlugin, SetDelay);
 RF_IMPLEMENT_FLOAT_SETTER(Delay_SetFeedback, "Feedback", DelayPlugin, SetFeedback);
+RF_IMPLEMENT_BOOL_SETTER(Delay_SetTempoSync, "Tempo Sync", DelayPlugin, SetTempoSync);
+RF_IMPLEMENT_FLOAT_SETTER(Ducker_SetThreshold, "Threshold", DuckerPlugin, SetThreshold);
+RF_IMPLEMENT_FLOAT_SETTER(Ducker_SetDepth, "Depth dB", DuckerPlugin, SetDepth);
+RF_IMPLEMENT_FLOAT_SETTER(Ducker_SetAttack, "Attack ms", DuckerPlugin, SetAttack);
+RF_IMPLEMENT_FLOAT_SETTER(Ducker_SetRelease, "Release ms", DuckerPlugin, SetRelease);
+RF_IMPLEMENT_FLOAT_SETTER(Ducker_SetHold, "Hold ms", DuckerPlugin, SetHold);
+RF_IMPLEMENT_SIDECHAIN_SETTER(Ducker_SetSidechain, DuckerPlugin);
 RF_IMPLEMENT_FLOAT_SETTER(IIR2HP_SetQ, "Q", IIR2HighpassFilterPlugin, SetQ);
 RF_IMPLEMENT_FLOAT_SETTER(IIR2HP_SetCutoff, "Cutoff", IIR2HighpassFilterPlugin, SetCutoff);
 RF_IMPLEMENT_FLOAT_SETTER(IIR2LP_SetQ, "Q", IIR2LowpassFilterPlugin, SetQ);
 RF_IMPLEMENT_FLOAT_SETTER(IIR2LP_SetCutoff, "Cutoff", IIR2LowpassFilterPlugin, SetCutoff);
 RF_IMPLEMENT_FLOAT_SETTER(Limiter_SetThreshold, "Threshold", LimiterPlugin, SetThreshold);
+RF_IMPLEMENT_FLOAT_SETTER(Limiter_SetLookahead, "Lookahead ms", LimiterPlugin, SetLookahead);
+RF_IMPLEMENT_FLOAT_SETTER(Limiter_SetRelease, "Release ms", LimiterPlugin, SetRelease);
+RF_IMPLEMENT_BOOL_SETTER(Limiter_SetTruePeak, "True Peak", LimiterPlugin, SetTruePeak);
 RF_IMPLEMENT_FLOAT_SETTER(Pan_SetAngle, "Pan", PanPlugin, SetAngle);
 
+rf::Delay_SetSyncValue::Delay_SetSyncValue(EditorPlugin* editorPlugin,
+                                           MixerSystem* mixerSystem,
+                                           MixGroupHandle mixGroupHandle,
+                                           int slot,
+                                           int before,
+                                           int after)
+    : SetIntParameter(editorPlugin, "Sync", mixerSystem, mixGroupHandle, slot, before, after)
+{
+}
+
+void rf::Delay_SetSyncValue::Do()
+{
+    RF_GET_PLUGIN(DelayPlugin)->SetSyncValue(static_cast<Sync::Value>(m_after));
+}
+
+void rf::Delay_SetSyncValue::Undo()
+{
+    RF_GET_PLUGIN(DelayPlugin)->SetSyncValue(static_cast<Sync::Value>(m_before));
+}
+
+rf::Pan_SetPanLaw::Pan_SetPanLaw(EditorPlugin* editorPlugin, MixerSystem* mixerSystem, MixGroupHandle mixGroupHandle, int slot, int before, int after)
+    : SetIntParameter(editorPlugin, "Pan Law", mixerSystem, mixGroupHandle, slot, before, after)
+{
+}
+
+void rf::Pan_SetPanLaw::Do()
+{
+    RF_GET_PLUGIN(PanPlugin)->SetPanLaw(static_cast<PanLaw>(m_after));
+}
+
+void rf::Pan_SetPanLaw::Undo()
+{
+    RF_GET_PLUGIN(PanPlugin)->SetPanLaw(static_cast<PanLaw>(m_before));
+}
+
 #undef RF_GET_PLUGIN
 #undef RF_IMPLEMENT_FLOAT_SETTER
-#undef RF_IMPLEMENT_INT_SETTER
\ No newline at end of file
+#undef RF_IMPLEMENT_INT_SETTER
+#undef RF_IMPLEMENT_BOOL_SETTER
+#undef RF_IMPLEMENT_SIDECHAIN_SETTER
\ No newline at end of file
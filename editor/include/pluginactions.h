@@ -36,6 +36,33 @@
         }                                                                                                                   \
     }
 
+#define RF_PLUGIN_GUI_SIDECHAIN(label, currentValueGetter, actionName)                                                                     \
+    {                                                                                                                                      \
+        const MixGroupHandle currentValue = currentValueGetter();                                                                          \
+        const char* currentName = currentValue ? mixerSystem->GetMixGroup(currentValue)->GetName() : "None";                               \
+        if (ImGui::BeginCombo(label, currentName))                                                                                         \
+        {                                                                                                                                  \
+            if (ImGui::Selectable("None", !currentValue) && currentValue)                                                                  \
+            {                                                                                                                              \
+                actions->DoAction(new actionName(this, mixerSystem, mixGroup->GetMixGroupHandle(), slot, currentValue, MixGroupHandle())); \
+            }                                                                                                                              \
+            for (int i = 0; i < RF_MAX_MIX_GROUPS; ++i)                                                                                    \
+            {                                                                                                                              \
+                const MixGroup* sidechain = mixerSystem->GetMixGroup(i);                                                                   \
+                const MixGroupHandle value = sidechain->GetMixGroupHandle();                                                               \
+                if (!value || !mixerSystem->CanSidechain(mixGroup->GetMixGroupHandle(), value))                                            \
+                {                                                                                                                          \
+                    continue;                                                                                                              \
+                }                                                                                                                          \
+                if (ImGui::Selectable(sidechain->GetName(), value == currentValue) && value != currentValue)                               \
+                {                                                                                                                          \
+                    actions->DoAction(new actionName(this, mixerSystem, mixGroup->GetMixGroupHandle(), slot, currentValue, value));        \
+                }                                                                                                                          \
+            }                                                                                                                              \
+            ImGui::EndCombo();                                                                                                             \
+        }                                                                                                                                  \
+    }
+
 #define RF_PLUGIN_GUI_FLOAT_SLIDER(label, speed, min, max, currentValueGetter, setter, actionName)                          \
     {                                                                                                                       \
         const float currentValue = currentValueGetter();                                                                    \
@@ -96,6 +123,24 @@
         void Undo() override;                                                                                                       \
     };
 
+#define RF_DEFINE_BOOL_SETTER(name)                                                                                                   \
+    class name final : public SetBoolParameter                                                                                        \
+    {                                                                                                                                 \
+    public:                                                                                                                           \
+        name(EditorPlugin* editorPlugin, MixerSystem* mixerSystem, MixGroupHandle mixGroupHandle, int slot, bool before, bool after); \
+        void Do() override;                                                                                                           \
+        void Undo() override;                                                                                                         \
+    };
+
+#define RF_DEFINE_SIDECHAIN_SETTER(name)                                                                                                                  \
+    class name final : public SetSidechainParameter                                                                                                       \
+    {                                                                                                                                                     \
+    public:                                                                                                                                               \
+        name(EditorPlugin* editorPlugin, MixerSystem* mixerSystem, MixGroupHandle mixGroupHandle, int slot, MixGroupHandle before, MixGroupHandle after); \
+        void Do() override;                                                                                                                               \
+        void Undo() override;                                                                                                                             \
+    };
+
 namespace rf
 {
 class EditorPlugin;
@@ -182,6 +227,49 @@ protected:
     int m_after = 0;
 };
 
+class SetBoolParameter : public Action
+{
+public:
+    SetBoolParameter(EditorPlugin* editorPlugin,
+                     const char* paramName,
+                     MixerSystem* mixerSystem,
+                     MixGroupHandle mixGroupHandle,
+                     int slot,
+                     bool before,
+                     bool after);
+
+    void Do() override = 0;
+    void Undo() override = 0;
+
+protected:
+    MixerSystem* m_mixerSystem = nullptr;
+    MixGroupHandle m_mixGroupHandle;
+    int m_slot = -1;
+    bool m_before = false;
+    bool m_after = false;
+};
+
+class SetSidechainParameter : public Action
+{
+public:
+    SetSidechainParameter(EditorPlugin* editorPlugin,
+                          MixerSystem* mixerSystem,
+                          MixGroupHandle mixGroupHandle,
+                          int slot,
+                          MixGroupHandle before,
+                          MixGroupHandle after);
+
+    void Do() override = 0;
+    void Undo() override = 0;
+
+protected:
+    MixerSystem* m_mixerSystem = nullptr;
+    MixGroupHandle m_mixGroupHandle;
+    int m_slot = -1;
+    MixGroupHandle m_before;
+    MixGroupHandle m_after;
+};
+
 RF_DEFINE_FLOAT_SETTER(Gain_SetGain);
 RF_DEFINE_INT_SETTER(BWHP_SetOrder);
 RF_DEFINE_FLOAT_SETTER(BWHP_SetCutoff);
@@ -192,14 +280,29 @@ RF_DEFINE_FLOAT_SETTER(Compressor_SetRatio);
 RF_DEFINE_FLOAT_SETTER(Compressor_SetMakeUpGain);
 RF_DEFINE_FLOAT_SETTER(Compressor_SetAttack);
 RF_DEFINE_FLOAT_SETTER(Compressor_SetRelease);
+RF_DEFINE_FLOAT_SETTER(Compressor_SetKnee);
+RF_DEFINE_BOOL_SETTER(Compressor_SetDetectRMS);
+RF_DEFINE_SIDECHAIN_SETTER(Compressor_SetSidechain);
 RF_DEFINE_FLOAT_SETTER(Delay_SetDelay);
 RF_DEFINE_FLOAT_SETTER(Delay_SetFeedback);
+RF_DEFINE_BOOL_SETTER(Delay_SetTempoSync);
+RF_DEFINE_INT_SETTER(Delay_SetSyncValue);
+RF_DEFINE_FLOAT_SETTER(Ducker_SetThreshold);
+RF_DEFINE_FLOAT_SETTER(Ducker_SetDepth);
+RF_DEFINE_FLOAT_SETTER(Ducker_SetAttack);
+RF_DEFINE_FLOAT_SETTER(Ducker_SetRelease);
+RF_DEFINE_FLOAT_SETTER(Ducker_SetHold);
+RF_DEFINE_SIDECHAIN_SETTER(Ducker_SetSidechain);
 RF_DEFINE_FLOAT_SETTER(IIR2HP_SetQ);
 RF_DEFINE_FLOAT_SETTER(IIR2HP_SetCutoff);
 RF_DEFINE_FLOAT_SETTER(IIR2LP_SetQ);
 RF_DEFINE_FLOAT_SETTER(IIR2LP_SetCutoff);
 RF_DEFINE_FLOAT_SETTER(Limiter_SetThreshold);
+RF_DEFINE_FLOAT_SETTER(Limiter_SetLookahead);
+RF_DEFINE_FLOAT_SETTER(Limiter_SetRelease);
+RF_DEFINE_BOOL_SETTER(Limiter_SetTruePeak);
 RF_DEFINE_FLOAT_SETTER(Pan_SetAngle);
+RF_DEFINE_INT_SETTER(Pan_SetPanLaw);
 RF_DEFINE_FLOAT_SETTER(Position_SetAngle);
 RF_DEFINE_FLOAT_SETTER(Position_SetCurrentDistance);
 RF_DEFINE_FLOAT_SETTER(Position_MinCurrentDistance);
@@ -210,4 +313,6 @@ RF_DEFINE_FLOAT_SETTER(Position_MaxLPFCutoff);
 }  // namespace rf
 
 #undef RF_DEFINE_FLOAT_SETTER
-#undef RF_DEFINE_INT_SETTER
\ No newline at end of file
+#undef RF_DEFINE_INT_SETTER
+#undef RF_DEFINE_BOOL_SETTER
+#undef RF_DEFINE_SIDECHAIN_SETTER
\ No newline at end of file
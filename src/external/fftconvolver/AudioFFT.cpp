@@ -24,6 +24,8 @@
 #include <cassert>
 #include <cmath>
 #include <cstring>
+/* RedFish Modification */
+#include <vector>
 
 #if defined(AUDIOFFT_APPLE_ACCELERATE)
 #    define AUDIOFFT_APPLE_ACCELERATE_USED
@@ -41,6 +43,12 @@
 #    include <vector>
 #endif
 
+/* RedFish Modification */
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#    define AUDIOFFT_USE_SSE
+#    include <xmmintrin.h>
+#endif
+
 namespace audiofft
 {
 namespace detail
@@ -1004,11 +1012,507 @@ typedef FFTW3FFT AudioFFTImplementation;
 
 #endif  // AUDIOFFT_FFTW3_USED
 
+// ================================================================
+
+/* RedFish Modification */
+
+/**
+ * @internal
+ * @class Radix4FFT
+ * @brief Single precision real FFT built on a radix-4 Stockham complex FFT of half the size
+ *
+ * The real input is packed into a complex sequence of half the length, transformed with an autosorting
+ * radix-4 FFT (no bit reversal pass, a radix-2 stage finishes odd powers of 2) and split back into the
+ * spectrum of the real input. Everything stays in single precision and split-complex layout, so unlike
+ * the Ooura implementation there is no conversion to and from double precision.
+ */
+class Radix4FFT : public detail::AudioFFTImpl
+{
+public:
+    Radix4FFT()
+        : detail::AudioFFTImpl()
+        , _size(0)
+        , _half(0)
+        , _cos()
+        , _sin()
+        , _re()
+        , _im()
+        , _workRe()
+        , _workIm()
+        , _twiddles()
+    {
+    }
+
+    Radix4FFT(const Radix4FFT &) = delete;
+    Radix4FFT &operator=(const Radix4FFT &) = delete;
+
+    virtual void init(size_t size) override
+    {
+        if (_size != size)
+        {
+            _size = size;
+            _half = size / 2;
+
+            // exp(2 * pi * i * k / size) serves both the complex stages and the real split.
+            _cos.resize(size);
+            _sin.resize(size);
+            const double twoPi = 6.283185307179586476925286766559;
+            for (size_t k = 0; k < size; ++k)
+            {
+                const double phase = twoPi * static_cast<double>(k) / static_cast<double>(size);
+                _cos[k] = static_cast<float>(std::cos(phase));
+                _sin[k] = static_cast<float>(std::sin(phase));
+            }
+
+            _re.resize(_half);
+            _im.resize(_half);
+            _workRe.resize(_half);
+            _workIm.resize(_half);
+
+            // Contiguous twiddles for every radix-4 pass so they can be loaded as vectors.
+            _twiddles.clear();
+            for (size_t n = _half; n > 2; n /= 4)
+            {
+                const size_t n1 = n / 4;
+                const size_t stride = _size / n;
+                for (size_t k = 1; k <= 3; ++k)
+                {
+                    for (size_t p = 0; p < n1; ++p)
+                    {
+                        _twiddles.push_back(_cos[k * p * stride]);
+                    }
+                    for (size_t p = 0; p < n1; ++p)
+                    {
+                        _twiddles.push_back(-_sin[k * p * stride]);
+                    }
+                }
+            }
+        }
+    }
+
+    virtual void fft(const float *data, float *re, float *im) override
+    {
+        const size_t half = _half;
+        float *zr = _re.data();
+        float *zi = _im.data();
+
+        // Even samples become the real part, odd samples the imaginary part.
+        size_t n = 0;
+#if defined(AUDIOFFT_USE_SSE)
+        for (; n + 4 <= half; n += 4)
+        {
+            const __m128 lo = _mm_loadu_ps(data + 2 * n);
+            const __m128 hi = _mm_loadu_ps(data + 2 * n + 4);
+            _mm_storeu_ps(zr + n, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(zi + n, _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+#endif
+        for (; n < half; ++n)
+        {
+            zr[n] = data[2 * n];
+            zi[n] = data[2 * n + 1];
+        }
+
+        transform(zr, zi, _workRe.data(), _workIm.data());
+
+        // X[k] = E[k] + W^k * O[k], with E and O recovered from Z[k] and conj(Z[half - k]).
+        re[0] = zr[0] + zi[0];
+        im[0] = 0.0f;
+        re[half] = zr[0] - zi[0];
+        im[half] = 0.0f;
+
+        size_t k = 1;
+#if defined(AUDIOFFT_USE_SSE)
+        const __m128 halfScale = _mm_set1_ps(0.5f);
+        for (; k + 4 <= half; k += 4)
+        {
+            const __m128 zkR = _mm_loadu_ps(zr + k);
+            const __m128 zkI = _mm_loadu_ps(zi + k);
+            const __m128 zmR = reverse(_mm_loadu_ps(zr + half - k - 3));
+            const __m128 zmI = reverse(_mm_loadu_ps(zi + half - k - 3));
+            const __m128 evenRe = _mm_mul_ps(halfScale, _mm_add_ps(zkR, zmR));
+            const __m128 evenIm = _mm_mul_ps(halfScale, _mm_sub_ps(zkI, zmI));
+            const __m128 oddRe = _mm_mul_ps(halfScale, _mm_add_ps(zkI, zmI));
+            const __m128 oddIm = _mm_mul_ps(halfScale, _mm_sub_ps(zmR, zkR));
+            const __m128 c = _mm_loadu_ps(_cos.data() + k);
+            const __m128 s = _mm_loadu_ps(_sin.data() + k);
+            _mm_storeu_ps(re + k, _mm_add_ps(evenRe, _mm_add_ps(_mm_mul_ps(c, oddRe), _mm_mul_ps(s, oddIm))));
+            _mm_storeu_ps(im + k, _mm_add_ps(evenIm, _mm_sub_ps(_mm_mul_ps(c, oddIm), _mm_mul_ps(s, oddRe))));
+        }
+#endif
+        for (; k < half; ++k)
+        {
+            const float evenRe = 0.5f * (zr[k] + zr[half - k]);
+            const float evenIm = 0.5f * (zi[k] - zi[half - k]);
+            const float oddRe = 0.5f * (zi[k] + zi[half - k]);
+            const float oddIm = 0.5f * (zr[half - k] - zr[k]);
+            const float c = _cos[k];
+            const float s = _sin[k];
+            re[k] = evenRe + c * oddRe + s * oddIm;
+            im[k] = evenIm + c * oddIm - s * oddRe;
+        }
+    }
+
+    virtual void ifft(float *data, const float *re, const float *im) override
+    {
+        const size_t half = _half;
+        float *zr = _re.data();
+        float *zi = _im.data();
+
+        // Z[k] = E[k] + i * O[k], the DC and Nyquist bins of a real signal have no imaginary part.
+        zr[0] = 0.5f * (re[0] + re[half]);
+        zi[0] = 0.5f * (re[0] - re[half]);
+
+        size_t k = 1;
+#if defined(AUDIOFFT_USE_SSE)
+        const __m128 halfScale = _mm_set1_ps(0.5f);
+        for (; k + 4 <= half; k += 4)
+        {
+            const __m128 xkR = _mm_loadu_ps(re + k);
+            const __m128 xkI = _mm_loadu_ps(im + k);
+            const __m128 xmR = reverse(_mm_loadu_ps(re + half - k - 3));
+            const __m128 xmI = reverse(_mm_loadu_ps(im + half - k - 3));
+            const __m128 evenRe = _mm_mul_ps(halfScale, _mm_add_ps(xkR, xmR));
+            const __m128 evenIm = _mm_mul_ps(halfScale, _mm_sub_ps(xkI, xmI));
+            const __m128 diffRe = _mm_mul_ps(halfScale, _mm_sub_ps(xkR, xmR));
+            const __m128 diffIm = _mm_mul_ps(halfScale, _mm_add_ps(xkI, xmI));
+            const __m128 c = _mm_loadu_ps(_cos.data() + k);
+            const __m128 s = _mm_loadu_ps(_sin.data() + k);
+            const __m128 oddRe = _mm_sub_ps(_mm_mul_ps(diffRe, c), _mm_mul_ps(diffIm, s));
+            const __m128 oddIm = _mm_add_ps(_mm_mul_ps(diffRe, s), _mm_mul_ps(diffIm, c));
+            _mm_storeu_ps(zr + k, _mm_sub_ps(evenRe, oddIm));
+            _mm_storeu_ps(zi + k, _mm_add_ps(evenIm, oddRe));
+        }
+#endif
+        for (; k < half; ++k)
+        {
+            const float evenRe = 0.5f * (re[k] + re[half - k]);
+            const float evenIm = 0.5f * (im[k] - im[half - k]);
+            const float diffRe = 0.5f * (re[k] - re[half - k]);
+            const float diffIm = 0.5f * (im[k] + im[half - k]);
+            const float c = _cos[k];
+            const float s = _sin[k];
+            const float oddRe = diffRe * c - diffIm * s;
+            const float oddIm = diffRe * s + diffIm * c;
+            zr[k] = evenRe - oddIm;
+            zi[k] = evenIm + oddRe;
+        }
+
+        // The inverse transform is the forward transform with the real and imaginary parts swapped.
+        transform(zi, zr, _workIm.data(), _workRe.data());
+
+        const float scale = 1.0f / static_cast<float>(half);
+        size_t n = 0;
+#if defined(AUDIOFFT_USE_SSE)
+        const __m128 simdScale = _mm_set1_ps(scale);
+        for (; n + 4 <= half; n += 4)
+        {
+            const __m128 r = _mm_mul_ps(_mm_loadu_ps(zr + n), simdScale);
+            const __m128 i = _mm_mul_ps(_mm_loadu_ps(zi + n), simdScale);
+            _mm_storeu_ps(data + 2 * n, _mm_unpacklo_ps(r, i));
+            _mm_storeu_ps(data + 2 * n + 4, _mm_unpackhi_ps(r, i));
+        }
+#endif
+        for (; n < half; ++n)
+        {
+            data[2 * n] = zr[n] * scale;
+            data[2 * n + 1] = zi[n] * scale;
+        }
+    }
+
+private:
+    size_t _size;
+    size_t _half;
+    std::vector<float> _cos;
+    std::vector<float> _sin;
+    std::vector<float> _re;
+    std::vector<float> _im;
+    std::vector<float> _workRe;
+    std::vector<float> _workIm;
+    std::vector<float> _twiddles;
+
+    // In-place forward complex FFT of _half points. The work buffers must be _half points as well.
+    void transform(float *re, float *im, float *workRe, float *workIm)
+    {
+        float *xr = re;
+        float *xi = im;
+        float *yr = workRe;
+        float *yi = workIm;
+        const float *twiddles = _twiddles.data();
+        size_t n = _half;
+        size_t s = 1;
+
+        while (n > 2)
+        {
+            const size_t n1 = n / 4;
+            radix4(xr, xi, yr, yi, n1, s, twiddles);
+            twiddles += 6 * n1;
+
+            std::swap(xr, yr);
+            std::swap(xi, yi);
+            n /= 4;
+            s *= 4;
+        }
+
+        // The data is in x. It has to end up in re/im, which is y whenever x is the work buffer.
+        float *outR = (xr == re) ? xr : yr;
+        float *outI = (xi == im) ? xi : yi;
+
+        if (n == 2)
+        {
+            radix2(xr, xi, outR, outI, s);
+        }
+        else if (outR != xr)
+        {
+            ::memcpy(outR, xr, s * sizeof(float));
+            ::memcpy(outI, xi, s * sizeof(float));
+        }
+    }
+
+    // One autosorting radix-4 pass: y[s * (4p + k)] = w^(kp) * DFT4(x[s * p], x[s * (p + n1)], ...)[k].
+    // The twiddles of the pass are laid out as 6 arrays of n1 (w1 re/im, w2 re/im, w3 re/im).
+    static void radix4(const float *xr, const float *xi, float *yr, float *yi, size_t n1, size_t s, const float *twiddles)
+    {
+        const size_t n2 = 2 * n1;
+        const size_t n3 = 3 * n1;
+        const float *w1r = twiddles;
+        const float *w1i = twiddles + n1;
+        const float *w2r = twiddles + 2 * n1;
+        const float *w2i = twiddles + 3 * n1;
+        const float *w3r = twiddles + 4 * n1;
+        const float *w3i = twiddles + 5 * n1;
+
+#if defined(AUDIOFFT_USE_SSE)
+        if (s >= 4)
+        {
+            // Vectorize over q, the data of each butterfly input is contiguous.
+            for (size_t p = 0; p < n1; ++p)
+            {
+                const __m128 tw1r = _mm_set1_ps(w1r[p]);
+                const __m128 tw1i = _mm_set1_ps(w1i[p]);
+                const __m128 tw2r = _mm_set1_ps(w2r[p]);
+                const __m128 tw2i = _mm_set1_ps(w2i[p]);
+                const __m128 tw3r = _mm_set1_ps(w3r[p]);
+                const __m128 tw3i = _mm_set1_ps(w3i[p]);
+
+                for (size_t q = 0; q < s; q += 4)
+                {
+                    __m128 y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i;
+                    butterfly(_mm_loadu_ps(xr + s * p + q),
+                              _mm_loadu_ps(xi + s * p + q),
+                              _mm_loadu_ps(xr + s * (p + n1) + q),
+                              _mm_loadu_ps(xi + s * (p + n1) + q),
+                              _mm_loadu_ps(xr + s * (p + n2) + q),
+                              _mm_loadu_ps(xi + s * (p + n2) + q),
+                              _mm_loadu_ps(xr + s * (p + n3) + q),
+                              _mm_loadu_ps(xi + s * (p + n3) + q),
+                              tw1r, tw1i, tw2r, tw2i, tw3r, tw3i,
+                              y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i);
+                    _mm_storeu_ps(yr + s * (4 * p + 0) + q, y0r);
+                    _mm_storeu_ps(yi + s * (4 * p + 0) + q, y0i);
+                    _mm_storeu_ps(yr + s * (4 * p + 1) + q, y1r);
+                    _mm_storeu_ps(yi + s * (4 * p + 1) + q, y1i);
+                    _mm_storeu_ps(yr + s * (4 * p + 2) + q, y2r);
+                    _mm_storeu_ps(yi + s * (4 * p + 2) + q, y2i);
+                    _mm_storeu_ps(yr + s * (4 * p + 3) + q, y3r);
+                    _mm_storeu_ps(yi + s * (4 * p + 3) + q, y3i);
+                }
+            }
+            return;
+        }
+
+        if (n1 >= 4)
+        {
+            // s == 1: vectorize over p and transpose so four consecutive butterflies are stored contiguously.
+            for (size_t p = 0; p < n1; p += 4)
+            {
+                __m128 y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i;
+                butterfly(_mm_loadu_ps(xr + p),
+                          _mm_loadu_ps(xi + p),
+                          _mm_loadu_ps(xr + p + n1),
+                          _mm_loadu_ps(xi + p + n1),
+                          _mm_loadu_ps(xr + p + n2),
+                          _mm_loadu_ps(xi + p + n2),
+                          _mm_loadu_ps(xr + p + n3),
+                          _mm_loadu_ps(xi + p + n3),
+                          _mm_loadu_ps(w1r + p),
+                          _mm_loadu_ps(w1i + p),
+                          _mm_loadu_ps(w2r + p),
+                          _mm_loadu_ps(w2i + p),
+                          _mm_loadu_ps(w3r + p),
+                          _mm_loadu_ps(w3i + p),
+                          y0r, y0i, y1r, y1i, y2r, y2i, y3r, y3i);
+                _MM_TRANSPOSE4_PS(y0r, y1r, y2r, y3r);
+                _MM_TRANSPOSE4_PS(y0i, y1i, y2i, y3i);
+                _mm_storeu_ps(yr + 4 * p + 0, y0r);
+                _mm_storeu_ps(yr + 4 * p + 4, y1r);
+                _mm_storeu_ps(yr + 4 * p + 8, y2r);
+                _mm_storeu_ps(yr + 4 * p + 12, y3r);
+                _mm_storeu_ps(yi + 4 * p + 0, y0i);
+                _mm_storeu_ps(yi + 4 * p + 4, y1i);
+                _mm_storeu_ps(yi + 4 * p + 8, y2i);
+                _mm_storeu_ps(yi + 4 * p + 12, y3i);
+            }
+            return;
+        }
+#endif
+
+        for (size_t p = 0; p < n1; ++p)
+        {
+            for (size_t q = 0; q < s; ++q)
+            {
+                const float *ar = xr + s * p + q;
+                const float *ai = xi + s * p + q;
+                const float *br = xr + s * (p + n1) + q;
+                const float *bi = xi + s * (p + n1) + q;
+                const float *cr = xr + s * (p + n2) + q;
+                const float *ci = xi + s * (p + n2) + q;
+                const float *dr = xr + s * (p + n3) + q;
+                const float *di = xi + s * (p + n3) + q;
+
+                const float apcR = *ar + *cr;
+                const float apcI = *ai + *ci;
+                const float amcR = *ar - *cr;
+                const float amcI = *ai - *ci;
+                const float bpdR = *br + *dr;
+                const float bpdI = *bi + *di;
+                const float bmdR = *br - *dr;
+                const float bmdI = *bi - *di;
+
+                const float t1r = amcR + bmdI;
+                const float t1i = amcI - bmdR;
+                const float t2r = apcR - bpdR;
+                const float t2i = apcI - bpdI;
+                const float t3r = amcR - bmdI;
+                const float t3i = amcI + bmdR;
+
+                yr[s * (4 * p + 0) + q] = apcR + bpdR;
+                yi[s * (4 * p + 0) + q] = apcI + bpdI;
+                yr[s * (4 * p + 1) + q] = w1r[p] * t1r - w1i[p] * t1i;
+                yi[s * (4 * p + 1) + q] = w1r[p] * t1i + w1i[p] * t1r;
+                yr[s * (4 * p + 2) + q] = w2r[p] * t2r - w2i[p] * t2i;
+                yi[s * (4 * p + 2) + q] = w2r[p] * t2i + w2i[p] * t2r;
+                yr[s * (4 * p + 3) + q] = w3r[p] * t3r - w3i[p] * t3i;
+                yi[s * (4 * p + 3) + q] = w3r[p] * t3i + w3i[p] * t3r;
+            }
+        }
+    }
+
+    // The final radix-2 pass for odd powers of 2, no twiddles are needed.
+    static void radix2(const float *xr, const float *xi, float *yr, float *yi, size_t s)
+    {
+        size_t q = 0;
+#if defined(AUDIOFFT_USE_SSE)
+        for (; q + 4 <= s; q += 4)
+        {
+            const __m128 aR = _mm_loadu_ps(xr + q);
+            const __m128 aI = _mm_loadu_ps(xi + q);
+            const __m128 bR = _mm_loadu_ps(xr + q + s);
+            const __m128 bI = _mm_loadu_ps(xi + q + s);
+            _mm_storeu_ps(yr + q, _mm_add_ps(aR, bR));
+            _mm_storeu_ps(yi + q, _mm_add_ps(aI, bI));
+            _mm_storeu_ps(yr + q + s, _mm_sub_ps(aR, bR));
+            _mm_storeu_ps(yi + q + s, _mm_sub_ps(aI, bI));
+        }
+#endif
+        for (; q < s; ++q)
+        {
+            const float aR = xr[q];
+            const float aI = xi[q];
+            const float bR = xr[q + s];
+            const float bI = xi[q + s];
+            yr[q] = aR + bR;
+            yi[q] = aI + bI;
+            yr[q + s] = aR - bR;
+            yi[q + s] = aI - bI;
+        }
+    }
+
+#if defined(AUDIOFFT_USE_SSE)
+    static inline __m128 reverse(const __m128 value)
+    {
+        return _mm_shuffle_ps(value, value, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+
+    static inline void butterfly(const __m128 ar,
+                                 const __m128 ai,
+                                 const __m128 br,
+                                 const __m128 bi,
+                                 const __m128 cr,
+                                 const __m128 ci,
+                                 const __m128 dr,
+                                 const __m128 di,
+                                 const __m128 w1r,
+                                 const __m128 w1i,
+                                 const __m128 w2r,
+                                 const __m128 w2i,
+                                 const __m128 w3r,
+                                 const __m128 w3i,
+                                 __m128 &y0r,
+                                 __m128 &y0i,
+                                 __m128 &y1r,
+                                 __m128 &y1i,
+                                 __m128 &y2r,
+                                 __m128 &y2i,
+                                 __m128 &y3r,
+                                 __m128 &y3i)
+    {
+        const __m128 apcR = _mm_add_ps(ar, cr);
+        const __m128 apcI = _mm_add_ps(ai, ci);
+        const __m128 amcR = _mm_sub_ps(ar, cr);
+        const __m128 amcI = _mm_sub_ps(ai, ci);
+        const __m128 bpdR = _mm_add_ps(br, dr);
+        const __m128 bpdI = _mm_add_ps(bi, di);
+        const __m128 bmdR = _mm_sub_ps(br, dr);
+        const __m128 bmdI = _mm_sub_ps(bi, di);
+
+        const __m128 t1r = _mm_add_ps(amcR, bmdI);
+        const __m128 t1i = _mm_sub_ps(amcI, bmdR);
+        const __m128 t2r = _mm_sub_ps(apcR, bpdR);
+        const __m128 t2i = _mm_sub_ps(apcI, bpdI);
+        const __m128 t3r = _mm_sub_ps(amcR, bmdI);
+        const __m128 t3i = _mm_add_ps(amcI, bmdR);
+
+        y0r = _mm_add_ps(apcR, bpdR);
+        y0i = _mm_add_ps(apcI, bpdI);
+        y1r = _mm_sub_ps(_mm_mul_ps(w1r, t1r), _mm_mul_ps(w1i, t1i));
+        y1i = _mm_add_ps(_mm_mul_ps(w1r, t1i), _mm_mul_ps(w1i, t1r));
+        y2r = _mm_sub_ps(_mm_mul_ps(w2r, t2r), _mm_mul_ps(w2i, t2i));
+        y2i = _mm_add_ps(_mm_mul_ps(w2r, t2i), _mm_mul_ps(w2i, t2r));
+        y3r = _mm_sub_ps(_mm_mul_ps(w3r, t3r), _mm_mul_ps(w3i, t3i));
+        y3i = _mm_add_ps(_mm_mul_ps(w3r, t3i), _mm_mul_ps(w3i, t3r));
+    }
+#endif
+};
+
 // =============================================================
 
+/* RedFish Modification */
+AudioFFT::Backend AudioFFT::s_backend = AudioFFT::Backend::Radix4;
+
 AudioFFT::AudioFFT()
-    : _impl(new AudioFFTImplementation())
 {
+    /* RedFish Modification */
+    if (s_backend == Backend::Radix4)
+    {
+        _impl.reset(new Radix4FFT());
+    }
+    else
+    {
+        _impl.reset(new AudioFFTImplementation());
+    }
+}
+
+/* RedFish Modification */
+void AudioFFT::SetBackend(Backend backend)
+{
+    s_backend = backend;
+}
+
+/* RedFish Modification */
+AudioFFT::Backend AudioFFT::GetBackend()
+{
+    return s_backend;
 }
 
 AudioFFT::~AudioFFT() {}
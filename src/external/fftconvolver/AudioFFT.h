@@ -152,8 +152,34 @@ namespace audiofft
      */
     static size_t ComplexSize(size_t size);
 
+    /* RedFish Modification */
+    /**
+     * @brief The FFT implementations that can be selected at runtime
+     */
+    enum class Backend
+    {
+      Radix4,  // Single precision radix-4 Stockham FFT (default)
+      Library, // The implementation selected at compile time (Ooura, FFTW3 or Apple Accelerate)
+    };
+
+    /* RedFish Modification */
+    /**
+     * @brief Selects the implementation used by AudioFFT objects constructed afterwards
+     * @param backend The implementation
+     */
+    static void SetBackend(Backend backend);
+
+    /* RedFish Modification */
+    /**
+     * @brief Returns the implementation used by AudioFFT objects constructed from now on
+     */
+    static Backend GetBackend();
+
   private:
     std::unique_ptr<detail::AudioFFTImpl> _impl;
+
+    /* RedFish Modification */
+    static Backend s_backend;
   };
 
 
@@ -36,17 +36,25 @@ FFTConvolver::FFTConvolver()
     , _segCount(0)
     , _fftComplexSize(0)
     , _segments()
-    , _segmentsIR()
-    , _master_ir_segments()
+    , _irSegments()
+    , _irSegCount()
+    , _irAmplitudes()
     , _fftBuffer()
     , _fft()
     , _preMultiplied()
+    , _mixedHead()
+    , _mixedHeadDirty(true)
     , _conv()
     , _overlap()
     , _current(0)
     , _inputBuffer()
     , _inputBufferFill(0)
 {
+    /* RedFish Modification */
+    for (int i = 0; i < FFTCONVOLER_MAX_NUM_IR; ++i)
+    {
+        _irAmplitudes[i] = 1.0f;
+    }
 }
 
 FFTConvolver::~FFTConvolver()
@@ -59,12 +67,6 @@ void FFTConvolver::reset()
     for (size_t i = 0; i < _segCount; ++i)
     {
         delete _segments[i];
-
-        /* RedFish Modification */
-        for (int j = 0; j < FFTCONVOLER_MAX_NUM_IR; ++j)
-        {
-            delete _segmentsIR[j][i];
-        }
     }
 
     _blockSize = 0;
@@ -76,13 +78,15 @@ void FFTConvolver::reset()
     /* RedFish Modification */
     for (int i = 0; i < FFTCONVOLER_MAX_NUM_IR; ++i)
     {
-        _segmentsIR[i].clear();
+        _irSegments[i] = nullptr;
+        _irSegCount[i] = 0;
     }
-    _master_ir_segments.clear();
 
     _fftBuffer.clear();
     _fft.init(0);
     _preMultiplied.clear();
+    _mixedHead.clear();
+    _mixedHeadDirty = true;
     _conv.clear();
     _overlap.clear();
     _current = 0;
@@ -93,33 +97,20 @@ void FFTConvolver::reset()
 /* RedFish Modification */
 void FFTConvolver::setImpulseResponseAmplitudes(const float amplitudes[FFTCONVOLER_MAX_NUM_IR])
 {
-    for (int i = 0; i < _segCount; ++i)
+    // The segments are shared between convolvers, so the amplitudes are applied while multiplying rather than baked into
+    // a per-convolver copy of the impulse response.
+    for (int i = 0; i < FFTCONVOLER_MAX_NUM_IR; ++i)
     {
-        const fftconvolver::Sample *s1_re = _segmentsIR[0][i]->re();
-        const fftconvolver::Sample *s1_im = _segmentsIR[0][i]->im();
-        const fftconvolver::Sample *s2_re = _segmentsIR[1][i]->re();
-        const fftconvolver::Sample *s2_im = _segmentsIR[1][i]->im();
-        const fftconvolver::Sample *s3_re = _segmentsIR[2][i]->re();
-        const fftconvolver::Sample *s3_im = _segmentsIR[2][i]->im();
-        fftconvolver::Sample *__restrict master_re = _master_ir_segments[i]->re();
-        fftconvolver::Sample *__restrict master_im = _master_ir_segments[i]->im();
-
-        for (int j = 0; j < _fftComplexSize; ++j)
+        if (_irAmplitudes[i] != amplitudes[i])
         {
-            float temp_re = s1_re[j] * amplitudes[0];
-            temp_re += s2_re[j] * amplitudes[1];
-            temp_re += s3_re[j] * amplitudes[2];
-            float temp_im = s1_im[j] * amplitudes[0];
-            temp_im += s2_im[j] * amplitudes[1];
-            temp_im += s3_im[j] * amplitudes[2];
-            master_re[j] = temp_re;
-            master_im[j] = temp_im;
+            _irAmplitudes[i] = amplitudes[i];
+            _mixedHeadDirty = true;
         }
     }
 }
 
 /* RedFish Modification */
-bool FFTConvolver::init(size_t blockSize, Sample **ir, size_t irLen)
+bool FFTConvolver::init(size_t blockSize, size_t segCount)
 {
     reset();
 
@@ -128,21 +119,14 @@ bool FFTConvolver::init(size_t blockSize, Sample **ir, size_t irLen)
         return false;
     }
 
-    /* RedFish Modification */
-    // Ignore zeros at the end of the impulse response because they only waste computation time
-    // while (irLen > 0 && ::fabs(ir[0][irLen-1]) < 0.000001f)
-    //{
-    //  --irLen;
-    //}
-
-    if (irLen == 0)
+    if (segCount == 0)
     {
         return true;
     }
 
     _blockSize = NextPowerOf2(blockSize);
     _segSize = 2 * _blockSize;
-    _segCount = static_cast<size_t>(::ceil(static_cast<float>(irLen) / static_cast<float>(_blockSize)));
+    _segCount = segCount;
     _fftComplexSize = audiofft::AudioFFT::ComplexSize(_segSize);
 
     // FFT
@@ -155,49 +139,150 @@ bool FFTConvolver::init(size_t blockSize, Sample **ir, size_t irLen)
         _segments.push_back(new SplitComplex(_fftComplexSize));
     }
 
-    /* RedFish Modification */
+    // Prepare convolution buffers
+    _preMultiplied.resize(_fftComplexSize);
+    _mixedHead.resize(_fftComplexSize);
+    _mixedHeadDirty = true;
+    _conv.resize(_fftComplexSize);
+    _overlap.resize(_blockSize);
+
+    // Prepare input buffer
+    _inputBuffer.resize(_blockSize);
+    _inputBufferFill = 0;
+
+    // Reset current position
+    _current = 0;
+
+    return true;
+}
+
+/* RedFish Modification */
+void FFTConvolver::clear()
+{
+    for (size_t i = 0; i < _segCount; ++i)
+    {
+        _segments[i]->setZero();
+    }
+
+    _inputBuffer.setZero();
+    _inputBufferFill = 0;
+    _overlap.setZero();
+    _current = 0;
+}
+
+/* RedFish Modification */
+bool FFTConvolver::setImpulseResponse(int index, const SplitComplex *segments, size_t segCount)
+{
+    if (index < 0 || index >= FFTCONVOLER_MAX_NUM_IR)
+    {
+        return false;
+    }
+
+    if (!segments || segCount == 0)
+    {
+        _irSegments[index] = nullptr;
+        _irSegCount[index] = 0;
+        _mixedHeadDirty = true;
+        return true;
+    }
+
+    if (segCount > _segCount || segments[0].size() != _fftComplexSize)
+    {
+        return false;
+    }
+
+    _irSegments[index] = segments;
+    _irSegCount[index] = segCount;
+    _mixedHeadDirty = true;
+    return true;
+}
+
+/* RedFish Modification */
+const SplitComplex* FFTConvolver::mixHead(Sample& scale)
+{
+    // The head segment is multiplied once per process() call rather than once per block. While several impulse
+    // responses are audible (a crossfade) their scaled heads are summed into one spectrum whenever the amplitudes
+    // change, so every call costs a single multiply-accumulate no matter how many impulse responses are mixed.
+    int numActive = 0;
+    int lastActive = 0;
     for (int j = 0; j < FFTCONVOLER_MAX_NUM_IR; ++j)
     {
-        // Prepare IR
-        for (size_t i = 0; i < _segCount; ++i)
+        if (_irSegments[j] && _irAmplitudes[j] != 0.0f)
         {
-            /* RedFish Modification */
-            SplitComplex *master_segment = new SplitComplex(_fftComplexSize);
-            master_segment->setZero();
-            _master_ir_segments.push_back(master_segment);
-            SplitComplex *segment = new SplitComplex(_fftComplexSize);
-            const size_t remaining = irLen - (i * _blockSize);
-            const size_t sizeCopy = (remaining >= _blockSize) ? _blockSize : remaining;
-            /* RedFish Modification */
-            CopyAndPad(_fftBuffer, &ir[j][i * _blockSize], sizeCopy);
-            _fft.fft(_fftBuffer.data(), segment->re(), segment->im());
-            _segmentsIR[j].push_back(segment);
+            ++numActive;
+            lastActive = j;
         }
     }
 
-    /* RedFish Modification */
-    for (int i = 0; i < _segCount; ++i)
+    if (numActive == 0)
+    {
+        return nullptr;
+    }
+
+    if (numActive == 1)
     {
-        for (int j = 0; j < _fftComplexSize; ++j)
+        scale = _irAmplitudes[lastActive];
+        return &_irSegments[lastActive][0];
+    }
+
+    if (_mixedHeadDirty)
+    {
+        _mixedHead.setZero();
+        Sample* re = _mixedHead.re();
+        Sample* im = _mixedHead.im();
+        for (int j = 0; j < FFTCONVOLER_MAX_NUM_IR; ++j)
         {
-            _master_ir_segments[i]->re()[j] = _segmentsIR[0][i]->re()[j];
-            _master_ir_segments[i]->im()[j] = _segmentsIR[0][i]->im()[j];
+            if (!_irSegments[j] || _irAmplitudes[j] == 0.0f)
+            {
+                continue;
+            }
+
+            const Sample amplitude = _irAmplitudes[j];
+            const Sample* irRe = _irSegments[j][0].re();
+            const Sample* irIm = _irSegments[j][0].im();
+            for (size_t i = 0; i < _fftComplexSize; ++i)
+            {
+                re[i] += amplitude * irRe[i];
+                im[i] += amplitude * irIm[i];
+            }
         }
+        _mixedHeadDirty = false;
     }
 
-    // Prepare convolution buffers
-    _preMultiplied.resize(_fftComplexSize);
-    _conv.resize(_fftComplexSize);
-    _overlap.resize(_blockSize);
+    scale = 1.0f;
+    return &_mixedHead;
+}
 
-    // Prepare input buffer
-    _inputBuffer.resize(_blockSize);
-    _inputBufferFill = 0;
+/* RedFish Modification */
+size_t FFTConvolver::SegmentCount(size_t blockSize, size_t irLen)
+{
+    const size_t partitionSize = NextPowerOf2(blockSize);
+    return (irLen + partitionSize - 1) / partitionSize;
+}
 
-    // Reset current position
-    _current = 0;
+/* RedFish Modification */
+size_t FFTConvolver::SegmentSize(size_t blockSize)
+{
+    return audiofft::AudioFFT::ComplexSize(2 * NextPowerOf2(blockSize));
+}
 
-    return true;
+/* RedFish Modification */
+void FFTConvolver::PrepareSegments(size_t blockSize, const Sample *ir, size_t irLen, SplitComplex *segments)
+{
+    const size_t partitionSize = NextPowerOf2(blockSize);
+    const size_t segCount = SegmentCount(blockSize, irLen);
+
+    audiofft::AudioFFT fft;
+    fft.init(2 * partitionSize);
+    SampleBuffer fftBuffer(2 * partitionSize);
+
+    for (size_t i = 0; i < segCount; ++i)
+    {
+        const size_t remaining = irLen - (i * partitionSize);
+        const size_t sizeCopy = (remaining >= partitionSize) ? partitionSize : remaining;
+        CopyAndPad(fftBuffer, &ir[i * partitionSize], sizeCopy);
+        fft.fft(fftBuffer.data(), segments[i].re(), segments[i].im());
+    }
 }
 
 void FFTConvolver::process(const Sample *input, Sample *output, size_t len)
@@ -224,19 +309,33 @@ void FFTConvolver::process(const Sample *input, Sample *output, size_t len)
         if (inputBufferWasEmpty)
         {
             _preMultiplied.setZero();
-            for (size_t i = 1; i < _segCount; ++i)
-            {
-                const size_t indexIr = i;
-                const size_t indexAudio = (_current + i) % _segCount;
 
-                /* RedFish Modification */
-                ComplexMultiplyAccumulate(_preMultiplied, *_master_ir_segments[indexIr], *_segments[indexAudio]);
+            /* RedFish Modification */
+            for (int j = 0; j < FFTCONVOLER_MAX_NUM_IR; ++j)
+            {
+                const SplitComplex *irSegments = _irSegments[j];
+                if (!irSegments || _irAmplitudes[j] == 0.0f)
+                {
+                    continue;
+                }
+
+                for (size_t i = 1; i < _irSegCount[j]; ++i)
+                {
+                    const size_t indexIr = i;
+                    const size_t indexAudio = (_current + i) % _segCount;
+                    ComplexMultiplyAccumulate(_preMultiplied, irSegments[indexIr], *_segments[indexAudio], _irAmplitudes[j]);
+                }
             }
         }
 
         _conv.copyFrom(_preMultiplied);
+
         /* RedFish Modification */
-        ComplexMultiplyAccumulate(_conv, *_segments[_current], *_master_ir_segments[0]);
+        Sample headScale = 1.0f;
+        if (const SplitComplex* head = mixHead(headScale))
+        {
+            ComplexMultiplyAccumulate(_conv, *_segments[_current], *head, headScale);
+        }
 
         // Backward FFT
         _fft.ifft(_fftBuffer.data(), _conv.re(), _conv.im());
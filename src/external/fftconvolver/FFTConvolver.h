@@ -58,15 +58,29 @@ public:
   FFTConvolver();  
   virtual ~FFTConvolver();
   
+  /* RedFish Modification */
   /**
-  * @brief Initializes the convolver
+  * @brief Initializes the convolver without any impulse response
+  *
+  * Only the input and overlap state is owned by the convolver. The frequency-domain
+  * impulse response segments are owned by the caller and can be shared between
+  * several convolvers (see PrepareSegments() and setImpulseResponse()).
+  *
   * @param blockSize Block size internally used by the convolver (partition size)
-  * @param ir The impulse response
-  * @param irLen Length of the impulse response
+  * @param segCount Maximum number of segments of any impulse response that will be set
   * @return true: Success - false: Failed
   */
+  bool init(size_t blockSize, size_t segCount);
+
   /* RedFish Modification */
-  bool init(size_t blockSize, Sample** ir, size_t irLen);
+  /**
+  * @brief Sets the impulse response in the given slot (no allocations, real-time safe)
+  * @param index The impulse response slot
+  * @param segments Frequency-domain segments prepared by PrepareSegments() or nullptr to clear the slot
+  * @param segCount Number of segments (must not exceed the segment count given to init())
+  * @return true: Success - false: Failed
+  */
+  bool setImpulseResponse(int index, const SplitComplex* segments, size_t segCount);
 
   /**
   * @brief Convolves the the given input samples and immediately outputs the result
@@ -77,14 +91,48 @@ public:
   void process(const Sample* input, Sample* output, size_t len);
 
   /**
-  * @brief Resets the convolver and discards the set impulse response
+  * @brief Resets the convolver and discards the set impulse responses
   */
   void reset();
 
+  /* RedFish Modification */
+  /**
+  * @brief Clears the input history and overlap but keeps the impulse responses (no allocations, real-time safe)
+  */
+  void clear();
+
   /* RedFish Modification */
   void setImpulseResponseAmplitudes(const float amplitudes[FFTCONVOLER_MAX_NUM_IR]);
 
+  /* RedFish Modification */
+  /**
+  * @brief Returns the number of segments an impulse response is partitioned into
+  * @param blockSize Block size internally used by the convolver (partition size)
+  * @param irLen Length of the impulse response
+  */
+  static size_t SegmentCount(size_t blockSize, size_t irLen);
+
+  /* RedFish Modification */
+  /**
+  * @brief Returns the size each segment passed to PrepareSegments() must have
+  * @param blockSize Block size internally used by the convolver (partition size)
+  */
+  static size_t SegmentSize(size_t blockSize);
+
+  /* RedFish Modification */
+  /**
+  * @brief Transforms an impulse response into its frequency-domain segments (allocates, not real-time safe)
+  * @param blockSize Block size internally used by the convolver (partition size)
+  * @param ir The impulse response
+  * @param irLen Length of the impulse response
+  * @param segments SegmentCount() segments, each of SegmentSize()
+  */
+  static void PrepareSegments(size_t blockSize, const Sample* ir, size_t irLen, SplitComplex* segments);
+
 private:
+  /* RedFish Modification */
+  const SplitComplex* mixHead(Sample& scale);
+
   size_t _blockSize;
   size_t _segSize;
   size_t _segCount;
@@ -92,13 +140,16 @@ private:
   std::vector<SplitComplex*> _segments;
 
   /* RedFish Modification */
-  std::vector<SplitComplex*> _segmentsIR[FFTCONVOLER_MAX_NUM_IR];
-  /* RedFish Modification */
-  std::vector<SplitComplex*> _master_ir_segments;
+  const SplitComplex* _irSegments[FFTCONVOLER_MAX_NUM_IR];
+  size_t _irSegCount[FFTCONVOLER_MAX_NUM_IR];
+  float _irAmplitudes[FFTCONVOLER_MAX_NUM_IR];
 
   SampleBuffer _fftBuffer;
   audiofft::AudioFFT _fft;
   SplitComplex _preMultiplied;
+  /* RedFish Modification */
+  SplitComplex _mixedHead;
+  bool _mixedHeadDirty;
   SplitComplex _conv;
   SampleBuffer _overlap;
   size_t _current;
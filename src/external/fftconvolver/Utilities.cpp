@@ -66,7 +66,60 @@ void ComplexMultiplyAccumulate(Sample *FFTCONVOLVER_RESTRICT re,
                                const Sample *FFTCONVOLVER_RESTRICT imB,
                                const size_t len)
 {
-#if defined(FFTCONVOLVER_USE_SSE)
+/* RedFish Modification */
+#if defined(FFTCONVOLVER_USE_AVX_512)
+    const size_t end16 = 16 * (len / 16);
+    for (size_t i = 0; i < end16; i += 16)
+    {
+        const __m512 ra = _mm512_load_ps(&reA[i]);
+        const __m512 rb = _mm512_load_ps(&reB[i]);
+        const __m512 ia = _mm512_load_ps(&imA[i]);
+        const __m512 ib = _mm512_load_ps(&imB[i]);
+        __m512 real = _mm512_load_ps(&re[i]);
+        __m512 imag = _mm512_load_ps(&im[i]);
+        real = _mm512_fmadd_ps(ra, rb, real);
+        real = _mm512_fnmadd_ps(ia, ib, real);
+        _mm512_store_ps(&re[i], real);
+        imag = _mm512_fmadd_ps(ra, ib, imag);
+        imag = _mm512_fmadd_ps(ia, rb, imag);
+        _mm512_store_ps(&im[i], imag);
+    }
+    for (size_t i = end16; i < len; ++i)
+    {
+        re[i] += reA[i] * reB[i] - imA[i] * imB[i];
+        im[i] += reA[i] * imB[i] + imA[i] * reB[i];
+    }
+#elif defined(FFTCONVOLVER_USE_AVX)
+    const size_t end8 = 8 * (len / 8);
+    for (size_t i = 0; i < end8; i += 8)
+    {
+        const __m256 ra = _mm256_load_ps(&reA[i]);
+        const __m256 rb = _mm256_load_ps(&reB[i]);
+        const __m256 ia = _mm256_load_ps(&imA[i]);
+        const __m256 ib = _mm256_load_ps(&imB[i]);
+        __m256 real = _mm256_load_ps(&re[i]);
+        __m256 imag = _mm256_load_ps(&im[i]);
+#if RF_USE_FMA
+        real = _mm256_fmadd_ps(ra, rb, real);
+        real = _mm256_fnmadd_ps(ia, ib, real);
+        _mm256_store_ps(&re[i], real);
+        imag = _mm256_fmadd_ps(ra, ib, imag);
+        imag = _mm256_fmadd_ps(ia, rb, imag);
+#else
+        real = _mm256_add_ps(real, _mm256_mul_ps(ra, rb));
+        real = _mm256_sub_ps(real, _mm256_mul_ps(ia, ib));
+        _mm256_store_ps(&re[i], real);
+        imag = _mm256_add_ps(imag, _mm256_mul_ps(ra, ib));
+        imag = _mm256_add_ps(imag, _mm256_mul_ps(ia, rb));
+#endif
+        _mm256_store_ps(&im[i], imag);
+    }
+    for (size_t i = end8; i < len; ++i)
+    {
+        re[i] += reA[i] * reB[i] - imA[i] * imB[i];
+        im[i] += reA[i] * imB[i] + imA[i] * reB[i];
+    }
+#elif defined(FFTCONVOLVER_USE_SSE)
     const size_t end4 = 4 * (len / 4);
     for (size_t i = 0; i < end4; i += 4)
     {
@@ -109,4 +162,114 @@ void ComplexMultiplyAccumulate(Sample *FFTCONVOLVER_RESTRICT re,
 #endif
 }
 
+/* RedFish Modification */
+void ComplexMultiplyAccumulate(SplitComplex &result, const SplitComplex &a, const SplitComplex &b, Sample scale)
+{
+    assert(result.size() == a.size());
+    assert(result.size() == b.size());
+    ComplexMultiplyAccumulate(result.re(), result.im(), a.re(), a.im(), b.re(), b.im(), scale, result.size());
+}
+
+/* RedFish Modification */
+void ComplexMultiplyAccumulate(Sample *FFTCONVOLVER_RESTRICT re,
+                               Sample *FFTCONVOLVER_RESTRICT im,
+                               const Sample *FFTCONVOLVER_RESTRICT reA,
+                               const Sample *FFTCONVOLVER_RESTRICT imA,
+                               const Sample *FFTCONVOLVER_RESTRICT reB,
+                               const Sample *FFTCONVOLVER_RESTRICT imB,
+                               const Sample scale,
+                               const size_t len)
+{
+    if (scale == 1.0f)
+    {
+        ComplexMultiplyAccumulate(re, im, reA, imA, reB, imB, len);
+        return;
+    }
+
+#if defined(FFTCONVOLVER_USE_AVX_512)
+    const __m512 s = _mm512_set1_ps(scale);
+    const size_t end16 = 16 * (len / 16);
+    for (size_t i = 0; i < end16; i += 16)
+    {
+        const __m512 ra = _mm512_mul_ps(_mm512_load_ps(&reA[i]), s);
+        const __m512 rb = _mm512_load_ps(&reB[i]);
+        const __m512 ia = _mm512_mul_ps(_mm512_load_ps(&imA[i]), s);
+        const __m512 ib = _mm512_load_ps(&imB[i]);
+        __m512 real = _mm512_load_ps(&re[i]);
+        __m512 imag = _mm512_load_ps(&im[i]);
+        real = _mm512_fmadd_ps(ra, rb, real);
+        real = _mm512_fnmadd_ps(ia, ib, real);
+        _mm512_store_ps(&re[i], real);
+        imag = _mm512_fmadd_ps(ra, ib, imag);
+        imag = _mm512_fmadd_ps(ia, rb, imag);
+        _mm512_store_ps(&im[i], imag);
+    }
+    for (size_t i = end16; i < len; ++i)
+    {
+        re[i] += scale * (reA[i] * reB[i] - imA[i] * imB[i]);
+        im[i] += scale * (reA[i] * imB[i] + imA[i] * reB[i]);
+    }
+#elif defined(FFTCONVOLVER_USE_AVX)
+    const __m256 s = _mm256_set1_ps(scale);
+    const size_t end8 = 8 * (len / 8);
+    for (size_t i = 0; i < end8; i += 8)
+    {
+        const __m256 ra = _mm256_mul_ps(_mm256_load_ps(&reA[i]), s);
+        const __m256 rb = _mm256_load_ps(&reB[i]);
+        const __m256 ia = _mm256_mul_ps(_mm256_load_ps(&imA[i]), s);
+        const __m256 ib = _mm256_load_ps(&imB[i]);
+        __m256 real = _mm256_load_ps(&re[i]);
+        __m256 imag = _mm256_load_ps(&im[i]);
+#if RF_USE_FMA
+        real = _mm256_fmadd_ps(ra, rb, real);
+        real = _mm256_fnmadd_ps(ia, ib, real);
+        _mm256_store_ps(&re[i], real);
+        imag = _mm256_fmadd_ps(ra, ib, imag);
+        imag = _mm256_fmadd_ps(ia, rb, imag);
+#else
+        real = _mm256_add_ps(real, _mm256_mul_ps(ra, rb));
+        real = _mm256_sub_ps(real, _mm256_mul_ps(ia, ib));
+        _mm256_store_ps(&re[i], real);
+        imag = _mm256_add_ps(imag, _mm256_mul_ps(ra, ib));
+        imag = _mm256_add_ps(imag, _mm256_mul_ps(ia, rb));
+#endif
+        _mm256_store_ps(&im[i], imag);
+    }
+    for (size_t i = end8; i < len; ++i)
+    {
+        re[i] += scale * (reA[i] * reB[i] - imA[i] * imB[i]);
+        im[i] += scale * (reA[i] * imB[i] + imA[i] * reB[i]);
+    }
+#elif defined(FFTCONVOLVER_USE_SSE)
+    const __m128 s = _mm_set1_ps(scale);
+    const size_t end4 = 4 * (len / 4);
+    for (size_t i = 0; i < end4; i += 4)
+    {
+        const __m128 ra = _mm_mul_ps(_mm_load_ps(&reA[i]), s);
+        const __m128 rb = _mm_load_ps(&reB[i]);
+        const __m128 ia = _mm_mul_ps(_mm_load_ps(&imA[i]), s);
+        const __m128 ib = _mm_load_ps(&imB[i]);
+        __m128 real = _mm_load_ps(&re[i]);
+        __m128 imag = _mm_load_ps(&im[i]);
+        real = _mm_add_ps(real, _mm_mul_ps(ra, rb));
+        real = _mm_sub_ps(real, _mm_mul_ps(ia, ib));
+        _mm_store_ps(&re[i], real);
+        imag = _mm_add_ps(imag, _mm_mul_ps(ra, ib));
+        imag = _mm_add_ps(imag, _mm_mul_ps(ia, rb));
+        _mm_store_ps(&im[i], imag);
+    }
+    for (size_t i = end4; i < len; ++i)
+    {
+        re[i] += scale * (reA[i] * reB[i] - imA[i] * imB[i]);
+        im[i] += scale * (reA[i] * imB[i] + imA[i] * reB[i]);
+    }
+#else
+    for (size_t i = 0; i < len; ++i)
+    {
+        re[i] += scale * (reA[i] * reB[i] - imA[i] * imB[i]);
+        im[i] += scale * (reA[i] * imB[i] + imA[i] * reB[i]);
+    }
+#endif
+}
+
 }  // End of namespace fftconvolver
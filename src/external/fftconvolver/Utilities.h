@@ -29,6 +29,16 @@
 #include <new>
 
 
+/* RedFish Modification */
+// Intrinsics headers must be included at global scope, before the namespace below pulls in <xmmintrin.h>.
+#include <redfish/defines.h>
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+  #include <immintrin.h>
+#elif defined(__SSE__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <xmmintrin.h>
+#endif
+
+
 namespace fftconvolver
 {
 
@@ -44,6 +54,24 @@ namespace fftconvolver
 #endif
 
 
+/* RedFish Modification */
+// Follow the SIMD mode RedFish is built with for the convolver's complex multiply-accumulate.
+#if RF_USE_AVX_512
+  #define FFTCONVOLVER_USE_AVX_512
+  #define FFTCONVOLVER_ALIGNMENT 64
+#elif RF_USE_AVX
+  #define FFTCONVOLVER_USE_AVX
+  #define FFTCONVOLVER_ALIGNMENT 32
+#else
+  #define FFTCONVOLVER_ALIGNMENT 16
+#endif
+
+// The SIMD paths use aligned loads, so buffers must be aligned whenever any of them is compiled in,
+// including targets such as MSVC x64 that don't define __SSE__.
+#if defined(FFTCONVOLVER_USE_SSE) || defined(FFTCONVOLVER_USE_AVX) || defined(FFTCONVOLVER_USE_AVX_512)
+  #define FFTCONVOLVER_ALIGNED_ALLOCATION
+#endif
+
 #if defined(__GNUC__)
   #define FFTCONVOLVER_RESTRICT __restrict__
 #else
@@ -60,7 +88,7 @@ bool SSEEnabled();
 
 /**
 * @class Buffer
-* @brief Simple buffer implementation (uses 16-byte alignment if SSE optimization is enabled)
+* @brief Simple buffer implementation (uses SIMD alignment if SSE optimization is enabled)
 */
 template<typename T>
 class Buffer
@@ -156,8 +184,9 @@ public:
 private:
   T* allocate(size_t size)
   {
-#if defined(FFTCONVOLVER_USE_SSE)
-    return static_cast<T*>(_mm_malloc(size * sizeof(T), 16));
+    /* RedFish Modification */
+#if defined(FFTCONVOLVER_ALIGNED_ALLOCATION)
+    return static_cast<T*>(_mm_malloc(size * sizeof(T), FFTCONVOLVER_ALIGNMENT));
 #else
     return new T[size];
 #endif
@@ -165,7 +194,8 @@ private:
   
   void deallocate(T* ptr)
   {
-#if defined(FFTCONVOLVER_USE_SSE)
+    /* RedFish Modification */
+#if defined(FFTCONVOLVER_ALIGNED_ALLOCATION)
     _mm_free(ptr);
 #else
     delete [] ptr;
@@ -349,6 +379,39 @@ void ComplexMultiplyAccumulate(Sample* FFTCONVOLVER_RESTRICT re,
                                const Sample* FFTCONVOLVER_RESTRICT reB,
                                const Sample* FFTCONVOLVER_RESTRICT imB,
                                const size_t len);
+
+
+/* RedFish Modification */
+/**
+* @brief Adds the scaled complex product of two split-complex buffers to a result buffer
+* @param result The result buffer
+* @param a The 1st factor of the complex product
+* @param b The 2nd factor of the complex product
+* @param scale The real factor the product is scaled by
+*/
+void ComplexMultiplyAccumulate(SplitComplex& result, const SplitComplex& a, const SplitComplex& b, Sample scale);
+
+
+/* RedFish Modification */
+/**
+* @brief Adds the scaled complex product of two split-complex arrays to a result array
+* @param re The real part of the result buffer
+* @param im The imaginary part of the result buffer
+* @param reA The real part of the 1st factor of the complex product
+* @param imA The imaginary part of the 1st factor of the complex product
+* @param reB The real part of the 2nd factor of the complex product
+* @param imB The imaginary part of the 2nd factor of the complex product
+* @param scale The real factor the product is scaled by
+* @param len The length of the arrays
+*/
+void ComplexMultiplyAccumulate(Sample* FFTCONVOLVER_RESTRICT re, 
+                               Sample* FFTCONVOLVER_RESTRICT im,
+                               const Sample* FFTCONVOLVER_RESTRICT reA,
+                               const Sample* FFTCONVOLVER_RESTRICT imA,
+                               const Sample* FFTCONVOLVER_RESTRICT reB,
+                               const Sample* FFTCONVOLVER_RESTRICT imB,
+                               const Sample scale,
+                               const size_t len);
   
 } // End of namespace fftconvolver
 
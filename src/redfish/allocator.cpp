@@ -22,11 +22,24 @@
 
 #include "allocator.h"
 
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#include "assert.h"
 #include "defaultallocatorcallback.h"
+#include "realtimechecks.h"
 
 rf::Allocator g_allocator;
 rf::AllocateCallback rf::Allocator::s_allocate = rf::Allocate;
 rf::DeallocateCallback rf::Allocator::s_deallocate = rf::Deallocate;
+rf::Allocator::Tag rf::Allocator::s_tags[AllocatorReport::k_maxTags];
+rf::PoolAllocator rf::Allocator::s_pools[AllocatorReport::k_maxPools];
+std::atomic<int> rf::Allocator::s_poolFallbacks[AllocatorReport::k_maxPools];
+rf::ArenaAllocator rf::Allocator::s_arena;
+int rf::Allocator::s_numArenaFallbacks = 0;
+int rf::Allocator::s_numPools = 0;
+bool rf::Allocator::s_arenaActive = false;
 
 void rf::Allocator::SetCallbacks(AllocateCallback allocate, DeallocateCallback deallocate)
 {
@@ -39,4 +52,240 @@ void rf::Allocator::SetCallbacks(AllocateCallback allocate, DeallocateCallback d
     {
         s_deallocate = deallocate;
     }
-}
\ No newline at end of file
+}
+
+void rf::Allocator::SetBudgets(const AllocatorBudget* budgets, int numBudgets)
+{
+    for (int i = 0; i < numBudgets; ++i)
+    {
+        s_tags[FindOrAddTag(budgets[i].m_tag)].m_budgetBytes = budgets[i].m_maxBytes;
+    }
+}
+
+void rf::Allocator::CreatePools(const AllocatorPool* pools, int numPools)
+{
+    RF_ASSERT(s_numPools == 0, "Allocator pools have already been created.");
+    RF_ASSERT(numPools <= AllocatorReport::k_maxPools, "Too many allocator pools.");
+    numPools = std::min(numPools, AllocatorReport::k_maxPools);
+
+    // Keep the pools sorted by block size, so allocations land in the smallest block they fit in.
+    AllocatorPool sorted[AllocatorReport::k_maxPools];
+    std::copy(pools, pools + numPools, sorted);
+    std::sort(sorted, sorted + numPools, [](const AllocatorPool& a, const AllocatorPool& b) { return a.m_blockSize < b.m_blockSize; });
+
+    for (int i = 0; i < numPools; ++i)
+    {
+        s_pools[i].Create(sorted[i].m_blockSize, sorted[i].m_numBlocks);
+        s_poolFallbacks[i] = 0;
+    }
+    s_numPools = numPools;
+}
+
+void rf::Allocator::ReleasePools()
+{
+    for (int i = 0; i < s_numPools; ++i)
+    {
+        s_pools[i].Release();
+    }
+    s_numPools = 0;
+}
+
+void rf::Allocator::BeginArena(size_t numBytes)
+{
+    s_numArenaFallbacks = 0;
+    if (numBytes > 0)
+    {
+        s_arena.Create(numBytes);
+        s_arenaActive = true;
+    }
+}
+
+void rf::Allocator::EndArena()
+{
+    s_arenaActive = false;
+}
+
+void rf::Allocator::ReleaseArena()
+{
+    s_arenaActive = false;
+    s_arena.Release();
+}
+
+void rf::Allocator::GetReport(AllocatorReport* outReport)
+{
+    outReport->m_numTags = 0;
+    for (int i = 0; i < AllocatorReport::k_maxTags; ++i)
+    {
+        const Tag& tag = s_tags[i];
+        const char* name = tag.m_name.load(std::memory_order_acquire);
+        if (!name)
+        {
+            continue;
+        }
+
+        AllocatorReport::Tag& reportTag = outReport->m_tags[outReport->m_numTags++];
+        reportTag.m_name = name;
+        reportTag.m_currentBytes = tag.m_currentBytes.load(std::memory_order_relaxed);
+        reportTag.m_peakBytes = tag.m_peakBytes.load(std::memory_order_relaxed);
+        reportTag.m_budgetBytes = tag.m_budgetBytes;
+        reportTag.m_numAllocations = tag.m_numAllocations.load(std::memory_order_relaxed);
+        reportTag.m_overBudget = tag.m_overBudget.load(std::memory_order_relaxed);
+    }
+
+    outReport->m_numPools = s_numPools;
+    for (int i = 0; i < s_numPools; ++i)
+    {
+        AllocatorReport::Pool& reportPool = outReport->m_pools[i];
+        reportPool.m_blockSize = s_pools[i].GetBlockSize();
+        reportPool.m_numBlocks = s_pools[i].GetNumBlocks();
+        reportPool.m_peakUsedBlocks = s_pools[i].GetPeakUsedBlocks();
+        reportPool.m_numFallbacks = s_poolFallbacks[i].load(std::memory_order_relaxed);
+    }
+
+    outReport->m_arenaSize = s_arena.GetSize();
+    outReport->m_arenaUsedBytes = s_arena.GetUsedBytes();
+    outReport->m_numArenaFallbacks = s_numArenaFallbacks;
+}
+
+void* rf::Allocator::AllocateMemory(size_t numBytes, const char* name, int alignment)
+{
+    RF_ASSERT(alignment <= k_maxAlignment, "Alignment is larger than the Allocator supports.");
+#if RF_ENABLE_REALTIME_CHECKS
+    RealtimeChecks::OnAllocation();
+#endif
+
+    // The header goes right in front of the data, padded so the data keeps its alignment.
+    const int dataAlignment = std::max(alignment, static_cast<int>(alignof(Header)));
+    const size_t mask = static_cast<size_t>(dataAlignment) - 1;
+    const size_t headerSize = (sizeof(Header) + mask) & ~mask;
+    const size_t totalBytes = headerSize + numBytes;
+
+    unsigned char* memory = nullptr;
+    Source source = Source::Callback;
+    int poolIndex = 0;
+
+    if (s_arenaActive)
+    {
+        memory = static_cast<unsigned char*>(s_arena.Allocate(totalBytes, dataAlignment));
+        if (memory)
+        {
+            source = Source::Arena;
+        }
+        else
+        {
+            ++s_numArenaFallbacks;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < s_numPools; ++i)
+        {
+            if (totalBytes <= static_cast<size_t>(s_pools[i].GetBlockSize()))
+            {
+                memory = static_cast<unsigned char*>(s_pools[i].Allocate());
+                if (memory)
+                {
+                    source = Source::Pool;
+                    poolIndex = i;
+                }
+                else
+                {
+                    s_poolFallbacks[i].fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            }
+        }
+    }
+
+    if (!memory)
+    {
+#if RF_ENABLE_REALTIME_CHECKS
+        RealtimeChecks::OnBlockingWait();
+#endif
+        memory = static_cast<unsigned char*>(s_allocate((totalBytes + mask) & ~mask, name, dataAlignment));
+    }
+
+    const int tagIndex = FindOrAddTag(name);
+    unsigned char* data = memory + headerSize;
+    Header* header = new (data - sizeof(Header)) Header();
+    header->m_numBytes = numBytes;
+    header->m_offset = static_cast<unsigned short>(headerSize);
+    header->m_tagIndex = static_cast<unsigned char>(tagIndex);
+    header->m_source = source;
+    header->m_poolIndex = static_cast<unsigned char>(poolIndex);
+
+    Tag& tag = s_tags[tagIndex];
+    const size_t currentBytes = tag.m_currentBytes.fetch_add(numBytes, std::memory_order_relaxed) + numBytes;
+    size_t peakBytes = tag.m_peakBytes.load(std::memory_order_relaxed);
+    while (currentBytes > peakBytes && !tag.m_peakBytes.compare_exchange_weak(peakBytes, currentBytes, std::memory_order_relaxed))
+    {
+    }
+    tag.m_numAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (tag.m_budgetBytes > 0 && currentBytes > tag.m_budgetBytes)
+    {
+        tag.m_overBudget.store(true, std::memory_order_relaxed);
+        RF_FAIL("An allocation went over its tag's budget. Check the AllocatorReport.");
+    }
+
+    return data;
+}
+
+void rf::Allocator::DeallocateMemory(void* data)
+{
+    if (!data)
+    {
+        return;
+    }
+
+#if RF_ENABLE_REALTIME_CHECKS
+    RealtimeChecks::OnDeallocation();
+#endif
+
+    unsigned char* bytes = static_cast<unsigned char*>(data);
+    const Header* header = reinterpret_cast<const Header*>(bytes - sizeof(Header));
+    s_tags[header->m_tagIndex].m_currentBytes.fetch_sub(header->m_numBytes, std::memory_order_relaxed);
+
+    unsigned char* memory = bytes - header->m_offset;
+    switch (header->m_source)
+    {
+        case Source::Callback:
+#if RF_ENABLE_REALTIME_CHECKS
+            RealtimeChecks::OnBlockingWait();
+#endif
+            s_deallocate(memory);
+            break;
+        // Arena memory is freed all at once with the arena.
+        case Source::Arena: break;
+        case Source::Pool: s_pools[header->m_poolIndex].Deallocate(memory); break;
+        default: RF_FAIL("Unknown allocation source."); break;
+    }
+}
+
+int rf::Allocator::FindOrAddTag(const char* name)
+{
+    if (!name)
+    {
+        name = "Untagged";
+    }
+
+    // Tags are claimed with a compare and swap, so the game and audio threads can both add tags.
+    const int lastTag = AllocatorReport::k_maxTags - 1;
+    for (int i = 0; i < lastTag; ++i)
+    {
+        const char* existing = s_tags[i].m_name.load(std::memory_order_acquire);
+        if (!existing && s_tags[i].m_name.compare_exchange_strong(existing, name, std::memory_order_acq_rel))
+        {
+            return i;
+        }
+
+        if (existing == name || strcmp(existing, name) == 0)
+        {
+            return i;
+        }
+    }
+
+    // Once every tag is used, the rest are tracked together.
+    s_tags[lastTag].m_name.store("Other", std::memory_order_release);
+    return lastTag;
+}
@@ -21,23 +21,93 @@
 // SOFTWARE.
 
 #pragma once
+#include <atomic>
+#include <cstddef>
 #include <utility>
 
+#include "arenaallocator.h"
+#include "poolallocator.h"
+
 namespace rf
 {
 using AllocateCallback = void* (*)(size_t numBytes, const char* name, int alignment);
 using DeallocateCallback = void (*)(void* data);
 
+// Caps the memory allocated under a tag (the name passed to the Allocator).
+struct AllocatorBudget
+{
+    const char* m_tag = nullptr;
+    size_t m_maxBytes = 0;
+};
+
+// A pool of fixed-size blocks. Allocations made after the Context is constructed use the smallest pool whose blocks
+// they fit in, and fall back to the allocation callback when that pool is full.
+struct AllocatorPool
+{
+    int m_blockSize = 0;
+    int m_numBlocks = 0;
+};
+
+struct AllocatorReport
+{
+    static constexpr int k_maxTags = 128;
+    static constexpr int k_maxPools = 8;
+
+    struct Tag
+    {
+        const char* m_name = nullptr;
+        size_t m_currentBytes = 0;
+        size_t m_peakBytes = 0;
+        size_t m_budgetBytes = 0;
+        int m_numAllocations = 0;
+        bool m_overBudget = false;
+    };
+
+    struct Pool
+    {
+        int m_blockSize = 0;
+        int m_numBlocks = 0;
+        int m_peakUsedBlocks = 0;
+        int m_numFallbacks = 0;
+    };
+
+    Tag m_tags[k_maxTags];
+    Pool m_pools[k_maxPools];
+    size_t m_arenaSize = 0;
+    size_t m_arenaUsedBytes = 0;
+    int m_numTags = 0;
+    int m_numPools = 0;
+    int m_numArenaFallbacks = 0;
+};
+
+// Every allocation RedFish makes goes through the Allocator. Allocations are tracked per tag (the name they are made
+// with) and come from one of three places:
+// - The arena, for allocations made while the Context is being constructed. It is freed all at once with the Context.
+// - A pool, for later allocations that fit one of the configured block sizes.
+// - The allocation callbacks, for everything else.
+// Tag names must outlive the Allocator. String literals are expected.
 class Allocator
 {
 public:
+    static constexpr int k_maxAlignment = 64;
+
     static void SetCallbacks(AllocateCallback allocate, DeallocateCallback deallocate);
+    static void SetBudgets(const AllocatorBudget* budgets, int numBudgets);
+    static void CreatePools(const AllocatorPool* pools, int numPools);
+    static void ReleasePools();
+    static void BeginArena(size_t numBytes);
+    static void EndArena();
+    static void ReleaseArena();
+    static void GetReport(AllocatorReport* outReport);
+
+    static void* AllocateMemory(size_t numBytes, const char* name, int alignment);
+    static void DeallocateMemory(void* data);
 
     template <class T, typename... Args>
     static T* AllocateAligned(const char* name, int alignment, Args&&... args)
     {
         const int size = sizeof(T);
-        void* data = s_allocate(size, name, alignment);
+        void* data = AllocateMemory(size, name, alignment);
         return new (data) T(std::forward<Args>(args)...);
     }
 
@@ -45,14 +115,14 @@ public:
     static T* Allocate(const char* name, Args&&... args)
     {
         const int size = sizeof(T);
-        void* data = s_allocate(size, name, alignof(T));
+        void* data = AllocateMemory(size, name, alignof(T));
         return new (data) T(std::forward<Args>(args)...);
     }
 
     template <class T>
     static T* AllocateBytes(const char* name, int size)
     {
-        void* data = s_allocate(size, name, alignof(T));
+        void* data = AllocateMemory(size, name, alignof(T));
         return static_cast<T*>(data);
     }
 
@@ -60,7 +130,7 @@ public:
     static T* AllocateArray(const char* name, int num, Args&&... args)
     {
         const int size = sizeof(T) * num;
-        T* data = static_cast<T*>(s_allocate(size, name, alignof(T)));
+        T* data = static_cast<T*>(AllocateMemory(size, name, alignof(T)));
         for (int i = 0; i < num; ++i)
         {
             new (data + i) T(std::forward<Args>(args)...);
@@ -74,7 +144,7 @@ public:
         if (*data)
         {
             (*data)->~T();
-            s_deallocate(*data);
+            DeallocateMemory(*data);
             *data = nullptr;
         }
     }
@@ -84,7 +154,7 @@ public:
     {
         if (*data)
         {
-            s_deallocate(*data);
+            DeallocateMemory(*data);
             *data = nullptr;
         }
     }
@@ -100,13 +170,51 @@ public:
                 toDelete = (*data) + i;
                 toDelete->~T();
             }
-            s_deallocate(*data);
+            DeallocateMemory(*data);
             *data = nullptr;
         }
     }
 
     static AllocateCallback s_allocate;
     static DeallocateCallback s_deallocate;
+
+private:
+    enum class Source : unsigned char
+    {
+        Callback,
+        Arena,
+        Pool
+    };
+
+    // Stored in front of every allocation.
+    struct Header
+    {
+        size_t m_numBytes = 0;
+        unsigned short m_offset = 0;
+        unsigned char m_tagIndex = 0;
+        Source m_source = Source::Callback;
+        unsigned char m_poolIndex = 0;
+    };
+
+    struct Tag
+    {
+        std::atomic<const char*> m_name {nullptr};
+        std::atomic<size_t> m_currentBytes {0};
+        std::atomic<size_t> m_peakBytes {0};
+        std::atomic<int> m_numAllocations {0};
+        std::atomic<bool> m_overBudget {false};
+        size_t m_budgetBytes = 0;
+    };
+
+    static Tag s_tags[AllocatorReport::k_maxTags];
+    static PoolAllocator s_pools[AllocatorReport::k_maxPools];
+    static std::atomic<int> s_poolFallbacks[AllocatorReport::k_maxPools];
+    static ArenaAllocator s_arena;
+    static int s_numArenaFallbacks;
+    static int s_numPools;
+    static bool s_arenaActive;
+
+    static int FindOrAddTag(const char* name);
 };
 
 extern Allocator g_allocator;
@@ -0,0 +1,75 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ambisonics.h"
+
+#include <cmath>
+
+#include "pluginutils.h"
+
+void rf::Ambisonics::DirectionToVector(float azimuth, float elevation, float* outVector)
+{
+    const float degreesToRadians = PluginUtils::k_twoPi / 360.0f;
+    const float cosElevation = cosf(elevation * degreesToRadians);
+    outVector[0] = cosElevation * cosf(azimuth * degreesToRadians);
+    outVector[1] = -cosElevation * sinf(azimuth * degreesToRadians);
+    outVector[2] = sinf(elevation * degreesToRadians);
+}
+
+void rf::Ambisonics::Encode(float x, float y, float z, float* outGains)
+{
+    outGains[0] = 1.0f;
+    outGains[1] = 1.7320508f * y;
+    outGains[2] = 1.7320508f * z;
+    outGains[3] = 1.7320508f * x;
+
+#if RF_AMBISONIC_ORDER == 3
+    const float x2 = x * x;
+    const float y2 = y * y;
+    const float z2 = z * z;
+    outGains[4] = 3.8729833f * x * y;
+    outGains[5] = 3.8729833f * y * z;
+    outGains[6] = 1.1180340f * (3.0f * z2 - 1.0f);
+    outGains[7] = 3.8729833f * x * z;
+    outGains[8] = 1.9364917f * (x2 - y2);
+    outGains[9] = 2.0916500f * y * (3.0f * x2 - y2);
+    outGains[10] = 10.2469508f * x * y * z;
+    outGains[11] = 1.6201852f * y * (5.0f * z2 - 1.0f);
+    outGains[12] = 1.3228757f * z * (5.0f * z2 - 3.0f);
+    outGains[13] = 1.6201852f * x * (5.0f * z2 - 1.0f);
+    outGains[14] = 5.1234754f * z * (x2 - y2);
+    outGains[15] = 2.0916500f * x * (x2 - 3.0f * y2);
+#endif
+}
+
+float rf::Ambisonics::GetDecodeWeight(int channel)
+{
+#if RF_AMBISONIC_ORDER == 3
+    static constexpr float k_weights[] = {1.0f, 0.8611363f, 0.6123336f, 0.3047279f};
+#else
+    static constexpr float k_weights[] = {1.0f, 0.5773503f};
+#endif
+
+    // ACN channels 1 to 3 are order 1, 4 to 8 are order 2 and 9 to 15 are order 3.
+    const int order = static_cast<int>(sqrtf(static_cast<float>(channel)));
+    return k_weights[order];
+}
@@ -0,0 +1,39 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "defines.h"
+
+namespace rf::Ambisonics
+{
+static constexpr int k_order = RF_AMBISONIC_ORDER;
+static constexpr int k_numChannels = (k_order + 1) * (k_order + 1);
+static_assert(k_order == 1 || k_order == 3, "RF_AMBISONIC_ORDER must be 1 or 3.");
+
+// Converts a direction to a unit vector where x is front, y is left and z is up. Azimuth is in degrees clockwise from
+// the front and elevation is in degrees above the horizon, matching PositioningParameters.
+void DirectionToVector(float azimuth, float elevation, float* outVector);
+// Fills outGains with the ACN ordered, N3D normalized spherical harmonics of a unit vector.
+void Encode(float x, float y, float z, float* outGains);
+// The max-rE weight of a channel. Decoders apply it to narrow the virtual source.
+float GetDecodeWeight(int channel);
+}  // namespace rf::Ambisonics
@@ -0,0 +1,74 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "arenaallocator.h"
+
+#include "allocator.h"
+#include "assert.h"
+
+void rf::ArenaAllocator::Create(size_t numBytes)
+{
+    RF_ASSERT(!m_memory, "The arena has already been created.");
+    m_memory = static_cast<unsigned char*>(Allocator::s_allocate(numBytes, "AllocatorArena", Allocator::k_maxAlignment));
+    m_size = numBytes;
+    m_cursor = 0;
+}
+
+void rf::ArenaAllocator::Release()
+{
+    if (m_memory)
+    {
+        Allocator::s_deallocate(m_memory);
+    }
+
+    m_memory = nullptr;
+    m_size = 0;
+    m_cursor = 0;
+}
+
+void* rf::ArenaAllocator::Allocate(size_t numBytes, int alignment)
+{
+    if (!m_memory)
+    {
+        return nullptr;
+    }
+
+    const size_t mask = static_cast<size_t>(alignment) - 1;
+    const size_t start = (m_cursor + mask) & ~mask;
+    if (start + numBytes > m_size)
+    {
+        return nullptr;
+    }
+
+    m_cursor = start + numBytes;
+    return m_memory + start;
+}
+
+size_t rf::ArenaAllocator::GetSize() const
+{
+    return m_size;
+}
+
+size_t rf::ArenaAllocator::GetUsedBytes() const
+{
+    return m_cursor;
+}
@@ -0,0 +1,53 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <cstddef>
+
+namespace rf
+{
+// A linear allocator over one block of memory. Allocating bumps a cursor and deallocating does nothing; the whole block
+// is freed at once. Used for the objects that live as long as the Context, which are all created on one thread during
+// its construction.
+class ArenaAllocator
+{
+public:
+    ArenaAllocator() = default;
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator(ArenaAllocator&&) = delete;
+    ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+    ArenaAllocator& operator=(ArenaAllocator&&) = delete;
+    ~ArenaAllocator() = default;
+
+    void Create(size_t numBytes);
+    void Release();
+    // Returns nullptr if the arena is full.
+    void* Allocate(size_t numBytes, int alignment);
+    size_t GetSize() const;
+    size_t GetUsedBytes() const;
+
+private:
+    unsigned char* m_memory = nullptr;
+    size_t m_size = 0;
+    size_t m_cursor = 0;
+};
+}  // namespace rf
@@ -28,26 +28,39 @@
 #include <external/dr_libs/dr_flac.h>
 #include <external/dr_libs/dr_wav.h>
 
+#include <algorithm>
+
 #include "allocator.h"
 #include "assert.h"
 #include "commandprocessor.h"
 #include "datacache.h"
 #include "loadcommands.h"
 #include "message.h"
+#include "streamloader.h"
+#include "tracecapture.h"
 
-rf::AssetSystem::AssetSystem(CommandProcessor* commands)
+rf::AssetSystem::AssetSystem(CommandProcessor* commands, float streamPrefetchSeconds, float streamBufferSeconds)
     : m_commands(commands)
+    , m_streamPrefetchSeconds(streamPrefetchSeconds)
+    , m_streamBufferSeconds(streamBufferSeconds)
 {
+    RF_ASSERT(streamBufferSeconds > 0.0f, "MusicConfig::m_streamBufferSeconds has to be more than 0");
     m_dataCache = Allocator::Allocate<DataCache>("DataCache");
 }
 
 rf::AssetSystem::~AssetSystem()
 {
+    // The loader writes into the data cache's streams, so it has to stop first.
+    if (m_streamLoader)
+    {
+        Allocator::Deallocate<StreamLoader>(&m_streamLoader);
+    }
     Allocator::Deallocate<DataCache>(&m_dataCache);
 }
 
 rf::AudioHandle rf::AssetSystem::Load(float* interleavedSampleData, int numFrames, int channels, const char* name)
 {
+    RF_TRACE_SCOPE("AssetSystem::Load");
     const AudioHandle cachedHandle = m_dataCache->AssetExists(name);
     if (cachedHandle)
     {
@@ -57,18 +70,13 @@ rf::AudioHandle rf::AssetSystem::Load(float* interleavedSampleData, int numFrame
 
     const int numSamples = numFrames * channels;
     const AudioHandle handle = m_dataCache->AllocateAudioData(interleavedSampleData, name, numSamples, channels);
-
-    AudioCommand cmd;
-    LoadAudioDataCommand& data = EncodeAudioCommand<LoadAudioDataCommand>(&cmd);
-    data.m_index = m_dataCache->GetAudioDataIndex(handle);
-    data.m_audioData = m_dataCache->GetAudioData(data.m_index);
-    m_commands->Add(cmd);
-
+    SendLoadCommand(handle);
     return handle;
 }
 
 rf::AudioHandle rf::AssetSystem::Load(const char* path)
 {
+    RF_TRACE_SCOPE("AssetSystem::Load");
     const AudioHandle cachedHandle = m_dataCache->AssetExists(path);
     if (cachedHandle)
     {
@@ -76,27 +84,8 @@ rf::AudioHandle rf::AssetSystem::Load(const char* path)
         return cachedHandle;
     }
 
-    const auto FindLastIndex = [](const char* str, const char find) {
-        int index = -1;
-        const size_t size = strlen(str);
-        for (int i = 0; i < size; ++i)
-        {
-            if (str[i] == find)
-            {
-                index = i;
-            }
-        }
-        return index;
-    };
-
     char buffer[RF_MAX_NAME_SIZE] = {};
-    const int startIndex = FindLastIndex(path, '.') + 1;
-    const size_t size = strlen(path);
-    int counter = 0;
-    for (size_t i = startIndex; i < size; ++i)
-    {
-        buffer[counter++] = path[i];
-    }
+    GetFileExtension(path, buffer);
 
     if (strcmp(buffer, "flac") == 0)
     {
@@ -111,6 +100,70 @@ rf::AudioHandle rf::AssetSystem::Load(const char* path)
     return AudioHandle();
 }
 
+rf::AudioHandle rf::AssetSystem::LoadStreamed(const char* path)
+{
+    RF_TRACE_SCOPE("AssetSystem::LoadStreamed");
+    const AudioHandle cachedHandle = m_dataCache->AssetExists(path);
+    if (cachedHandle)
+    {
+        m_dataCache->IncrementReferenceCount(cachedHandle);
+        return cachedHandle;
+    }
+
+    char buffer[RF_MAX_NAME_SIZE] = {};
+    GetFileExtension(path, buffer);
+
+    int numFrames = 0;
+    int numChannels = 0;
+    int sampleRate = 0;
+    bool isFLAC = false;
+    if (strcmp(buffer, "flac") == 0)
+    {
+        drflac* flac = drflac_open_file(path, NULL);
+        if (!flac)
+        {
+            RF_FAIL("Could not load FLAC file");
+            return AudioHandle();
+        }
+
+        numFrames = static_cast<int>(flac->totalPCMFrameCount);
+        numChannels = flac->channels;
+        sampleRate = flac->sampleRate;
+        isFLAC = true;
+        drflac_close(flac);
+    }
+    else if (strcmp(buffer, "wav") == 0)
+    {
+        drwav wav;
+        if (!drwav_init_file(&wav, path, NULL))
+        {
+            RF_FAIL("Could not load WAV file");
+            return AudioHandle();
+        }
+
+        numFrames = static_cast<int>(wav.totalPCMFrameCount);
+        numChannels = wav.channels;
+        sampleRate = wav.sampleRate;
+        drwav_uninit(&wav);
+    }
+    else
+    {
+        RF_FAIL("Unsupported file type. Only 'flac' and 'wav' is supported");
+        return AudioHandle();
+    }
+
+    if (!m_streamLoader)
+    {
+        m_streamLoader = Allocator::Allocate<StreamLoader>("StreamLoader", RF_MAX_AUDIO_DATA);
+    }
+
+    const int numPrefetchFrames = static_cast<int>(m_streamPrefetchSeconds * static_cast<float>(sampleRate));
+    const int numBufferFrames = std::max(static_cast<int>(m_streamBufferSeconds * static_cast<float>(sampleRate)), 1);
+    const AudioHandle handle = m_dataCache->AllocateStreamedAudioData(path, numFrames, numChannels, numPrefetchFrames, numBufferFrames, isFLAC);
+    SendLoadCommand(handle);
+    return handle;
+}
+
 void rf::AssetSystem::Unload(const AudioHandle audioHandle)
 {
     if (m_dataCache->DecrementReferenceCount(audioHandle))
@@ -156,11 +209,55 @@ rf::AudioHandle rf::AssetSystem::LoadFLACFile(const char* path)
     return handle;
 }
 
+void rf::AssetSystem::SendLoadCommand(AudioHandle audioHandle)
+{
+    AudioCommand cmd;
+    LoadAudioDataCommand& data = EncodeAudioCommand<LoadAudioDataCommand>(&cmd);
+    data.m_audioHandle = audioHandle;
+    data.m_index = m_dataCache->GetAudioDataIndex(audioHandle);
+    data.m_audioData = m_dataCache->GetAudioData(data.m_index);
+    m_commands->Add(cmd);
+}
+
+void rf::AssetSystem::GetFileExtension(const char* path, char* outExtension)
+{
+    const auto FindLastIndex = [](const char* str, const char find) {
+        int index = -1;
+        const size_t size = strlen(str);
+        for (int i = 0; i < size; ++i)
+        {
+            if (str[i] == find)
+            {
+                index = i;
+            }
+        }
+        return index;
+    };
+
+    const int startIndex = FindLastIndex(path, '.') + 1;
+    const size_t size = strlen(path);
+    int counter = 0;
+    for (size_t i = startIndex; i < size; ++i)
+    {
+        outExtension[counter++] = path[i];
+    }
+}
+
 const rf::AudioData* rf::AssetSystem::GetAudioData(AudioHandle audioHandle) const
 {
     return m_dataCache->GetAudioData(audioHandle);
 }
 
+const rf::AudioData* rf::AssetSystem::GetAudioData(int index) const
+{
+    return m_dataCache->GetAudioData(index);
+}
+
+rf::AudioHandle rf::AssetSystem::GetAudioHandle(int index) const
+{
+    return m_dataCache->GetAudioHandle(index);
+}
+
 int rf::AssetSystem::GetAudioDataIndex(AudioHandle audioHandle) const
 {
     return m_dataCache->GetAudioDataIndex(audioHandle);
@@ -173,9 +270,35 @@ bool rf::AssetSystem::ProcessMessages(const Message& message)
         case MessageType::AssetDelete:
         {
             const AudioHandle audioHandle = message.GetAssetDeleteData()->m_audioHandle;
+            AudioStream* stream = m_dataCache->GetAudioData(audioHandle)->m_stream;
+            if (stream)
+            {
+                m_streamLoader->Remove(stream);
+            }
             m_dataCache->DeallocateAudioData(audioHandle, m_commands);
             return true;
         }
+        case MessageType::MusicStreamPrefetch:
+        {
+            const Message::MusicStreamPrefetchData* data = message.GetMusicStreamPrefetchData();
+            // The asset may have been unloaded since the audio thread asked.
+            AudioStream* stream = m_dataCache->GetAudioData(data->m_audioDataIndex)->m_stream;
+            if (stream)
+            {
+                m_streamLoader->Prefetch(stream, data->m_generation);
+            }
+            return true;
+        }
+        case MessageType::MusicStreamRelease:
+        {
+            const Message::MusicStreamReleaseData* data = message.GetMusicStreamReleaseData();
+            AudioStream* stream = m_dataCache->GetAudioData(data->m_audioDataIndex)->m_stream;
+            if (stream)
+            {
+                m_streamLoader->Release(stream, data->m_generation);
+            }
+            return true;
+        }
         default: return false;
     }
 }
\ No newline at end of file
@@ -27,13 +27,14 @@ namespace rf
 {
 class CommandProcessor;
 class DataCache;
+class StreamLoader;
 struct AudioData;
 struct Message;
 
 class AssetSystem
 {
 public:
-    AssetSystem(CommandProcessor* commands);
+    AssetSystem(CommandProcessor* commands, float streamPrefetchSeconds, float streamBufferSeconds);
     AssetSystem(const AssetSystem&) = delete;
     AssetSystem(AssetSystem&&) = delete;
     AssetSystem& operator=(const AssetSystem&) = delete;
@@ -42,15 +43,26 @@ public:
 
     AudioHandle Load(float* interleavedSampleData, int numFrames, int channels, const char* name);
     AudioHandle Load(const char* path);
+    // Only reads the header of the file. Its samples are decoded on a loader thread when a transition to a cue that uses
+    // it is queued, and freed when the cue is no longer queued or playing. Only the head of the file and a ring just
+    // ahead of playback are held in memory, see MusicConfig. Only cue layers can be streamed.
+    AudioHandle LoadStreamed(const char* path);
     void Unload(const AudioHandle audioHandle);
 
 private:
     DataCache* m_dataCache = nullptr;
     CommandProcessor* m_commands = nullptr;
+    StreamLoader* m_streamLoader = nullptr;
+    float m_streamPrefetchSeconds = 0.0f;
+    float m_streamBufferSeconds = 0.0f;
 
     AudioHandle LoadWAVFile(const char* path);
     AudioHandle LoadFLACFile(const char* path);
+    void SendLoadCommand(AudioHandle audioHandle);
+    static void GetFileExtension(const char* path, char* outExtension);
     const AudioData* GetAudioData(AudioHandle audioHandle) const;
+    const AudioData* GetAudioData(int index) const;
+    AudioHandle GetAudioHandle(int index) const;
     int GetAudioDataIndex(AudioHandle audioHandle) const;
     bool ProcessMessages(const Message& message);
 
@@ -28,11 +28,14 @@ namespace rf
 class AudioTimeline;
 
 typedef void (*AudioCommandCallback)(AudioTimeline* timeline, void* command);
-static constexpr int k_audioCommandSize = 80;
+static constexpr int k_audioCommandSize = 112;
 
 struct AudioCommand
 {
     AudioCommandCallback m_callback = nullptr;
+    // The playhead, in frames, the command runs at. The audio callback is split there so it lands on that exact frame.
+    // -1 runs it at the start of the next audio callback.
+    long long m_playhead = -1;
     uint8_t m_data[k_audioCommandSize];
 };
 
@@ -40,7 +43,7 @@ template <class T, typename... Args>
 T& EncodeAudioCommand(AudioCommand* cmd, Args&&... args)
 {
     cmd->m_callback = T::s_callback;
-    static_assert(sizeof(T) <= k_audioCommandSize, "Audio Command is larger than 80 bytes. Increase k_audioCommandSize.");
+    static_assert(sizeof(T) <= k_audioCommandSize, "Audio Command is larger than 112 bytes. Increase k_audioCommandSize.");
     return *new (cmd->m_data) T(std::forward<Args>(args)...);
 }
 }  // namespace rf
\ No newline at end of file
@@ -66,14 +66,18 @@ void rf::AudioData::Allocate(const AudioData& audioData)
 
 void rf::AudioData::Free()
 {
-    for (int i = 0; i < m_numChannels; ++i)
+    if (m_arrayOfChannels)
     {
-        Allocator::DeallocateBytes(&m_arrayOfChannels[i]);
+        for (int i = 0; i < m_numChannels; ++i)
+        {
+            Allocator::DeallocateBytes(&m_arrayOfChannels[i]);
+        }
+        Allocator::DeallocateBytes(&m_arrayOfChannels);
     }
-    Allocator::DeallocateBytes(&m_arrayOfChannels);
 
     m_name = nullptr;
     m_arrayOfChannels = nullptr;
+    m_stream = nullptr;
     m_numChannels = 0;
     m_numFrames = 0;
     m_numSamples = 0;
@@ -24,6 +24,8 @@
 
 namespace rf
 {
+struct AudioStream;
+
 struct AudioData
 {
     AudioData() = default;
@@ -34,7 +36,9 @@ struct AudioData
     ~AudioData() = default;
 
     const char* m_name = nullptr;
+    // Null for streamed assets, which keep their samples in m_stream while they are loaded.
     float** m_arrayOfChannels = nullptr;
+    AudioStream* m_stream = nullptr;
     int m_numSamples = 0;
     int m_numFrames = 0;
     int m_numChannels = 0;
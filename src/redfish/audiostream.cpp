@@ -0,0 +1,165 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "audiostream.h"
+
+#include <algorithm>
+#include <climits>
+
+int rf::AudioStream::GetNumReadyFrames() const
+{
+    if (!m_isRequested)
+    {
+        return 0;
+    }
+
+    const unsigned long long progress = m_progress.load(std::memory_order_acquire);
+    if (GetGeneration(progress) != m_generation)
+    {
+        return 0;
+    }
+
+    return GetNumFrames(progress);
+}
+
+bool rf::AudioStream::IsReady() const
+{
+    return GetNumReadyFrames() >= m_numPrefetchFrames;
+}
+
+int rf::AudioStream::GetNumReadableFrames(int frame, int numFrames) const
+{
+    int numReadableFrames = 0;
+    if (frame < m_numPrefetchFrames)
+    {
+        numReadableFrames = std::min(std::max(GetNumReadyFrames() - frame, 0), numFrames);
+        if (numReadableFrames == numFrames || frame + numReadableFrames < m_numPrefetchFrames)
+        {
+            return numReadableFrames;
+        }
+    }
+    else if (!IsReady())
+    {
+        return 0;
+    }
+
+    // Ring frames are only read once the loader has answered the latest seek, and only between the read position and
+    // the end of what it has decoded, which the loader won't touch.
+    const unsigned long long tailProgress = m_tailProgress.load(std::memory_order_acquire);
+    if (GetGeneration(tailProgress) != m_seekCount)
+    {
+        return numReadableFrames;
+    }
+
+    const int tailFrame = frame + numReadableFrames;
+    const int tailEnd = GetNumFrames(tailProgress);
+    const int tailStart = IsResident() ? m_numPrefetchFrames : std::max(m_readFrame, tailEnd - m_numBufferFrames);
+    if (tailFrame < tailStart || tailFrame >= tailEnd)
+    {
+        return numReadableFrames;
+    }
+
+    return numReadableFrames + std::min(numFrames - numReadableFrames, tailEnd - tailFrame);
+}
+
+int rf::AudioStream::GetBufferIndex(int frame) const
+{
+    return frame < m_numPrefetchFrames ? frame : m_numPrefetchFrames + (frame - m_numPrefetchFrames) % m_numBufferFrames;
+}
+
+int rf::AudioStream::GetNumContiguousFrames(int frame) const
+{
+    return frame < m_numPrefetchFrames ? m_numPrefetchFrames - frame : m_numBufferFrames - (frame - m_numPrefetchFrames) % m_numBufferFrames;
+}
+
+void rf::AudioStream::OnRead(int nextFrame)
+{
+    if (nextFrame < m_numPrefetchFrames)
+    {
+        m_isReadingHead = true;
+    }
+    else
+    {
+        m_nextReadFrame = std::min(m_nextReadFrame, nextFrame);
+    }
+}
+
+void rf::AudioStream::UpdateReadPosition()
+{
+    // The earliest reader in the ring decides where it goes. With only readers in the head, the ring is moved back to
+    // the start of the tail while they play the head, so it is ready when they get there.
+    int readFrame = m_nextReadFrame;
+    if (readFrame == INT_MAX)
+    {
+        readFrame = m_isReadingHead ? m_numPrefetchFrames : -1;
+    }
+    m_nextReadFrame = INT_MAX;
+    m_isReadingHead = false;
+
+    if (readFrame < 0 || IsResident())
+    {
+        return;
+    }
+
+    const unsigned long long tailProgress = m_tailProgress.load(std::memory_order_acquire);
+    const bool isSeeking = GetGeneration(tailProgress) != m_seekCount;
+    if (readFrame < m_readFrame || (!isSeeking && readFrame > GetNumFrames(tailProgress)))
+    {
+        ++m_seekCount;
+    }
+    else if (readFrame == m_readFrame)
+    {
+        return;
+    }
+
+    m_readFrame = readFrame;
+    m_readPosition.store(PackProgress(m_seekCount, m_readFrame), std::memory_order_release);
+}
+
+void rf::AudioStream::ResetReadPosition()
+{
+    ++m_seekCount;
+    m_readFrame = m_numPrefetchFrames;
+    m_nextReadFrame = INT_MAX;
+    m_isReadingHead = false;
+    m_readPosition.store(PackProgress(m_seekCount, m_readFrame), std::memory_order_release);
+}
+
+bool rf::AudioStream::IsResident() const
+{
+    return m_numPrefetchFrames + m_numBufferFrames >= m_numFrames;
+}
+
+unsigned long long rf::AudioStream::PackProgress(unsigned int generation, int numFrames)
+{
+    return (static_cast<unsigned long long>(generation) << 32) | static_cast<unsigned int>(numFrames);
+}
+
+unsigned int rf::AudioStream::GetGeneration(unsigned long long progress)
+{
+    return static_cast<unsigned int>(progress >> 32);
+}
+
+int rf::AudioStream::GetNumFrames(unsigned long long progress)
+{
+    return static_cast<int>(progress & 0xffffffffull);
+}
\ No newline at end of file
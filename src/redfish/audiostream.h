@@ -0,0 +1,93 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <atomic>
+#include "defines.h"
+
+namespace rf
+{
+// A streamed asset's samples. The first m_numPrefetchFrames frames, the head, stay decoded while the stream is
+// requested, so the layer can start and restart without waiting. The rest is decoded into a ring of
+// m_numBufferFrames frames just ahead of the audio thread, which reports how far it has read. When a new reader needs
+// frames the ring has already moved past, or a reader has fallen behind the ring, the audio thread asks the loader to
+// seek by bumping a seek count. Until the loader answers with that count, none of the ring is read.
+struct AudioStream
+{
+    AudioStream() = default;
+    AudioStream(const AudioStream&) = delete;
+    AudioStream(AudioStream&&) = delete;
+    AudioStream& operator=(const AudioStream&) = delete;
+    AudioStream& operator=(AudioStream&&) = delete;
+    ~AudioStream() = default;
+
+    // How many frames of the head of the audio thread's latest request are decoded. Audio thread only.
+    int GetNumReadyFrames() const;
+    // Whether the head is decoded. Audio thread only.
+    bool IsReady() const;
+    // How many frames from frame on can be read right now. Audio thread only.
+    int GetNumReadableFrames(int frame, int numFrames) const;
+    // Where frame is in m_arrayOfChannels, and how many frames follow it there before the ring wraps.
+    int GetBufferIndex(int frame) const;
+    int GetNumContiguousFrames(int frame) const;
+    // Audio thread. Called by every reader after each read with the next frame it will read.
+    void OnRead(int nextFrame);
+    // Audio thread. Tells the loader where the readers of this block have got to, and asks it to seek if the ring no
+    // longer covers them.
+    void UpdateReadPosition();
+    // Audio thread. Starts reading from the beginning for a new request.
+    void ResetReadPosition();
+    // Whether the whole asset fits in the head and the ring, in which case it is decoded once and never seeks.
+    bool IsResident() const;
+
+    static unsigned long long PackProgress(unsigned int generation, int numFrames);
+    static unsigned int GetGeneration(unsigned long long progress);
+    static int GetNumFrames(unsigned long long progress);
+
+    // Set when the asset is loaded. The path is copied, since the caller's string does not outlive the load call.
+    char m_path[RF_MAX_NAME_SIZE] = {};
+    int m_numFrames = 0;
+    int m_numChannels = 0;
+    int m_numPrefetchFrames = 0;
+    int m_numBufferFrames = 0;
+    bool m_isFLAC = false;
+
+    // Written by the stream loader. The samples belong to the generation in m_progress, the head first and the ring
+    // after it.
+    float** m_arrayOfChannels = nullptr;
+    // The high 32 bits are the generation being decoded, the low 32 bits how many frames of its head are decoded.
+    std::atomic<unsigned long long> m_progress {0};
+    // The high 32 bits are the seek count the loader last answered, the low 32 bits the frame the ring is decoded up to.
+    std::atomic<unsigned long long> m_tailProgress {0};
+
+    // Written by the audio thread. The high 32 bits are the seek count, the low 32 bits the earliest frame past the
+    // head the audio thread can still read. The loader never overwrites that frame or anything after it.
+    std::atomic<unsigned long long> m_readPosition {0};
+    unsigned int m_generation = 0;
+    unsigned int m_seekCount = 0;
+    int m_readFrame = 0;
+    int m_nextReadFrame = 0;
+    bool m_isReadingHead = false;
+    int m_numMissingFrames = 0;
+    bool m_isRequested = false;
+};
+}  // namespace rf
\ No newline at end of file
@@ -22,13 +22,20 @@
 
 #include "audiotimeline.h"
 
+#include <algorithm>
+
+#include "commandprocessor.h"
+#include "playingsoundset.h"
+
 static constexpr int k_numMixItems = RF_MAX_VOICES * 2;
 
-rf::AudioTimeline::AudioTimeline(int numChannels, int bufferSize, int sampleRate)
+rf::AudioTimeline::AudioTimeline(int numChannels, int bufferSize, int sampleRate, const MusicConfig& musicConfig)
     : m_spec({bufferSize, sampleRate, numChannels})
+    , m_messenger(PlayingSoundSet::GetMaxPlayingSounds(musicConfig))
     , m_voiceSet(&m_messenger, m_spec)
     , m_summingMixer(numChannels, bufferSize, sampleRate)
-    , m_musicManager(this, m_spec)
+    , m_musicManager(this, m_spec, musicConfig)
+    , m_profiler(m_spec)
 {
     m_audioDataReferences = Allocator::AllocateArray<const AudioData*>("AudioDataReferences", RF_MAX_AUDIO_DATA);
     m_mixItems = Allocator::AllocateArray<MixItem>("MixItems", k_numMixItems, numChannels, bufferSize);
@@ -40,16 +47,40 @@ rf::AudioTimeline::~AudioTimeline()
     Allocator::DeallocateArray<MixItem>(&m_mixItems, k_numMixItems);
 }
 
-void rf::AudioTimeline::Process(float* buffer, int size)
+int rf::AudioTimeline::Process(float* buffer, int size, CommandProcessor* commands)
 {
-    memset(buffer, 0, size * sizeof(float));
-    m_musicManager.Process(m_playhead, m_mixItems, &m_mixItemIndex);
-    m_voiceSet.Process(m_playhead, m_mixItems, &m_mixItemIndex);
-    m_summingMixer.Sum(buffer, m_mixItems, m_mixItemIndex, size, &m_messenger);
-    m_mixItemIndex = 0;
-    m_playhead += size;
+    memset(buffer, 0, size * m_spec.m_channels * sizeof(float));
+
+    int numCommands = 0;
+    int offset = 0;
+    while (offset < size)
+    {
+        // Render at most one block at a time, whatever size the host asked for. Commands due at the current playhead have
+        // already run, so the next one is always at least a frame away.
+        int numFrames = std::min(size - offset, m_spec.m_bufferSize);
+        const long long nextPlayhead = commands->GetNextPlayhead();
+        if (nextPlayhead >= 0 && nextPlayhead < m_playhead + numFrames)
+        {
+            numFrames = static_cast<int>(nextPlayhead - m_playhead);
+        }
+
+        Render(buffer + offset * m_spec.m_channels, numFrames);
+        offset += numFrames;
+
+        ProfilerScope scope(&m_profiler, Profiler::Stage::Commands);
+        numCommands += commands->ProcessScheduled(this);
+    }
+
+    m_summingMixer.PublishMeters(&m_metering);
+
+    Message msg;
+    msg.m_type = MessageType::ContextPlayhead;
+    msg.GetContextPlayheadData()->m_playhead = m_playhead;
+    m_messenger.AddMessage(msg);
+
     m_messenger.FlushMessages();
     HandleShutdown();
+    return numCommands;
 }
 
 const long long& rf::AudioTimeline::GetPlayhead() const
@@ -73,6 +104,23 @@ void rf::AudioTimeline::Shutdown()
     m_shutdownState = ShutdownState::Stop;
 }
 
+void rf::AudioTimeline::Render(float* buffer, int size)
+{
+    {
+        ProfilerScope scope(&m_profiler, Profiler::Stage::Music);
+        m_musicManager.Process(m_playhead, size, m_mixItems, &m_mixItemIndex);
+    }
+
+    {
+        ProfilerScope scope(&m_profiler, Profiler::Stage::Voices);
+        m_voiceSet.Process(m_playhead, size, m_mixItems, &m_mixItemIndex);
+    }
+
+    m_summingMixer.Sum(buffer, m_mixItems, m_mixItemIndex, size, &m_messenger, &m_profiler);
+    m_mixItemIndex = 0;
+    m_playhead += size;
+}
+
 int rf::AudioTimeline::GetMaxNumMixItems()
 {
     return k_numMixItems;
@@ -23,26 +23,32 @@
 #pragma once
 #include "audiospec.h"
 #include "messenger.h"
+#include "meteringblock.h"
 #include "musicmanager.h"
+#include "profiler.h"
 #include "summingmixer.h"
 #include "voiceset.h"
 
 namespace rf
 {
+class CommandProcessor;
 struct AudioData;
 struct MixItem;
+struct MusicConfig;
 
 class AudioTimeline
 {
 public:
-    AudioTimeline(int numChannels, int bufferSize, int sampleRate);
+    AudioTimeline(int numChannels, int bufferSize, int sampleRate, const MusicConfig& musicConfig);
     AudioTimeline(const AudioTimeline&) = delete;
     AudioTimeline(AudioTimeline&&) = delete;
     AudioTimeline& operator=(const AudioTimeline&) = delete;
     AudioTimeline& operator=(AudioTimeline&&) = delete;
     ~AudioTimeline();
 
-    void Process(float* buffer, int size);
+    // Renders size frames, which may be any number, in blocks of at most the spec's buffer size. A block is also split
+    // wherever a scheduled command is due, so the command runs on its frame. Returns how many scheduled commands ran.
+    int Process(float* buffer, int size, CommandProcessor* commands);
     const long long& GetPlayhead() const;
     const AudioSpec& GetAudioSpec() const;
     const AudioData* GetAudioData(int index) const;
@@ -52,9 +58,11 @@ public:
     const AudioData** m_audioDataReferences = nullptr;
     AudioSpec m_spec;
     Messenger m_messenger;
+    MeteringBlock m_metering;
     VoiceSet m_voiceSet;
     SummingMixer m_summingMixer;
     MusicManager m_musicManager;
+    Profiler m_profiler;
 
 private:
     MixItem* m_mixItems = nullptr;
@@ -70,6 +78,7 @@ private:
         Complete,
     } m_shutdownState = ShutdownState::None;
 
+    void Render(float* buffer, int size);
     void HandleShutdown();
 };
 }  // namespace rf
\ No newline at end of file
@@ -22,11 +22,20 @@
 
 #include "basevoice.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "assert.h"
 #include "audiodata.h"
+#include "audiostream.h"
 #include "functions.h"
+#include "messenger.h"
 #include "mixitem.h"
 
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+#    include <immintrin.h>
+#endif
+
 rf::BaseVoice::BaseVoice(int bufferSize)
     : m_gain(bufferSize)
 {
@@ -36,12 +45,15 @@ void rf::BaseVoice::PlayBase(const PlayParams& params)
 {
     m_startTime = params.m_startTime;
     m_arrayOfChannels = params.m_audioData->m_arrayOfChannels;
+    m_stream = params.m_audioData->m_stream;
     m_channels = params.m_audioData->m_numChannels;
     m_numFrames = params.m_audioData->m_numFrames;
     m_audioHandle = params.m_audioHandle;
     m_soundEffectHandle = params.m_soundEffectHandle;
     m_mixGroupHandle = params.m_mixGroupHandle;
     m_stingerHandle = params.m_stingerHandle;
+    m_audioDataIndex = params.m_audioDataIndex;
+    m_playingSoundId = -1;
     m_localPlayCount = 0;
     m_playCount = params.m_playCount;
     m_pitch = params.m_pitch;
@@ -63,18 +75,126 @@ rf::BaseVoice::Info rf::BaseVoice::FillMixItemBase(long long playhead,
     mixItem->ZeroOut();
     mixItem->m_mixGroupHandle = m_mixGroupHandle;
 
+    if (Read(playhead, mixItem, nullptr, 1.0f, startingIndex, fillSize, bufferSize, messenger, &info))
+    {
+        m_gain.Process(mixItem, bufferSize);
+    }
+
+    return info;
+}
+
+rf::BaseVoice::Info rf::BaseVoice::MixIntoMixItemBase(long long playhead,
+                                                      MixItem* mixItem,
+                                                      const float* amplitudes,
+                                                      float amplitude,
+                                                      int startingIndex,
+                                                      int fillSize,
+                                                      int bufferSize,
+                                                      Messenger* messenger)
+{
+    RF_ASSERT(mixItem->m_mixGroupHandle == m_mixGroupHandle, "Expected the mix item to belong to this voice's mix group");
+
+    Info info;
+    info.m_audioHandle = m_audioHandle;
+    Read(playhead, mixItem, amplitudes, amplitude, startingIndex, fillSize, bufferSize, messenger, &info);
+    return info;
+}
+
+void rf::BaseVoice::ResetBase(Messenger* messenger)
+{
+    if (m_isPlaying)
+    {
+        Functions::SendVoiceStopMessage(*this, messenger);
+        if (m_playingSoundId >= 0)
+        {
+            messenger->ReleasePlayingSoundId(m_playingSoundId);
+        }
+    }
+
+    m_startTime = -1;
+    m_gain.SetAmplitude(1.0f, false);
+    m_audioHandle = AudioHandle();
+    m_soundEffectHandle = SoundEffectHandle();
+    m_mixGroupHandle = MixGroupHandle();
+    m_stingerHandle = StingerHandle();
+    m_arrayOfChannels = nullptr;
+    m_stream = nullptr;
+    m_pitch = 1.0f;
+    m_channels = 0;
+    m_audioDataIndex = -1;
+    m_playingSoundId = -1;
+    m_seek = 0;
+    m_numFrames = 0;
+    m_localPlayCount = 0;
+    m_playCount = 0;
+    m_isPlaying = false;
+}
+
+bool rf::BaseVoice::IsPlaying() const
+{
+    return m_isPlaying;
+}
+
+rf::AudioHandle rf::BaseVoice::GetAudioHandle() const
+{
+    return m_audioHandle;
+}
+
+rf::SoundEffectHandle rf::BaseVoice::GetSoundEffectHandle() const
+{
+    return m_soundEffectHandle;
+}
+
+rf::MixGroupHandle rf::BaseVoice::GetMixGroupHandle() const
+{
+    return m_mixGroupHandle;
+}
+
+rf::StingerHandle rf::BaseVoice::GetStingerHandle() const
+{
+    return m_stingerHandle;
+}
+
+long long rf::BaseVoice::GetStartTime() const
+{
+    return m_startTime;
+}
+
+int rf::BaseVoice::GetAudioDataIndex() const
+{
+    return m_audioDataIndex;
+}
+
+int rf::BaseVoice::GetPlayingSoundId() const
+{
+    return m_playingSoundId;
+}
+
+bool rf::BaseVoice::Read(long long playhead,
+                         MixItem* mixItem,
+                         const float* amplitudes,
+                         float amplitude,
+                         int startingIndex,
+                         int fillSize,
+                         int bufferSize,
+                         Messenger* messenger,
+                         Info* outInfo)
+{
+    Info& info = *outInfo;
+
     if (!m_isPlaying)
     {
         const bool inFirstWindow = Functions::InFirstWindow(playhead, m_startTime, bufferSize);
         if (inFirstWindow)
         {
+            m_playingSoundId = messenger->AcquirePlayingSoundId();
             Functions::SendVoiceStartMessage(*this, messenger);
             m_isPlaying = true;
             info.m_started = true;
         }
         else
         {
-            return info;
+            return false;
         }
     }
 
@@ -89,29 +209,13 @@ rf::BaseVoice::Info rf::BaseVoice::FillMixItemBase(long long playhead,
         isOutOfSamples = true;
     }
 
-    const int phase1FillAmount = maxFill;
     float index = 0.0f;
-    int lastPlacementFrame = 0;
+    const int lastPlacementFrame = ReadChannels(mixItem, m_seek, amplitudes, amplitude, startingIndex, maxFill, &index);
+    RF_ASSERT(lastPlacementFrame < bufferSize, "Frame out of bounds");
 
-    for (int i = 0; i < m_channels; ++i)
+    if (lastPlacementFrame >= startingIndex)
     {
-        index = 0.0f;
-        for (int j = 0; j < phase1FillAmount; ++j)
-        {
-            const int intIndex = static_cast<int>(index);
-            const int lookupFrame = m_seek + intIndex;
-            if (lookupFrame >= m_numFrames)
-            {
-                break;
-            }
-
-            lastPlacementFrame = j + startingIndex;
-            RF_ASSERT(i < m_channels, "Channel out of bounds");
-            RF_ASSERT(lastPlacementFrame < bufferSize, "Frame out of bounds");
-            mixItem->m_arrayOfChannels[i][lastPlacementFrame] = m_arrayOfChannels[i][lookupFrame];
-            info.m_lastFilledFrame = lastPlacementFrame;
-            index += m_pitch;
-        }
+        info.m_lastFilledFrame = lastPlacementFrame;
     }
 
     const int intIndex = static_cast<int>(index);
@@ -129,20 +233,13 @@ rf::BaseVoice::Info rf::BaseVoice::FillMixItemBase(long long playhead,
         {
             info.m_looped = true;
             const int numSamplesFilled = lastPlacementFrame + 1;
-            const int phase2FillAmount = fillSize - numSamplesFilled;
+            const int phase2FillAmount = fillSize - (numSamplesFilled - startingIndex);
 
-            for (int i = 0; i < m_channels; ++i)
+            const int lastFrame = ReadChannels(mixItem, 0, amplitudes, amplitude, numSamplesFilled, phase2FillAmount, &index);
+            RF_ASSERT(lastFrame < bufferSize, "Frame out of bounds");
+            if (lastFrame >= numSamplesFilled)
             {
-                index = 0.0f;
-                for (int j = 0; j < phase2FillAmount; ++j)
-                {
-                    const int lookupFrame = static_cast<int>(index);
-                    RF_ASSERT(i < m_channels, "Channel out of bounds");
-                    RF_ASSERT(lastPlacementFrame < lastPlacementFrame + 1 + j, "Frame out of bounds");
-                    mixItem->m_arrayOfChannels[i][lastPlacementFrame + 1 + j] = m_arrayOfChannels[i][lookupFrame];
-                    info.m_lastFilledFrame = lastPlacementFrame + 1 + j;
-                    index += m_pitch;
-                }
+                info.m_lastFilledFrame = lastFrame;
             }
             m_seek = static_cast<int>(index);
         }
@@ -152,63 +249,127 @@ rf::BaseVoice::Info rf::BaseVoice::FillMixItemBase(long long playhead,
         }
     }
 
-    m_gain.Process(mixItem, bufferSize);
-
     info.m_mixItemFullyFilled = info.m_lastFilledFrame == bufferSize - 1;
-    return info;
+    return true;
 }
 
-void rf::BaseVoice::ResetBase(Messenger* messenger)
+int rf::BaseVoice::ReadChannels(MixItem* mixItem, int seek, const float* amplitudes, float amplitude, int startingIndex, int numFrames, float* outIndex)
 {
-    if (m_isPlaying)
+    // Sources with more channels than the output drop the extra channels.
+    const int numChannels = std::min(m_channels, mixItem->m_channels);
+
+    if (m_stream)
     {
-        Functions::SendVoiceStopMessage(*this, messenger);
+        // Only frames the loader has decoded, and still holds, can be read. The rest are left silent but still played
+        // through, so the music keeps its place, and are reported as an underrun.
+        RF_ASSERT(m_pitch == 1.0f, "Streamed assets can't be pitched");
+        const int numPlayFrames = std::min(numFrames, m_numFrames - seek);
+        const int numReadableFrames = m_stream->GetNumReadableFrames(seek, numPlayFrames);
+        int offset = 0;
+        while (offset < numReadableFrames)
+        {
+            // The head and the ring are read separately, and the ring in two parts where it wraps.
+            const int frame = seek + offset;
+            const int numContiguousFrames = std::min(numReadableFrames - offset, m_stream->GetNumContiguousFrames(frame));
+            const int bufferIndex = m_stream->GetBufferIndex(frame);
+            for (int i = 0; i < numChannels; ++i)
+            {
+                float* destination = mixItem->m_arrayOfChannels[i].GetAsFloatBuffer();
+                ReadFrames(m_stream->m_arrayOfChannels[i] + bufferIndex, 0, numContiguousFrames, 1.0f, amplitudes, amplitude, startingIndex + offset, numContiguousFrames, destination, outIndex);
+            }
+            offset += numContiguousFrames;
+        }
+
+        m_stream->OnRead(seek + numPlayFrames);
+        m_stream->m_numMissingFrames += numPlayFrames - numReadableFrames;
+        *outIndex = static_cast<float>(numPlayFrames);
+        return startingIndex + numPlayFrames - 1;
     }
 
-    m_startTime = -1;
-    m_gain.SetAmplitude(1.0f, false);
-    m_audioHandle = AudioHandle();
-    m_soundEffectHandle = SoundEffectHandle();
-    m_mixGroupHandle = MixGroupHandle();
-    m_stingerHandle = StingerHandle();
-    m_arrayOfChannels = nullptr;
-    m_pitch = 1.0f;
-    m_channels = 0;
-    m_seek = 0;
-    m_numFrames = 0;
-    m_localPlayCount = 0;
-    m_playCount = 0;
-    m_isPlaying = false;
-}
+    int lastFrame = startingIndex - 1;
+    for (int i = 0; i < numChannels; ++i)
+    {
+        float* destination = mixItem->m_arrayOfChannels[i].GetAsFloatBuffer();
+        lastFrame = ReadFrames(m_arrayOfChannels[i], seek, m_numFrames, m_pitch, amplitudes, amplitude, startingIndex, numFrames, destination, outIndex);
+    }
 
-bool rf::BaseVoice::IsPlaying() const
-{
-    return m_isPlaying;
+    return lastFrame;
 }
 
-rf::AudioHandle rf::BaseVoice::GetAudioHandle() const
+int rf::BaseVoice::ReadFrames(const float* source,
+                              int seek,
+                              int numSourceFrames,
+                              float pitch,
+                              const float* amplitudes,
+                              float amplitude,
+                              int startingIndex,
+                              int numFrames,
+                              float* destination,
+                              float* outIndex)
 {
-    return m_audioHandle;
-}
-
-rf::SoundEffectHandle rf::BaseVoice::GetSoundEffectHandle() const
-{
-    return m_soundEffectHandle;
-}
+    // Work out up front how many frames land inside the source, so the loops below have no bounds check or early out.
+    const int numSourceFramesLeft = numSourceFrames - seek;
+    int numReadFrames = 0;
+    if (numSourceFramesLeft > 0)
+    {
+        numReadFrames = pitch > 0.0f ? static_cast<int>(std::min(static_cast<float>(numFrames), ceilf(static_cast<float>(numSourceFramesLeft) / pitch)))
+                                     : numFrames;
 
-rf::MixGroupHandle rf::BaseVoice::GetMixGroupHandle() const
-{
-    return m_mixGroupHandle;
-}
+        // Rounding can leave the estimate a frame either side of the last frame in bounds.
+        while (numReadFrames > 0 && static_cast<int>(static_cast<float>(numReadFrames - 1) * pitch) >= numSourceFramesLeft)
+        {
+            --numReadFrames;
+        }
+        while (numReadFrames < numFrames && static_cast<int>(static_cast<float>(numReadFrames) * pitch) < numSourceFramesLeft)
+        {
+            ++numReadFrames;
+        }
+    }
 
-rf::StingerHandle rf::BaseVoice::GetStingerHandle() const
-{
-    return m_stingerHandle;
-}
+    const float* from = source + seek;
+    float* to = destination + startingIndex;
+    if (pitch == 1.0f)
+    {
+        if (amplitudes)
+        {
+            const float* gains = amplitudes + startingIndex;
+            int j = 0;
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+            const __m128 scale = _mm_set1_ps(amplitude);
+            for (; j + 4 <= numReadFrames; j += 4)
+            {
+                const __m128 sample = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(from + j), _mm_loadu_ps(gains + j)), scale);
+                _mm_storeu_ps(to + j, _mm_add_ps(_mm_loadu_ps(to + j), sample));
+            }
+#endif
+            for (; j < numReadFrames; ++j)
+            {
+                to[j] += from[j] * gains[j] * amplitude;
+            }
+        }
+        else
+        {
+            std::copy(from, from + numReadFrames, to);
+        }
+    }
+    else if (amplitudes)
+    {
+        const float* gains = amplitudes + startingIndex;
+        for (int j = 0; j < numReadFrames; ++j)
+        {
+            to[j] += from[static_cast<int>(static_cast<float>(j) * pitch)] * gains[j] * amplitude;
+        }
+    }
+    else
+    {
+        for (int j = 0; j < numReadFrames; ++j)
+        {
+            to[j] = from[static_cast<int>(static_cast<float>(j) * pitch)];
+        }
+    }
 
-long long rf::BaseVoice::GetStartTime() const
-{
-    return m_startTime;
+    *outIndex = static_cast<float>(numReadFrames) * pitch;
+    return startingIndex + numReadFrames - 1;
 }
 
 bool rf::BaseVoice::Info::operator==(const Info& other) const
@@ -28,6 +28,7 @@ namespace rf
 {
 class Messenger;
 struct AudioData;
+struct AudioStream;
 struct MixItem;
 
 static constexpr int k_stopSamples = 32;
@@ -47,6 +48,7 @@ public:
         long long m_startTime = 0;
         float m_amplitude = 1.0f;
         float m_pitch = 1.0f;
+        int m_audioDataIndex = -1;
         int m_playCount = 1;
     };
 
@@ -65,6 +67,16 @@ public:
 
     void PlayBase(const PlayParams& params);
     Info FillMixItemBase(long long playhead, MixItem* mixItem, int startingIndex, int fillSize, int bufferSize, Messenger* messenger);
+    // Adds the voice to a mix item that other voices of the same mix group may already have written to, scaling each
+    // frame by amplitudes and amplitude instead of the voice's own gain. The mix item is not cleared first.
+    Info MixIntoMixItemBase(long long playhead,
+                            MixItem* mixItem,
+                            const float* amplitudes,
+                            float amplitude,
+                            int startingIndex,
+                            int fillSize,
+                            int bufferSize,
+                            Messenger* messenger);
     void ResetBase(Messenger* messenger);
     bool IsPlaying() const;
     AudioHandle GetAudioHandle() const;
@@ -72,6 +84,8 @@ public:
     MixGroupHandle GetMixGroupHandle() const;
     StingerHandle GetStingerHandle() const;
     long long GetStartTime() const;
+    int GetAudioDataIndex() const;
+    int GetPlayingSoundId() const;
 
 protected:
     long long m_startTime = -1;
@@ -81,12 +95,37 @@ protected:
     MixGroupHandle m_mixGroupHandle;
     StingerHandle m_stingerHandle;
     float** m_arrayOfChannels = nullptr;
+    AudioStream* m_stream = nullptr;
     float m_pitch = 1.0f;
     int m_channels = 0;
+    int m_audioDataIndex = -1;
+    int m_playingSoundId = -1;
     int m_seek = 0;
     int m_numFrames = 0;
     int m_localPlayCount = 0;
     int m_playCount = 0;
     bool m_isPlaying = false;
+
+private:
+    bool Read(long long playhead,
+              MixItem* mixItem,
+              const float* amplitudes,
+              float amplitude,
+              int startingIndex,
+              int fillSize,
+              int bufferSize,
+              Messenger* messenger,
+              Info* outInfo);
+    int ReadChannels(MixItem* mixItem, int seek, const float* amplitudes, float amplitude, int startingIndex, int numFrames, float* outIndex);
+    static int ReadFrames(const float* source,
+                          int seek,
+                          int numSourceFrames,
+                          float pitch,
+                          const float* amplitudes,
+                          float amplitude,
+                          int startingIndex,
+                          int numFrames,
+                          float* destination,
+                          float* outIndex);
 };
 }  // namespace rf
\ No newline at end of file
@@ -0,0 +1,430 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "binauralrenderer.h"
+
+#include <algorithm>
+
+#include "allocator.h"
+#include "assert.h"
+#include "audiotimeline.h"
+#include "pluginutils.h"
+#include "voice.h"
+
+rf::BinauralRenderer::BinauralRenderer(const AudioSpec& spec)
+    : m_mono(spec.m_bufferSize)
+    , m_scratch(spec.m_bufferSize)
+{
+    const int numSegments = static_cast<int>(fftconvolver::FFTConvolver::SegmentCount(spec.m_bufferSize, PluginUtils::k_maxHRIRLength));
+    m_buses = Allocator::AllocateArray<Bus>("BinauralBuses", RF_MAX_BINAURAL_BUSES, spec.m_bufferSize, numSegments);
+    m_directSlots = Allocator::AllocateArray<DirectSlot>("BinauralDirectSlots", RF_MAX_DIRECT_BINAURAL_VOICES, spec.m_bufferSize, numSegments);
+}
+
+rf::BinauralRenderer::~BinauralRenderer()
+{
+    Allocator::DeallocateArray<Bus>(&m_buses, RF_MAX_BINAURAL_BUSES);
+    Allocator::DeallocateArray<DirectSlot>(&m_directSlots, RF_MAX_DIRECT_BINAURAL_VOICES);
+}
+
+void rf::BinauralRenderer::SetHRTF(const HRTF* hrtf)
+{
+    m_hrtf = hrtf;
+
+    const int numSegments = m_hrtf->GetNumSegments();
+    for (int i = 0; i < RF_MAX_BINAURAL_BUSES; ++i)
+    {
+        for (int channel = 0; channel < Ambisonics::k_numChannels; ++channel)
+        {
+            for (int ear = 0; ear < HRTF::k_numEars; ++ear)
+            {
+                m_buses[i].m_convolvers[channel][ear].setImpulseResponse(0, m_hrtf->GetAmbisonicSegments(channel, ear), numSegments);
+            }
+        }
+    }
+}
+
+void rf::BinauralRenderer::AssignDirectSlots(Voice* voices, int numVoices)
+{
+    int nearest[RF_MAX_DIRECT_BINAURAL_VOICES];
+    float nearestDistances[RF_MAX_DIRECT_BINAURAL_VOICES];
+    int numNearest = 0;
+
+    // Snapshot the binaural voices for this block and keep the closest ones sorted by distance.
+    for (int i = 0; i < numVoices; ++i)
+    {
+        Voice& voice = voices[i];
+        BinauralVoiceState& state = voice.m_binaural;
+        const PositioningParameters& parameters = voice.m_positioning.GetPositioningParameters();
+        state.m_active = m_hrtf && parameters.m_enable && parameters.m_binaural;
+        state.m_azimuth = parameters.m_azimuth;
+        state.m_elevation = parameters.m_elevation;
+        voice.m_positioning.SetPanBypass(state.m_active);
+
+        if (!state.m_active)
+        {
+            continue;
+        }
+
+        const float distance = parameters.m_currentDistance;
+        int position = numNearest;
+        while (position > 0 && nearestDistances[position - 1] > distance)
+        {
+            --position;
+        }
+
+        if (position < RF_MAX_DIRECT_BINAURAL_VOICES)
+        {
+            for (int j = std::min(numNearest, RF_MAX_DIRECT_BINAURAL_VOICES - 1); j > position; --j)
+            {
+                nearest[j] = nearest[j - 1];
+                nearestDistances[j] = nearestDistances[j - 1];
+            }
+
+            nearest[position] = i;
+            nearestDistances[position] = distance;
+            numNearest = std::min(numNearest + 1, RF_MAX_DIRECT_BINAURAL_VOICES);
+        }
+    }
+
+    // Voices that dropped out of the nearest set give their slot back before the new ones are handed out.
+    for (int i = 0; i < numVoices; ++i)
+    {
+        if (voices[i].m_binaural.m_directSlot == -1)
+        {
+            continue;
+        }
+
+        bool isNearest = false;
+        for (int j = 0; j < numNearest; ++j)
+        {
+            isNearest = isNearest || nearest[j] == i;
+        }
+
+        if (!isNearest)
+        {
+            Release(&voices[i]);
+        }
+    }
+
+    for (int j = 0; j < numNearest; ++j)
+    {
+        BinauralVoiceState& state = voices[nearest[j]].m_binaural;
+        if (state.m_directSlot != -1)
+        {
+            continue;
+        }
+
+        for (int i = 0; i < RF_MAX_DIRECT_BINAURAL_VOICES; ++i)
+        {
+            DirectSlot& slot = m_directSlots[i];
+            if (!slot.m_inUse)
+            {
+                slot.m_inUse = true;
+                for (int set = 0; set < DirectSlot::k_numSets; ++set)
+                {
+                    for (int ear = 0; ear < HRTF::k_numEars; ++ear)
+                    {
+                        slot.m_convolvers[set][ear].clear();
+                    }
+
+                    for (int n = 0; n < HRTF::k_numNearest; ++n)
+                    {
+                        slot.m_measurements[set][n] = -1;
+                    }
+                }
+
+                state.m_directSlot = i;
+                break;
+            }
+        }
+    }
+}
+
+bool rf::BinauralRenderer::Render(Voice* voice, MixItem* mixItem, int bufferSize)
+{
+    BinauralVoiceState& state = voice->m_binaural;
+    if (!state.m_active)
+    {
+        return false;
+    }
+
+    Downmix(mixItem, std::min(voice->m_channels, mixItem->m_channels));
+
+    if (state.m_directSlot != -1)
+    {
+        RenderDirect(&state, mixItem, bufferSize);
+        return false;
+    }
+
+    Bus* bus = FindBus(mixItem->m_mixGroupHandle);
+    if (!bus)
+    {
+        RF_FAIL("Out of binaural buses. Try increasing RF_MAX_BINAURAL_BUSES");
+        return false;
+    }
+
+    Encode(&state, bus, bufferSize);
+    return true;
+}
+
+void rf::BinauralRenderer::Release(Voice* voice)
+{
+    BinauralVoiceState& state = voice->m_binaural;
+    if (state.m_directSlot != -1)
+    {
+        m_directSlots[state.m_directSlot].m_inUse = false;
+        state.m_directSlot = -1;
+    }
+
+    state.m_hasGains = false;
+}
+
+void rf::BinauralRenderer::Decode(MixItem* outMixItems, int* outNumMixItems, int bufferSize)
+{
+    if (!m_hrtf)
+    {
+        return;
+    }
+
+    // A bus keeps decoding after its last voice stops until the convolution tails have rung out. Then it is free for
+    // another mix group. Blocks can be split, so the tail is counted in frames.
+    const int tailFrames = (m_hrtf->GetNumSegments() + 1) * m_scratch.m_size;
+    for (int i = 0; i < RF_MAX_BINAURAL_BUSES; ++i)
+    {
+        Bus& bus = m_buses[i];
+        if (!bus.m_mixGroupHandle)
+        {
+            continue;
+        }
+
+        bus.m_idleFrames = bus.m_fed ? 0 : bus.m_idleFrames + bufferSize;
+        bus.m_fed = false;
+        if (bus.m_idleFrames > tailFrames)
+        {
+            bus.m_mixGroupHandle = MixGroupHandle();
+            continue;
+        }
+
+        MixItem* mixItem = &outMixItems[(*outNumMixItems)++];
+        RF_ASSERT(*outNumMixItems < AudioTimeline::GetMaxNumMixItems(), "Too many mix items will be generated. Increase RF_MAX_VOICES");
+        mixItem->ZeroOut();
+        mixItem->m_mixGroupHandle = bus.m_mixGroupHandle;
+
+        // The convolvers only write bufferSize frames, and the rest of the scratch buffer is summed too.
+        m_scratch.ZeroOut();
+        for (int channel = 0; channel < Ambisonics::k_numChannels; ++channel)
+        {
+            const float* input = bus.m_mixItem.m_arrayOfChannels[channel].GetAsFloatBuffer();
+            for (int ear = 0; ear < HRTF::k_numEars; ++ear)
+            {
+                bus.m_convolvers[channel][ear].process(input, m_scratch.GetAsFloatBuffer(), bufferSize);
+                mixItem->m_arrayOfChannels[ear].Sum(m_scratch, 1.0f);
+            }
+        }
+
+        bus.m_mixItem.ZeroOut();
+    }
+}
+
+rf::BinauralRenderer::Bus* rf::BinauralRenderer::FindBus(MixGroupHandle mixGroupHandle)
+{
+    Bus* freeBus = nullptr;
+    for (int i = 0; i < RF_MAX_BINAURAL_BUSES; ++i)
+    {
+        Bus& bus = m_buses[i];
+        if (bus.m_mixGroupHandle == mixGroupHandle)
+        {
+            return &bus;
+        }
+
+        if (!freeBus && !bus.m_mixGroupHandle)
+        {
+            freeBus = &bus;
+        }
+    }
+
+    if (freeBus)
+    {
+        freeBus->m_mixGroupHandle = mixGroupHandle;
+        freeBus->m_idleFrames = 0;
+    }
+
+    return freeBus;
+}
+
+void rf::BinauralRenderer::Downmix(const MixItem* mixItem, int numSourceChannels)
+{
+    // Positioned sounds are point sources, so every source channel is folded into one signal first. This averages
+    // (1/N) like the VBAP fold-down, so a correlated stereo source renders at the level of its mono equivalent.
+    m_mono.ZeroOut();
+    if (numSourceChannels <= 0)
+    {
+        return;
+    }
+
+    const float foldDownGain = 1.0f / static_cast<float>(numSourceChannels);
+    for (int c = 0; c < numSourceChannels; ++c)
+    {
+        m_mono.Sum(mixItem->m_arrayOfChannels[c], foldDownGain);
+    }
+}
+
+void rf::BinauralRenderer::Encode(BinauralVoiceState* state, Bus* bus, int bufferSize)
+{
+    float direction[3];
+    float targets[Ambisonics::k_numChannels];
+    Ambisonics::DirectionToVector(state->m_azimuth, state->m_elevation, direction);
+    Ambisonics::Encode(direction[0], direction[1], direction[2], targets);
+
+    if (!state->m_hasGains)
+    {
+        std::copy(targets, targets + Ambisonics::k_numChannels, state->m_gains);
+        state->m_hasGains = true;
+    }
+
+    // Ramp each channel's gain across the block so a moving source doesn't zipper.
+    const float* mono = m_mono.GetAsFloatBuffer();
+    const float inverseBufferSize = 1.0f / static_cast<float>(bufferSize);
+    for (int channel = 0; channel < Ambisonics::k_numChannels; ++channel)
+    {
+        float* output = bus->m_mixItem.m_arrayOfChannels[channel].GetAsFloatBuffer();
+        const float start = state->m_gains[channel];
+        const float step = (targets[channel] - start) * inverseBufferSize;
+        int i = 0;
+
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+        const __m128 starts = _mm_set1_ps(start);
+        const __m128 steps = _mm_set1_ps(step);
+        const __m128 offsets = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+        for (; i + 4 <= bufferSize; i += 4)
+        {
+            const __m128 indices = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), offsets);
+            const __m128 gains = _mm_add_ps(starts, _mm_mul_ps(steps, indices));
+            _mm_storeu_ps(output + i, _mm_add_ps(_mm_loadu_ps(output + i), _mm_mul_ps(_mm_loadu_ps(mono + i), gains)));
+        }
+#endif
+
+        for (; i < bufferSize; ++i)
+        {
+            output[i] += mono[i] * (start + step * static_cast<float>(i + 1));
+        }
+
+        state->m_gains[channel] = targets[channel];
+    }
+
+    bus->m_fed = true;
+}
+
+void rf::BinauralRenderer::RenderDirect(BinauralVoiceState* state, MixItem* mixItem, int bufferSize)
+{
+    DirectSlot& slot = m_directSlots[state->m_directSlot];
+
+    float direction[3];
+    int measurements[HRTF::k_numNearest];
+    float weights[HRTF::k_numNearest];
+    Ambisonics::DirectionToVector(state->m_azimuth, state->m_elevation, direction);
+    m_hrtf->FindNearest(direction[0], direction[1], direction[2], measurements, weights);
+
+    // A new voice has nothing to fade from, so both sets start on its direction.
+    const int currentSet = slot.m_currentSet;
+    const int nextSet = 1 - currentSet;
+    const bool isFirst = slot.m_measurements[currentSet][0] == -1;
+    const bool changed = !std::equal(measurements, measurements + HRTF::k_numNearest, slot.m_measurements[currentSet]) ||
+                         !std::equal(weights, weights + HRTF::k_numNearest, slot.m_weights[currentSet]);
+    if (changed)
+    {
+        SetDirectSet(&slot, nextSet, measurements, weights);
+        if (isFirst)
+        {
+            SetDirectSet(&slot, currentSet, measurements, weights);
+        }
+    }
+
+    const bool crossfade = changed && !isFirst;
+    const float* mono = m_mono.GetAsFloatBuffer();
+    float* next = m_scratch.GetAsFloatBuffer();
+    const float inverseBufferSize = 1.0f / static_cast<float>(bufferSize);
+    mixItem->ZeroOut();
+    for (int ear = 0; ear < HRTF::k_numEars; ++ear)
+    {
+        float* output = mixItem->m_arrayOfChannels[ear].GetAsFloatBuffer();
+        slot.m_convolvers[currentSet][ear].process(mono, output, bufferSize);
+        slot.m_convolvers[nextSet][ear].process(mono, next, bufferSize);
+        if (crossfade)
+        {
+            for (int i = 0; i < bufferSize; ++i)
+            {
+                output[i] += (next[i] - output[i]) * (static_cast<float>(i + 1) * inverseBufferSize);
+            }
+        }
+    }
+
+    if (crossfade)
+    {
+        slot.m_currentSet = nextSet;
+    }
+}
+
+void rf::BinauralRenderer::SetDirectSet(DirectSlot* slot, int set, const int* measurements, const float* weights)
+{
+    // Convolution is linear, so weighting the outputs of the nearest measurements is the same as convolving with their
+    // interpolated HRIR. The convolver sums its impulse response slots with these weights in the frequency domain.
+    const int numSegments = m_hrtf->GetNumSegments();
+    for (int ear = 0; ear < HRTF::k_numEars; ++ear)
+    {
+        fftconvolver::FFTConvolver& convolver = slot->m_convolvers[set][ear];
+        for (int n = 0; n < HRTF::k_numNearest; ++n)
+        {
+            if (slot->m_measurements[set][n] != measurements[n])
+            {
+                convolver.setImpulseResponse(n, m_hrtf->GetMeasurement(measurements[n]).m_segments[ear], numSegments);
+            }
+        }
+        convolver.setImpulseResponseAmplitudes(weights);
+    }
+
+    std::copy(measurements, measurements + HRTF::k_numNearest, slot->m_measurements[set]);
+    std::copy(weights, weights + HRTF::k_numNearest, slot->m_weights[set]);
+}
+
+rf::BinauralRenderer::Bus::Bus(int bufferSize, int numSegments)
+    : m_mixItem(Ambisonics::k_numChannels, bufferSize)
+{
+    for (int channel = 0; channel < Ambisonics::k_numChannels; ++channel)
+    {
+        for (int ear = 0; ear < HRTF::k_numEars; ++ear)
+        {
+            m_convolvers[channel][ear].init(bufferSize, numSegments);
+        }
+    }
+}
+
+rf::BinauralRenderer::DirectSlot::DirectSlot(int bufferSize, int numSegments)
+{
+    for (int set = 0; set < k_numSets; ++set)
+    {
+        for (int ear = 0; ear < HRTF::k_numEars; ++ear)
+        {
+            m_convolvers[set][ear].init(bufferSize, numSegments);
+        }
+    }
+}
@@ -0,0 +1,98 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <external/fftconvolver/FFTConvolver.h>
+
+#include "ambisonics.h"
+#include "audiospec.h"
+#include "binauralvoicestate.h"
+#include "buffer.h"
+#include "defines.h"
+#include "hrtf.h"
+#include "identifiers.h"
+#include "mixitem.h"
+
+namespace rf
+{
+class Voice;
+
+// Renders voices that have binaural positioning enabled. Most voices are encoded into a shared ambisonic bus per mix
+// group, and each bus is decoded to binaural once per block, so the convolution cost does not grow with the voice count.
+// The voices nearest to the listener skip the bus and are convolved with their own HRIR pair, interpolated between the
+// closest measurements.
+class BinauralRenderer
+{
+public:
+    BinauralRenderer(const AudioSpec& spec);
+    BinauralRenderer(const BinauralRenderer&) = delete;
+    BinauralRenderer(BinauralRenderer&&) = delete;
+    BinauralRenderer& operator=(const BinauralRenderer&) = delete;
+    BinauralRenderer& operator=(BinauralRenderer&&) = delete;
+    ~BinauralRenderer();
+
+    void SetHRTF(const HRTF* hrtf);
+    void AssignDirectSlots(Voice* voices, int numVoices);
+    // Returns true if the voice was encoded into an ambisonic bus. Its mix item is then no longer needed.
+    bool Render(Voice* voice, MixItem* mixItem, int bufferSize);
+    void Release(Voice* voice);
+    void Decode(MixItem* outMixItems, int* outNumMixItems, int bufferSize);
+
+private:
+    struct Bus
+    {
+        MixGroupHandle m_mixGroupHandle;
+        MixItem m_mixItem;
+        fftconvolver::FFTConvolver m_convolvers[Ambisonics::k_numChannels][HRTF::k_numEars];
+        int m_idleFrames = 0;
+        bool m_fed = false;
+
+        Bus(int bufferSize, int numSegments);
+    };
+
+    // Two convolver sets that both run every block, so either one can take over. When the direction changes the idle set
+    // takes the new measurements and weights, and the output crossfades to it across the block.
+    struct DirectSlot
+    {
+        static constexpr int k_numSets = 2;
+        fftconvolver::FFTConvolver m_convolvers[k_numSets][HRTF::k_numEars];
+        int m_measurements[k_numSets][HRTF::k_numNearest] = {};
+        float m_weights[k_numSets][HRTF::k_numNearest] = {};
+        int m_currentSet = 0;
+        bool m_inUse = false;
+
+        DirectSlot(int bufferSize, int numSegments);
+    };
+
+    const HRTF* m_hrtf = nullptr;
+    Bus* m_buses = nullptr;
+    DirectSlot* m_directSlots = nullptr;
+    Buffer m_mono;
+    Buffer m_scratch;
+
+    Bus* FindBus(MixGroupHandle mixGroupHandle);
+    void Downmix(const MixItem* mixItem, int numSourceChannels);
+    void Encode(BinauralVoiceState* state, Bus* bus, int bufferSize);
+    void RenderDirect(BinauralVoiceState* state, MixItem* mixItem, int bufferSize);
+    void SetDirectSet(DirectSlot* slot, int set, const int* measurements, const float* weights);
+};
+}  // namespace rf
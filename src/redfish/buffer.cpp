@@ -143,6 +143,39 @@ void rf::Buffer::Multiply(const Buffer& buffer)
 #endif
 }
 
+void rf::Buffer::Multiply(const Buffer& buffer, int numFrames)
+{
+    RF_ASSERT(numFrames <= m_size && numFrames <= buffer.m_size, "Frame count is larger than the buffers");
+
+    int i = 0;
+#if RF_USE_SSE
+    for (; (i + 1) * 4 <= numFrames; ++i)
+    {
+        *(m_buffer + i) = _mm_mul_ps(*(m_buffer + i), *(buffer.m_buffer + i));
+    }
+    i *= 4;
+#elif RF_USE_AVX
+    for (; (i + 1) * 8 <= numFrames; ++i)
+    {
+        *(m_buffer + i) = _mm256_mul_ps(*(m_buffer + i), *(buffer.m_buffer + i));
+    }
+    i *= 8;
+#elif RF_USE_AVX_512
+    for (; (i + 1) * 16 <= numFrames; ++i)
+    {
+        *(m_buffer + i) = _mm512_mul_ps(*(m_buffer + i), *(buffer.m_buffer + i));
+    }
+    i *= 16;
+#endif
+
+    float* data = GetAsFloatBuffer();
+    const float* other = buffer.GetAsFloatBuffer();
+    for (; i < numFrames; ++i)
+    {
+        data[i] *= other[i];
+    }
+}
+
 void rf::Buffer::ScalarMultiply(float scalar)
 {
 #if RF_USE_SSE
@@ -179,13 +212,21 @@ void rf::Buffer::Sum(const Buffer& buffer, float amplitude)
     const __m128 simdScalar = _mm_set1_ps(amplitude);
     for (int i = 0; i < m_numSimdIterations; ++i)
     {
+#if RF_USE_FMA
         *(m_buffer + i) = _mm_fmadd_ps(*(buffer.m_buffer + i), simdScalar, *(m_buffer + i));
+#else
+        *(m_buffer + i) = _mm_add_ps(*(m_buffer + i), _mm_mul_ps(*(buffer.m_buffer + i), simdScalar));
+#endif
     }
 #elif RF_USE_AVX
     const __m256 simdScalar = _mm256_set1_ps(amplitude);
     for (int i = 0; i < m_numSimdIterations; ++i)
     {
+#if RF_USE_FMA
         *(m_buffer + i) = _mm256_fmadd_ps(*(buffer.m_buffer + i), simdScalar, *(m_buffer + i));
+#else
+        *(m_buffer + i) = _mm256_add_ps(*(m_buffer + i), _mm256_mul_ps(*(buffer.m_buffer + i), simdScalar));
+#endif
     }
 #elif RF_USE_AVX_512
     const __m512 simdScalar = _mm512_set1_ps(amplitude);
@@ -219,6 +260,42 @@ void rf::Buffer::Subtract(const Buffer& buffer)
 #endif
 }
 
+void rf::Buffer::MaxAbsolute(const Buffer& buffer, int numFrames)
+{
+    RF_ASSERT(numFrames <= m_size && numFrames <= buffer.m_size, "Frame count is larger than the buffers");
+
+    int i = 0;
+#if RF_USE_SSE
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    for (; (i + 1) * 4 <= numFrames; ++i)
+    {
+        *(m_buffer + i) = _mm_max_ps(*(m_buffer + i), _mm_andnot_ps(signMask, *(buffer.m_buffer + i)));
+    }
+    i *= 4;
+#elif RF_USE_AVX
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    for (; (i + 1) * 8 <= numFrames; ++i)
+    {
+        *(m_buffer + i) = _mm256_max_ps(*(m_buffer + i), _mm256_andnot_ps(signMask, *(buffer.m_buffer + i)));
+    }
+    i *= 8;
+#elif RF_USE_AVX_512
+    for (; (i + 1) * 16 <= numFrames; ++i)
+    {
+        *(m_buffer + i) = _mm512_max_ps(*(m_buffer + i), _mm512_abs_ps(*(buffer.m_buffer + i)));
+    }
+    i *= 16;
+#endif
+
+    float* data = GetAsFloatBuffer();
+    const float* other = buffer.GetAsFloatBuffer();
+    for (; i < numFrames; ++i)
+    {
+        const float absValue = other[i] < 0.0f ? -other[i] : other[i];
+        data[i] = data[i] > absValue ? data[i] : absValue;
+    }
+}
+
 float* rf::Buffer::GetAsFloatBuffer()
 {
     return reinterpret_cast<float*>(m_buffer);
@@ -296,6 +373,59 @@ float rf::Buffer::GetAbsoluteMax() const
 #endif
 }
 
+float rf::Buffer::GetSumOfSquares() const
+{
+#if RF_USE_SSE
+    __m128 sum = _mm_setzero_ps();
+    for (int i = 0; i < m_numSimdIterations; ++i)
+    {
+        __m128 value = m_buffer[i];
+        sum = _mm_add_ps(sum, _mm_mul_ps(value, value));
+    }
+    __m128 permValue = _mm_permute_ps(sum, _MM_SHUFFLE(1, 0, 3, 2));
+    sum = _mm_add_ps(sum, permValue);
+    permValue = _mm_permute_ps(sum, _MM_SHUFFLE(2, 3, 0, 1));
+    sum = _mm_add_ps(sum, permValue);
+    return _mm_cvtss_f32(sum);
+#else
+    const float* buffer = GetAsFloatBuffer();
+    float sum = 0.0f;
+    for (int i = 0; i < m_size; ++i)
+    {
+        sum += buffer[i] * buffer[i];
+    }
+    return sum;
+#endif
+}
+
+int rf::Buffer::GetNumClipped() const
+{
+#if RF_USE_SSE
+    const __m128 fullScale = _mm_set1_ps(1.0f);
+    int numClipped = 0;
+    for (int i = 0; i < m_numSimdIterations; ++i)
+    {
+        __m128 absValue = _mm_andnot_ps(_mm_set1_ps(-0.0f), m_buffer[i]);
+        const int mask = _mm_movemask_ps(_mm_cmpge_ps(absValue, fullScale));
+        numClipped += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+    }
+    return numClipped;
+#else
+    const float* buffer = GetAsFloatBuffer();
+    int numClipped = 0;
+    for (int i = 0; i < m_size; ++i)
+    {
+        const float value = buffer[i];
+        const float absValue = value < 0.0f ? -value : value;
+        if (absValue >= 1.0f)
+        {
+            ++numClipped;
+        }
+    }
+    return numClipped;
+#endif
+}
+
 void rf::Buffer::Allocate(int size)
 {
     Free();
@@ -306,15 +436,15 @@ void rf::Buffer::Allocate(int size)
 
 #if RF_USE_SSE
     sizeOfType = sizeof(__m128);
-    m_buffer = static_cast<__m128*>(Allocator::s_allocate(m_bytes, "Buffer", alignof(__m128)));
+    m_buffer = static_cast<__m128*>(Allocator::AllocateMemory(m_bytes, "Buffer", alignof(__m128)));
 #elif RF_USE_AVX
     sizeOfType = sizeof(__m256);
-    m_buffer = static_cast<__m256*>(Allocator::s_allocate(m_bytes, "Buffer", alignof(__m256)));
+    m_buffer = static_cast<__m256*>(Allocator::AllocateMemory(m_bytes, "Buffer", alignof(__m256)));
 #elif RF_USE_AVX_512
     sizeOfType = sizeof(__m512);
-    m_buffer = static_cast<__m512*>(Allocator::s_allocate(m_bytes, "Buffer", alignof(__m512)));
+    m_buffer = static_cast<__m512*>(Allocator::AllocateMemory(m_bytes, "Buffer", alignof(__m512)));
 #else
-    m_buffer = static_cast<float*>(Allocator::s_allocate(m_bytes, "Buffer", alignof(float)));
+    m_buffer = static_cast<float*>(Allocator::AllocateMemory(m_bytes, "Buffer", alignof(float)));
 #endif
 
     m_numSimdIterations = m_bytes / sizeOfType;
@@ -325,7 +455,7 @@ void rf::Buffer::Free()
 {
     if (m_buffer)
     {
-        Allocator::s_deallocate(m_buffer);
+        Allocator::DeallocateMemory(m_buffer);
         m_buffer = nullptr;
         m_size = 0;
         m_bytes = 0;
@@ -50,13 +50,17 @@ public:
     void ZeroOut();
     void Set(float value);
     void Multiply(const Buffer& buffer);
+    void Multiply(const Buffer& buffer, int numFrames);
     void ScalarMultiply(float scalar);
     void Sum(const Buffer& buffer, float amplitude);
     void Subtract(const Buffer& buffer);
+    void MaxAbsolute(const Buffer& buffer, int numFrames);
     float* GetAsFloatBuffer();
     const float* GetAsFloatBuffer() const;
     float GetMax() const;
     float GetAbsoluteMax() const;
+    float GetSumOfSquares() const;
+    int GetNumClipped() const;
 
     int m_size = 0;
     int m_bytes = 0;
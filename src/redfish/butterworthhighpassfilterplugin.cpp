@@ -22,7 +22,10 @@
 
 #include "butterworthhighpassfilterplugin.h"
 
+#include "allocator.h"
+#include "butterworthhighpassfilterdsp.h"
 #include "commandprocessor.h"
+#include "context.h"
 #include "functions.h"
 #include "plugincommands.h"
 
@@ -33,7 +36,7 @@ rf::ButterworthHighpassFilterPlugin::ButterworthHighpassFilterPlugin(Context* co
                                                                      int pluginIndex)
     : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::ButterworthHighpassFilter)
 {
-    RF_SEND_PLUGIN_CREATE_COMMAND(CreateButterworthHighpassFilterDSPCommand);
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreateButterworthHighpassFilterDSPCommand, ButterworthHighpassFilterDSP);
 }
 
 rf::ButterworthHighpassFilterPlugin::~ButterworthHighpassFilterPlugin()
@@ -54,7 +57,7 @@ void rf::ButterworthHighpassFilterPlugin::SetOrder(int order)
     SetButterworthHighpassFilterDSPOrderCommand& data = EncodeAudioCommand<SetButterworthHighpassFilterDSPOrderCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_order = m_order;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 int rf::ButterworthHighpassFilterPlugin::GetOrder() const
@@ -75,7 +78,7 @@ void rf::ButterworthHighpassFilterPlugin::SetCutoff(float cutoff)
     SetButterworthHighpassFilterDSPCutoffCommand& data = EncodeAudioCommand<SetButterworthHighpassFilterDSPCutoffCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_cutoff = m_cutoff;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::ButterworthHighpassFilterPlugin::GetCutoff() const
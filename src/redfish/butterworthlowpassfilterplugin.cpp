@@ -22,7 +22,10 @@
 
 #include "butterworthlowpassfilterplugin.h"
 
+#include "allocator.h"
+#include "butterworthlowpassfilterdsp.h"
 #include "commandprocessor.h"
+#include "context.h"
 #include "functions.h"
 #include "plugincommands.h"
 
@@ -33,7 +36,7 @@ rf::ButterworthLowpassFilterPlugin::ButterworthLowpassFilterPlugin(Context* cont
                                                                    int pluginIndex)
     : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::ButterworthLowpassFilter)
 {
-    RF_SEND_PLUGIN_CREATE_COMMAND(CreateButterworthLowpassFilterDSPCommand);
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreateButterworthLowpassFilterDSPCommand, ButterworthLowpassFilterDSP);
 }
 
 rf::ButterworthLowpassFilterPlugin::~ButterworthLowpassFilterPlugin()
@@ -54,7 +57,7 @@ void rf::ButterworthLowpassFilterPlugin::SetOrder(int order)
     SetButterworthLowpassFilterDSPOrderCommand& data = EncodeAudioCommand<SetButterworthLowpassFilterDSPOrderCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_order = m_order;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 int rf::ButterworthLowpassFilterPlugin::GetOrder() const
@@ -75,7 +78,7 @@ void rf::ButterworthLowpassFilterPlugin::SetCutoff(float cutoff)
     SetButterworthLowpassFilterDSPCutoffCommand& data = EncodeAudioCommand<SetButterworthLowpassFilterDSPCutoffCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_cutoff = m_cutoff;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::ButterworthLowpassFilterPlugin::GetCutoff() const
@@ -22,7 +22,14 @@
 
 #include "commandprocessor.h"
 
-#include "defines.h"
+#include <algorithm>
+
+#include "assert.h"
+#include "audiotimeline.h"
+#include "realtimechecks.h"
+
+// Marks a command added by Flush. Add only ever stamps -1 or a playhead of 0 or more.
+static constexpr long long k_flushPlayhead = -2;
 
 rf::CommandProcessor::CommandProcessor()
     : m_audioCommands(RF_MAX_AUDIO_COMMANDS)
@@ -31,14 +38,112 @@ rf::CommandProcessor::CommandProcessor()
 
 void rf::CommandProcessor::Add(const AudioCommand& cmd)
 {
-    m_audioCommands.enqueue(cmd);
+    Add(cmd, -1);
+}
+
+long long rf::CommandProcessor::Add(const AudioCommand& cmd, long long readyPlayhead)
+{
+    AudioCommand queuedCmd = cmd;
+    queuedCmd.m_playhead = std::max(m_playhead, readyPlayhead);
+
+#if RF_ENABLE_REALTIME_CHECKS
+    // try_enqueue never allocates, so failing means more than RF_MAX_AUDIO_COMMANDS are waiting for the audio thread.
+    if (!m_audioCommands.try_enqueue(queuedCmd))
+    {
+        RealtimeChecks::OnQueueGrowth();
+        m_audioCommands.enqueue(queuedCmd);
+    }
+#else
+    m_audioCommands.enqueue(queuedCmd);
+#endif
+
+    return queuedCmd.m_playhead;
+}
+
+void rf::CommandProcessor::Flush(const AudioCommand& cmd)
+{
+    AudioCommand queuedCmd = cmd;
+    queuedCmd.m_playhead = k_flushPlayhead;
+    m_audioCommands.enqueue(queuedCmd);
+}
+
+void rf::CommandProcessor::SetPlayhead(long long playhead)
+{
+    m_playhead = playhead;
 }
 
-void rf::CommandProcessor::Process(AudioTimeline* timeline)
+int rf::CommandProcessor::Process(AudioTimeline* timeline)
 {
+    int numCommands = ProcessScheduled(timeline);
+
+    const long long playhead = timeline->GetPlayhead();
     AudioCommand cmd;
     while (m_audioCommands.try_dequeue(cmd))
     {
+        if (cmd.m_playhead == k_flushPlayhead)
+        {
+            numCommands += ProcessAllScheduled(timeline);
+        }
+        else if (cmd.m_playhead > playhead && Schedule(cmd))
+        {
+            continue;
+        }
+
+        cmd.m_callback(timeline, cmd.m_data);
+        ++numCommands;
+    }
+
+    return numCommands;
+}
+
+int rf::CommandProcessor::ProcessScheduled(AudioTimeline* timeline)
+{
+    const long long playhead = timeline->GetPlayhead();
+    int numCommands = 0;
+    while (m_numScheduledCommands > 0 && m_scheduledCommands[m_numScheduledCommands - 1].m_playhead <= playhead)
+    {
+        AudioCommand& cmd = m_scheduledCommands[--m_numScheduledCommands];
+        cmd.m_callback(timeline, cmd.m_data);
+        ++numCommands;
+    }
+
+    return numCommands;
+}
+
+long long rf::CommandProcessor::GetNextPlayhead() const
+{
+    return m_numScheduledCommands > 0 ? m_scheduledCommands[m_numScheduledCommands - 1].m_playhead : -1;
+}
+
+bool rf::CommandProcessor::Schedule(const AudioCommand& cmd)
+{
+    if (m_numScheduledCommands == RF_MAX_SCHEDULED_AUDIO_COMMANDS)
+    {
+        RF_FAIL("Too many scheduled audio commands. Increase RF_MAX_SCHEDULED_AUDIO_COMMANDS");
+        return false;
+    }
+
+    // Goes in front of the commands held for the same playhead, so it runs after them.
+    int index = m_numScheduledCommands;
+    while (index > 0 && m_scheduledCommands[index - 1].m_playhead <= cmd.m_playhead)
+    {
+        m_scheduledCommands[index] = m_scheduledCommands[index - 1];
+        --index;
+    }
+
+    m_scheduledCommands[index] = cmd;
+    ++m_numScheduledCommands;
+    return true;
+}
+
+int rf::CommandProcessor::ProcessAllScheduled(AudioTimeline* timeline)
+{
+    const int numCommands = m_numScheduledCommands;
+    while (m_numScheduledCommands > 0)
+    {
+        AudioCommand& cmd = m_scheduledCommands[--m_numScheduledCommands];
         cmd.m_callback(timeline, cmd.m_data);
     }
+
+    return numCommands;
 }
\ No newline at end of file
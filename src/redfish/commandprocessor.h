@@ -24,6 +24,7 @@
 #include <external/concurrentqueue/concurrentqueue.h>
 
 #include "audiocommand.h"
+#include "defines.h"
 
 namespace rf
 {
@@ -39,9 +40,34 @@ public:
     CommandProcessor& operator=(CommandProcessor&&) = delete;
 
     void Add(const AudioCommand& cmd);
-    void Process(AudioTimeline* timeline);
+    // Game thread. Adds a command that runs no earlier than readyPlayhead, and returns the playhead it was given. A mix
+    // group, plug-in or sound effect passes the previous result back in, so none of its commands overtakes an earlier
+    // one that was scheduled further ahead.
+    long long Add(const AudioCommand& cmd, long long readyPlayhead);
+    // Game thread. Adds a command that is never scheduled. When the audio thread reaches it, every held command runs
+    // straight away, whatever its playhead, and then this one does. Used for shutdown, so nothing is left holding
+    // resources the game thread handed over.
+    void Flush(const AudioCommand& cmd);
+    // Game thread. Commands added from now on run at this playhead. -1 goes back to running them at the start of the
+    // next audio callback.
+    void SetPlayhead(long long playhead);
+    // Audio thread. Runs queued commands that are due in the order they were added, and holds the rest until their
+    // playhead. Held commands with the same playhead run in the order they were added. Returns how many commands were
+    // processed.
+    int Process(AudioTimeline* timeline);
+    // Audio thread. Runs the held commands that are due at the timeline's playhead. Returns how many were processed.
+    int ProcessScheduled(AudioTimeline* timeline);
+    // Audio thread. The playhead of the next held command, or -1 if there is none.
+    long long GetNextPlayhead() const;
 
 private:
     moodycamel::ConcurrentQueue<AudioCommand> m_audioCommands;
+    // Held commands sorted latest first, so the next one due is always at the back.
+    AudioCommand m_scheduledCommands[RF_MAX_SCHEDULED_AUDIO_COMMANDS];
+    long long m_playhead = -1;
+    int m_numScheduledCommands = 0;
+
+    bool Schedule(const AudioCommand& cmd);
+    int ProcessAllScheduled(AudioTimeline* timeline);
 };
 }  // namespace rf
\ No newline at end of file
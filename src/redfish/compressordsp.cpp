@@ -29,8 +29,11 @@
 
 rf::CompressorDSP::CompressorDSP(const AudioSpec& spec)
     : DSPBase(spec)
-    , m_fader(spec.m_bufferSize)
+    , m_detector(spec.m_bufferSize)
 {
+    m_attackCoefficient = ComputeCoefficient(10.0f);
+    m_releaseCoefficient = ComputeCoefficient(300.0f);
+    m_rmsCoefficient = ComputeCoefficient(k_rmsWindow);
 }
 
 void rf::CompressorDSP::SetThreshold(float threshold)
@@ -43,19 +46,36 @@ void rf::CompressorDSP::SetRatio(float ratio)
     m_ratio = ratio;
 }
 
+void rf::CompressorDSP::SetKnee(float knee)
+{
+    m_kneeDb = knee;
+}
+
 void rf::CompressorDSP::SetMakeUpGainAmplitude(float makeUpGainAmplitude)
 {
-    m_makeUpGainAmplitude = makeUpGainAmplitude;
+    m_makeUpGainDb = Functions::AmplitudeToDecibel(makeUpGainAmplitude);
 }
 
 void rf::CompressorDSP::SetAttack(float attack)
 {
-    m_attack = attack;
+    m_attackCoefficient = ComputeCoefficient(attack);
 }
 
 void rf::CompressorDSP::SetRelease(float release)
 {
-    m_release = release;
+    m_releaseCoefficient = ComputeCoefficient(release);
+}
+
+void rf::CompressorDSP::SetDetectRMS(bool detectRMS)
+{
+    m_detectRMS = detectRMS;
+}
+
+float rf::CompressorDSP::ComputeCoefficient(float ms) const
+{
+    // One-pole smoothing coefficient that covers 1 - 1/e of a step in the given time.
+    const float samples = ms * 0.001f * static_cast<float>(m_spec.m_sampleRate);
+    return samples > 1.0f ? expf(-1.0f / samples) : 0.0f;
 }
 
 void rf::CompressorDSP::Process(MixItem* mixItem, int bufferSize)
@@ -65,60 +85,60 @@ void rf::CompressorDSP::Process(MixItem* mixItem, int bufferSize)
         return;
     }
 
-    const int numChannels = mixItem->m_channels;
+    // The detector listens to the sidechain when there is one so another mix group can drive the gain.
+    const MixItem* key = m_sidechain ? m_sidechain : mixItem;
+    const int numKeyChannels = key->m_channels;
+    float* detector = m_detector.GetAsFloatBuffer();
 
-    float maxAmp = -1.0f;
-    for (int i = 0; i < numChannels; ++i)
+    // Linked detection: the loudest channel for peak, the mean square across channels for RMS.
+    if (m_detectRMS)
     {
-        for (int j = 0; j < bufferSize; ++j)
+        const float channelScale = 1.0f / static_cast<float>(numKeyChannels);
+        for (int i = 0; i < bufferSize; ++i)
         {
-            if (mixItem->m_arrayOfChannels[i][j] > maxAmp)
+            float sum = 0.0f;
+            for (int c = 0; c < numKeyChannels; ++c)
             {
-                maxAmp = mixItem->m_arrayOfChannels[i][j];
+                const float sample = key->m_arrayOfChannels[c][i];
+                sum += sample * sample;
             }
+            m_meanSquare = sum * channelScale + (m_meanSquare - sum * channelScale) * m_rmsCoefficient;
+            detector[i] = sqrtf(m_meanSquare);
         }
     }
-    const float mixItemDb = Functions::AmplitudeToDecibel(maxAmp);
-
-    const int attackSamples = Functions::MsToSamples(m_attack, m_spec.m_sampleRate);
-    const int releaseSamples = Functions::MsToSamples(m_release, m_spec.m_sampleRate);
-
-    if (mixItemDb > m_thresholdDb)
+    else
     {
-        m_state = State::Attack;
-
-        // Find the difference between the compressed level and the input level and use it to
-        // determine how much to turn down the input. We only support a 'hard knee'.
-        const float diff = mixItemDb - m_thresholdDb;
-        const float ratioedSignal = diff / m_ratio;
-        const float totalSignal = m_thresholdDb + ratioedSignal;
-        const float reductionDb = mixItemDb - totalSignal;
-        const float reductionAmp = Functions::DecibelToAmplitude(-reductionDb);
-        m_fader.Update(reductionAmp, 0, attackSamples);
+        key->GetLinkedPeaks(&m_detector, bufferSize);
     }
-    else
+
+    Functions::AmplitudeToDecibel(detector, detector, bufferSize);
+
+    // Log-domain gain computer with a quadratic soft knee, followed by attack/release smoothing of
+    // the gain reduction. The smoothed gain is written back over the detector as dB.
+    const float slope = 1.0f - 1.0f / m_ratio;
+    const float halfKnee = 0.5f * m_kneeDb;
+    const float kneeScale = m_kneeDb > 0.0f ? slope / (2.0f * m_kneeDb) : 0.0f;
+    for (int i = 0; i < bufferSize; ++i)
     {
-        if (m_state == State::Attack)
+        const float over = detector[i] - m_thresholdDb;
+
+        float gainReduction = 0.0f;
+        if (over >= halfKnee)
         {
-            m_state = State::Release;
-            m_fader.Update(1.0f, 0, releaseSamples);
+            gainReduction = slope * over;
         }
-        else if (m_state == State::Release)
+        else if (over > -halfKnee)
         {
-            m_state = State::Steady;
+            const float kneeOver = over + halfKnee;
+            gainReduction = kneeScale * kneeOver * kneeOver;
         }
-    }
 
-    m_fader.Process(mixItem, bufferSize);
+        const float coefficient = gainReduction > m_gainReductionDb ? m_attackCoefficient : m_releaseCoefficient;
+        m_gainReductionDb = gainReduction + (m_gainReductionDb - gainReduction) * coefficient;
+        detector[i] = m_makeUpGainDb - m_gainReductionDb;
+    }
 
-    // Apply make-up gain to the mix item.
-    Buffer* mixItemBuffer = mixItem->m_arrayOfChannels;
+    Functions::DecibelToAmplitude(detector, detector, bufferSize);
 
-    for (int i = 0; i < numChannels; ++i)
-    {
-        for (int j = 0; j < bufferSize; ++j)
-        {
-            mixItemBuffer[i][j] = mixItemBuffer[i][j] * m_makeUpGainAmplitude;
-        }
-    }
-}
\ No newline at end of file
+    mixItem->Multiply(m_detector, bufferSize);
+}
@@ -23,7 +23,6 @@
 #pragma once
 #include "buffer.h"
 #include "dspbase.h"
-#include "fader.h"
 
 namespace rf
 {
@@ -34,25 +33,28 @@ public:
 
     void SetThreshold(float threshold);
     void SetRatio(float ratio);
+    void SetKnee(float knee);
     void SetMakeUpGainAmplitude(float makeUpGainAmplitude);
     void SetAttack(float attack);
     void SetRelease(float release);
+    void SetDetectRMS(bool detectRMS);
     void Process(MixItem* mixItem, int bufferSize) override final;
 
 private:
-    enum class State
-    {
-        Steady,
-        Attack,
-        Release
-    };
-
-    State m_state = State::Steady;
-    Fader m_fader;
+    static constexpr float k_rmsWindow = 10.0f;
+
+    float ComputeCoefficient(float ms) const;
+
+    Buffer m_detector;
     float m_thresholdDb = -24.0f;
     float m_ratio = 1.0f;
-    float m_makeUpGainAmplitude = 1.0f;
-    float m_attack = 10.0f;
-    float m_release = 300.0f;
+    float m_kneeDb = 0.0f;
+    float m_makeUpGainDb = 0.0f;
+    float m_attackCoefficient = 0.0f;
+    float m_releaseCoefficient = 0.0f;
+    float m_rmsCoefficient = 0.0f;
+    float m_meanSquare = 0.0f;
+    float m_gainReductionDb = 0.0f;
+    bool m_detectRMS = false;
 };
-}  // namespace rf
\ No newline at end of file
+}  // namespace rf
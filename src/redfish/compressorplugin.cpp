@@ -22,16 +22,21 @@
 
 #include "compressorplugin.h"
 
+#include "allocator.h"
 #include "commandprocessor.h"
+#include "compressordsp.h"
+#include "context.h"
 #include "defines.h"
 #include "functions.h"
+#include "mixersystem.h"
+#include "mixgroup.h"
 #include "plugincommands.h"
 #include "pluginutils.h"
 
 rf::CompressorPlugin::CompressorPlugin(Context* context, CommandProcessor* commands, MixGroupHandle mixGroupHandle, int mixGroupSlot, int pluginIndex)
     : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::Compressor)
 {
-    RF_SEND_PLUGIN_CREATE_COMMAND(CreateCompressorDSPCommand);
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreateCompressorDSPCommand, CompressorDSP);
 }
 
 rf::CompressorPlugin::~CompressorPlugin()
@@ -52,7 +57,7 @@ void rf::CompressorPlugin::SetThreshold(float threshold)
     SetCompressorDSPThresholdCommand& data = EncodeAudioCommand<SetCompressorDSPThresholdCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_threshold = m_threshold;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::CompressorPlugin::GetThreshold() const
@@ -73,7 +78,7 @@ void rf::CompressorPlugin::SetRatio(float ratio)
     SetCompressorDSPRatioCommand& data = EncodeAudioCommand<SetCompressorDSPRatioCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_ratio = m_ratio;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::CompressorPlugin::GetRatio() const
@@ -94,7 +99,7 @@ void rf::CompressorPlugin::SetMakeUpGainDb(float makeUpGainDb)
     SetCompressorDSPMakeUpGainAmplitudeCommand& data = EncodeAudioCommand<SetCompressorDSPMakeUpGainAmplitudeCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_amplitude = Functions::DecibelToAmplitude(m_makeUpGainDb);
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::CompressorPlugin::GetMakeUpGainDb() const
@@ -115,7 +120,7 @@ void rf::CompressorPlugin::SetAttack(float attack)
     SetCompressorDSPAttackCommand& data = EncodeAudioCommand<SetCompressorDSPAttackCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_attack = m_attack;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::CompressorPlugin::GetAttack() const
@@ -136,7 +141,7 @@ void rf::CompressorPlugin::SetRelease(float release)
     SetCompressorDSPReleaseCommand& data = EncodeAudioCommand<SetCompressorDSPReleaseCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_release = m_release;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::CompressorPlugin::GetRelease() const
@@ -144,6 +149,58 @@ float rf::CompressorPlugin::GetRelease() const
     return m_release;
 }
 
+void rf::CompressorPlugin::SetKnee(float knee)
+{
+    if (Functions::FloatEquality(m_knee, knee))
+    {
+        return;
+    }
+
+    m_knee = Functions::Clamp(knee, 0.0f, 24.0f);
+
+    AudioCommand cmd;
+    SetCompressorDSPKneeCommand& data = EncodeAudioCommand<SetCompressorDSPKneeCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_knee = m_knee;
+    AddCommand(cmd);
+}
+
+float rf::CompressorPlugin::GetKnee() const
+{
+    return m_knee;
+}
+
+void rf::CompressorPlugin::SetDetectRMS(bool detectRMS)
+{
+    if (m_detectRMS == detectRMS)
+    {
+        return;
+    }
+
+    m_detectRMS = detectRMS;
+
+    AudioCommand cmd;
+    SetCompressorDSPDetectRMSCommand& data = EncodeAudioCommand<SetCompressorDSPDetectRMSCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_detectRMS = m_detectRMS;
+    AddCommand(cmd);
+}
+
+bool rf::CompressorPlugin::GetDetectRMS() const
+{
+    return m_detectRMS;
+}
+
+void rf::CompressorPlugin::SetSidechain(const MixGroup* mixGroup)
+{
+    SetSidechainMixGroupHandle(mixGroup ? mixGroup->GetMixGroupHandle() : MixGroupHandle());
+}
+
+rf::MixGroup* rf::CompressorPlugin::GetSidechain() const
+{
+    return m_sidechainMixGroupHandle ? m_context->GetMixerSystem()->GetMixGroup(m_sidechainMixGroupHandle) : nullptr;
+}
+
 void rf::CompressorPlugin::ToJson(nlohmann::ordered_json& json) const
 {
     json["threshold"] = GetThreshold();
@@ -151,6 +208,11 @@ void rf::CompressorPlugin::ToJson(nlohmann::ordered_json& json) const
     json["makeUpGainDb"] = GetMakeUpGainDb();
     json["attack"] = GetAttack();
     json["release"] = GetRelease();
+    json["knee"] = GetKnee();
+    json["detectRMS"] = GetDetectRMS();
+
+    const MixGroup* sidechain = GetSidechain();
+    json["sidechain"] = sidechain ? sidechain->GetName() : "";
 }
 
 void rf::CompressorPlugin::FromJson(const nlohmann::ordered_json& json)
@@ -160,4 +222,9 @@ void rf::CompressorPlugin::FromJson(const nlohmann::ordered_json& json)
     SetMakeUpGainDb(json.value("makeUpGainDb", GetMakeUpGainDb()));
     SetAttack(json.value("attack", GetAttack()));
     SetRelease(json.value("release", GetRelease()));
+    SetKnee(json.value("knee", GetKnee()));
+    SetDetectRMS(json.value("detectRMS", GetDetectRMS()));
+
+    const std::string sidechain = json.value("sidechain", std::string());
+    SetSidechain(sidechain.empty() ? nullptr : m_context->GetMixerSystem()->GetMixGroup(sidechain.c_str()));
 }
\ No newline at end of file
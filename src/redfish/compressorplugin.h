@@ -26,6 +26,8 @@
 
 namespace rf
 {
+class MixGroup;
+
 class CompressorPlugin : public PluginBase
 {
 public:
@@ -46,6 +48,12 @@ public:
     float GetAttack() const;
     void SetRelease(float release);
     float GetRelease() const;
+    void SetKnee(float knee);
+    float GetKnee() const;
+    void SetDetectRMS(bool detectRMS);
+    bool GetDetectRMS() const;
+    void SetSidechain(const MixGroup* mixGroup);
+    MixGroup* GetSidechain() const;
 
     void ToJson(nlohmann::ordered_json& json) const override;
     void FromJson(const nlohmann::ordered_json& json) override;
@@ -56,5 +64,7 @@ private:
     float m_makeUpGainDb = 0.0f;
     float m_attack = 10.0f;
     float m_release = 300.0f;
+    float m_knee = 0.0f;
+    bool m_detectRMS = false;
 };
 }  // namespace rf
\ No newline at end of file
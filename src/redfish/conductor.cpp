@@ -36,9 +36,9 @@ rf::Conductor::Conductor(MusicDatabase* musicDatabase, const AudioSpec& spec, Me
 {
 }
 
-void rf::Conductor::Update(long long playhead, const MusicTransitionRequest& currentRequest, bool isPlaying)
+void rf::Conductor::Update(long long playhead, int bufferSize, const MusicTransitionRequest& currentRequest, bool isPlaying)
 {
-    m_metronome.Update(playhead, currentRequest, isPlaying);
+    m_metronome.Update(playhead, bufferSize, currentRequest, isPlaying);
 }
 
 void rf::Conductor::Reset()
@@ -62,7 +62,7 @@ rf::MusicTransitionRequest rf::Conductor::CreateRequest(int transitionIndex, lon
     {
         RF_ASSERT(Functions::FloatEquality(-1.0f, m_metronome.GetTempo()), "Expected -1.0f tempo");
         RF_ASSERT(m_metronome.GetMeter() == Meter(), "Expected null metre");
-        m_metronome.Set(cueData.m_tempo, cueData.m_meter);
+        m_metronome.SetCue(transitionData.m_cueIndex);
     }
 
     RF_ASSERT(cueData.m_numLayers > 0, "Expected cue to have layers");
@@ -98,7 +98,7 @@ rf::MusicTransitionRequest rf::Conductor::CreateRequest(int transitionIndex, lon
                 // stinger. We need to extend transitionStartTime. transitionStartTime is created by
                 // CalculateStartTime() which does math with m_metronome's data. Therefore, when we extend it, we want
                 // to use m_metronome's data to create the correct extension.
-                extension = Metronome::GetSyncSamples(m_spec, transitionData.m_sync, m_metronome.GetTempo(), m_metronome.GetMeter());
+                extension = m_metronome.GetSyncSamples(transitionData.m_sync);
             }
 
             // While the stinger does not fit, we increment by the extension.
@@ -153,12 +153,13 @@ long long rf::Conductor::CalculateStartTime(const Sync& sync, long long playhead
                         return playhead;
                     }
 
-                    const long long syncValue = static_cast<long long>(m_metronome.PreciseBeatSwitch(sync));
+                    const TempoMap& tempoMap = m_metronome.GetTempoMap();
+                    const long long cueStartTime = m_lastCreatedRequest.m_startTime;
 
                     // Calculate the start transition wrt the start of the cue.
                     if (sync.m_referencePoint == Sync::ReferencePoint::CueStart)
                     {
-                        startTime = m_lastCreatedRequest.m_startTime + syncValue;
+                        startTime = cueStartTime + tempoMap.GetSyncSamples(sync, 0);
 
                         // startTime needs to be >= playhead
                         if (startTime >= playhead)
@@ -176,31 +177,7 @@ long long rf::Conductor::CalculateStartTime(const Sync& sync, long long playhead
                     // If we are past '7/8' in the current measure, we will get '7/8' in the next measure.
 
                     const int numFullBarsPlayed = m_metronome.GetBarCounter() - 1;
-                    const long long barValue = static_cast<long long>(m_metronome.PreciseBeatSwitch(Sync(Sync::Value::Bar)));
-                    const long long currentMeasureStartTime = m_lastCreatedRequest.m_startTime + (numFullBarsPlayed * barValue);
-                    startTime = -1;
-
-                    long long referencePoint = currentMeasureStartTime;
-                    long long nextMeasure = currentMeasureStartTime + barValue;
-                    int counter = 0;
-
-                    while (startTime < playhead)
-                    {
-                        RF_ASSERT(
-                            counter < 1000,
-                            "Expected to find a transition in less than 1000 iterations. Did we forget to call UpdateLastCreatedRequest somewhere?");
-
-                        startTime = referencePoint + syncValue;
-
-                        referencePoint += syncValue;
-                        if (referencePoint >= nextMeasure)
-                        {
-                            referencePoint = nextMeasure;
-                            nextMeasure += barValue;
-                        }
-
-                        ++counter;
-                    }
+                    startTime = cueStartTime + tempoMap.GetNextSyncPoint(sync, numFullBarsPlayed, playhead - cueStartTime);
                 }
             }
             return startTime;
@@ -215,7 +192,7 @@ long long rf::Conductor::CalculateStartTime(const Sync& sync, long long playhead
 
 int rf::Conductor::GetSyncSamples(const Sync& sync) const
 {
-    return Metronome::GetSyncSamples(m_spec, sync, m_metronome.GetTempo(), m_metronome.GetMeter());
+    return m_metronome.GetSyncSamples(sync);
 }
 
 void rf::Conductor::UpdateLastCreatedRequest(const MusicTransitionRequest& request)
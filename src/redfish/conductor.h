@@ -42,7 +42,7 @@ public:
     Conductor& operator=(Conductor&&) = delete;
     ~Conductor() = default;
 
-    void Update(long long playhead, const MusicTransitionRequest& currentRequest, bool isPlaying);
+    void Update(long long playhead, int bufferSize, const MusicTransitionRequest& currentRequest, bool isPlaying);
     void Reset();
     MusicTransitionRequest CreateRequest(int transitionIndex, long long playhead, bool isPlaying, const AudioData** audioData);
     long long CalculateStartTime(const Sync& sync, long long playhead, bool isPlaying) const;
@@ -22,6 +22,7 @@
 
 #pragma once
 #include "allocator.h"
+#include "musicconfig.h"
 
 namespace rf
 {
@@ -30,8 +31,26 @@ struct Config
     int m_sampleRate = 44100;
     int m_bufferSize = 1024;
     int m_channels = 2;
+    // Number of frames rendered at a time, independent of how many frames the audio device asks for. Fades, panning and
+    // filter parameters update once per block, and DSP buffers and convolution partitions are sized to it. 0 renders in
+    // blocks of m_bufferSize.
+    int m_blockSize = 0;
     AllocateCallback m_onAllocate = nullptr;
     DeallocateCallback m_onDeallocate = nullptr;
+    // Size in bytes of the arena that holds everything allocated while the Context is constructed. 0 disables the
+    // arena. The AllocatorReport shows how much of it was used.
+    size_t m_arenaSize = 0;
+    // Fixed-size block pools for allocations made after construction, such as plug-ins and DSPs. Copied when the Context
+    // is constructed.
+    const AllocatorPool* m_pools = nullptr;
+    int m_numPools = 0;
+    // Per-tag memory budgets. Going over a budget asserts and is flagged in the AllocatorReport.
+    const AllocatorBudget* m_budgets = nullptr;
+    int m_numBudgets = 0;
+    // Called when the Context is destroyed, with the peak memory used by every tag.
+    void (*m_onAllocatorReport)(const AllocatorReport& report) = nullptr;
+    // Capacities of the music system.
+    MusicConfig m_music;
     void (*m_lockAudioDevice)() = nullptr;
     void (*m_unlockAudioDevice)() = nullptr;
 
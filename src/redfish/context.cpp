@@ -30,30 +30,51 @@
 #include "audiodata.h"
 #include "audiotimeline.h"
 #include "eventsystem.h"
+#include "hrtf.h"
+#include "irlibrary.h"
 #include "loadcommands.h"
 #include "mixersystem.h"
 #include "musicsystem.h"
+#include "spatialsystem.h"
+#include "tracecapture.h"
+#include "vbapdsp.h"
 #include "version.h"
 
 rf::Context::Context(const Config& config)
-    : m_spec {config.m_bufferSize, config.m_sampleRate, config.m_channels}
+    : m_spec {config.m_blockSize > 0 ? config.m_blockSize : config.m_bufferSize, config.m_sampleRate, config.m_channels}
     , m_config(config)
+    , m_playingSounds(PlayingSoundSet::GetMaxPlayingSounds(config.m_music))
 {
+    RF_ASSERT(VBAPDSP::IsLayoutSupported(config.m_channels), "RedFish supports 2 (stereo), 6 (5.1) and 8 (7.1) channel outputs.");
     Allocator::SetCallbacks(config.m_onAllocate, config.m_onDeallocate);
-    m_timeline = Allocator::Allocate<AudioTimeline>("AudioTimeline", m_config.m_channels, m_config.m_bufferSize, m_config.m_sampleRate);
-    m_assetSystem = Allocator::Allocate<AssetSystem>("AssetSystem", &m_commandProcessor);
+    Allocator::SetBudgets(config.m_budgets, config.m_numBudgets);
+    Allocator::CreatePools(config.m_pools, config.m_numPools);
+    Allocator::BeginArena(config.m_arenaSize);
+    m_timeline = Allocator::Allocate<AudioTimeline>("AudioTimeline", m_spec.m_channels, m_spec.m_bufferSize, m_spec.m_sampleRate, config.m_music);
+    m_assetSystem = Allocator::Allocate<AssetSystem>("AssetSystem", &m_commandProcessor, config.m_music.m_streamPrefetchSeconds, config.m_music.m_streamBufferSeconds);
+    m_irLibrary = Allocator::Allocate<IRLibrary>("IRLibrary", m_spec, &m_commandProcessor);
     m_mixerSystem = Allocator::Allocate<MixerSystem>("MixerSystem", this, &m_commandProcessor);
     m_mixerSystem->CreateMasterMixGroup();
-    m_musicSystem = Allocator::Allocate<MusicSystem>("MusicSystem", &m_commandProcessor, m_assetSystem);
+    m_musicSystem = Allocator::Allocate<MusicSystem>("MusicSystem", &m_commandProcessor, m_assetSystem, config.m_music);
     m_eventSystem = Allocator::Allocate<EventSystem>("EventSystem", &m_commandProcessor);
-    m_playingSoundInfo.reserve(RF_MAX_VOICES);
+    m_transformTable = Allocator::Allocate<TransformTable>("TransformTable");
+    m_spatialSystem = Allocator::Allocate<SpatialSystem>("SpatialSystem", m_transformTable);
+    // The audio callback has not been set yet, so the audio thread can't be reading the voice set.
+    m_timeline->m_voiceSet.SetTransformTable(m_transformTable);
+    CreateMessageRoutes();
+#if RF_ENABLE_TRACE_CAPTURE
+    TraceCapture::Create();
+#endif
+    Allocator::EndArena();
 }
 
 rf::Context::~Context()
 {
     AudioCommand cmd;
     ShutdownCommand& data = EncodeAudioCommand<ShutdownCommand>(&cmd);
-    m_commandProcessor.Add(cmd);
+    // Not scheduled, even inside BeginScheduledCommands, and runs every held command first so the DSPs and buffers
+    // they carry end up owned by the audio thread and are freed with it.
+    m_commandProcessor.Flush(cmd);
 
     bool waitForShutdown = true;
     while (waitForShutdown)
@@ -66,6 +87,12 @@ rf::Context::~Context()
                 waitForShutdown = false;
                 break;
             }
+
+            // DSPs the audio thread has already let go of are no longer owned by the summing mixer.
+            if (msg.m_type == MessageType::DSPDestroy || msg.m_type == MessageType::ConvolverChannelsDestroy)
+            {
+                m_mixerSystem->ProcessMessages(msg);
+            }
         }
     }
 
@@ -76,74 +103,34 @@ rf::Context::~Context()
     Allocator::Deallocate<MixerSystem>(&m_mixerSystem);
     Allocator::Deallocate<MusicSystem>(&m_musicSystem);
     Allocator::Deallocate<EventSystem>(&m_eventSystem);
+    Allocator::Deallocate<IRLibrary>(&m_irLibrary);
+    Allocator::Deallocate<HRTF>(&m_hrtf);
+    Allocator::Deallocate<SpatialSystem>(&m_spatialSystem);
+    Allocator::Deallocate<TransformTable>(&m_transformTable);
     m_timeline = nullptr;
     m_config.m_unlockAudioDevice();
-}
+#if RF_ENABLE_TRACE_CAPTURE
+    TraceCapture::Release();
+#endif
 
-void rf::Context::Update()
-{
-    Message msg;
-    while (m_timeline->m_messenger.Dequeue(msg))
+    if (m_config.m_onAllocatorReport)
     {
-        bool processed = false;
-
-        if (m_assetSystem->ProcessMessages(msg))
-        {
-            processed = true;
-        }
-
-        if (m_mixerSystem->ProcessMessages(msg))
-        {
-            processed = true;
-        }
+        AllocatorReport report;
+        Allocator::GetReport(&report);
+        m_config.m_onAllocatorReport(report);
+    }
 
-        if (m_musicSystem->ProcessMessages(msg))
-        {
-            processed = true;
-        }
+    Allocator::ReleasePools();
+    Allocator::ReleaseArena();
+}
 
-        if (!processed)
-        {
-            switch (msg.m_type)
-            {
-                case MessageType::ContextVoiceStart:
-                {
-                    const Message::ContextVoiceStartData& data = *msg.GetContextVoiceStartData();
-                    const AudioData* audioData = m_assetSystem->GetAudioData(data.m_audioHandle);
-                    m_playingSoundInfo.push_back({audioData->m_name, data.m_audioHandle});
-                    break;
-                }
-                case MessageType::ContextVoiceStop:
-                {
-                    const Message::ContextVoiceStopData& data = *msg.GetContextVoiceStopData();
-                    const int size = static_cast<int>(m_playingSoundInfo.size());
-
-                    bool found = false;
-                    for (int i = 0; i < size; ++i)
-                    {
-                        if (m_playingSoundInfo[i].m_audioHandle == data.m_audioHandle)
-                        {
-                            m_playingSoundInfo.erase(m_playingSoundInfo.begin() + i);
-                            found = true;
-                            break;
-                        }
-                    }
-
-                    RF_ASSERT(found, "We are trying to remove a sound that we have not played.");
-                    break;
-                }
-                case MessageType::ContextNumVoices:
-                {
-                    const Message::ContextNumVoicesData& data = *msg.GetContextNumVoicesData();
-                    m_numPlayingVoices = data.m_numVoices;
-                    break;
-                }
-                default: RF_FAIL("Message type not supported."); break;
-            }
-        }
+void rf::Context::Update()
+{
+    RF_TRACE_SCOPE("Context::Update");
+    m_spatialSystem->Update();
+    m_timeline->m_metering.Acquire();
 
-        m_eventSystem->ProcessMessages(msg);
-    }
+    ProcessMessages();
 }
 
 rf::AssetSystem* rf::Context::GetAssetSystem()
@@ -166,23 +153,143 @@ rf::EventSystem* rf::Context::GetEventSystem()
     return m_eventSystem;
 }
 
+rf::IRLibrary* rf::Context::GetIRLibrary()
+{
+    return m_irLibrary;
+}
+
+rf::SpatialSystem* rf::Context::GetSpatialSystem()
+{
+    return m_spatialSystem;
+}
+
 const rf::AudioSpec& rf::Context::GetAudioSpec() const
 {
     return m_spec;
 }
 
+bool rf::Context::LoadHRTF(const char* path)
+{
+    RF_TRACE_SCOPE("Context::LoadHRTF");
+    // The audio thread reads the HRTF without locking, so it can only be loaded once.
+    if (m_hrtf)
+    {
+        RF_FAIL("An HRTF is already loaded.");
+        return false;
+    }
+
+    HRTF* hrtf = Allocator::Allocate<HRTF>("HRTF", m_spec);
+    if (!hrtf->Load(path))
+    {
+        Allocator::Deallocate<HRTF>(&hrtf);
+        return false;
+    }
+
+    m_hrtf = hrtf;
+
+    AudioCommand cmd;
+    LoadHRTFCommand& data = EncodeAudioCommand<LoadHRTFCommand>(&cmd);
+    data.m_hrtf = m_hrtf;
+    m_commandProcessor.Add(cmd);
+    return true;
+}
+
 int rf::Context::GetNumPlayingVoices() const
 {
     return m_numPlayingVoices;
 }
 
+long long rf::Context::GetPlayhead() const
+{
+    return m_playhead;
+}
+
+void rf::Context::BeginScheduledCommands(long long playhead)
+{
+    RF_ASSERT(playhead >= 0, "Expected a playhead of 0 or more");
+    m_commandProcessor.SetPlayhead(playhead);
+}
+
+void rf::Context::EndScheduledCommands()
+{
+    m_commandProcessor.SetPlayhead(-1);
+}
+
 const std::vector<rf::PlayingSoundInfo>& rf::Context::GetPlayingSoundInfo() const
 {
-    return m_playingSoundInfo;
+    return m_playingSounds.GetPlayingSounds();
+}
+
+int rf::Context::GetNumPlayingSounds(AudioHandle audioHandle) const
+{
+    return m_playingSounds.GetNumPlaying(m_assetSystem->GetAudioDataIndex(audioHandle));
+}
+
+void rf::Context::GetRealtimeReport(RealtimeReport* outReport) const
+{
+    RealtimeChecks::GetReport(outReport);
+}
+
+void rf::Context::ResetRealtimeReport()
+{
+    RealtimeChecks::Reset();
+}
+
+float rf::Context::GetCpuPercent(Profiler::Stage stage) const
+{
+    return m_cpuPercent[static_cast<int>(stage)];
+}
+
+const rf::MixGroupMeter* rf::Context::GetMixGroupMeter(MixGroupHandle mixGroupHandle) const
+{
+    return m_timeline->m_metering.GetMeter(mixGroupHandle, m_mixerSystem->GetMixGroupIndex(mixGroupHandle));
+}
+
+void rf::Context::StartTraceCapture()
+{
+#if RF_ENABLE_TRACE_CAPTURE
+    if (m_isCapturingTrace || !m_tracePath.empty())
+    {
+        RF_FAIL("A trace capture is already running or being written.");
+        return;
+    }
+
+    m_isCapturingTrace = true;
+    TraceCapture::BeginGameCapture();
+
+    AudioCommand cmd;
+    EncodeAudioCommand<StartTraceCaptureCommand>(&cmd);
+    m_commandProcessor.Add(cmd);
+#else
+    RF_FAIL("Trace capture requires RF_ENABLE_TRACE_CAPTURE.");
+#endif
+}
+
+void rf::Context::StopTraceCapture(const char* path)
+{
+#if RF_ENABLE_TRACE_CAPTURE
+    if (!m_isCapturingTrace)
+    {
+        RF_FAIL("No trace capture is running.");
+        return;
+    }
+
+    m_isCapturingTrace = false;
+    m_tracePath = path;
+    TraceCapture::EndGameCapture();
+
+    AudioCommand cmd;
+    EncodeAudioCommand<StopTraceCaptureCommand>(&cmd);
+    m_commandProcessor.Add(cmd);
+#else
+    (void)path;
+    RF_FAIL("Trace capture requires RF_ENABLE_TRACE_CAPTURE.");
+#endif
 }
 
 void rf::Context::Serialize() const
 {
+    RF_TRACE_SCOPE("Context::Serialize");
     const Version& version = GetVersion();
 
     nlohmann::ordered_json json;
@@ -200,6 +307,7 @@ void rf::Context::Serialize() const
 
 void rf::Context::Deserialize(const char* path)
 {
+    RF_TRACE_SCOPE("Context::Deserialize");
     std::ifstream ifs(path);
     nlohmann::ordered_json json = nlohmann::json::parse(ifs);
 
@@ -217,12 +325,137 @@ void rf::Context::Deserialize(const char* path)
     }
 }
 
+void rf::Context::CreateMessageRoutes()
+{
+    const auto Route = [this](MessageType type, MessageHandler handler, bool coalesce = false) {
+        MessageRoute& route = m_messageRoutes[static_cast<int>(type)];
+        route.m_handler = handler;
+        route.m_coalesce = coalesce;
+    };
+
+    // The systems are looked up through the context, since deserializing replaces the mixer system.
+    const MessageHandler assetSystem = [](Context* context, const Message& message) { context->m_assetSystem->ProcessMessages(message); };
+    const MessageHandler irLibrary = [](Context* context, const Message& message) { context->m_irLibrary->ProcessMessages(message); };
+    const MessageHandler mixerSystem = [](Context* context, const Message& message) { context->m_mixerSystem->ProcessMessages(message); };
+    const MessageHandler musicSystem = [](Context* context, const Message& message) { context->m_musicSystem->ProcessMessages(message); };
+    const MessageHandler musicSystemAndEvents = [](Context* context, const Message& message) {
+        context->m_musicSystem->ProcessMessages(message);
+        context->m_eventSystem->ProcessMessages(message);
+    };
+
+    Route(MessageType::AssetDelete, assetSystem);
+    Route(MessageType::ImpulseResponseDelete, irLibrary);
+    Route(MessageType::ConvolverChannelsDestroy, mixerSystem);
+    Route(MessageType::DSPDestroy, mixerSystem);
+    Route(MessageType::MixGroupFadeComplete, mixerSystem);
+    Route(MessageType::ProfilerMixGroup, mixerSystem);
+    Route(MessageType::MusicBarChanged, musicSystemAndEvents);
+    Route(MessageType::MusicBeatChanged, musicSystemAndEvents);
+    Route(MessageType::MusicFinished, musicSystemAndEvents);
+    Route(MessageType::MusicCurrentBar, musicSystem, true);
+    Route(MessageType::MusicCurrentBeat, musicSystem, true);
+    Route(MessageType::MusicDestroyCue, musicSystem);
+    Route(MessageType::MusicDestroyStinger, musicSystem);
+    Route(MessageType::MusicDestroyTransition, musicSystem);
+    Route(MessageType::MusicMeter, musicSystem, true);
+    Route(MessageType::MusicStreamMiss, musicSystem);
+    Route(MessageType::MusicStreamPrefetch, assetSystem);
+    Route(MessageType::MusicStreamRelease, assetSystem);
+    Route(MessageType::MusicStreamStart, musicSystem);
+    Route(MessageType::MusicStreamUnderrun, musicSystem);
+    Route(MessageType::MusicTempo, musicSystem, true);
+    Route(MessageType::MusicTransitioned, musicSystem);
+
+    Route(MessageType::ContextVoiceStart, [](Context* context, const Message& message) {
+        const Message::ContextVoiceStartData& data = *message.GetContextVoiceStartData();
+        const AudioData* audioData = context->m_assetSystem->GetAudioData(data.m_audioDataIndex);
+        const AudioHandle audioHandle = context->m_assetSystem->GetAudioHandle(data.m_audioDataIndex);
+        context->m_playingSounds.Add(data.m_playingSoundId, data.m_audioDataIndex, {audioData->m_name, audioHandle});
+    });
+
+    Route(MessageType::ContextVoiceStop, [](Context* context, const Message& message) {
+        context->m_playingSounds.Remove(message.GetContextVoiceStopData()->m_playingSoundId);
+    });
+
+    Route(
+        MessageType::ContextNumVoices,
+        [](Context* context, const Message& message) { context->m_numPlayingVoices = message.GetContextNumVoicesData()->m_numVoices; },
+        true);
+
+    Route(
+        MessageType::ContextPlayhead,
+        [](Context* context, const Message& message) { context->m_playhead = message.GetContextPlayheadData()->m_playhead; },
+        true);
+
+    Route(MessageType::ProfilerStage, [](Context* context, const Message& message) {
+        const Message::ProfilerStageData& data = *message.GetProfilerStageData();
+        context->m_cpuPercent[data.m_stage] = data.m_cpuPercent;
+    });
+
+#if RF_ENABLE_TRACE_CAPTURE
+    Route(MessageType::TraceCaptureComplete, [](Context* context, const Message&) {
+        const bool written = TraceCapture::Write(context->m_tracePath.c_str());
+        RF_ASSERT(written, "Could not write the trace capture.");
+        context->m_tracePath.clear();
+    });
+#endif
+}
+
+void rf::Context::ProcessMessages()
+{
+    Message messages[k_messageBatchSize];
+    int numMessages = 0;
+    while ((numMessages = m_timeline->m_messenger.DequeueBulk(messages, k_messageBatchSize)) > 0)
+    {
+        // Find the newest message of each coalesced type, the ones before it are already out of date.
+        int newestIndex[k_numMessageTypes];
+        for (int i = 0; i < numMessages; ++i)
+        {
+            newestIndex[static_cast<int>(messages[i].m_type)] = i;
+        }
+
+        for (int i = 0; i < numMessages; ++i)
+        {
+            const Message& message = messages[i];
+            const MessageRoute& route = m_messageRoutes[static_cast<int>(message.m_type)];
+            if (!route.m_handler)
+            {
+                RF_FAIL("Message type not supported.");
+                continue;
+            }
+
+            if (route.m_coalesce && newestIndex[static_cast<int>(message.m_type)] != i)
+            {
+                continue;
+            }
+
+            route.m_handler(this, message);
+        }
+    }
+}
+
 void rf::Context::OnAudioCallback(float* buffer, int size)
 {
     if (m_timeline)
     {
-        m_commandProcessor.Process(m_timeline);
-        m_timeline->Process(buffer, size);
+#if RF_ENABLE_REALTIME_CHECKS
+        RealtimeChecks::BeginCallback();
+#endif
+        m_timeline->m_profiler.BeginCallback();
+        int numCommands = 0;
+        {
+            ProfilerScope scope(&m_timeline->m_profiler, Profiler::Stage::Commands);
+            numCommands = m_commandProcessor.Process(m_timeline);
+        }
+        numCommands += m_timeline->Process(buffer, size, &m_commandProcessor);
+        m_timeline->m_profiler.EndCallback(size, &m_timeline->m_messenger);
+#if RF_ENABLE_TRACE_CAPTURE
+        TraceCapture::EndCallback(m_timeline->m_voiceSet.GetNumVoices(), numCommands, m_timeline->m_messenger.GetNumMessages());
+#endif
+#if RF_ENABLE_REALTIME_CHECKS
+        const float deadlineMs = 1000.0f * static_cast<float>(size) / static_cast<float>(m_spec.m_sampleRate);
+        RealtimeChecks::EndCallback(deadlineMs);
+#endif
     }
 }
 
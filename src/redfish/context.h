@@ -21,12 +21,17 @@
 // SOFTWARE.
 
 #pragma once
+#include <string>
 #include <vector>
 
 #include "audiospec.h"
 #include "commandprocessor.h"
 #include "config.h"
-#include "playingsoundinfo.h"
+#include "defines.h"
+#include "message.h"
+#include "playingsoundset.h"
+#include "profiler.h"
+#include "realtimechecks.h"
 
 namespace rf
 {
@@ -34,9 +39,14 @@ class AssetSystem;
 class AudioCallback;
 class AudioTimeline;
 class EventSystem;
+class HRTF;
+class IRLibrary;
 class MixerSystem;
 class MusicSystem;
+class SpatialSystem;
+class TransformTable;
 struct AudioData;
+struct MixGroupMeter;
 
 class Context
 {
@@ -53,25 +63,78 @@ public:
     MixerSystem* GetMixerSystem();
     MusicSystem* GetMusicSystem();
     EventSystem* GetEventSystem();
+    IRLibrary* GetIRLibrary();
+    SpatialSystem* GetSpatialSystem();
     const AudioSpec& GetAudioSpec() const;
+    bool LoadHRTF(const char* path);
     int GetNumPlayingVoices() const;
+    // The audio thread's playhead, in frames, as of the last audio callback before Update.
+    long long GetPlayhead() const;
+    // Every audio command sent until EndScheduledCommands, from playing sounds to setting plug-in parameters, runs
+    // when the audio thread reaches playhead, on that exact frame, instead of at the start of the next audio
+    // callback. A playhead the audio thread has already passed runs the commands right away. Later commands for the
+    // same mix group, plug-in, send or sound effect wait for a scheduled one; anything else runs as usual. Schedule
+    // far enough past GetPlayhead to cover the time until the next audio callback.
+    void BeginScheduledCommands(long long playhead);
+    void EndScheduledCommands();
     const std::vector<PlayingSoundInfo>& GetPlayingSoundInfo() const;
+    // How many voices are playing a loaded asset, counting every layer and variation that uses it.
+    int GetNumPlayingSounds(AudioHandle audioHandle) const;
+    // Everything the audio thread has done that is not realtime safe since the last reset. Empty unless
+    // RF_ENABLE_REALTIME_CHECKS is enabled.
+    void GetRealtimeReport(RealtimeReport* outReport) const;
+    void ResetRealtimeReport();
+    // Share of the audio callback's time budget a stage used, averaged over RF_PROFILER_PUBLISH_INTERVAL_MS.
+    float GetCpuPercent(Profiler::Stage stage) const;
+    // The levels of a mix group as of the last audio callback before Update. Null until the audio thread has mixed it.
+    const MixGroupMeter* GetMixGroupMeter(MixGroupHandle mixGroupHandle) const;
+    // Records every audio callback and RF_TRACE_SCOPE on the game thread until StopTraceCapture, which writes them to
+    // path as Chrome trace JSON once the audio thread has stopped recording. Requires RF_ENABLE_TRACE_CAPTURE.
+    void StartTraceCapture();
+    void StopTraceCapture(const char* path);
     void Serialize() const;
     void Deserialize(const char* path);
 
 private:
+    using MessageHandler = void (*)(Context* context, const Message& message);
+
+    // Where each message type goes. Coalesced messages only report state, so only the newest one of its type in a
+    // batch is handled.
+    struct MessageRoute
+    {
+        MessageHandler m_handler = nullptr;
+        bool m_coalesce = false;
+    };
+
+    static constexpr int k_messageBatchSize = 64;
+
     AudioSpec m_spec;
     Config m_config;
     CommandProcessor m_commandProcessor;
-    std::vector<PlayingSoundInfo> m_playingSoundInfo;
+    PlayingSoundSet m_playingSounds;
+#if RF_ENABLE_TRACE_CAPTURE
+    std::string m_tracePath;
+#endif
     AudioTimeline* m_timeline = nullptr;
     AssetSystem* m_assetSystem = nullptr;
     MixerSystem* m_mixerSystem = nullptr;
     MusicSystem* m_musicSystem = nullptr;
     EventSystem* m_eventSystem = nullptr;
+    IRLibrary* m_irLibrary = nullptr;
+    SpatialSystem* m_spatialSystem = nullptr;
+    TransformTable* m_transformTable = nullptr;
+    HRTF* m_hrtf = nullptr;
     AudioCallback* m_audioCallback = nullptr;
+    MessageRoute m_messageRoutes[k_numMessageTypes];
+    float m_cpuPercent[Profiler::k_numStages] = {};
+    long long m_playhead = 0;
     int m_numPlayingVoices = 0;
+#if RF_ENABLE_TRACE_CAPTURE
+    bool m_isCapturingTrace = false;
+#endif
 
+    void CreateMessageRoutes();
+    void ProcessMessages();
     void OnAudioCallback(float* buffer, int size);
     void SetAudioCallback(AudioCallback* audioCallback);
 
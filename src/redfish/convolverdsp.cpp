@@ -24,7 +24,7 @@
 
 #include "allocator.h"
 #include "assert.h"
-#include "audiodata.h"
+#include "irlibrary.h"
 #include "mixitem.h"
 
 rf::ConvolverDSP::ConvolverDSP(const AudioSpec& spec)
@@ -36,16 +36,14 @@ rf::ConvolverDSP::ConvolverDSP(const AudioSpec& spec)
         m_irAmplitudes[i] = 1.0f;
     }
 
-    m_irs = Allocator::AllocateArray<AudioData>("IRs", PluginUtils::k_maxConvolverIRs);
-
     // Dry Signal Buffer
     {
         const int bufferSize = spec.m_bufferSize;
-        m_dryBuffer = static_cast<float**>(Allocator::s_allocate(sizeof(float*) * PluginUtils::k_maxChannels, "DryBuffer", alignof(void*)));
+        m_dryBuffer = static_cast<float**>(Allocator::AllocateMemory(sizeof(float*) * PluginUtils::k_maxChannels, "DryBuffer", alignof(void*)));
 
         for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
         {
-            m_dryBuffer[i] = static_cast<float*>(Allocator::s_allocate(sizeof(float) * bufferSize, "DryBuffer", alignof(float)));
+            m_dryBuffer[i] = static_cast<float*>(Allocator::AllocateMemory(sizeof(float) * bufferSize, "DryBuffer", alignof(float)));
             memset(m_dryBuffer[i], 0, sizeof(float) * bufferSize);
         }
     }
@@ -59,173 +57,88 @@ rf::ConvolverDSP::~ConvolverDSP()
     {
         for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
         {
-            Allocator::s_deallocate(m_dryBuffer[i]);
+            Allocator::DeallocateMemory(m_dryBuffer[i]);
         }
 
-        Allocator::s_deallocate(m_dryBuffer);
-    }
-
-    if (m_loaded)
-    {
-        for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
-        {
-            for (int j = 0; j < PluginUtils::k_maxConvolverIRs; ++j)
-            {
-                Allocator::s_deallocate(m_irArray[i][j]);
-            }
-            Allocator::s_deallocate(m_irArray[i]);
-        }
-        Allocator::s_deallocate(m_irArray);
+        Allocator::DeallocateMemory(m_dryBuffer);
     }
 
-    for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
-    {
-        m_channelConvolvers[i].reset();
-    }
+    Allocator::Deallocate<ConvolverChannels>(&m_channels);
+}
 
-    for (int i = 0; i < PluginUtils::k_maxConvolverIRs; ++i)
+rf::ConvolverChannels* rf::ConvolverDSP::CreateChannels(const AudioSpec& spec, int numSegments)
+{
+    ConvolverChannels* channels = Allocator::Allocate<ConvolverChannels>("ConvolverChannels");
+    for (int i = 0; i < PluginUtils::k_impulseResponseChannels; ++i)
     {
-        m_irs[i].Free();
+        channels->m_convolvers[i].init(spec.m_bufferSize, numSegments);
     }
-    Allocator::DeallocateArray<AudioData>(&m_irs, PluginUtils::k_maxConvolverIRs);
+    return channels;
 }
 
-void rf::ConvolverDSP::LoadIR(const AudioData* ir, float amplitude, int index)
+rf::ConvolverChannels* rf::ConvolverDSP::LoadIR(const ImpulseResponse* ir, float amplitude, int index, ConvolverChannels* channels)
 {
-    if (!IndexCheck(index))
+    ConvolverChannels* oldChannels = nullptr;
+    if (channels)
     {
-        return;
+        oldChannels = m_channels;
+        m_channels = channels;
     }
 
-    if (ir->m_numChannels != PluginUtils::k_maxChannels)
+    if (!IndexCheck(index) || !ir || !m_channels)
     {
-        RF_FAIL("Incorrect impulse channel count for impulse response. Impulse response not loaded.");
-        return;
+        return oldChannels;
     }
 
-    if (m_numIrs >= PluginUtils::k_maxConvolverIRs)
+    // The IR is owned by the IR library and shared with other convolvers, so we only keep a reference to it.
+    if (!m_irs[index])
     {
-        RF_FAIL("Too many impulse responses loaded.");
-        return;
+        ++m_numIrs;
     }
+    m_irs[index] = ir;
+    m_irAmplitudes[index] = amplitude;
 
-    // Deep-copy the IR audio asset so it is immune to the IR being unloaded.
-    m_irs[index].Allocate(*ir);
-    ++m_numIrs;
-
-    // Length of the IR that we are loading.
-    const int lenIr = ir->m_numFrames;
-
-    // If we are loading an IR with a greater length, we must reallocate.
-    bool reallocate = false;
-
-    if (lenIr > m_maxIrLen)
+    // New channels start without any impulse response, so they get all of them.
+    if (channels)
     {
-        m_maxIrLen = lenIr;
-        reallocate = true;
+        SetImpulseResponses();
     }
-
-    // Allocate the IR array.
-
-    // [
-    // channel 1: [[IR1], [IR2], [IR3]],
-    // channel 2: [[IR1], [IR2], [IR3]]
-    // ]
-
-    // We allocate the IR array the first time.
-    if (!m_loaded)
+    else
     {
-        m_irArray = static_cast<float***>(Allocator::s_allocate(sizeof(float**) * PluginUtils::k_maxChannels, "IRArray", alignof(void*)));
-
-        for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
+        for (int i = 0; i < PluginUtils::k_impulseResponseChannels; ++i)
         {
-            m_irArray[i] = static_cast<float**>(Allocator::s_allocate(sizeof(float*) * PluginUtils::k_maxConvolverIRs, "IRArray", alignof(void*)));
-
-            for (int j = 0; j < PluginUtils::k_maxConvolverIRs; ++j)
-            {
-                m_irArray[i][j] = static_cast<float*>(Allocator::s_allocate(sizeof(float) * m_maxIrLen, "IRArray", alignof(float)));
-                memset(m_irArray[i][j], 0, sizeof(float) * m_maxIrLen);
-            }
+            m_channels->m_convolvers[i].setImpulseResponse(index, ir->m_segments[i], ir->m_numSegments);
         }
+        UpdateAmplitudes();
     }
-    // If we need to reallocate due to an increase in IR length.
-    else if (reallocate && m_loaded)
-    {
-        for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
-        {
-            for (int j = 0; j < PluginUtils::k_maxConvolverIRs; ++j)
-            {
-                Allocator::s_deallocate(m_irArray[i][j]);
-                m_irArray[i][j] = static_cast<float*>(Allocator::s_allocate(sizeof(float) * m_maxIrLen, "IRArray", alignof(float)));
-                memset(m_irArray[i][j], 0, sizeof(float) * m_maxIrLen);
-            }
-        }
-    }
-
-    for (int k = 0; k < PluginUtils::k_maxConvolverIRs; ++k)
-    {
-        if (m_irs[k].m_numFrames > 0)
-        {
-            for (int i = 0; i < m_irs[k].m_numFrames; ++i)
-            {
-                float** samples = m_irs[k].m_arrayOfChannels;
-                for (int j = 0; j < PluginUtils::k_maxChannels; ++j)
-                {
-                    m_irArray[j][k][i] = samples[j][i];
-                }
-            }
-        }
-        else
-        {
-            for (int i = 0; i < m_maxIrLen; ++i)
-            {
-                for (int j = 0; j < PluginUtils::k_maxChannels; ++j)
-                {
-                    m_irArray[j][k][i] = 0.0f;
-                }
-            }
-        }
-    }
-
-    InitChannelConvolvers();
-    SetIRAmplitude(amplitude, index);
 
     m_loaded = true;
+    return oldChannels;
 }
 
 void rf::ConvolverDSP::UnloadIR(int index)
 {
-    if (!IndexCheck(index))
+    if (!IndexCheck(index) || !m_irs[index])
     {
         return;
     }
 
-    m_irs[index].Free();
-
-    for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
+    m_irs[index] = nullptr;
+    for (int i = 0; i < PluginUtils::k_impulseResponseChannels; ++i)
     {
-        for (int j = 0; j < m_maxIrLen; ++j)
-        {
-            m_irArray[i][index][j] = 0.0f;
-        }
+        m_channels->m_convolvers[i].setImpulseResponse(index, nullptr, 0);
     }
 
-    InitChannelConvolvers();
-
+    // The channels are kept for the next IR, so only their history is cleared.
     --m_numIrs;
     if (m_numIrs == 0)
     {
         m_loaded = false;
 
-        for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
+        for (int i = 0; i < PluginUtils::k_impulseResponseChannels; ++i)
         {
-            for (int j = 0; j < PluginUtils::k_maxConvolverIRs; ++j)
-            {
-                Allocator::s_deallocate(m_irArray[i][j]);
-            }
-            Allocator::s_deallocate(m_irArray[i]);
+            m_channels->m_convolvers[i].clear();
         }
-        Allocator::s_deallocate(m_irArray);
     }
 }
 
@@ -262,14 +175,15 @@ void rf::ConvolverDSP::Process(MixItem* mixItem, int bufferSize)
         }
     }
 
-    for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
+    // Impulse responses are stereo, so only the front left and right channels are convolved. Any other channels stay dry.
+    for (int i = 0; i < PluginUtils::k_impulseResponseChannels; ++i)
     {
         float* buffer = mixItem->m_arrayOfChannels[i].GetAsFloatBuffer();
-        m_channelConvolvers[i].process(buffer, buffer, bufferSize);
+        m_channels->m_convolvers[i].process(buffer, buffer, bufferSize);
     }
 
     // Apply the wet/dry ratio on the mix item.
-    const float inverse = 1.0f / (bufferSize - 1);
+    const float inverse = bufferSize > 1 ? 1.0f / (bufferSize - 1) : 1.0f;
 
     for (int i = 0; i < numChannels; ++i)
     {
@@ -296,11 +210,18 @@ bool rf::ConvolverDSP::IndexCheck(int index)
     return false;
 }
 
-void rf::ConvolverDSP::InitChannelConvolvers()
+void rf::ConvolverDSP::SetImpulseResponses()
 {
-    for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
+    for (int i = 0; i < PluginUtils::k_impulseResponseChannels; ++i)
     {
-        m_channelConvolvers[i].init(m_spec.m_bufferSize, m_irArray[i], m_maxIrLen);
+        for (int j = 0; j < PluginUtils::k_maxConvolverIRs; ++j)
+        {
+            const ImpulseResponse* ir = m_irs[j];
+            if (ir)
+            {
+                m_channels->m_convolvers[i].setImpulseResponse(j, ir->m_segments[i], ir->m_numSegments);
+            }
+        }
     }
 
     UpdateAmplitudes();
@@ -308,8 +229,14 @@ void rf::ConvolverDSP::InitChannelConvolvers()
 
 void rf::ConvolverDSP::UpdateAmplitudes()
 {
-    for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
+    // Amplitudes can be set before the first IR, and are picked up once it loads.
+    if (!m_channels)
+    {
+        return;
+    }
+
+    for (int i = 0; i < PluginUtils::k_impulseResponseChannels; ++i)
     {
-        m_channelConvolvers[i].setImpulseResponseAmplitudes(m_irAmplitudes);
+        m_channels->m_convolvers[i].setImpulseResponseAmplitudes(m_irAmplitudes);
     }
 }
\ No newline at end of file
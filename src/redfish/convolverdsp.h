@@ -29,7 +29,13 @@
 
 namespace rf
 {
-struct AudioData;
+struct ImpulseResponse;
+
+// The convolver state for each impulse response channel, sized for the longest impulse response it will hold.
+struct ConvolverChannels
+{
+    fftconvolver::FFTConvolver m_convolvers[PluginUtils::k_impulseResponseChannels];
+};
 
 class ConvolverDSP : public DSPBase
 {
@@ -41,7 +47,11 @@ public:
     ConvolverDSP& operator=(ConvolverDSP&&) = delete;
     ~ConvolverDSP();
 
-    void LoadIR(const AudioData* ir, float amplitude, int index);
+    // Game thread. Allocates channels for impulse responses of up to numSegments segments.
+    static ConvolverChannels* CreateChannels(const AudioSpec& spec, int numSegments);
+    // Switches to channels first if they are given, since the IR doesn't fit the current ones. Returns the channels it
+    // replaced, for the game thread to free, or nullptr.
+    ConvolverChannels* LoadIR(const ImpulseResponse* ir, float amplitude, int index, ConvolverChannels* channels);
     void UnloadIR(int index);
     void SetIRAmplitude(float amplitude, int index);
     void SetWetPercentage(float wetPercent);
@@ -49,18 +59,16 @@ public:
     static bool IndexCheck(int index);
 
 private:
-    fftconvolver::FFTConvolver m_channelConvolvers[PluginUtils::k_maxChannels];
-    AudioData* m_irs = nullptr;
-    float*** m_irArray = nullptr;
+    ConvolverChannels* m_channels = nullptr;
+    const ImpulseResponse* m_irs[PluginUtils::k_maxConvolverIRs] = {};
     float** m_dryBuffer = nullptr;
     float* m_irAmplitudes = nullptr;
     int m_numIrs = 0;
-    int m_maxIrLen = 0;
     float m_startWetPercentage = 1.0f;
     float m_destinationWetPercentage = 1.0f;
     bool m_loaded = false;
 
-    void InitChannelConvolvers();
+    void SetImpulseResponses();
     void UpdateAmplitudes();
 };
 }  // namespace rf
\ No newline at end of file
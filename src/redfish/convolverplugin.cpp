@@ -22,29 +22,43 @@
 
 #include "convolverplugin.h"
 
+#include "allocator.h"
 #include "assetsystem.h"
 #include "context.h"
 #include "convolverdsp.h"
 #include "functions.h"
+#include "irlibrary.h"
 #include "plugincommands.h"
 #include "pluginutils.h"
 
 rf::ConvolverPlugin::ConvolverPlugin(Context* context, CommandProcessor* commands, MixGroupHandle mixGroupHandle, int mixGroupSlot, int pluginIndex)
     : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::Convolver)
 {
-    RF_SEND_PLUGIN_CREATE_COMMAND(CreateConvolverDSPCommand);
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreateConvolverDSPCommand, ConvolverDSP);
 
     m_amplitudes = Allocator::AllocateArray<float>("ConvolverPluginAmplitudes", PluginUtils::k_maxConvolverIRs);
     for (int i = 0; i < PluginUtils::k_maxConvolverIRs; ++i)
     {
         m_amplitudes[i] = 1.0f;
     }
+
+    m_irHandles = Allocator::AllocateArray<AudioHandle>("ConvolverPluginIRHandles", PluginUtils::k_maxConvolverIRs);
 }
 
 rf::ConvolverPlugin::~ConvolverPlugin()
 {
     Allocator::DeallocateArray<float>(&m_amplitudes, PluginUtils::k_maxConvolverIRs);
     RF_SEND_PLUGIN_DESTROY_COMMAND(DestroyConvolverDSPCommand);
+
+    // Released after the destroy command so the IR library only frees IRs the audio thread has stopped using.
+    for (int i = 0; i < PluginUtils::k_maxConvolverIRs; ++i)
+    {
+        if (m_irHandles[i])
+        {
+            m_context->GetIRLibrary()->Release(m_irHandles[i]);
+        }
+    }
+    Allocator::DeallocateArray<AudioHandle>(&m_irHandles, PluginUtils::k_maxConvolverIRs);
 }
 
 void rf::ConvolverPlugin::LoadIR(const AudioHandle audioHandle, int index)
@@ -54,13 +68,38 @@ void rf::ConvolverPlugin::LoadIR(const AudioHandle audioHandle, int index)
         return;
     }
 
+    if (m_irHandles[index] == audioHandle)
+    {
+        return;
+    }
+
+    IRLibrary* irLibrary = m_context->GetIRLibrary();
+    const ImpulseResponse* impulseResponse = irLibrary->Acquire(audioHandle, m_context->GetAssetSystem()->GetAudioData(audioHandle));
+    if (!impulseResponse)
+    {
+        return;
+    }
+
     AudioCommand cmd;
     LoadConvolverDSPIRCommand& data = EncodeAudioCommand<LoadConvolverDSPIRCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_index = index;
     data.m_amplitude = m_amplitudes[index];
-    data.m_audioDataIndex = m_context->GetAssetSystem()->GetAudioDataIndex(audioHandle);
-    m_commands->Add(cmd);
+    data.m_impulseResponse = impulseResponse;
+    if (impulseResponse->m_numSegments > m_maxNumSegments)
+    {
+        // Sized here so the audio thread only has to switch to them.
+        m_maxNumSegments = impulseResponse->m_numSegments;
+        data.m_channels = ConvolverDSP::CreateChannels(m_context->GetAudioSpec(), m_maxNumSegments);
+    }
+    AddCommand(cmd);
+
+    // The load command replaces the previous IR on the audio thread, so it is safe to release it now.
+    if (m_irHandles[index])
+    {
+        irLibrary->Release(m_irHandles[index]);
+    }
+    m_irHandles[index] = audioHandle;
 }
 
 void rf::ConvolverPlugin::UnloadIR(int index)
@@ -70,11 +109,19 @@ void rf::ConvolverPlugin::UnloadIR(int index)
         return;
     }
 
+    if (!m_irHandles[index])
+    {
+        return;
+    }
+
     AudioCommand cmd;
     UnloadConvolverDSPIRCommand& data = EncodeAudioCommand<UnloadConvolverDSPIRCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_index = index;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
+
+    m_context->GetIRLibrary()->Release(m_irHandles[index]);
+    m_irHandles[index] = AudioHandle();
 }
 
 void rf::ConvolverPlugin::SetWetPercentage(float percentage)
@@ -90,7 +137,7 @@ void rf::ConvolverPlugin::SetWetPercentage(float percentage)
     SetConvolverDSPWetPercentageCommand& data = EncodeAudioCommand<SetConvolverDSPWetPercentageCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_percentage = m_wetPercentage;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::ConvolverPlugin::GetWetPercentage() const
@@ -118,7 +165,7 @@ void rf::ConvolverPlugin::SetIRVolumeDb(float volumeDb, int index)
     data.m_dspIndex = m_pluginIndex;
     data.m_index = index;
     data.m_amplitude = m_amplitudes[index];
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::ConvolverPlugin::GetIRVolumeDb(int index) const
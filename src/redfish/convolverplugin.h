@@ -48,6 +48,9 @@ public:
 
 private:
     float* m_amplitudes = nullptr;
+    AudioHandle* m_irHandles = nullptr;
     float m_wetPercentage = 1.0f;
+    // The longest IR the DSP's channels have been sized for.
+    int m_maxNumSegments = 0;
 };
 }  // namespace rf
\ No newline at end of file
@@ -32,15 +32,21 @@ rf::Cue::Cue(const CueParameters& cueParameters, const AssetSystem* assetSystem,
     , m_tempo(cueParameters.m_tempo)
     , m_gainDb(cueParameters.m_gainDb)
     , m_numLayers(cueParameters.m_numLayers)
+    , m_numTempoChanges(cueParameters.m_numTempoChanges)
     , m_index(index)
 {
-    RF_ASSERT(m_numLayers < RF_MAX_CUE_LAYERS, "Too many layers added. Increase RF_MAX_CUE_LAYERS");
+    RF_ASSERT(m_numLayers <= RF_MAX_CUE_LAYERS, "Too many layers added. Increase RF_MAX_CUE_LAYERS");
     for (int i = 0; i < m_numLayers; ++i)
     {
         m_layers[i] = cueParameters.m_layers[i];
         m_layers[i].m_audioDataIndex = assetSystem->GetAudioDataIndex(m_layers[i].m_audioHandle);
     }
 
+    for (int i = 0; i < m_numTempoChanges; ++i)
+    {
+        m_tempoChanges[i] = cueParameters.m_tempoChanges[i];
+    }
+
     if (cueParameters.m_name)
     {
         strcpy_s(m_name, cueParameters.m_name);
@@ -78,6 +84,17 @@ float rf::Cue::GetTempo() const
     return m_tempo;
 }
 
+const rf::TempoChange& rf::Cue::GetTempoChange(int index) const
+{
+    RF_ASSERT(index >= 0 && index < m_numTempoChanges, "Index out of bounds");
+    return m_tempoChanges[index];
+}
+
+int rf::Cue::GetNumTempoChanges() const
+{
+    return m_numTempoChanges;
+}
+
 float rf::Cue::GetGainDb() const
 {
     return m_gainDb;
@@ -108,3 +125,19 @@ void rf::CueParameters::ClearLayers()
     memset(m_layers, 0, sizeof(Layer) * RF_MAX_CUE_LAYERS);
     m_numLayers = 0;
 }
+
+void rf::CueParameters::AddTempoChange(int bar, float tempo, const Meter& meter)
+{
+    RF_ASSERT(m_numTempoChanges < RF_MAX_CUE_TEMPO_CHANGES, "Too many tempo changes added. Increase RF_MAX_CUE_TEMPO_CHANGES");
+    RF_ASSERT(bar > (m_numTempoChanges > 0 ? m_tempoChanges[m_numTempoChanges - 1].m_bar : 0), "Expected tempo changes to be added in order of bar");
+    TempoChange change;
+    change.m_meter = meter;
+    change.m_tempo = tempo;
+    change.m_bar = bar;
+    m_tempoChanges[m_numTempoChanges++] = change;
+}
+
+void rf::CueParameters::ClearTempoChanges()
+{
+    m_numTempoChanges = 0;
+}
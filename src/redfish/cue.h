@@ -24,6 +24,7 @@
 #include "defines.h"
 #include "layer.h"
 #include "meter.h"
+#include "tempomap.h"
 
 namespace rf
 {
@@ -48,31 +49,40 @@ public:
     CueHandle GetCueHandle() const;
     const Meter& GetMeter() const;
     float GetTempo() const;
+    const TempoChange& GetTempoChange(int index) const;
+    int GetNumTempoChanges() const;
     float GetGainDb() const;
     const char* GetName() const;
 
 private:
     char m_name[RF_MAX_NAME_SIZE];
     Layer m_layers[RF_MAX_CUE_LAYERS];
+    TempoChange m_tempoChanges[RF_MAX_CUE_TEMPO_CHANGES];
     CueHandle m_cueHandle;
     Meter m_meter;
     float m_tempo = 0.0f;
     float m_gainDb = 0.0f;
     int m_numLayers = 0;
+    int m_numTempoChanges = 0;
     int m_index = -1;
 };
 
 struct CueParameters
 {
     Layer m_layers[RF_MAX_CUE_LAYERS] = {};
+    TempoChange m_tempoChanges[RF_MAX_CUE_TEMPO_CHANGES] = {};
     Meter m_meter;
     const char* m_name = nullptr;
     float m_tempo = 0.0f;
     float m_gainDb = 0.0f;
     int m_numLayers = 0;
+    int m_numTempoChanges = 0;
 
     void AddLayer(AudioHandle audioHandle, const MixGroup* mixGroup, float volumeDb);
     void AddLayer(AudioHandle audioHandle, const MixGroup* mixGroup);
     void ClearLayers();
+    // Changes the tempo and meter from the start of a bar, counting from 0. Changes must be added in order of bar.
+    void AddTempoChange(int bar, float tempo, const Meter& meter);
+    void ClearTempoChanges();
 };
 }  // namespace rf
\ No newline at end of file
@@ -22,6 +22,8 @@
 
 #include "datacache.h"
 
+#include <algorithm>
+
 #include "allocator.h"
 #include "assert.h"
 #include "commandprocessor.h"
@@ -63,6 +65,42 @@ rf::AudioHandle rf::DataCache::AllocateAudioData(const float* samples, const cha
     return CreateAudioHandle();
 }
 
+rf::AudioHandle rf::DataCache::AllocateStreamedAudioData(const char* path, int numFrames, int numChannels, int numPrefetchFrames, int numBufferFrames, bool isFLAC)
+{
+    for (int i = 0; i < RF_MAX_AUDIO_DATA; ++i)
+    {
+        if (!m_audioDataHandleLookupList[i])
+        {
+            const AudioHandle handle = CreateAudioHandle();
+            m_audioDataHandleLookupList[i] = handle;
+
+            // The generation carries over from the last asset in this slot, so none of its requests can be mistaken
+            // for this one's.
+            AudioStream& stream = m_audioStreams[i];
+            strcpy_s(stream.m_path, path);
+            stream.m_numFrames = numFrames;
+            stream.m_numChannels = numChannels;
+            stream.m_numPrefetchFrames = std::min(numPrefetchFrames, numFrames);
+            stream.m_numBufferFrames = std::min(numBufferFrames, numFrames - stream.m_numPrefetchFrames);
+            stream.m_isFLAC = isFLAC;
+            stream.m_isRequested = false;
+            stream.m_numMissingFrames = 0;
+
+            AudioData& data = m_audioData[i];
+            data.m_name = stream.m_path;
+            data.m_numChannels = numChannels;
+            data.m_numFrames = numFrames;
+            data.m_numSamples = numFrames * numChannels;
+            data.m_stream = &stream;
+            ++data.m_referenceCount;
+            return handle;
+        }
+    }
+
+    RF_FAIL("Could not allocate audio data. Try increasing RF_MAX_AUDIO_DATA");
+    return CreateAudioHandle();
+}
+
 void rf::DataCache::DeallocateAudioData(AudioHandle audioHandle, CommandProcessor* commands)
 {
     for (int i = 0; i < RF_MAX_AUDIO_DATA; ++i)
@@ -118,6 +156,12 @@ const rf::AudioData* rf::DataCache::GetAudioData(int index) const
     return &m_audioData[index];
 }
 
+rf::AudioHandle rf::DataCache::GetAudioHandle(int index) const
+{
+    RF_ASSERT(index >= 0 && index < RF_MAX_AUDIO_DATA, "Index out of bounds");
+    return m_audioDataHandleLookupList[index];
+}
+
 rf::AudioHandle rf::DataCache::AssetExists(const char* path)
 {
     for (int i = 0; i < RF_MAX_AUDIO_DATA; ++i)
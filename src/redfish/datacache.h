@@ -22,6 +22,7 @@
 
 #pragma once
 #include "audiodata.h"
+#include "audiostream.h"
 #include "defines.h"
 #include "identifiers.h"
 
@@ -40,10 +41,13 @@ public:
     ~DataCache();
 
     AudioHandle AllocateAudioData(const float* samples, const char* path, int numSamples, int numChannels);
+    // Reserves a slot for an asset whose samples are decoded by the StreamLoader when the music system needs them.
+    AudioHandle AllocateStreamedAudioData(const char* path, int numFrames, int numChannels, int numPrefetchFrames, int numBufferFrames, bool isFLAC);
     void DeallocateAudioData(AudioHandle audioHandle, CommandProcessor* commands);
     int GetAudioDataIndex(AudioHandle audioHandle) const;
     const AudioData* GetAudioData(AudioHandle audioHandle) const;
     const AudioData* GetAudioData(int index) const;
+    AudioHandle GetAudioHandle(int index) const;
     AudioHandle AssetExists(const char* path);
     void IncrementReferenceCount(AudioHandle audioHandle);
     bool DecrementReferenceCount(AudioHandle audioHandle);
@@ -51,5 +55,7 @@ public:
 private:
     AudioHandle m_audioDataHandleLookupList[RF_MAX_AUDIO_DATA] = {};
     AudioData m_audioData[RF_MAX_AUDIO_DATA] = {};
+    // Never freed, so the audio thread and the stream loader can hold on to them after the asset is unloaded.
+    AudioStream m_audioStreams[RF_MAX_AUDIO_DATA];
 };
 }  // namespace rf
\ No newline at end of file
@@ -29,6 +29,30 @@
 // Controls whether or not asserts are enabled.
 #define RF_ENABLE_ASSERTS true
 
+// Counts allocations, queue growth and blocking calls made on the audio thread, and times every audio callback against
+// its deadline. See Context::GetRealtimeReport. Every allocation and callback pays for the bookkeeping, so it is only
+// on in debug builds unless it is defined on the command line.
+#ifndef RF_ENABLE_REALTIME_CHECKS
+#ifdef NDEBUG
+#define RF_ENABLE_REALTIME_CHECKS false
+#else
+#define RF_ENABLE_REALTIME_CHECKS true
+#endif
+#endif
+
+// Asserts as soon as the audio thread does something that is not realtime safe, instead of only counting it.
+// Requires RF_ENABLE_REALTIME_CHECKS.
+#define RF_ASSERT_ON_REALTIME_VIOLATIONS false
+
+// Allows Context::StartTraceCapture to record a timeline of the audio and game threads. When disabled, tracing
+// compiles away entirely.
+#define RF_ENABLE_TRACE_CAPTURE false
+
+// The max amount of audio callbacks and game thread events a trace capture holds. Recording stops when either is full.
+// At 48kHz with a 512 frame buffer, 8192 callbacks is a little under 90 seconds.
+#define RF_TRACE_CAPTURE_MAX_CALLBACKS 8192
+#define RF_TRACE_CAPTURE_MAX_GAME_EVENTS 8192
+
 // Determines the max number of audio commands that can be sent
 // for each audio callback without incurring an allocation.
 // Audio commands are send to the audio thread when
@@ -44,9 +68,17 @@
 // Determines the array sized used for storing names for objects with names (cues, ...)
 #define RF_MAX_NAME_SIZE 128
 
+// The max amount of audio commands that can wait on the audio thread for a playhead in a later audio callback. Past
+// this, new scheduled commands run as soon as they are received.
+#define RF_MAX_SCHEDULED_AUDIO_COMMANDS 256
+
 // The max amount of simultaneous sounds that RedFish can play.
 #define RF_MAX_VOICES 256
 
+// How often the audio thread sends its profiling results to the game thread, in milliseconds.
+// Results are averaged over this window, so longer intervals give steadier numbers.
+#define RF_PROFILER_PUBLISH_INTERVAL_MS 250
+
 // Enables SIMD for some operation. Enabling
 // SIMD may increase performance.
 // Set one of the values to 1 to enable a SIMD mode.
@@ -55,13 +87,43 @@
 #define RF_USE_AVX_512 0
 #define RF_USE_SSE 1
 
+// Enables fused multiply-add in the SSE and AVX paths. FMA is not part of SSE or AVX, so it
+// follows the compiler's target (AVX2 hardware always has it). AVX-512 always uses it.
+#if defined(__FMA__) || defined(__AVX2__)
+#define RF_USE_FMA 1
+#else
+#define RF_USE_FMA 0
+#endif
+
 // ------------------------------------------------------------------------------------------------
 // Mixing
 // ------------------------------------------------------------------------------------------------
 
+// The order of the ambisonic buses that binaural voices are encoded into. Set to 1 (4 channels) or 3 (16 channels).
+// Higher orders localize more sharply, but every bus decodes with 2 convolutions per channel.
+#define RF_AMBISONIC_ORDER 1
+
+// Max amount of mix groups that can have binaural voices playing at once. Each one gets its own ambisonic bus and
+// binaural decoder.
+#define RF_MAX_BINAURAL_BUSES 4
+
 // Defines the max gain for some plug-ins.
 #define RF_MAX_DECIBELS 12.0f
 
+// The amount of binaural voices nearest to the listener that are convolved with their own interpolated HRIR pair
+// instead of being encoded into an ambisonic bus.
+#define RF_MAX_DIRECT_BINAURAL_VOICES 4
+
+// Max amount of emitters that can exist at once. Emitters are positioned objects that sound effects follow in 3D.
+#define RF_MAX_EMITTERS 256
+
+// Max amount of unique impulse responses that can be loaded into convolver plug-ins at once.
+// Convolvers that load the same audio asset share a single copy of its frequency-domain data.
+#define RF_MAX_IMPULSE_RESPONSES 16
+
+// Max amount of mix groups that can have loudness metering enabled at once.
+#define RF_MAX_LOUDNESS_METERS 8
+
 // Max amount of plug-ins that can be created on a mix group.
 #define RF_MAX_MIX_GROUP_PLUGINS 5
 
@@ -74,7 +136,8 @@
 // Defines silences, anything lower than RF_MIN_DECIBELS is silenced.
 #define RF_MIN_DECIBELS -60.0f
 
-// Controls the pan law for the Pan Plug-in. Set one of these values to 1.
+// Controls the default pan law for the Pan Plug-in and positioning. Pan Plug-ins can change it at runtime.
+// Set one of these values to 1.
 #define RF_PAN_LAW_MINUS_FOUR_DOT_FIVE 0
 #define RF_PAN_LAW_MINUS_SIX 0
 #define RF_PAN_LAW_MINUS_THREE 1
@@ -83,14 +146,18 @@
 // Music
 // ------------------------------------------------------------------------------------------------
 
-// Controls the max number of layers a music cue can have.
-#define RF_MAX_CUE_LAYERS 4
+// The most layers CueParameters can hold. How many layers a Context can play is set by MusicConfig::m_maxCueLayers,
+// which is what sizes the music voices.
+#define RF_MAX_CUE_LAYERS 16
+
+// Controls how many tempo or meter changes a music cue can have after its start.
+#define RF_MAX_CUE_TEMPO_CHANGES 8
 
-// Controls how many music cues can exist at once.
+// The default for how many music cues can exist at once. See MusicConfig.
 #define RF_MAX_CUES 64
 
-// Controls how many stingers can exist at once.
+// The default for how many stingers can exist, and play, at once. See MusicConfig.
 #define RF_MAX_STINGERS 64
 
-// Controls how many transitions can exist at once.
+// The default for how many transitions can exist at once. See MusicConfig.
 #define RF_MAX_TRANSITIONS 64
\ No newline at end of file
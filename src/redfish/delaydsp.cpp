@@ -22,28 +22,42 @@
 
 #include "delaydsp.h"
 
+#include <algorithm>
+
 #include "allocator.h"
 #include "functions.h"
+#include "metronome.h"
 #include "mixitem.h"
 #include "pluginutils.h"
 
 rf::DelayDSP::DelayDSP(const AudioSpec& spec)
     : DSPBase(spec)
+    , m_sync(Sync::Value::Quarter)
 {
-    m_delayBufferSize = Functions::MsToSamples(PluginUtils::k_maxDelayTime, m_spec.m_sampleRate);
-    m_buffer = Allocator::AllocateArray<Buffer>("DelayBuffer", spec.m_channels, m_delayBufferSize);
-    m_feedbackBuffer = Allocator::AllocateArray<Buffer>("DelayFeedbackBuffer", spec.m_channels, m_delayBufferSize);
+    // A block reads up to m_maxDelay samples back while writing a full buffer ahead, so the ring has to hold both.
+    m_maxDelay = Functions::MsToSamples(PluginUtils::k_maxDelayTime, m_spec.m_sampleRate);
+    m_ringSize = Functions::NextPowerOfTwo(m_maxDelay + m_spec.m_bufferSize);
+    m_ringMask = m_ringSize - 1;
+    m_buffer = Allocator::AllocateArray<Buffer>("DelayBuffer", spec.m_channels, m_ringSize);
 }
 
 rf::DelayDSP::~DelayDSP()
 {
     Allocator::DeallocateArray<Buffer>(&m_buffer, m_spec.m_channels);
-    Allocator::DeallocateArray<Buffer>(&m_feedbackBuffer, m_spec.m_channels);
+}
+
+void rf::DelayDSP::SetMetronome(const Metronome* metronome)
+{
+    m_metronome = metronome;
 }
 
 void rf::DelayDSP::SetDelay(int delay)
 {
-    m_delay = delay;
+    m_timeDelay = Functions::Clamp(delay, 1, m_maxDelay);
+    if (!m_tempoSync)
+    {
+        m_targetDelay = m_timeDelay;
+    }
 }
 
 void rf::DelayDSP::SetFeedback(float feedback)
@@ -51,6 +65,73 @@ void rf::DelayDSP::SetFeedback(float feedback)
     m_feedback = feedback;
 }
 
+void rf::DelayDSP::SetTempoSync(bool tempoSync)
+{
+    m_tempoSync = tempoSync;
+    m_syncedTempo = -1.0f;
+    if (!m_tempoSync)
+    {
+        m_targetDelay = m_timeDelay;
+    }
+}
+
+void rf::DelayDSP::SetSyncValue(Sync::Value syncValue)
+{
+    m_sync = Sync(syncValue);
+    m_syncedTempo = -1.0f;
+}
+
+void rf::DelayDSP::UpdateSyncedDelay()
+{
+    // Without music playing there is no tempo to follow, so keep the last delay.
+    const float tempo = m_metronome->GetTempo();
+    const Meter meter = m_metronome->GetMeter();
+    if (tempo <= 0.0f || (Functions::FloatEquality(tempo, m_syncedTempo) && meter == m_syncedMeter))
+    {
+        return;
+    }
+
+    m_syncedTempo = tempo;
+    m_syncedMeter = meter;
+    m_targetDelay = Functions::Clamp(Metronome::GetSyncSamples(m_spec, m_sync, tempo, meter), 1, m_maxDelay);
+}
+
+void rf::DelayDSP::ProcessSpan(const float* from,
+                               const float* to,
+                               float* write,
+                               float* samples,
+                               int numSamples,
+                               float fade,
+                               float fadeIncrement) const
+{
+    // The delayed signal crossfades from one tap to the other. When the delay is steady both taps are the same.
+    int i = 0;
+
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+    const __m128 feedback = _mm_set1_ps(m_feedback);
+    const __m128 fadeStep = _mm_set1_ps(fadeIncrement * 4.0f);
+    __m128 fades = _mm_setr_ps(fade, fade + fadeIncrement, fade + fadeIncrement * 2.0f, fade + fadeIncrement * 3.0f);
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        const __m128 a = _mm_loadu_ps(from + i);
+        const __m128 b = _mm_loadu_ps(to + i);
+        const __m128 delayed = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), fades));
+        _mm_storeu_ps(write + i, _mm_add_ps(_mm_loadu_ps(samples + i), _mm_mul_ps(feedback, delayed)));
+        _mm_storeu_ps(samples + i, delayed);
+        fades = _mm_add_ps(fades, fadeStep);
+    }
+    fade += fadeIncrement * static_cast<float>(i);
+#endif
+
+    for (; i < numSamples; ++i)
+    {
+        const float delayed = from[i] + (to[i] - from[i]) * fade;
+        write[i] = samples[i] + m_feedback * delayed;
+        samples[i] = delayed;
+        fade += fadeIncrement;
+    }
+}
+
 void rf::DelayDSP::Process(MixItem* mixItem, int bufferSize)
 {
     if (m_bypass)
@@ -58,19 +139,42 @@ void rf::DelayDSP::Process(MixItem* mixItem, int bufferSize)
         return;
     }
 
-    Buffer* buffer = mixItem->m_arrayOfChannels;
-    int writeHead = (m_readHead + m_delay) % m_delayBufferSize;
+    if (m_tempoSync)
+    {
+        UpdateSyncedDelay();
+    }
 
-    for (int i = 0; i < bufferSize; ++i)
+    // A delay change crossfades from the old tap to the new one over this buffer instead of jumping.
+    const int fromDelay = m_delay;
+    const int toDelay = m_targetDelay;
+    const int minDelay = std::min(fromDelay, toDelay);
+    const float fadeIncrement = fromDelay == toDelay ? 0.0f : 1.0f / static_cast<float>(bufferSize);
+
+    for (int c = 0; c < m_spec.m_channels; ++c)
     {
-        for (int c = 0; c < m_spec.m_channels; ++c)
+        float* samples = mixItem->m_arrayOfChannels[c].GetAsFloatBuffer();
+        float* ring = m_buffer[c].GetAsFloatBuffer();
+
+        // Work in spans that don't wrap either read head or the write head, and that never read what the span
+        // itself writes.
+        int i = 0;
+        while (i < bufferSize)
         {
-            m_buffer[c][writeHead] += buffer[c][i] + (m_feedback * m_feedbackBuffer[c][i]);
-            buffer[c][i] = m_buffer[c][m_readHead];
-            m_feedbackBuffer[c][i] = m_buffer[c][m_readHead];
-            m_buffer[c][m_readHead] = 0.0f;
+            const int write = (m_writeHead + i) & m_ringMask;
+            const int readFrom = (write - fromDelay) & m_ringMask;
+            const int readTo = (write - toDelay) & m_ringMask;
+
+            int span = std::min(bufferSize - i, minDelay);
+            span = std::min(span, m_ringSize - write);
+            span = std::min(span, m_ringSize - readFrom);
+            span = std::min(span, m_ringSize - readTo);
+
+            const float fade = fadeIncrement * static_cast<float>(i + 1);
+            ProcessSpan(ring + readFrom, ring + readTo, ring + write, samples + i, span, fade, fadeIncrement);
+            i += span;
         }
-        writeHead = (writeHead + 1) % m_delayBufferSize;
-        m_readHead = (m_readHead + 1) % m_delayBufferSize;
     }
-}
\ No newline at end of file
+
+    m_writeHead = (m_writeHead + bufferSize) & m_ringMask;
+    m_delay = toDelay;
+}
@@ -23,9 +23,13 @@
 #pragma once
 #include "buffer.h"
 #include "dspbase.h"
+#include "meter.h"
+#include "sync.h"
 
 namespace rf
 {
+class Metronome;
+
 class DelayDSP : public DSPBase
 {
 public:
@@ -36,16 +40,30 @@ public:
     DelayDSP& operator=(DelayDSP&&) = delete;
     ~DelayDSP();
 
+    void SetMetronome(const Metronome* metronome);
     void SetDelay(int delay);
     void SetFeedback(float feedback);
+    void SetTempoSync(bool tempoSync);
+    void SetSyncValue(Sync::Value syncValue);
     void Process(MixItem* mixItem, int bufferSize) override final;
 
 private:
+    void UpdateSyncedDelay();
+    void ProcessSpan(const float* from, const float* to, float* write, float* samples, int numSamples, float fade, float fadeIncrement) const;
+
+    const Metronome* m_metronome = nullptr;
     Buffer* m_buffer = nullptr;
-    Buffer* m_feedbackBuffer = nullptr;
-    int m_delay = 0;
-    float m_feedback = 0;
-    int m_delayBufferSize = 0;
-    int m_readHead = 0;
+    Sync m_sync;
+    Meter m_syncedMeter;
+    float m_syncedTempo = -1.0f;
+    float m_feedback = 0.0f;
+    int m_delay = 1;
+    int m_targetDelay = 1;
+    int m_timeDelay = 1;
+    int m_maxDelay = 0;
+    int m_ringSize = 0;
+    int m_ringMask = 0;
+    int m_writeHead = 0;
+    bool m_tempoSync = false;
 };
-}  // namespace rf
\ No newline at end of file
+}  // namespace rf
@@ -22,7 +22,10 @@
 
 #include "delayplugin.h"
 
+#include "allocator.h"
+#include "assert.h"
 #include "context.h"
+#include "delaydsp.h"
 #include "functions.h"
 #include "plugincommands.h"
 #include "pluginutils.h"
@@ -30,7 +33,7 @@
 rf::DelayPlugin::DelayPlugin(Context* context, CommandProcessor* commands, MixGroupHandle mixGroupHandle, int mixGroupSlot, int pluginIndex)
     : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::Delay)
 {
-    RF_SEND_PLUGIN_CREATE_COMMAND(CreateDelayDSPCommand);
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreateDelayDSPCommand, DelayDSP);
 }
 
 rf::DelayPlugin::~DelayPlugin()
@@ -51,7 +54,7 @@ void rf::DelayPlugin::SetDelay(float delay)
     SetDelayDSPDelayCommand& data = EncodeAudioCommand<SetDelayDSPDelayCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_delay = Functions::MsToSamples(m_delay, m_context->GetAudioSpec().m_sampleRate);
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::DelayPlugin::GetDelay() const
@@ -72,7 +75,7 @@ void rf::DelayPlugin::SetFeedback(float feedback)
     SetDelayDSPFeedbackCommand& data = EncodeAudioCommand<SetDelayDSPFeedbackCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_feedback = m_feedback;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::DelayPlugin::GetFeedback() const
@@ -80,14 +83,66 @@ float rf::DelayPlugin::GetFeedback() const
     return m_feedback;
 }
 
+void rf::DelayPlugin::SetTempoSync(bool tempoSync)
+{
+    if (m_tempoSync == tempoSync)
+    {
+        return;
+    }
+
+    m_tempoSync = tempoSync;
+
+    AudioCommand cmd;
+    SetDelayDSPTempoSyncCommand& data = EncodeAudioCommand<SetDelayDSPTempoSyncCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_tempoSync = m_tempoSync;
+    AddCommand(cmd);
+}
+
+bool rf::DelayPlugin::GetTempoSync() const
+{
+    return m_tempoSync;
+}
+
+void rf::DelayPlugin::SetSyncValue(Sync::Value syncValue)
+{
+    if (m_syncValue == syncValue)
+    {
+        return;
+    }
+
+    if (syncValue == Sync::Value::Cut || syncValue == Sync::Value::Queue)
+    {
+        RF_FAIL("Delay can only sync to a musical note value");
+        return;
+    }
+
+    m_syncValue = syncValue;
+
+    AudioCommand cmd;
+    SetDelayDSPSyncValueCommand& data = EncodeAudioCommand<SetDelayDSPSyncValueCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_syncValue = m_syncValue;
+    AddCommand(cmd);
+}
+
+rf::Sync::Value rf::DelayPlugin::GetSyncValue() const
+{
+    return m_syncValue;
+}
+
 void rf::DelayPlugin::ToJson(nlohmann::ordered_json& json) const
 {
     json["delay"] = GetDelay();
     json["feedback"] = GetFeedback();
+    json["tempoSync"] = GetTempoSync();
+    json["syncValue"] = static_cast<int>(GetSyncValue());
 }
 
 void rf::DelayPlugin::FromJson(const nlohmann::ordered_json& json)
 {
     SetDelay(json.value("delay", GetDelay()));
     SetFeedback(json.value("feedback", GetFeedback()));
+    SetSyncValue(static_cast<Sync::Value>(json.value("syncValue", static_cast<int>(GetSyncValue()))));
+    SetTempoSync(json.value("tempoSync", GetTempoSync()));
 }
\ No newline at end of file
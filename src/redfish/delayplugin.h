@@ -23,6 +23,7 @@
 #pragma once
 #include "identifiers.h"
 #include "pluginbase.h"
+#include "sync.h"
 
 namespace rf
 {
@@ -40,6 +41,10 @@ public:
     float GetDelay() const;
     void SetFeedback(float feedback);
     float GetFeedback() const;
+    void SetTempoSync(bool tempoSync);
+    bool GetTempoSync() const;
+    void SetSyncValue(Sync::Value syncValue);
+    Sync::Value GetSyncValue() const;
 
     void ToJson(nlohmann::ordered_json& json) const override;
     void FromJson(const nlohmann::ordered_json& json) override;
@@ -47,5 +52,7 @@ public:
 private:
     float m_delay = 0;
     float m_feedback = 0;
+    Sync::Value m_syncValue = Sync::Value::Quarter;
+    bool m_tempoSync = false;
 };
 }  // namespace rf
\ No newline at end of file
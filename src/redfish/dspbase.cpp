@@ -35,4 +35,23 @@ void rf::DSPBase::SetBypass(bool bypass)
 bool rf::DSPBase::GetBypass() const
 {
     return m_bypass;
-}
\ No newline at end of file
+}
+
+void rf::DSPBase::SetSidechainMixGroup(MixGroupHandle mixGroupHandle)
+{
+    m_sidechainMixGroupHandle = mixGroupHandle;
+    if (!m_sidechainMixGroupHandle)
+    {
+        m_sidechain = nullptr;
+    }
+}
+
+rf::MixGroupHandle rf::DSPBase::GetSidechainMixGroup() const
+{
+    return m_sidechainMixGroupHandle;
+}
+
+void rf::DSPBase::SetSidechain(const MixItem* sidechain)
+{
+    m_sidechain = sidechain;
+}
@@ -22,6 +22,7 @@
 
 #pragma once
 #include "audiospec.h"
+#include "identifiers.h"
 
 namespace rf
 {
@@ -37,9 +38,14 @@ public:
 
     void SetBypass(bool bypass);
     bool GetBypass() const;
+    void SetSidechainMixGroup(MixGroupHandle mixGroupHandle);
+    MixGroupHandle GetSidechainMixGroup() const;
+    void SetSidechain(const MixItem* sidechain);
 
 protected:
     AudioSpec m_spec;
+    MixGroupHandle m_sidechainMixGroupHandle;
+    const MixItem* m_sidechain = nullptr;
     bool m_bypass = false;
 };
 }  // namespace rf
\ No newline at end of file
@@ -0,0 +1,106 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "duckerdsp.h"
+
+#include <cmath>
+
+#include "functions.h"
+#include "mixitem.h"
+#include "pluginutils.h"
+
+rf::DuckerDSP::DuckerDSP(const AudioSpec& spec)
+    : DSPBase(spec)
+    , m_gains(spec.m_bufferSize)
+{
+    SetThreshold(PluginUtils::k_defaultDuckerThreshold);
+    SetDepth(PluginUtils::k_defaultDuckerDepth);
+    SetAttack(PluginUtils::k_defaultDuckerAttack);
+    SetRelease(PluginUtils::k_defaultDuckerRelease);
+    SetHold(PluginUtils::k_defaultDuckerHold);
+}
+
+void rf::DuckerDSP::SetThreshold(float threshold)
+{
+    m_thresholdAmplitude = Functions::DecibelToAmplitude(threshold);
+}
+
+void rf::DuckerDSP::SetDepth(float depth)
+{
+    m_depthDb = depth;
+}
+
+void rf::DuckerDSP::SetAttack(float attack)
+{
+    m_attackCoefficient = ComputeCoefficient(attack);
+}
+
+void rf::DuckerDSP::SetRelease(float release)
+{
+    m_releaseCoefficient = ComputeCoefficient(release);
+}
+
+void rf::DuckerDSP::SetHold(float hold)
+{
+    m_holdSamples = Functions::MsToSamples(hold, m_spec.m_sampleRate);
+}
+
+float rf::DuckerDSP::ComputeCoefficient(float ms) const
+{
+    const float samples = ms * 0.001f * static_cast<float>(m_spec.m_sampleRate);
+    return samples > 1.0f ? expf(-1.0f / samples) : 0.0f;
+}
+
+void rf::DuckerDSP::Process(MixItem* mixItem, int bufferSize)
+{
+    // Without a key there is nothing to duck against, let the signal through untouched.
+    if (m_bypass || !m_sidechain)
+    {
+        return;
+    }
+
+    m_sidechain->GetLinkedPeaks(&m_gains, bufferSize);
+    float* gains = m_gains.GetAsFloatBuffer();
+
+    // The key opens the ducker whenever it crosses the threshold and keeps it open for the hold
+    // time, which stops the gain from chattering on every zero crossing of the key.
+    for (int i = 0; i < bufferSize; ++i)
+    {
+        if (gains[i] > m_thresholdAmplitude)
+        {
+            m_holdCounter = m_holdSamples + 1;
+        }
+        else if (m_holdCounter > 0)
+        {
+            --m_holdCounter;
+        }
+
+        const float target = m_holdCounter > 0 ? m_depthDb : 0.0f;
+        const float coefficient = target < m_gainDb ? m_attackCoefficient : m_releaseCoefficient;
+        m_gainDb = target + (m_gainDb - target) * coefficient;
+        gains[i] = m_gainDb;
+    }
+
+    Functions::DecibelToAmplitude(gains, gains, bufferSize);
+
+    mixItem->Multiply(m_gains, bufferSize);
+}
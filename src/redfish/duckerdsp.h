@@ -0,0 +1,53 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "buffer.h"
+#include "dspbase.h"
+
+namespace rf
+{
+class DuckerDSP : public DSPBase
+{
+public:
+    DuckerDSP(const AudioSpec& spec);
+
+    void SetThreshold(float threshold);
+    void SetDepth(float depth);
+    void SetAttack(float attack);
+    void SetRelease(float release);
+    void SetHold(float hold);
+    void Process(MixItem* mixItem, int bufferSize) override final;
+
+private:
+    float ComputeCoefficient(float ms) const;
+
+    Buffer m_gains;
+    float m_thresholdAmplitude = 0.0f;
+    float m_depthDb = 0.0f;
+    float m_attackCoefficient = 0.0f;
+    float m_releaseCoefficient = 0.0f;
+    float m_gainDb = 0.0f;
+    int m_holdSamples = 0;
+    int m_holdCounter = 0;
+};
+}  // namespace rf
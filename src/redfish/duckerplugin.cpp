@@ -0,0 +1,183 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "duckerplugin.h"
+
+#include "allocator.h"
+#include "commandprocessor.h"
+#include "context.h"
+#include "defines.h"
+#include "duckerdsp.h"
+#include "functions.h"
+#include "mixersystem.h"
+#include "mixgroup.h"
+#include "plugincommands.h"
+
+rf::DuckerPlugin::DuckerPlugin(Context* context, CommandProcessor* commands, MixGroupHandle mixGroupHandle, int mixGroupSlot, int pluginIndex)
+    : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::Ducker)
+{
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreateDuckerDSPCommand, DuckerDSP);
+}
+
+rf::DuckerPlugin::~DuckerPlugin()
+{
+    RF_SEND_PLUGIN_DESTROY_COMMAND(DestroyDuckerDSPCommand);
+}
+
+void rf::DuckerPlugin::SetThreshold(float threshold)
+{
+    if (Functions::FloatEquality(m_threshold, threshold))
+    {
+        return;
+    }
+
+    m_threshold = Functions::Clamp(threshold, RF_MIN_DECIBELS, RF_MAX_DECIBELS);
+
+    AudioCommand cmd;
+    SetDuckerDSPThresholdCommand& data = EncodeAudioCommand<SetDuckerDSPThresholdCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_threshold = m_threshold;
+    AddCommand(cmd);
+}
+
+float rf::DuckerPlugin::GetThreshold() const
+{
+    return m_threshold;
+}
+
+void rf::DuckerPlugin::SetDepth(float depth)
+{
+    if (Functions::FloatEquality(m_depth, depth))
+    {
+        return;
+    }
+
+    m_depth = Functions::Clamp(depth, RF_MIN_DECIBELS, 0.0f);
+
+    AudioCommand cmd;
+    SetDuckerDSPDepthCommand& data = EncodeAudioCommand<SetDuckerDSPDepthCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_depth = m_depth;
+    AddCommand(cmd);
+}
+
+float rf::DuckerPlugin::GetDepth() const
+{
+    return m_depth;
+}
+
+void rf::DuckerPlugin::SetAttack(float attack)
+{
+    if (Functions::FloatEquality(m_attack, attack))
+    {
+        return;
+    }
+
+    m_attack = Functions::Clamp(attack, 0.0f, 500.0f);
+
+    AudioCommand cmd;
+    SetDuckerDSPAttackCommand& data = EncodeAudioCommand<SetDuckerDSPAttackCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_attack = m_attack;
+    AddCommand(cmd);
+}
+
+float rf::DuckerPlugin::GetAttack() const
+{
+    return m_attack;
+}
+
+void rf::DuckerPlugin::SetRelease(float release)
+{
+    if (Functions::FloatEquality(m_release, release))
+    {
+        return;
+    }
+
+    m_release = Functions::Clamp(release, 0.0f, 5000.0f);
+
+    AudioCommand cmd;
+    SetDuckerDSPReleaseCommand& data = EncodeAudioCommand<SetDuckerDSPReleaseCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_release = m_release;
+    AddCommand(cmd);
+}
+
+float rf::DuckerPlugin::GetRelease() const
+{
+    return m_release;
+}
+
+void rf::DuckerPlugin::SetHold(float hold)
+{
+    if (Functions::FloatEquality(m_hold, hold))
+    {
+        return;
+    }
+
+    m_hold = Functions::Clamp(hold, 0.0f, PluginUtils::k_maxDuckerHold);
+
+    AudioCommand cmd;
+    SetDuckerDSPHoldCommand& data = EncodeAudioCommand<SetDuckerDSPHoldCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_hold = m_hold;
+    AddCommand(cmd);
+}
+
+float rf::DuckerPlugin::GetHold() const
+{
+    return m_hold;
+}
+
+void rf::DuckerPlugin::SetSidechain(const MixGroup* mixGroup)
+{
+    SetSidechainMixGroupHandle(mixGroup ? mixGroup->GetMixGroupHandle() : MixGroupHandle());
+}
+
+rf::MixGroup* rf::DuckerPlugin::GetSidechain() const
+{
+    return m_sidechainMixGroupHandle ? m_context->GetMixerSystem()->GetMixGroup(m_sidechainMixGroupHandle) : nullptr;
+}
+
+void rf::DuckerPlugin::ToJson(nlohmann::ordered_json& json) const
+{
+    json["threshold"] = GetThreshold();
+    json["depth"] = GetDepth();
+    json["attack"] = GetAttack();
+    json["release"] = GetRelease();
+    json["hold"] = GetHold();
+
+    const MixGroup* sidechain = GetSidechain();
+    json["sidechain"] = sidechain ? sidechain->GetName() : "";
+}
+
+void rf::DuckerPlugin::FromJson(const nlohmann::ordered_json& json)
+{
+    SetThreshold(json.value("threshold", GetThreshold()));
+    SetDepth(json.value("depth", GetDepth()));
+    SetAttack(json.value("attack", GetAttack()));
+    SetRelease(json.value("release", GetRelease()));
+    SetHold(json.value("hold", GetHold()));
+
+    const std::string sidechain = json.value("sidechain", std::string());
+    SetSidechain(sidechain.empty() ? nullptr : m_context->GetMixerSystem()->GetMixGroup(sidechain.c_str()));
+}
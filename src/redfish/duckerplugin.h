@@ -0,0 +1,65 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "identifiers.h"
+#include "pluginbase.h"
+#include "pluginutils.h"
+
+namespace rf
+{
+class MixGroup;
+
+class DuckerPlugin : public PluginBase
+{
+public:
+    DuckerPlugin(Context* context, CommandProcessor* commands, MixGroupHandle mixGroupHandle, int mixGroupSlot, int pluginIndex);
+    DuckerPlugin(const DuckerPlugin&) = delete;
+    DuckerPlugin(DuckerPlugin&&) = delete;
+    DuckerPlugin& operator=(const DuckerPlugin&) = delete;
+    DuckerPlugin& operator=(DuckerPlugin&&) = delete;
+    ~DuckerPlugin();
+
+    void SetThreshold(float threshold);
+    float GetThreshold() const;
+    void SetDepth(float depth);
+    float GetDepth() const;
+    void SetAttack(float attack);
+    float GetAttack() const;
+    void SetRelease(float release);
+    float GetRelease() const;
+    void SetHold(float hold);
+    float GetHold() const;
+    void SetSidechain(const MixGroup* mixGroup);
+    MixGroup* GetSidechain() const;
+
+    void ToJson(nlohmann::ordered_json& json) const override;
+    void FromJson(const nlohmann::ordered_json& json) override;
+
+private:
+    float m_threshold = PluginUtils::k_defaultDuckerThreshold;
+    float m_depth = PluginUtils::k_defaultDuckerDepth;
+    float m_attack = PluginUtils::k_defaultDuckerAttack;
+    float m_release = PluginUtils::k_defaultDuckerRelease;
+    float m_hold = PluginUtils::k_defaultDuckerHold;
+};
+}  // namespace rf
@@ -68,10 +68,8 @@ bool rf::Fader::Process_Part1_DoesFadeStartThisBuffer(int bufferSize, int* outPr
 
     if (m_state == State::SetBufferToCurrentAmplitude)
     {
-        for (int i = 0; i < bufferSize; ++i)
-        {
-            m_amplitudeBuffer[i] = m_currentAmplitude;
-        }
+        // The whole buffer, not just this block, since later blocks can be longer.
+        m_amplitudeBuffer.Set(m_currentAmplitude);
         m_isFadeComplete = true;
         m_state = State::StandBy;
     }
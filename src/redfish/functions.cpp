@@ -25,8 +25,13 @@
 #include <random>
 
 #include "basevoice.h"
+#include "defines.h"
 #include "messenger.h"
 
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+#    include <immintrin.h>
+#endif
+
 bool rf::Functions::FloatEquality(float x, float y)
 {
     const float epsilon = 1.192092896e-07F;
@@ -94,6 +99,84 @@ float rf::Functions::AmplitudeToDecibel(float amplitude)
     return 20.0f * log10f(amplitude);
 }
 
+void rf::Functions::DecibelToAmplitude(const float* decibels, float* outAmplitudes, int size)
+{
+    int i = 0;
+
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+    // 10^(dB / 20) computed as 2^y. The integer part of y goes straight into the exponent bits and
+    // 2^f for f in [-0.5, 0.5] is a 6th order polynomial, which is good to roughly 1e-5 dB.
+    const __m128 minDecibels = _mm_set1_ps(RF_MIN_DECIBELS);
+    const __m128 decibelToLog2 = _mm_set1_ps(0.166096404744368f);
+    for (; i + 4 <= size; i += 4)
+    {
+        const __m128 decibel = _mm_loadu_ps(decibels + i);
+        const __m128 y = _mm_min_ps(_mm_mul_ps(decibel, decibelToLog2), _mm_set1_ps(127.0f));
+        const __m128i n = _mm_cvtps_epi32(y);
+        const __m128 f = _mm_sub_ps(y, _mm_cvtepi32_ps(n));
+
+        __m128 p = _mm_set1_ps(1.5403530393381609e-4f);
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.3333558146428443e-3f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(9.6181291076284772e-3f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(5.5504108664821580e-2f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(2.4022650695910071e-1f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(6.9314718055994531e-1f));
+        p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f));
+
+        const __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+        const __m128 amplitude = _mm_mul_ps(p, scale);
+        _mm_storeu_ps(outAmplitudes + i, _mm_and_ps(amplitude, _mm_cmpgt_ps(decibel, minDecibels)));
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        outAmplitudes[i] = DecibelToAmplitude(decibels[i]);
+    }
+}
+
+void rf::Functions::AmplitudeToDecibel(const float* amplitudes, float* outDecibels, int size)
+{
+    int i = 0;
+
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+    // 20 * log10(x) computed from log2(x). The mantissa is folded into [sqrt(0.5), sqrt(2)) so the
+    // atanh series 2 * (t + t^3 / 3 + t^5 / 5 + t^7 / 7) with t = (m - 1) / (m + 1) converges quickly. Only silence
+    // is floored, at 1e-30 (-600 dB), so quiet signals keep their level for callers with thresholds below
+    // RF_MIN_DECIBELS.
+    const __m128 log2ToDecibel = _mm_set1_ps(6.020599913279624f);
+    const __m128 sqrtTwo = _mm_set1_ps(1.41421356237309504880f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= size; i += 4)
+    {
+        const __m128 amplitude = _mm_max_ps(_mm_loadu_ps(amplitudes + i), _mm_set1_ps(1e-30f));
+        const __m128i bits = _mm_castps_si128(amplitude);
+        __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+        __m128 mantissa = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+
+        const __m128 fold = _mm_cmpgt_ps(mantissa, sqrtTwo);
+        mantissa = _mm_sub_ps(mantissa, _mm_and_ps(fold, _mm_mul_ps(mantissa, _mm_set1_ps(0.5f))));
+        exponent = _mm_add_ps(exponent, _mm_and_ps(fold, one));
+
+        const __m128 t = _mm_div_ps(_mm_sub_ps(mantissa, one), _mm_add_ps(mantissa, one));
+        const __m128 t2 = _mm_mul_ps(t, t);
+        __m128 p = _mm_set1_ps(1.0f / 7.0f);
+        p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f / 5.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f / 3.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, t2), one);
+
+        // 2 / ln(2) turns the natural log series into log2.
+        const __m128 log2 = _mm_add_ps(exponent, _mm_mul_ps(_mm_mul_ps(p, t), _mm_set1_ps(2.885390081777927f)));
+        _mm_storeu_ps(outDecibels + i, _mm_mul_ps(log2, log2ToDecibel));
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+        outDecibels[i] = AmplitudeToDecibel(std::max(amplitudes[i], 1e-30f));
+    }
+}
+
 float rf::Functions::ComputePeakDecibel(float* sampleBuffer, int bufferSize)
 {
     float maxValue = 0.0f;
@@ -156,6 +239,16 @@ int rf::Functions::MsToSamples(float ms, int sampleRate)
     return static_cast<int>(sampleRate * (ms * 0.001f));
 }
 
+int rf::Functions::NextPowerOfTwo(int x)
+{
+    int result = 1;
+    while (result < x)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
 bool rf::Functions::InFirstWindow(long long playhead, long long startTime, int bufferSize)
 {
     return (startTime >= playhead) && (startTime < (playhead + bufferSize));
@@ -163,19 +256,30 @@ bool rf::Functions::InFirstWindow(long long playhead, long long startTime, int b
 
 void rf::Functions::SendVoiceStartMessage(const BaseVoice& voice, Messenger* messanger)
 {
+    if (voice.GetPlayingSoundId() < 0)
+    {
+        return;
+    }
+
     Message msg;
     msg.m_type = MessageType::ContextVoiceStart;
     Message::ContextVoiceStartData* data = msg.GetContextVoiceStartData();
-    data->m_audioHandle = voice.GetAudioHandle();
+    data->m_playingSoundId = voice.GetPlayingSoundId();
+    data->m_audioDataIndex = voice.GetAudioDataIndex();
     messanger->AddMessage(msg);
 }
 
 void rf::Functions::SendVoiceStopMessage(const BaseVoice& voice, Messenger* messanger)
 {
+    if (voice.GetPlayingSoundId() < 0)
+    {
+        return;
+    }
+
     Message msg;
     msg.m_type = MessageType::ContextVoiceStop;
     Message::ContextVoiceStopData* data = msg.GetContextVoiceStopData();
-    data->m_audioHandle = voice.GetAudioHandle();
+    data->m_playingSoundId = voice.GetPlayingSoundId();
     messanger->AddMessage(msg);
 }
 
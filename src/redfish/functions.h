@@ -40,12 +40,15 @@ int RandomInt(int min, int max);
 float RandomFloat(float min, float max);
 float DecibelToAmplitude(float decibel);
 float AmplitudeToDecibel(float amplitude);
+void DecibelToAmplitude(const float* decibels, float* outAmplitudes, int size);
+void AmplitudeToDecibel(const float* amplitudes, float* outDecibels, int size);
 float ComputePeakDecibel(float* sampleBuffer, int bufferSize);
 float ComputePeakAmplitude(float* sampleBuffer, int bufferSize);
 float ComputeRMSDecibel(float* sampleBuffer, int bufferSize);
 float ComputeRMSAmplitude(float* sampleBuffer, int bufferSize);
 float Int16ToFloat32(int16_t sample);
 int MsToSamples(float ms, int sampleRate);
+int NextPowerOfTwo(int x);
 bool InFirstWindow(long long playhead, long long startTime, int bufferSize);
 void SendVoiceStartMessage(const BaseVoice& voice, Messenger* messanger);
 void SendVoiceStopMessage(const BaseVoice& voice, Messenger* messanger);
@@ -42,7 +42,7 @@ void rf::Gain::SetAmplitude(float amplitude, bool interpolate)
 
 void rf::Gain::Process(MixItem* item, int bufferSize)
 {
-    const float start = m_amplitudeBuffer[bufferSize - 1];
+    const float start = m_currentAmplitude;
     if (Functions::FloatEquality(start, 1.0f) && Functions::FloatEquality(m_destinationAmplitude, 1.0f))
     {
         return;
@@ -69,6 +69,9 @@ void rf::Gain::Process(MixItem* item, int bufferSize)
         }
     }
 
+    // Blocks can be shorter than the amplitude buffer, so the next ramp starts from the last frame this one applied.
+    m_currentAmplitude = m_amplitudeBuffer[bufferSize - 1];
+
     const int numChannels = item->m_channels;
     Buffer* sampleData = item->m_arrayOfChannels;
     for (int i = 0; i < numChannels; ++i)
@@ -37,6 +37,7 @@ public:
 
 private:
     Buffer m_amplitudeBuffer;
+    float m_currentAmplitude = 1.0f;
     float m_destinationAmplitude = 1.0f;
     bool m_interpolate = true;
 };
@@ -22,15 +22,18 @@
 
 #include "gainplugin.h"
 
+#include "allocator.h"
 #include "commandprocessor.h"
+#include "context.h"
 #include "functions.h"
+#include "gaindsp.h"
 #include "plugincommands.h"
 #include "pluginutils.h"
 
 rf::GainPlugin::GainPlugin(Context* context, CommandProcessor* commands, MixGroupHandle mixGroupHandle, int mixGroupSlot, int pluginIndex)
     : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::Gain)
 {
-    RF_SEND_PLUGIN_CREATE_COMMAND(CreateGainDSPCommand);
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreateGainDSPCommand, GainDSP);
 }
 
 rf::GainPlugin::~GainPlugin()
@@ -51,7 +54,7 @@ void rf::GainPlugin::SetGainDb(float gainDb)
     SetGainDSPAmplitudeCommand& data = EncodeAudioCommand<SetGainDSPAmplitudeCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_amplitude = Functions::DecibelToAmplitude(m_gainDb);
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::GainPlugin::GetGainDb() const
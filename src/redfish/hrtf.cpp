@@ -0,0 +1,328 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "hrtf.h"
+
+#include <external/fftconvolver/FFTConvolver.h>
+#include <external/nlohmann/json.hpp>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include "allocator.h"
+#include "assert.h"
+#include "functions.h"
+#include "pluginutils.h"
+
+rf::HRTF::HRTF(const AudioSpec& spec)
+    : m_spec(spec)
+{
+}
+
+rf::HRTF::~HRTF()
+{
+    Free();
+}
+
+bool rf::HRTF::Load(const char* path)
+{
+    Free();
+
+    std::ifstream ifs(path);
+    if (!ifs)
+    {
+        RF_FAIL("Could not open HRTF file.");
+        return false;
+    }
+
+    const nlohmann::json json = nlohmann::json::parse(ifs, nullptr, false);
+    if (json.is_discarded() || !json.contains("SourcePosition") || !json.contains("Data.IR"))
+    {
+        RF_FAIL("HRTF file is malformed.");
+        return false;
+    }
+
+    const auto sampleRate = json.find("Data.SamplingRate");
+    if (sampleRate == json.end() || !sampleRate->is_number() || sampleRate->get<int>() != m_spec.m_sampleRate)
+    {
+        RF_FAIL("HRTF sample rate does not match the output sample rate.");
+        return false;
+    }
+
+    const nlohmann::json& positions = json["SourcePosition"];
+    const nlohmann::json& irs = json["Data.IR"];
+    if (!positions.is_array() || !irs.is_array() || positions.size() < k_numNearest || irs.size() != positions.size() ||
+        !irs[0].is_array() || irs[0].empty() || !irs[0][0].is_array())
+    {
+        RF_FAIL("HRTF file is malformed.");
+        return false;
+    }
+
+    const int numMeasurements = static_cast<int>(positions.size());
+    const int numFrames = static_cast<int>(irs[0][0].size());
+    if (numFrames == 0 || numFrames > PluginUtils::k_maxHRIRLength)
+    {
+        RF_FAIL("HRIRs must be at most PluginUtils::k_maxHRIRLength samples long.");
+        return false;
+    }
+
+    // Everything is checked before anything is built, so a malformed file neither throws nor leaves a partial HRTF.
+    for (int m = 0; m < numMeasurements; ++m)
+    {
+        const nlohmann::json& position = positions[m];
+        const nlohmann::json& pair = irs[m];
+        if (!position.is_array() || position.size() < 2 || !position[0].is_number() || !position[1].is_number() ||
+            !pair.is_array() || pair.size() != k_numEars)
+        {
+            RF_FAIL("HRTF file is malformed.");
+            return false;
+        }
+
+        for (int ear = 0; ear < k_numEars; ++ear)
+        {
+            const nlohmann::json& ir = pair[ear];
+            if (!ir.is_array() || static_cast<int>(ir.size()) != numFrames)
+            {
+                RF_FAIL("Every HRIR in an HRTF file must be the same length.");
+                return false;
+            }
+
+            for (const nlohmann::json& sample : ir)
+            {
+                if (!sample.is_number())
+                {
+                    RF_FAIL("HRTF file is malformed.");
+                    return false;
+                }
+            }
+        }
+    }
+
+    const int blockSize = m_spec.m_bufferSize;
+    const int segmentSize = static_cast<int>(fftconvolver::FFTConvolver::SegmentSize(blockSize));
+    m_numSegments = static_cast<int>(fftconvolver::FFTConvolver::SegmentCount(blockSize, numFrames));
+    m_measurements = Allocator::AllocateArray<Measurement>("HRTFMeasurements", numMeasurements);
+    m_numMeasurements = numMeasurements;
+
+    // The HRIRs are kept in the time domain until the ambisonic decode filters have been built from them.
+    const float degreesToRadians = PluginUtils::k_twoPi / 360.0f;
+    std::vector<float> hrirs(numMeasurements * k_numEars * numFrames, 0.0f);
+    for (int m = 0; m < numMeasurements; ++m)
+    {
+        const float azimuth = positions[m][0].get<float>() * degreesToRadians;
+        const float elevation = positions[m][1].get<float>() * degreesToRadians;
+
+        Measurement& measurement = m_measurements[m];
+        measurement.m_x = cosf(elevation) * cosf(azimuth);
+        measurement.m_y = cosf(elevation) * sinf(azimuth);
+        measurement.m_z = sinf(elevation);
+
+        for (int ear = 0; ear < k_numEars; ++ear)
+        {
+            const nlohmann::json& ir = irs[m][ear];
+            float* hrir = &hrirs[(m * k_numEars + ear) * numFrames];
+            for (int i = 0; i < numFrames; ++i)
+            {
+                hrir[i] = ir[i].get<float>();
+            }
+
+            measurement.m_segments[ear] = Allocator::AllocateArray<fftconvolver::SplitComplex>("HRTFSegments", m_numSegments, segmentSize);
+            fftconvolver::FFTConvolver::PrepareSegments(blockSize, hrir, numFrames, measurement.m_segments[ear]);
+        }
+    }
+
+    // Decoding an ambisonic bus to a set of virtual speakers and convolving every speaker with its HRIR pair is linear, so
+    // the speakers fold into one filter pair per ambisonic channel.
+    float directions[k_maxVirtualSpeakers * 3];
+    float weights[k_maxVirtualSpeakers];
+    const int numSpeakers = GetVirtualSpeakers(directions, weights);
+    std::vector<float> filters(Ambisonics::k_numChannels * k_numEars * numFrames, 0.0f);
+    for (int s = 0; s < numSpeakers; ++s)
+    {
+        const float* direction = &directions[s * 3];
+        int nearest[k_numNearest];
+        float nearestWeights[k_numNearest];
+        FindNearest(direction[0], direction[1], direction[2], nearest, nearestWeights);
+
+        float gains[Ambisonics::k_numChannels];
+        Ambisonics::Encode(direction[0], direction[1], direction[2], gains);
+
+        for (int channel = 0; channel < Ambisonics::k_numChannels; ++channel)
+        {
+            const float gain = weights[s] * Ambisonics::GetDecodeWeight(channel) * gains[channel];
+            for (int ear = 0; ear < k_numEars; ++ear)
+            {
+                float* filter = &filters[(channel * k_numEars + ear) * numFrames];
+                for (int n = 0; n < k_numNearest; ++n)
+                {
+                    const float* hrir = &hrirs[(nearest[n] * k_numEars + ear) * numFrames];
+                    const float amplitude = gain * nearestWeights[n];
+                    for (int i = 0; i < numFrames; ++i)
+                    {
+                        filter[i] += hrir[i] * amplitude;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int channel = 0; channel < Ambisonics::k_numChannels; ++channel)
+    {
+        for (int ear = 0; ear < k_numEars; ++ear)
+        {
+            const float* filter = &filters[(channel * k_numEars + ear) * numFrames];
+            m_ambisonicSegments[channel][ear] = Allocator::AllocateArray<fftconvolver::SplitComplex>("HRTFSegments", m_numSegments, segmentSize);
+            fftconvolver::FFTConvolver::PrepareSegments(blockSize, filter, numFrames, m_ambisonicSegments[channel][ear]);
+        }
+    }
+
+    return true;
+}
+
+const rf::HRTF::Measurement& rf::HRTF::GetMeasurement(int index) const
+{
+    RF_ASSERT(index >= 0 && index < m_numMeasurements, "Index out of bounds");
+    return m_measurements[index];
+}
+
+const fftconvolver::SplitComplex* rf::HRTF::GetAmbisonicSegments(int channel, int ear) const
+{
+    return m_ambisonicSegments[channel][ear];
+}
+
+int rf::HRTF::GetNumSegments() const
+{
+    return m_numSegments;
+}
+
+void rf::HRTF::FindNearest(float x, float y, float z, int* outIndices, float* outWeights) const
+{
+    float dots[k_numNearest];
+    for (int i = 0; i < k_numNearest; ++i)
+    {
+        outIndices[i] = 0;
+        dots[i] = -2.0f;
+    }
+
+    // Keep the closest measurements sorted by dot product, largest first.
+    for (int m = 0; m < m_numMeasurements; ++m)
+    {
+        const Measurement& measurement = m_measurements[m];
+        const float dot = x * measurement.m_x + y * measurement.m_y + z * measurement.m_z;
+        for (int i = 0; i < k_numNearest; ++i)
+        {
+            if (dot > dots[i])
+            {
+                for (int j = k_numNearest - 1; j > i; --j)
+                {
+                    dots[j] = dots[j - 1];
+                    outIndices[j] = outIndices[j - 1];
+                }
+
+                dots[i] = dot;
+                outIndices[i] = m;
+                break;
+            }
+        }
+    }
+
+    float sum = 0.0f;
+    for (int i = 0; i < k_numNearest; ++i)
+    {
+        const float angle = acosf(Functions::Clamp(dots[i], -1.0f, 1.0f));
+        outWeights[i] = 1.0f / (angle + 0.001f);
+        sum += outWeights[i];
+    }
+
+    for (int i = 0; i < k_numNearest; ++i)
+    {
+        outWeights[i] /= sum;
+    }
+}
+
+int rf::HRTF::GetVirtualSpeakers(float* outDirections, float* outWeights) const
+{
+    // A spherical design with its quadrature weights decodes exactly up to the ambisonic order. Order 1 uses the corners
+    // of a cube and order 3 adds the axes and edge midpoints to make the 26 point Lebedev grid.
+    int numSpeakers = 0;
+    const float corner = 1.0f / sqrtf(3.0f);
+    for (int i = 0; i < 8; ++i)
+    {
+        float* direction = &outDirections[numSpeakers * 3];
+        direction[0] = (i & 1) ? corner : -corner;
+        direction[1] = (i & 2) ? corner : -corner;
+        direction[2] = (i & 4) ? corner : -corner;
+        outWeights[numSpeakers++] = Ambisonics::k_order == 1 ? 1.0f / 8.0f : 9.0f / 280.0f;
+    }
+
+#if RF_AMBISONIC_ORDER == 3
+    const float edge = 1.0f / PluginUtils::k_sqrtTwo;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        for (int sign = -1; sign <= 1; sign += 2)
+        {
+            float* direction = &outDirections[numSpeakers * 3];
+            direction[0] = 0.0f;
+            direction[1] = 0.0f;
+            direction[2] = 0.0f;
+            direction[axis] = static_cast<float>(sign);
+            outWeights[numSpeakers++] = 1.0f / 21.0f;
+        }
+
+        // Edge midpoints lie in the plane where this axis is 0.
+        for (int i = 0; i < 4; ++i)
+        {
+            float* direction = &outDirections[numSpeakers * 3];
+            direction[axis] = 0.0f;
+            direction[(axis + 1) % 3] = (i & 1) ? edge : -edge;
+            direction[(axis + 2) % 3] = (i & 2) ? edge : -edge;
+            outWeights[numSpeakers++] = 4.0f / 105.0f;
+        }
+    }
+#endif
+
+    return numSpeakers;
+}
+
+void rf::HRTF::Free()
+{
+    for (int m = 0; m < m_numMeasurements; ++m)
+    {
+        for (int ear = 0; ear < k_numEars; ++ear)
+        {
+            Allocator::DeallocateArray<fftconvolver::SplitComplex>(&m_measurements[m].m_segments[ear], m_numSegments);
+        }
+    }
+
+    Allocator::DeallocateArray<Measurement>(&m_measurements, m_numMeasurements);
+
+    for (int channel = 0; channel < Ambisonics::k_numChannels; ++channel)
+    {
+        for (int ear = 0; ear < k_numEars; ++ear)
+        {
+            Allocator::DeallocateArray<fftconvolver::SplitComplex>(&m_ambisonicSegments[channel][ear], m_numSegments);
+        }
+    }
+
+    m_numMeasurements = 0;
+    m_numSegments = 0;
+}
@@ -0,0 +1,84 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "ambisonics.h"
+#include "audiospec.h"
+
+namespace fftconvolver
+{
+class SplitComplex;
+}  // namespace fftconvolver
+
+namespace rf
+{
+// A set of head related impulse responses, stored as frequency-domain partitions for the FFT convolver. Alongside the
+// measured HRIR pairs it holds one filter pair per ambisonic channel that decodes an ambisonic bus straight to binaural.
+// Built on the game thread and read-only once handed to the audio thread.
+//
+// The file is JSON laid out like a SOFA SimpleFreeFieldHRIR file:
+//     "Data.SamplingRate": must match the output sample rate.
+//     "SourcePosition": [azimuth, elevation, distance] per measurement. Azimuth is counter-clockwise in degrees.
+//     "Data.IR": [left, right] HRIR pair per measurement, at most PluginUtils::k_maxHRIRLength samples each.
+class HRTF
+{
+public:
+    static constexpr int k_numEars = 2;
+    static constexpr int k_numNearest = 3;
+
+    struct Measurement
+    {
+        // Unit vector towards the measured source. x is front, y is left and z is up.
+        float m_x = 0.0f;
+        float m_y = 0.0f;
+        float m_z = 0.0f;
+        fftconvolver::SplitComplex* m_segments[k_numEars] = {};
+    };
+
+    HRTF(const AudioSpec& spec);
+    HRTF(const HRTF&) = delete;
+    HRTF(HRTF&&) = delete;
+    HRTF& operator=(const HRTF&) = delete;
+    HRTF& operator=(HRTF&&) = delete;
+    ~HRTF();
+
+    bool Load(const char* path);
+    const Measurement& GetMeasurement(int index) const;
+    const fftconvolver::SplitComplex* GetAmbisonicSegments(int channel, int ear) const;
+    int GetNumSegments() const;
+    // Finds the measurements closest to a direction and weights them by their inverse angular distance. The weights sum
+    // to 1.
+    void FindNearest(float x, float y, float z, int* outIndices, float* outWeights) const;
+
+private:
+    static constexpr int k_maxVirtualSpeakers = 26;
+
+    AudioSpec m_spec;
+    Measurement* m_measurements = nullptr;
+    fftconvolver::SplitComplex* m_ambisonicSegments[Ambisonics::k_numChannels][k_numEars] = {};
+    int m_numMeasurements = 0;
+    int m_numSegments = 0;
+
+    int GetVirtualSpeakers(float* outDirections, float* outWeights) const;
+    void Free();
+};
+}  // namespace rf
@@ -52,5 +52,6 @@ RF_HANDLE_IMPLEMENTATION(PluginHandle);
 RF_HANDLE_IMPLEMENTATION(CueHandle);
 RF_HANDLE_IMPLEMENTATION(TransitionHandle);
 RF_HANDLE_IMPLEMENTATION(StingerHandle);
+RF_HANDLE_IMPLEMENTATION(EmitterHandle);
 
 #undef RF_HANDLE_IMPLEMENTATION
@@ -45,6 +45,7 @@ RF_HANDLE(PluginHandle);
 RF_HANDLE(CueHandle);
 RF_HANDLE(TransitionHandle);
 RF_HANDLE(StingerHandle);
+RF_HANDLE(EmitterHandle);
 
 #undef RF_HANDLE
 }  // namespace rf
\ No newline at end of file
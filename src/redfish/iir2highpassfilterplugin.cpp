@@ -22,8 +22,11 @@
 
 #include "iir2highpassfilterplugin.h"
 
+#include "allocator.h"
 #include "commandprocessor.h"
+#include "context.h"
 #include "functions.h"
+#include "iir2highpassfilterdsp.h"
 #include "plugincommands.h"
 
 rf::IIR2HighpassFilterPlugin::IIR2HighpassFilterPlugin(Context* context,
@@ -33,7 +36,7 @@ rf::IIR2HighpassFilterPlugin::IIR2HighpassFilterPlugin(Context* context,
                                                        int pluginIndex)
     : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::IIR2HighpassFilter)
 {
-    RF_SEND_PLUGIN_CREATE_COMMAND(CreateIIR2HighpassFilterDSPCommand);
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreateIIR2HighpassFilterDSPCommand, IIR2HighpassFilterDSP);
 }
 
 rf::IIR2HighpassFilterPlugin::~IIR2HighpassFilterPlugin()
@@ -54,7 +57,7 @@ void rf::IIR2HighpassFilterPlugin::SetQ(float q)
     SetIIR2HighpassFilterDSPQCommand& data = EncodeAudioCommand<SetIIR2HighpassFilterDSPQCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_q = m_q;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::IIR2HighpassFilterPlugin::GetQ() const
@@ -75,7 +78,7 @@ void rf::IIR2HighpassFilterPlugin::SetCutoff(float cutoff)
     SetIIR2HighpassFilterDSPCutoffCommand& data = EncodeAudioCommand<SetIIR2HighpassFilterDSPCutoffCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_cutoff = m_cutoff;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::IIR2HighpassFilterPlugin::GetCutoff() const
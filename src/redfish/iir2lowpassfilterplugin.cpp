@@ -22,8 +22,11 @@
 
 #include "iir2lowpassfilterplugin.h"
 
+#include "allocator.h"
 #include "commandprocessor.h"
+#include "context.h"
 #include "functions.h"
+#include "iir2lowpassfilterdsp.h"
 #include "plugincommands.h"
 
 rf::IIR2LowpassFilterPlugin::IIR2LowpassFilterPlugin(Context* context,
@@ -33,7 +36,7 @@ rf::IIR2LowpassFilterPlugin::IIR2LowpassFilterPlugin(Context* context,
                                                      int pluginIndex)
     : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::IIR2LowpassFilter)
 {
-    RF_SEND_PLUGIN_CREATE_COMMAND(CreateIIR2LowpassFilterDSPCommand);
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreateIIR2LowpassFilterDSPCommand, IIR2LowpassFilterDSP);
 }
 
 rf::IIR2LowpassFilterPlugin::~IIR2LowpassFilterPlugin()
@@ -54,7 +57,7 @@ void rf::IIR2LowpassFilterPlugin::SetQ(float q)
     SetIIR2LowpassFilterDSPQCommand& data = EncodeAudioCommand<SetIIR2LowpassFilterDSPQCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_q = m_q;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::IIR2LowpassFilterPlugin::GetQ() const
@@ -75,7 +78,7 @@ void rf::IIR2LowpassFilterPlugin::SetCutoff(float cutoff)
     SetIIR2LowpassFilterDSPCutoffCommand& data = EncodeAudioCommand<SetIIR2LowpassFilterDSPCutoffCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_cutoff = m_cutoff;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::IIR2LowpassFilterPlugin::GetCutoff() const
@@ -0,0 +1,184 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "irlibrary.h"
+
+#include <external/fftconvolver/FFTConvolver.h>
+
+#include "allocator.h"
+#include "assert.h"
+#include "audiodata.h"
+#include "commandprocessor.h"
+#include "loadcommands.h"
+#include "message.h"
+
+rf::IRLibrary::IRLibrary(const AudioSpec& spec, CommandProcessor* commands)
+    : m_commands(commands)
+    , m_blockSize(spec.m_bufferSize)
+    , m_segmentSize(static_cast<int>(fftconvolver::FFTConvolver::SegmentSize(spec.m_bufferSize)))
+{
+}
+
+rf::IRLibrary::~IRLibrary()
+{
+    for (int i = 0; i < RF_MAX_IMPULSE_RESPONSES; ++i)
+    {
+        Free(&m_impulseResponses[i]);
+    }
+}
+
+rf::IRLibrary::MemoryStats rf::IRLibrary::GetMemoryStats() const
+{
+    MemoryStats stats;
+    for (int i = 0; i < RF_MAX_IMPULSE_RESPONSES; ++i)
+    {
+        const ImpulseResponse& impulseResponse = m_impulseResponses[i];
+        if (impulseResponse.m_audioHandle)
+        {
+            stats.m_numBytes += impulseResponse.m_numBytes;
+            stats.m_numUnsharedBytes += impulseResponse.m_numBytes * impulseResponse.m_referenceCount;
+            stats.m_numReferences += impulseResponse.m_referenceCount;
+            ++stats.m_numImpulseResponses;
+        }
+    }
+    return stats;
+}
+
+const rf::ImpulseResponse* rf::IRLibrary::Acquire(AudioHandle audioHandle, const AudioData* audioData)
+{
+    if (!audioData)
+    {
+        RF_FAIL("Impulse response audio data is not loaded. Impulse response not loaded.");
+        return nullptr;
+    }
+
+    RF_ASSERT(!audioData->m_stream, "Impulse responses can't be streamed");
+    ImpulseResponse* freeSlot = nullptr;
+    for (int i = 0; i < RF_MAX_IMPULSE_RESPONSES; ++i)
+    {
+        ImpulseResponse& impulseResponse = m_impulseResponses[i];
+        if (impulseResponse.m_audioHandle == audioHandle)
+        {
+            ++impulseResponse.m_referenceCount;
+            return &impulseResponse;
+        }
+
+        // A slot is only reusable once the audio thread has let go of it.
+        if (!freeSlot && !impulseResponse.m_audioHandle && impulseResponse.m_pendingReleases == 0)
+        {
+            freeSlot = &impulseResponse;
+        }
+    }
+
+    if (audioData->m_numChannels != PluginUtils::k_impulseResponseChannels)
+    {
+        RF_FAIL("Incorrect impulse channel count for impulse response. Impulse response not loaded.");
+        return nullptr;
+    }
+
+    if (!freeSlot)
+    {
+        RF_FAIL("Too many impulse responses loaded. Try increasing RF_MAX_IMPULSE_RESPONSES");
+        return nullptr;
+    }
+
+    const int numFrames = audioData->m_numFrames;
+    const int numSegments = static_cast<int>(fftconvolver::FFTConvolver::SegmentCount(m_blockSize, numFrames));
+    for (int i = 0; i < PluginUtils::k_impulseResponseChannels; ++i)
+    {
+        freeSlot->m_segments[i] = Allocator::AllocateArray<fftconvolver::SplitComplex>("IRSegments", numSegments, m_segmentSize);
+        fftconvolver::FFTConvolver::PrepareSegments(m_blockSize, audioData->m_arrayOfChannels[i], numFrames, freeSlot->m_segments[i]);
+    }
+
+    freeSlot->m_audioHandle = audioHandle;
+    freeSlot->m_numSegments = numSegments;
+    freeSlot->m_numFrames = numFrames;
+    freeSlot->m_referenceCount = 1;
+    freeSlot->m_numBytes = sizeof(float) * 2 * m_segmentSize * numSegments * PluginUtils::k_impulseResponseChannels;
+    return freeSlot;
+}
+
+void rf::IRLibrary::Release(AudioHandle audioHandle)
+{
+    for (int i = 0; i < RF_MAX_IMPULSE_RESPONSES; ++i)
+    {
+        ImpulseResponse& impulseResponse = m_impulseResponses[i];
+        if (impulseResponse.m_audioHandle == audioHandle)
+        {
+            --impulseResponse.m_referenceCount;
+            RF_ASSERT(impulseResponse.m_referenceCount >= 0, "Bad reference counting");
+
+            if (impulseResponse.m_referenceCount == 0)
+            {
+                // The audio thread may still be convolving with this impulse response. The command is processed after
+                // any unload or destroy commands already sent by the convolvers, so the data is only freed once it
+                // comes back to us as a message.
+                ++impulseResponse.m_pendingReleases;
+
+                AudioCommand cmd;
+                ReleaseImpulseResponseCommand& data = EncodeAudioCommand<ReleaseImpulseResponseCommand>(&cmd);
+                data.m_index = i;
+                m_commands->Add(cmd);
+            }
+            return;
+        }
+    }
+
+    RF_FAIL("Cannot release impulse response");
+}
+
+void rf::IRLibrary::Free(ImpulseResponse* impulseResponse)
+{
+    for (int i = 0; i < PluginUtils::k_impulseResponseChannels; ++i)
+    {
+        Allocator::DeallocateArray<fftconvolver::SplitComplex>(&impulseResponse->m_segments[i], impulseResponse->m_numSegments);
+    }
+
+    impulseResponse->m_audioHandle = AudioHandle();
+    impulseResponse->m_numSegments = 0;
+    impulseResponse->m_numFrames = 0;
+    impulseResponse->m_referenceCount = 0;
+    impulseResponse->m_numBytes = 0;
+}
+
+bool rf::IRLibrary::ProcessMessages(const Message& message)
+{
+    switch (message.m_type)
+    {
+        case MessageType::ImpulseResponseDelete:
+        {
+            const int index = message.GetImpulseResponseDeleteData()->m_index;
+            RF_ASSERT(index >= 0 && index < RF_MAX_IMPULSE_RESPONSES, "Index out of bounds");
+            ImpulseResponse& impulseResponse = m_impulseResponses[index];
+            --impulseResponse.m_pendingReleases;
+            RF_ASSERT(impulseResponse.m_pendingReleases >= 0, "Bad release counting");
+
+            // The impulse response may have been acquired again while the release was in flight.
+            if (impulseResponse.m_referenceCount == 0 && impulseResponse.m_pendingReleases == 0)
+            {
+                Free(&impulseResponse);
+            }
+            return true;
+        }
+        default: return false;
+    }
+}
@@ -0,0 +1,91 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stddef.h>
+
+#include "audiospec.h"
+#include "defines.h"
+#include "identifiers.h"
+#include "pluginutils.h"
+
+namespace fftconvolver
+{
+class SplitComplex;
+}  // namespace fftconvolver
+
+namespace rf
+{
+class CommandProcessor;
+struct AudioData;
+struct Message;
+
+// The frequency-domain partitions of an impulse response. Read-only once created, and shared by every convolver that
+// loads the same audio asset.
+struct ImpulseResponse
+{
+    AudioHandle m_audioHandle;
+    fftconvolver::SplitComplex* m_segments[PluginUtils::k_impulseResponseChannels] = {};
+    int m_numSegments = 0;
+    int m_numFrames = 0;
+    int m_referenceCount = 0;
+    int m_pendingReleases = 0;
+    size_t m_numBytes = 0;
+};
+
+class IRLibrary
+{
+public:
+    struct MemoryStats
+    {
+        // Bytes used by the impulse responses currently loaded.
+        size_t m_numBytes = 0;
+        // Bytes that would be used if every convolver held its own copy of the impulse responses it loaded.
+        size_t m_numUnsharedBytes = 0;
+        int m_numImpulseResponses = 0;
+        int m_numReferences = 0;
+    };
+
+    IRLibrary(const AudioSpec& spec, CommandProcessor* commands);
+    IRLibrary(const IRLibrary&) = delete;
+    IRLibrary(IRLibrary&&) = delete;
+    IRLibrary& operator=(const IRLibrary&) = delete;
+    IRLibrary& operator=(IRLibrary&&) = delete;
+    ~IRLibrary();
+
+    MemoryStats GetMemoryStats() const;
+
+private:
+    ImpulseResponse m_impulseResponses[RF_MAX_IMPULSE_RESPONSES];
+    CommandProcessor* m_commands = nullptr;
+    int m_blockSize = 0;
+    int m_segmentSize = 0;
+
+    const ImpulseResponse* Acquire(AudioHandle audioHandle, const AudioData* audioData);
+    void Release(AudioHandle audioHandle);
+    void Free(ImpulseResponse* impulseResponse);
+    bool ProcessMessages(const Message& message);
+
+    friend class Context;
+    friend class ConvolverPlugin;
+};
+}  // namespace rf
@@ -22,23 +22,33 @@
 
 #include "layerset.h"
 
+#include <algorithm>
+
 #include "allocator.h"
 #include "assert.h"
 #include "audiospec.h"
 #include "audiotimeline.h"
+#include "buffer.h"
+#include "musicstreamer.h"
 #include "musicvoice.h"
 
-rf::LayerSet::LayerSet(const AudioSpec& spec, Messenger* messanger)
+// Even an instant change is spread over a few frames so that it does not click.
+static constexpr int k_minLayerRampFrames = 32;
+
+rf::LayerSet::LayerSet(const AudioSpec& spec, int maxLayers, Messenger* messanger)
     : m_messanger(messanger)
-    , m_bufferSize(spec.m_bufferSize)
+    , m_layerAmplitudes(maxLayers, spec.m_bufferSize)
+    , m_maxLayers(maxLayers)
 {
-    m_voices = Allocator::AllocateArray<MusicVoice>("MusicVoices", RF_MAX_CUE_LAYERS, spec);
+    m_voices = Allocator::AllocateArray<MusicVoice>("MusicVoices", m_maxLayers, spec);
+    m_layerGains = Allocator::AllocateArray<LayerGain>("MusicLayerGains", m_maxLayers);
     Reset();
 }
 
 rf::LayerSet::~LayerSet()
 {
-    Allocator::DeallocateArray<MusicVoice>(&m_voices, RF_MAX_CUE_LAYERS);
+    Allocator::DeallocateArray<MusicVoice>(&m_voices, m_maxLayers);
+    Allocator::DeallocateArray<LayerGain>(&m_layerGains, m_maxLayers);
 }
 
 void rf::LayerSet::Play(const MusicTransitionRequest& request,
@@ -46,7 +56,11 @@ void rf::LayerSet::Play(const MusicTransitionRequest& request,
                         const MusicDatabase::CueData& cueData,
                         const AudioData** audioData)
 {
+    // Layers still playing from the previous cue have to report their stop before their voices are reused.
+    Reset();
+
     m_numLayers = cueData.m_numLayers;
+    RF_ASSERT(m_numLayers <= m_maxLayers, "Too many layers. Increase MusicConfig::m_maxCueLayers");
     for (int i = 0; i < m_numLayers; ++i)
     {
         m_voices[i].Play(request.m_startTime, cueData, transitionData.m_playCount, i, audioData);
@@ -63,17 +77,44 @@ void rf::LayerSet::Reset()
     m_numLayers = 0;
 }
 
+void rf::LayerSet::SetLayerAmplitude(int layerIndex, float amplitude, int sampleDuration)
+{
+    RF_ASSERT(layerIndex >= 0 && layerIndex < m_maxLayers, "Index out of bounds");
+    LayerGain& gain = m_layerGains[layerIndex];
+    gain.m_destinationAmplitude = amplitude;
+    gain.m_numRampFrames = std::max(sampleDuration, k_minLayerRampFrames);
+    gain.m_increment = (amplitude - gain.m_amplitude) / static_cast<float>(gain.m_numRampFrames);
+}
+
+void rf::LayerSet::ProcessLayerAmplitudes(int bufferSize)
+{
+    for (int i = 0; i < m_maxLayers; ++i)
+    {
+        LayerGain& gain = m_layerGains[i];
+        float* amplitudes = m_layerAmplitudes.m_arrayOfChannels[i].GetAsFloatBuffer();
+
+        int j = 0;
+        for (; j < bufferSize && gain.m_numRampFrames > 0; ++j)
+        {
+            gain.m_amplitude = --gain.m_numRampFrames > 0 ? gain.m_amplitude + gain.m_increment : gain.m_destinationAmplitude;
+            amplitudes[j] = gain.m_amplitude;
+        }
+
+        for (; j < bufferSize; ++j)
+        {
+            amplitudes[j] = gain.m_amplitude;
+        }
+    }
+}
+
 rf::BaseVoice::Info rf::LayerSet::Process(long long playhead,
                                           int startingIndex,
                                           int fillSize,
+                                          int bufferSize,
                                           bool forceVoicesToDone,
                                           MixItem* outMixItems,
                                           int* outNumMixItems)
 {
-#if RF_ENABLE_ASSERTS
-    BaseVoice::Info infoCheck[RF_MAX_CUE_LAYERS];
-#endif
-
     BaseVoice::Info info;
 
     if (fillSize == 0)
@@ -81,11 +122,35 @@ rf::BaseVoice::Info rf::LayerSet::Process(long long playhead,
         return info;
     }
 
+    // Layers that share a mix group are summed straight into one mix item, with their amplitudes applied as they are
+    // read, so the mixer sees one item per mix group rather than one per layer.
+    const int firstMixItem = *outNumMixItems;
+#if RF_ENABLE_ASSERTS
+    BaseVoice::Info firstInfo;
+#endif
     for (int i = 0; i < m_numLayers; ++i)
     {
-        MixItem* item = &outMixItems[(*outNumMixItems)++];
-        RF_ASSERT(*outNumMixItems < AudioTimeline::GetMaxNumMixItems(), "Too many mix items will be generated. Increase RF_MAX_VOICES");
-        info = m_voices[i].FillMixItemBase(playhead, item, startingIndex, fillSize, m_bufferSize, m_messanger);
+        const MixGroupHandle mixGroupHandle = m_voices[i].GetMixGroupHandle();
+        MixItem* item = nullptr;
+        for (int j = firstMixItem; j < *outNumMixItems; ++j)
+        {
+            if (outMixItems[j].m_mixGroupHandle == mixGroupHandle)
+            {
+                item = &outMixItems[j];
+                break;
+            }
+        }
+
+        if (!item)
+        {
+            item = &outMixItems[(*outNumMixItems)++];
+            RF_ASSERT(*outNumMixItems < AudioTimeline::GetMaxNumMixItems(), "Too many mix items will be generated. Increase RF_MAX_VOICES");
+            item->ZeroOut();
+            item->m_mixGroupHandle = mixGroupHandle;
+        }
+
+        const float* amplitudes = m_layerAmplitudes.m_arrayOfChannels[i].GetAsFloatBuffer();
+        info = m_voices[i].MixIntoMixItemBase(playhead, item, amplitudes, m_voices[i].GetAmplitude(), startingIndex, fillSize, bufferSize, m_messanger);
         RF_ASSERT(item->m_mixGroupHandle, "Mix item has no mix group. This is incorrect.");
 
         if (info.m_done || forceVoicesToDone)
@@ -94,7 +159,15 @@ rf::BaseVoice::Info rf::LayerSet::Process(long long playhead,
         }
 
 #if RF_ENABLE_ASSERTS
-        infoCheck[i] = info;
+        // Remove the audio handle info from the compare because we'd expect the handles to be different for different
+        // layers.
+        BaseVoice::Info compare = info;
+        compare.m_audioHandle = AudioHandle();
+        if (i == 0)
+        {
+            firstInfo = compare;
+        }
+        RF_ASSERT(compare == firstInfo, "Expected the same info");
 #endif
     }
 
@@ -103,18 +176,6 @@ rf::BaseVoice::Info rf::LayerSet::Process(long long playhead,
         Reset();
     }
 
-#if RF_ENABLE_ASSERTS
-    // Remove the audio handle info from the compare because we'd expect the handles to be different for different layers.
-    BaseVoice::Info compare1 = infoCheck[0];
-    compare1.m_audioHandle = AudioHandle();
-    for (int i = 0; i < m_numLayers; ++i)
-    {
-        BaseVoice::Info compare2 = infoCheck[i];
-        compare2.m_audioHandle = AudioHandle();
-        RF_ASSERT(compare1 == compare2, "Expected the same info");
-    }
-#endif
-
     return info;
 }
 
@@ -126,4 +187,12 @@ bool rf::LayerSet::IsPlaying() const
         isPlaying = m_voices[i].IsPlaying() || isPlaying;
     }
     return isPlaying;
+}
+
+void rf::LayerSet::RequireStreams(MusicStreamer* streamer) const
+{
+    for (int i = 0; i < m_numLayers; ++i)
+    {
+        streamer->Require(m_voices[i].GetAudioDataIndex(), m_voices[i].GetStartTime());
+    }
 }
\ No newline at end of file
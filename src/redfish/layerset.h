@@ -22,12 +22,14 @@
 
 #pragma once
 #include "basevoice.h"
+#include "mixitem.h"
 #include "musicdatabase.h"
 #include "musictransitionrequest.h"
 
 namespace rf
 {
 class Messenger;
+class MusicStreamer;
 class MusicVoice;
 class RedFishContext;
 struct AudioSpec;
@@ -35,7 +37,7 @@ struct AudioSpec;
 class LayerSet
 {
 public:
-    LayerSet(const AudioSpec& spec, Messenger* messanger);
+    LayerSet(const AudioSpec& spec, int maxLayers, Messenger* messanger);
     ~LayerSet();
 
     void Play(const MusicTransitionRequest& request,
@@ -43,13 +45,36 @@ public:
               const MusicDatabase::CueData& cueData,
               const AudioData** audioData);
     void Reset();
-    BaseVoice::Info Process(long long playhead, int startingIndex, int fillSize, bool forceVoicesToDone, MixItem* outMixItems, int* outNumMixItems);
+    // Ramps a layer to amplitude over sampleDuration frames. The layer mix is kept across cues, so it follows the music
+    // through transitions.
+    void SetLayerAmplitude(int layerIndex, float amplitude, int sampleDuration);
+    // Works out the amplitude of every layer for each frame of the block. Called once per block, before Process.
+    void ProcessLayerAmplitudes(int bufferSize);
+    BaseVoice::Info Process(long long playhead,
+                            int startingIndex,
+                            int fillSize,
+                            int bufferSize,
+                            bool forceVoicesToDone,
+                            MixItem* outMixItems,
+                            int* outNumMixItems);
     bool IsPlaying() const;
+    void RequireStreams(MusicStreamer* streamer) const;
 
 private:
+    struct LayerGain
+    {
+        float m_amplitude = 1.0f;
+        float m_destinationAmplitude = 1.0f;
+        float m_increment = 0.0f;
+        int m_numRampFrames = 0;
+    };
+
     Messenger* m_messanger = nullptr;
     MusicVoice* m_voices = nullptr;
+    LayerGain* m_layerGains = nullptr;
+    // One channel per layer, holding the layer mix amplitude for each frame of the block.
+    MixItem m_layerAmplitudes;
+    int m_maxLayers = 0;
     int m_numLayers = 0;
-    int m_bufferSize = 0;
 };
 }  // namespace rf
\ No newline at end of file
@@ -24,37 +24,211 @@
 
 #include <cmath>
 
+#include "allocator.h"
 #include "functions.h"
 #include "mixitem.h"
+#include "pluginutils.h"
 
 rf::LimiterDSP::LimiterDSP(const AudioSpec& spec)
     : DSPBase(spec)
+    , m_truePeakCoefficients(k_truePeakTaps * k_truePeakPhases)
 {
+    m_maxLookahead = Functions::MsToSamples(PluginUtils::k_maxLimiterLookahead, m_spec.m_sampleRate);
+    m_ringSize = Functions::NextPowerOfTwo(m_maxLookahead + k_truePeakLatency + 1);
+    m_ringMask = m_ringSize - 1;
+
+    m_delayLine = Allocator::AllocateArray<Buffer>("LimiterDelayLine", spec.m_channels, m_ringSize);
+    m_truePeakHistory = Allocator::AllocateArray<Buffer>("LimiterTruePeakHistory", spec.m_channels, k_truePeakTaps * 2);
+    m_peaks = Allocator::Allocate<Buffer>("LimiterPeaks", m_ringSize);
+    m_holdValues = Allocator::Allocate<Buffer>("LimiterHoldValues", m_ringSize);
+    m_gains = Allocator::Allocate<Buffer>("LimiterGains", m_ringSize);
+    m_holdTimes = Allocator::AllocateArray<unsigned int>("LimiterHoldTimes", m_ringSize);
+    m_gains->Set(1.0f);
+
+    // Windowed sinc interpolators laid out tap-major so that one multiply-add per tap produces
+    // all 4 phases at once. Phase p estimates the signal p/4 of a sample after the latency point.
+    const float pi = PluginUtils::k_twoPi * 0.5f;
+    float* coefficients = m_truePeakCoefficients.GetAsFloatBuffer();
+    for (int p = 0; p < k_truePeakPhases; ++p)
+    {
+        float sum = 0.0f;
+        for (int k = 0; k < k_truePeakTaps; ++k)
+        {
+            const float t = static_cast<float>(k_truePeakTaps - 1 - k - k_truePeakLatency) + static_cast<float>(p) / k_truePeakPhases;
+            const float sinc = fabsf(t) < 1e-6f ? 1.0f : sinf(pi * t) / (pi * t);
+            const float window = 0.5f + 0.5f * cosf(pi * t / (k_truePeakLatency + 0.5f));
+            coefficients[k * k_truePeakPhases + p] = sinc * window;
+            sum += sinc * window;
+        }
+
+        for (int k = 0; k < k_truePeakTaps; ++k)
+        {
+            coefficients[k * k_truePeakPhases + p] /= sum;
+        }
+    }
+
+    SetRelease(Functions::MsToSamples(PluginUtils::k_defaultLimiterRelease, m_spec.m_sampleRate));
+    SetLookahead(Functions::MsToSamples(PluginUtils::k_defaultLimiterLookahead, m_spec.m_sampleRate));
+}
+
+rf::LimiterDSP::~LimiterDSP()
+{
+    Allocator::DeallocateArray<Buffer>(&m_delayLine, m_spec.m_channels);
+    Allocator::DeallocateArray<Buffer>(&m_truePeakHistory, m_spec.m_channels);
+    Allocator::Deallocate<Buffer>(&m_peaks);
+    Allocator::Deallocate<Buffer>(&m_holdValues);
+    Allocator::Deallocate<Buffer>(&m_gains);
+    Allocator::DeallocateArray<unsigned int>(&m_holdTimes, m_ringSize);
 }
 
 void rf::LimiterDSP::SetThreshold(float threshold)
 {
-    m_threshold = threshold;
+    m_thresholdAmplitude = Functions::DecibelToAmplitude(threshold);
+}
+
+void rf::LimiterDSP::SetLookahead(int lookahead)
+{
+    m_lookahead = Functions::Clamp(lookahead, 1, m_maxLookahead);
+    ResetWindow();
+}
+
+void rf::LimiterDSP::SetRelease(int release)
+{
+    m_releaseCoefficient = expf(-1.0f / static_cast<float>(release > 1 ? release : 1));
+}
+
+void rf::LimiterDSP::SetTruePeak(bool truePeak)
+{
+    m_truePeak = truePeak;
+    ResetWindow();
+}
+
+void rf::LimiterDSP::ResetWindow()
+{
+    // The signal is delayed by the lookahead plus whatever latency the detector adds. Changing either
+    // moves the read head, so rebuild the sliding max and the gain average over the new window from
+    // the history instead of letting them catch up.
+    m_delay = m_lookahead + (m_truePeak ? k_truePeakLatency : 0);
+
+    Buffer& peaks = *m_peaks;
+    Buffer& holdValues = *m_holdValues;
+    Buffer& gains = *m_gains;
+
+    m_holdHead = 0;
+    m_holdTail = 0;
+    m_gainSum = 0.0;
+    for (unsigned int time = m_time - m_lookahead; time != m_time; ++time)
+    {
+        const float peak = peaks[time & m_ringMask];
+        while (m_holdTail != m_holdHead && holdValues[(m_holdTail - 1) & m_ringMask] <= peak)
+        {
+            --m_holdTail;
+        }
+        holdValues[m_holdTail & m_ringMask] = peak;
+        m_holdTimes[m_holdTail & m_ringMask] = time;
+        ++m_holdTail;
+
+        m_gainSum += gains[time & m_ringMask];
+    }
+}
+
+float rf::LimiterDSP::DetectTruePeak(int channel, float sample)
+{
+    // The history is written twice so the last k_truePeakTaps samples are always contiguous.
+    float* history = m_truePeakHistory[channel].GetAsFloatBuffer();
+    history[m_truePeakWrite] = sample;
+    history[m_truePeakWrite + k_truePeakTaps] = sample;
+    const float* window = history + m_truePeakWrite + 1;
+    const float* coefficients = m_truePeakCoefficients.GetAsFloatBuffer();
+
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+    __m128 phases = _mm_setzero_ps();
+    for (int k = 0; k < k_truePeakTaps; ++k)
+    {
+        const __m128 tap = _mm_load_ps(coefficients + k * k_truePeakPhases);
+        phases = _mm_add_ps(phases, _mm_mul_ps(_mm_set1_ps(window[k]), tap));
+    }
+
+    phases = _mm_andnot_ps(_mm_set1_ps(-0.0f), phases);
+    phases = _mm_max_ps(phases, _mm_shuffle_ps(phases, phases, _MM_SHUFFLE(2, 3, 0, 1)));
+    phases = _mm_max_ps(phases, _mm_shuffle_ps(phases, phases, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(phases);
+#else
+    float peak = 0.0f;
+    for (int p = 0; p < k_truePeakPhases; ++p)
+    {
+        float phase = 0.0f;
+        for (int k = 0; k < k_truePeakTaps; ++k)
+        {
+            phase += window[k] * coefficients[k * k_truePeakPhases + p];
+        }
+        peak = fabsf(phase) > peak ? fabsf(phase) : peak;
+    }
+    return peak;
+#endif
 }
 
-void rf::LimiterDSP::Process(MixItem* mixItem, int)
+void rf::LimiterDSP::Process(MixItem* mixItem, int bufferSize)
 {
     if (m_bypass)
     {
         return;
     }
 
-    const float max = fabsf(mixItem->GetPeakAmplitude());
-    const float maxDb = Functions::AmplitudeToDecibel(max);
-    float difference = m_threshold - maxDb;
+    Buffer* buffer = mixItem->m_arrayOfChannels;
+    const int numChannels = mixItem->m_channels;
+    Buffer& peaks = *m_peaks;
+    Buffer& holdValues = *m_holdValues;
+    Buffer& gains = *m_gains;
+    const float inverseLookahead = 1.0f / static_cast<float>(m_lookahead);
 
-    if (difference < 0.0f)
+    for (int i = 0; i < bufferSize; ++i)
     {
-        const float ampDifference = Functions::DecibelToAmplitude(difference);
-        const int numChannels = mixItem->m_channels;
-        for (int i = 0; i < numChannels; ++i)
+        const int write = m_time & m_ringMask;
+        const int read = (m_time - m_delay) & m_ringMask;
+
+        // Channels are linked so the stereo image doesn't shift while limiting.
+        float peak = 0.0f;
+        for (int c = 0; c < numChannels; ++c)
+        {
+            const float sample = buffer[c][i];
+            const float channelPeak = m_truePeak ? DetectTruePeak(c, sample) : fabsf(sample);
+            peak = channelPeak > peak ? channelPeak : peak;
+            m_delayLine[c][write] = sample;
+        }
+        m_truePeakWrite = (m_truePeakWrite + 1) & (k_truePeakTaps - 1);
+        peaks[write] = peak;
+
+        // Sliding max over the last m_lookahead + 1 peaks. Every peak enters and leaves the deque
+        // once, so this is O(1) per sample.
+        while (m_holdTail != m_holdHead && holdValues[(m_holdTail - 1) & m_ringMask] <= peak)
+        {
+            --m_holdTail;
+        }
+        holdValues[m_holdTail & m_ringMask] = peak;
+        m_holdTimes[m_holdTail & m_ringMask] = m_time;
+        ++m_holdTail;
+        while (m_time - m_holdTimes[m_holdHead & m_ringMask] > static_cast<unsigned int>(m_lookahead))
         {
-            mixItem->m_arrayOfChannels[i].ScalarMultiply(ampDifference);
+            ++m_holdHead;
         }
+
+        // Attack instantly to the gain the loudest upcoming peak needs and release exponentially.
+        const float windowPeak = holdValues[m_holdHead & m_ringMask];
+        const float target = windowPeak > m_thresholdAmplitude ? m_thresholdAmplitude / windowPeak : 1.0f;
+        m_envelope = target < m_envelope ? target : target + (m_envelope - target) * m_releaseCoefficient;
+
+        // Averaging the envelope over the lookahead turns the instant attack into a ramp that
+        // reaches the required gain exactly when the peak leaves the delay line.
+        m_gainSum += m_envelope - gains[(m_time - m_lookahead) & m_ringMask];
+        gains[write] = m_envelope;
+        const float gain = static_cast<float>(m_gainSum) * inverseLookahead;
+
+        for (int c = 0; c < numChannels; ++c)
+        {
+            buffer[c][i] = m_delayLine[c][read] * gain;
+        }
+
+        ++m_time;
     }
-}
\ No newline at end of file
+}
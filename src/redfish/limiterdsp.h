@@ -30,11 +30,48 @@ class LimiterDSP : public DSPBase
 {
 public:
     LimiterDSP(const AudioSpec& spec);
+    LimiterDSP(const LimiterDSP&) = delete;
+    LimiterDSP(LimiterDSP&&) = delete;
+    LimiterDSP& operator=(const LimiterDSP&) = delete;
+    LimiterDSP& operator=(LimiterDSP&&) = delete;
+    ~LimiterDSP();
 
     void SetThreshold(float threshold);
+    void SetLookahead(int lookahead);
+    void SetRelease(int release);
+    void SetTruePeak(bool truePeak);
     void Process(MixItem* mixItem, int bufferSize) override final;
 
 private:
-    float m_threshold = 0.0f;
+    // The true-peak detector interpolates 3 extra points between every input sample with a 16 tap
+    // polyphase filter. Phase 0 is the input sample itself, delayed by half the filter length.
+    static constexpr int k_truePeakTaps = 16;
+    static constexpr int k_truePeakPhases = 4;
+    static constexpr int k_truePeakLatency = k_truePeakTaps / 2;
+
+    float DetectTruePeak(int channel, float sample);
+    void ResetWindow();
+
+    Buffer* m_delayLine = nullptr;
+    Buffer* m_truePeakHistory = nullptr;
+    Buffer m_truePeakCoefficients;
+    Buffer* m_peaks = nullptr;
+    Buffer* m_holdValues = nullptr;
+    Buffer* m_gains = nullptr;
+    unsigned int* m_holdTimes = nullptr;
+    double m_gainSum = 0.0;
+    float m_thresholdAmplitude = 1.0f;
+    float m_releaseCoefficient = 0.0f;
+    float m_envelope = 1.0f;
+    unsigned int m_time = 0;
+    int m_ringSize = 0;
+    int m_ringMask = 0;
+    int m_maxLookahead = 1;
+    int m_lookahead = 1;
+    int m_delay = 1;
+    unsigned int m_holdHead = 0;
+    unsigned int m_holdTail = 0;
+    int m_truePeakWrite = 0;
+    bool m_truePeak = false;
 };
-}  // namespace rf
\ No newline at end of file
+}  // namespace rf
@@ -22,15 +22,18 @@
 
 #include "limiterplugin.h"
 
+#include "allocator.h"
 #include "commandprocessor.h"
+#include "context.h"
 #include "functions.h"
+#include "limiterdsp.h"
 #include "plugincommands.h"
 #include "pluginutils.h"
 
 rf::LimiterPlugin::LimiterPlugin(Context* context, CommandProcessor* commands, MixGroupHandle mixGroupHandle, int mixGroupSlot, int pluginIndex)
     : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::Limiter)
 {
-    RF_SEND_PLUGIN_CREATE_COMMAND(CreateLimiterDSPCommand);
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreateLimiterDSPCommand, LimiterDSP);
 }
 
 rf::LimiterPlugin::~LimiterPlugin()
@@ -51,7 +54,7 @@ void rf::LimiterPlugin::SetThreshold(float threshold)
     SetLimiterDSPThresholdCommand& data = EncodeAudioCommand<SetLimiterDSPThresholdCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_threshold = m_threshold;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::LimiterPlugin::GetThreshold() const
@@ -59,12 +62,81 @@ float rf::LimiterPlugin::GetThreshold() const
     return m_threshold;
 }
 
+void rf::LimiterPlugin::SetLookahead(float lookahead)
+{
+    if (Functions::FloatEquality(m_lookahead, lookahead))
+    {
+        return;
+    }
+
+    m_lookahead = Functions::Clamp(lookahead, 0.0f, PluginUtils::k_maxLimiterLookahead);
+
+    AudioCommand cmd;
+    SetLimiterDSPLookaheadCommand& data = EncodeAudioCommand<SetLimiterDSPLookaheadCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_lookahead = Functions::MsToSamples(m_lookahead, m_context->GetAudioSpec().m_sampleRate);
+    AddCommand(cmd);
+}
+
+float rf::LimiterPlugin::GetLookahead() const
+{
+    return m_lookahead;
+}
+
+void rf::LimiterPlugin::SetRelease(float release)
+{
+    if (Functions::FloatEquality(m_release, release))
+    {
+        return;
+    }
+
+    m_release = Functions::Clamp(release, PluginUtils::k_minLimiterRelease, PluginUtils::k_maxLimiterRelease);
+
+    AudioCommand cmd;
+    SetLimiterDSPReleaseCommand& data = EncodeAudioCommand<SetLimiterDSPReleaseCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_release = Functions::MsToSamples(m_release, m_context->GetAudioSpec().m_sampleRate);
+    AddCommand(cmd);
+}
+
+float rf::LimiterPlugin::GetRelease() const
+{
+    return m_release;
+}
+
+void rf::LimiterPlugin::SetTruePeak(bool truePeak)
+{
+    if (m_truePeak == truePeak)
+    {
+        return;
+    }
+
+    m_truePeak = truePeak;
+
+    AudioCommand cmd;
+    SetLimiterDSPTruePeakCommand& data = EncodeAudioCommand<SetLimiterDSPTruePeakCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_truePeak = m_truePeak;
+    AddCommand(cmd);
+}
+
+bool rf::LimiterPlugin::GetTruePeak() const
+{
+    return m_truePeak;
+}
+
 void rf::LimiterPlugin::ToJson(nlohmann::ordered_json& json) const
 {
     json["threshold"] = GetThreshold();
+    json["lookahead"] = GetLookahead();
+    json["release"] = GetRelease();
+    json["truePeak"] = GetTruePeak();
 }
 
 void rf::LimiterPlugin::FromJson(const nlohmann::ordered_json& json)
 {
     SetThreshold(json.value("threshold", GetThreshold()));
+    SetLookahead(json.value("lookahead", GetLookahead()));
+    SetRelease(json.value("release", GetRelease()));
+    SetTruePeak(json.value("truePeak", GetTruePeak()));
 }
\ No newline at end of file
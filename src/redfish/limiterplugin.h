@@ -23,6 +23,7 @@
 #pragma once
 #include "identifiers.h"
 #include "pluginbase.h"
+#include "pluginutils.h"
 
 namespace rf
 {
@@ -38,11 +39,20 @@ public:
 
     void SetThreshold(float threshold);
     float GetThreshold() const;
+    void SetLookahead(float lookahead);
+    float GetLookahead() const;
+    void SetRelease(float release);
+    float GetRelease() const;
+    void SetTruePeak(bool truePeak);
+    bool GetTruePeak() const;
 
     void ToJson(nlohmann::ordered_json& json) const override;
     void FromJson(const nlohmann::ordered_json& json) override;
 
 private:
     float m_threshold = 0.0f;
+    float m_lookahead = PluginUtils::k_defaultLimiterLookahead;
+    float m_release = PluginUtils::k_defaultLimiterRelease;
+    bool m_truePeak = false;
 };
 }  // namespace rf
\ No newline at end of file
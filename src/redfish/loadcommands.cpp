@@ -23,10 +23,12 @@
 #include "loadcommands.h"
 
 #include "audiotimeline.h"
+#include "tracecapture.h"
 
 rf::AudioCommandCallback rf::LoadAudioDataCommand::s_callback = [](AudioTimeline* timeline, void* command) {
     const LoadAudioDataCommand& cmd = *static_cast<LoadAudioDataCommand*>(command);
     timeline->m_audioDataReferences[cmd.m_index] = cmd.m_audioData;
+    timeline->m_musicManager.Load(cmd.m_index, cmd.m_audioHandle, cmd.m_audioData);
 };
 
 rf::AudioCommandCallback rf::UnloadAudioDataCommand::s_callback = [](AudioTimeline* timeline, void* command) {
@@ -43,4 +45,28 @@ rf::AudioCommandCallback rf::ClearAudioDataReferenceCommand::s_callback = [](Aud
     timeline->m_audioDataReferences[cmd.m_index] = nullptr;
 };
 
-rf::AudioCommandCallback rf::ShutdownCommand::s_callback = [](AudioTimeline* timeline, void*) { timeline->Shutdown(); };
\ No newline at end of file
+rf::AudioCommandCallback rf::ReleaseImpulseResponseCommand::s_callback = [](AudioTimeline* timeline, void* command) {
+    const ReleaseImpulseResponseCommand& cmd = *static_cast<ReleaseImpulseResponseCommand*>(command);
+    Message msg;
+    msg.m_type = MessageType::ImpulseResponseDelete;
+    msg.GetImpulseResponseDeleteData()->m_index = cmd.m_index;
+    timeline->m_messenger.AddMessage(msg);
+};
+
+rf::AudioCommandCallback rf::LoadHRTFCommand::s_callback = [](AudioTimeline* timeline, void* command) {
+    const LoadHRTFCommand& cmd = *static_cast<LoadHRTFCommand*>(command);
+    timeline->m_voiceSet.SetHRTF(cmd.m_hrtf);
+};
+
+rf::AudioCommandCallback rf::ShutdownCommand::s_callback = [](AudioTimeline* timeline, void*) { timeline->Shutdown(); };
+
+rf::AudioCommandCallback rf::StartTraceCaptureCommand::s_callback = [](AudioTimeline*, void*) { TraceCapture::BeginAudioCapture(); };
+
+rf::AudioCommandCallback rf::StopTraceCaptureCommand::s_callback = [](AudioTimeline* timeline, void*) {
+    TraceCapture::EndAudioCapture();
+
+    // The game thread can read the capture once it gets this message.
+    Message msg;
+    msg.m_type = MessageType::TraceCaptureComplete;
+    timeline->m_messenger.AddMessage(msg);
+};
\ No newline at end of file
@@ -26,10 +26,12 @@
 
 namespace rf
 {
+class HRTF;
 struct AudioData;
 
 struct LoadAudioDataCommand
 {
+    AudioHandle m_audioHandle;
     int m_index = -1;
     const AudioData* m_audioData = nullptr;
     static AudioCommandCallback s_callback;
@@ -47,8 +49,30 @@ struct ClearAudioDataReferenceCommand
     static AudioCommandCallback s_callback;
 };
 
+struct ReleaseImpulseResponseCommand
+{
+    int m_index = -1;
+    static AudioCommandCallback s_callback;
+};
+
+struct LoadHRTFCommand
+{
+    const HRTF* m_hrtf = nullptr;
+    static AudioCommandCallback s_callback;
+};
+
 struct ShutdownCommand
 {
     static AudioCommandCallback s_callback;
 };
+
+struct StartTraceCaptureCommand
+{
+    static AudioCommandCallback s_callback;
+};
+
+struct StopTraceCaptureCommand
+{
+    static AudioCommandCallback s_callback;
+};
 }  // namespace rf
\ No newline at end of file
@@ -0,0 +1,348 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "loudnessmeter.h"
+
+#include <cmath>
+
+#include "allocator.h"
+#include "assert.h"
+#include "buffer.h"
+#include "meteringblock.h"
+#include "mixitem.h"
+
+rf::LoudnessMeter::LoudnessMeter(int numChannels, int sampleRate)
+    : m_numChannels(numChannels)
+    , m_blockSize(sampleRate / 10)
+{
+    RF_ASSERT(numChannels <= k_maxChannels, "Too many channels for loudness metering.");
+
+    // K-weighting is a high shelf modelling the head followed by the RLB highpass. The analog prototypes are warped to
+    // the sample rate so the response matches the 48kHz coefficients in BS.1770 at any rate.
+    const double pi = 3.14159265358979323846;
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+        const double k = tan(pi * f0 / sampleRate);
+        const double vh = pow(10.0, gainDb / 20.0);
+        const double vb = pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+        m_shelf.m_b0 = static_cast<float>((vh + vb * k / q + k * k) / a0);
+        m_shelf.m_b1 = static_cast<float>(2.0 * (k * k - vh) / a0);
+        m_shelf.m_b2 = static_cast<float>((vh - vb * k / q + k * k) / a0);
+        m_shelf.m_a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        m_shelf.m_a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+    }
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+        const double k = tan(pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+        m_highpass.m_b0 = 1.0f;
+        m_highpass.m_b1 = -2.0f;
+        m_highpass.m_b2 = 1.0f;
+        m_highpass.m_a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        m_highpass.m_a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+    }
+
+    // Channels follow the SMPTE order. The LFE is left out and the surrounds are weighted by +1.5dB.
+    for (int i = 0; i < numChannels; ++i)
+    {
+        const bool isSurroundLayout = numChannels >= 6;
+        if (isSurroundLayout && i == 3)
+        {
+            m_weights[i] = 0.0f;
+        }
+        else if (isSurroundLayout && i > 3)
+        {
+            m_weights[i] = 1.41f;
+        }
+        else
+        {
+            m_weights[i] = 1.0f;
+        }
+    }
+
+    m_histogramCount = Allocator::AllocateArray<int>("LoudnessMeter", k_numHistogramBins);
+    m_histogramEnergy = Allocator::AllocateArray<double>("LoudnessMeter", k_numHistogramBins);
+    Reset();
+}
+
+rf::LoudnessMeter::~LoudnessMeter()
+{
+    Allocator::DeallocateArray<int>(&m_histogramCount, k_numHistogramBins);
+    Allocator::DeallocateArray<double>(&m_histogramEnergy, k_numHistogramBins);
+}
+
+void rf::LoudnessMeter::Reset()
+{
+    for (int i = 0; i < k_maxChannels; ++i)
+    {
+        m_shelfState1[i] = 0.0f;
+        m_shelfState2[i] = 0.0f;
+        m_highpassState1[i] = 0.0f;
+        m_highpassState2[i] = 0.0f;
+        m_sumOfSquares[i] = 0.0f;
+    }
+
+    for (int i = 0; i < k_numShortTermBlocks; ++i)
+    {
+        m_blockEnergy[i] = 0.0f;
+    }
+
+    for (int i = 0; i < k_numHistogramBins; ++i)
+    {
+        m_histogramCount[i] = 0;
+        m_histogramEnergy[i] = 0.0;
+    }
+
+    m_gatedEnergy = 0.0;
+    m_momentaryLufs = EnergyToLufs(0.0);
+    m_shortTermLufs = EnergyToLufs(0.0);
+    m_integratedLufs = EnergyToLufs(0.0);
+    m_numGatingBlocks = 0;
+    m_blockPosition = 0;
+    m_blockIndex = 0;
+    m_numBlocks = 0;
+}
+
+void rf::LoudnessMeter::Process(const MixItem& mixItem, int bufferSize)
+{
+    // Lanes past the last channel read channel 0 but have no weight, so every SIMD lane can run unconditionally.
+    const float* channels[k_maxChannels];
+    for (int i = 0; i < k_maxChannels; ++i)
+    {
+        channels[i] = mixItem.m_arrayOfChannels[i < m_numChannels ? i : 0].GetAsFloatBuffer();
+    }
+
+    int offset = 0;
+    while (offset < bufferSize)
+    {
+        const int remainingInBlock = m_blockSize - m_blockPosition;
+        const int numFrames = bufferSize - offset < remainingInBlock ? bufferSize - offset : remainingInBlock;
+        Filter(channels, offset, numFrames);
+        offset += numFrames;
+        m_blockPosition += numFrames;
+
+        if (m_blockPosition == m_blockSize)
+        {
+            EndBlock();
+            m_blockPosition = 0;
+        }
+    }
+}
+
+void rf::LoudnessMeter::GetLoudness(MixGroupMeter* outMeter) const
+{
+    outMeter->m_momentaryLufs = m_momentaryLufs;
+    outMeter->m_shortTermLufs = m_shortTermLufs;
+    outMeter->m_integratedLufs = m_integratedLufs;
+    outMeter->m_hasLoudness = true;
+}
+
+void rf::LoudnessMeter::Filter(const float* const* channels, int offset, int numFrames)
+{
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+    // Four channels are filtered side by side, so a stereo group needs one pass and 5.1 or 7.1 needs two.
+    const __m128 shelfB0 = _mm_set1_ps(m_shelf.m_b0);
+    const __m128 shelfB1 = _mm_set1_ps(m_shelf.m_b1);
+    const __m128 shelfB2 = _mm_set1_ps(m_shelf.m_b2);
+    const __m128 shelfA1 = _mm_set1_ps(m_shelf.m_a1);
+    const __m128 shelfA2 = _mm_set1_ps(m_shelf.m_a2);
+    const __m128 highpassA1 = _mm_set1_ps(m_highpass.m_a1);
+    const __m128 highpassA2 = _mm_set1_ps(m_highpass.m_a2);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 flushThreshold = _mm_set1_ps(k_flushThreshold);
+    const auto Flush = [signMask, flushThreshold](__m128 value) {
+        return _mm_and_ps(value, _mm_cmpgt_ps(_mm_andnot_ps(signMask, value), flushThreshold));
+    };
+
+    for (int lane = 0; lane < m_numChannels; lane += 4)
+    {
+        const float* c0 = channels[lane] + offset;
+        const float* c1 = channels[lane + 1] + offset;
+        const float* c2 = channels[lane + 2] + offset;
+        const float* c3 = channels[lane + 3] + offset;
+        __m128 shelf1 = _mm_load_ps(m_shelfState1 + lane);
+        __m128 shelf2 = _mm_load_ps(m_shelfState2 + lane);
+        __m128 highpass1 = _mm_load_ps(m_highpassState1 + lane);
+        __m128 highpass2 = _mm_load_ps(m_highpassState2 + lane);
+        __m128 sum = _mm_load_ps(m_sumOfSquares + lane);
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            const __m128 x = _mm_set_ps(c3[i], c2[i], c1[i], c0[i]);
+
+            const __m128 shelfOut = _mm_add_ps(_mm_mul_ps(shelfB0, x), shelf1);
+            shelf1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(shelfB1, x), _mm_mul_ps(shelfA1, shelfOut)), shelf2);
+            shelf2 = _mm_sub_ps(_mm_mul_ps(shelfB2, x), _mm_mul_ps(shelfA2, shelfOut));
+
+            // The RLB numerator is 1, -2, 1.
+            const __m128 y = _mm_add_ps(shelfOut, highpass1);
+            highpass1 = _mm_sub_ps(_mm_sub_ps(highpass2, _mm_mul_ps(two, shelfOut)), _mm_mul_ps(highpassA1, y));
+            highpass2 = _mm_sub_ps(shelfOut, _mm_mul_ps(highpassA2, y));
+
+            sum = _mm_add_ps(sum, _mm_mul_ps(y, y));
+        }
+
+        _mm_store_ps(m_shelfState1 + lane, Flush(shelf1));
+        _mm_store_ps(m_shelfState2 + lane, Flush(shelf2));
+        _mm_store_ps(m_highpassState1 + lane, Flush(highpass1));
+        _mm_store_ps(m_highpassState2 + lane, Flush(highpass2));
+        _mm_store_ps(m_sumOfSquares + lane, sum);
+    }
+#else
+    const auto Flush = [](float value) { return fabsf(value) > k_flushThreshold ? value : 0.0f; };
+
+    for (int channel = 0; channel < m_numChannels; ++channel)
+    {
+        const float* input = channels[channel] + offset;
+        float shelf1 = m_shelfState1[channel];
+        float shelf2 = m_shelfState2[channel];
+        float highpass1 = m_highpassState1[channel];
+        float highpass2 = m_highpassState2[channel];
+        float sum = m_sumOfSquares[channel];
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            const float x = input[i];
+
+            const float shelfOut = m_shelf.m_b0 * x + shelf1;
+            shelf1 = m_shelf.m_b1 * x - m_shelf.m_a1 * shelfOut + shelf2;
+            shelf2 = m_shelf.m_b2 * x - m_shelf.m_a2 * shelfOut;
+
+            const float y = m_highpass.m_b0 * shelfOut + highpass1;
+            highpass1 = m_highpass.m_b1 * shelfOut - m_highpass.m_a1 * y + highpass2;
+            highpass2 = m_highpass.m_b2 * shelfOut - m_highpass.m_a2 * y;
+
+            sum += y * y;
+        }
+
+        m_shelfState1[channel] = Flush(shelf1);
+        m_shelfState2[channel] = Flush(shelf2);
+        m_highpassState1[channel] = Flush(highpass1);
+        m_highpassState2[channel] = Flush(highpass2);
+        m_sumOfSquares[channel] = sum;
+    }
+#endif
+}
+
+void rf::LoudnessMeter::EndBlock()
+{
+    float energy = 0.0f;
+    for (int i = 0; i < m_numChannels; ++i)
+    {
+        energy += m_weights[i] * m_sumOfSquares[i];
+        m_sumOfSquares[i] = 0.0f;
+    }
+    energy /= static_cast<float>(m_blockSize);
+
+    m_blockEnergy[m_blockIndex] = energy;
+    m_blockIndex = (m_blockIndex + 1) % k_numShortTermBlocks;
+    if (m_numBlocks < k_numShortTermBlocks)
+    {
+        ++m_numBlocks;
+    }
+
+    // Sum the newest blocks, walking back from the one just written.
+    double momentaryEnergy = 0.0;
+    double shortTermEnergy = 0.0;
+    for (int i = 0; i < m_numBlocks; ++i)
+    {
+        const int index = (m_blockIndex - 1 - i + k_numShortTermBlocks) % k_numShortTermBlocks;
+        if (i < k_numMomentaryBlocks)
+        {
+            momentaryEnergy += m_blockEnergy[index];
+        }
+        shortTermEnergy += m_blockEnergy[index];
+    }
+
+    // Until 3 seconds have been measured, short-term loudness covers what there is.
+    shortTermEnergy /= m_numBlocks;
+    m_shortTermLufs = EnergyToLufs(shortTermEnergy);
+
+    // Momentary windows overlap by 75%, and each complete one is also a gating block for integrated loudness.
+    if (m_numBlocks >= k_numMomentaryBlocks)
+    {
+        momentaryEnergy /= k_numMomentaryBlocks;
+        m_momentaryLufs = EnergyToLufs(momentaryEnergy);
+        AddGatingBlock(static_cast<float>(momentaryEnergy));
+    }
+}
+
+void rf::LoudnessMeter::AddGatingBlock(float energy)
+{
+    const float lufs = EnergyToLufs(energy);
+
+    // Absolute gate.
+    if (lufs <= MixGroupMeter::k_minLufs)
+    {
+        return;
+    }
+
+    int bin = static_cast<int>((lufs - MixGroupMeter::k_minLufs) / k_histogramBinLu);
+    if (bin >= k_numHistogramBins)
+    {
+        bin = k_numHistogramBins - 1;
+    }
+
+    ++m_histogramCount[bin];
+    m_histogramEnergy[bin] += energy;
+    m_gatedEnergy += energy;
+    ++m_numGatingBlocks;
+
+    UpdateIntegrated();
+}
+
+void rf::LoudnessMeter::UpdateIntegrated()
+{
+    // Relative gate, 10 LU below the loudness of everything that passed the absolute gate.
+    const float relativeGateLufs = EnergyToLufs(m_gatedEnergy / m_numGatingBlocks) - 10.0f;
+    int startBin = static_cast<int>(ceilf((relativeGateLufs - MixGroupMeter::k_minLufs) / k_histogramBinLu));
+    if (startBin < 0)
+    {
+        startBin = 0;
+    }
+
+    double energy = 0.0;
+    int numBlocks = 0;
+    for (int i = startBin; i < k_numHistogramBins; ++i)
+    {
+        energy += m_histogramEnergy[i];
+        numBlocks += m_histogramCount[i];
+    }
+
+    m_integratedLufs = numBlocks > 0 ? EnergyToLufs(energy / numBlocks) : MixGroupMeter::k_minLufs;
+}
+
+float rf::LoudnessMeter::EnergyToLufs(double energy)
+{
+    if (energy <= 0.0)
+    {
+        return MixGroupMeter::k_minLufs;
+    }
+
+    const float lufs = static_cast<float>(-0.691 + 10.0 * log10(energy));
+    return lufs > MixGroupMeter::k_minLufs ? lufs : MixGroupMeter::k_minLufs;
+}
@@ -0,0 +1,100 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "defines.h"
+
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+#    include <immintrin.h>
+#endif
+
+namespace rf
+{
+struct MixGroupMeter;
+struct MixItem;
+
+// Measures loudness as described in ITU-R BS.1770. The signal is K-weighted and its energy is gathered into 100 ms
+// blocks, from which the momentary (400 ms), short-term (3 s) and gated integrated loudness are derived. Integrated
+// loudness keeps a histogram of gating blocks, so it costs the same after an hour as after a second.
+class LoudnessMeter
+{
+public:
+    LoudnessMeter(int numChannels, int sampleRate);
+    LoudnessMeter(const LoudnessMeter&) = delete;
+    LoudnessMeter(LoudnessMeter&&) = delete;
+    LoudnessMeter& operator=(const LoudnessMeter&) = delete;
+    LoudnessMeter& operator=(LoudnessMeter&&) = delete;
+    ~LoudnessMeter();
+
+    void Reset();
+    void Process(const MixItem& mixItem, int bufferSize);
+    void GetLoudness(MixGroupMeter* outMeter) const;
+
+    bool m_isInUse = false;
+
+private:
+    static constexpr int k_maxChannels = 8;
+    static constexpr int k_numShortTermBlocks = 30;
+    static constexpr int k_numMomentaryBlocks = 4;
+    static constexpr int k_numHistogramBins = 1000;
+    static constexpr float k_histogramBinLu = 0.1f;
+    // Filter state this small is flushed to zero once per block, so decaying silence never reaches denormals.
+    static constexpr float k_flushThreshold = 1e-15f;
+
+    struct Biquad
+    {
+        float m_b0 = 1.0f;
+        float m_b1 = 0.0f;
+        float m_b2 = 0.0f;
+        float m_a1 = 0.0f;
+        float m_a2 = 0.0f;
+    };
+
+    Biquad m_shelf;
+    Biquad m_highpass;
+    alignas(16) float m_shelfState1[k_maxChannels] = {};
+    alignas(16) float m_shelfState2[k_maxChannels] = {};
+    alignas(16) float m_highpassState1[k_maxChannels] = {};
+    alignas(16) float m_highpassState2[k_maxChannels] = {};
+    alignas(16) float m_sumOfSquares[k_maxChannels] = {};
+    float m_weights[k_maxChannels] = {};
+    float m_blockEnergy[k_numShortTermBlocks] = {};
+    int* m_histogramCount = nullptr;
+    double* m_histogramEnergy = nullptr;
+    double m_gatedEnergy = 0.0;
+    float m_momentaryLufs = 0.0f;
+    float m_shortTermLufs = 0.0f;
+    float m_integratedLufs = 0.0f;
+    int m_numGatingBlocks = 0;
+    int m_numChannels = 0;
+    int m_blockSize = 0;
+    int m_blockPosition = 0;
+    int m_blockIndex = 0;
+    int m_numBlocks = 0;
+
+    void Filter(const float* const* channels, int offset, int numFrames);
+    void EndBlock();
+    void AddGatingBlock(float energy);
+    void UpdateIntegrated();
+    static float EnergyToLufs(double energy);
+};
+}  // namespace rf
@@ -29,18 +29,22 @@
 
 namespace rf
 {
-#define RF_MESSAGE(data, type)                            \
-    data* Get##data()                                     \
-    {                                                     \
-        RF_ASSERT(type == m_type, "Wrong message type."); \
-        return reinterpret_cast<data*>(m_data);           \
-    }                                                     \
-    const data* Get##data() const                         \
-    {                                                     \
-        RF_ASSERT(type == m_type, "Wrong message type."); \
-        return reinterpret_cast<const data*>(m_data);     \
-    }                                                     \
-    static_assert(sizeof(data) <= k_maxDataSize, "Exceeded max data");
+class DSPBase;
+struct ConvolverChannels;
+
+#define RF_MESSAGE(data, type)                                         \
+    data* Get##data()                                                  \
+    {                                                                  \
+        RF_ASSERT(type == m_type, "Wrong message type.");              \
+        return reinterpret_cast<data*>(m_data);                        \
+    }                                                                  \
+    const data* Get##data() const                                      \
+    {                                                                  \
+        RF_ASSERT(type == m_type, "Wrong message type.");              \
+        return reinterpret_cast<const data*>(m_data);                  \
+    }                                                                  \
+    static_assert(sizeof(data) <= k_maxDataSize, "Exceeded max data"); \
+    static_assert(alignof(data) <= k_dataAlignment, "Exceeded data alignment");
 
 enum class MessageType
 {
@@ -48,11 +52,14 @@ enum class MessageType
 
     AssetDelete,
     ContextNumVoices,
+    ContextPlayhead,
     ContextShutdownComplete,
     ContextVoiceStart,
     ContextVoiceStop,
+    ConvolverChannelsDestroy,
+    DSPDestroy,
+    ImpulseResponseDelete,
     MixGroupFadeComplete,
-    MixGroupPeakAmplitude,
     MusicBarChanged,
     MusicBeatChanged,
     MusicCurrentBar,
@@ -62,10 +69,23 @@ enum class MessageType
     MusicDestroyTransition,
     MusicFinished,
     MusicMeter,
+    MusicStreamMiss,
+    MusicStreamPrefetch,
+    MusicStreamRelease,
+    MusicStreamStart,
+    MusicStreamUnderrun,
     MusicTempo,
     MusicTransitioned,
+    ProfilerMixGroup,
+    ProfilerStage,
+    TraceCaptureComplete,
+
+    // Must be last.
+    Count,
 };
 
+static constexpr int k_numMessageTypes = static_cast<int>(MessageType::Count);
+
 struct Message
 {
     MessageType m_type = MessageType::Invalid;
@@ -80,26 +100,41 @@ struct Message
         int m_numVoices;
     };
 
+    struct ContextPlayheadData
+    {
+        long long m_playhead;
+    };
+
     struct ContextVoiceStartData
     {
-        AudioHandle m_audioHandle;
+        int m_playingSoundId;
+        int m_audioDataIndex;
     };
 
     struct ContextVoiceStopData
     {
-        AudioHandle m_audioHandle;
+        int m_playingSoundId;
     };
 
-    struct MixGroupFadeCompleteData
+    struct ConvolverChannelsDestroyData
     {
-        MixGroupHandle m_mixGroupHandle;
-        float m_amplitude;
+        ConvolverChannels* m_channels;
     };
 
-    struct MixGroupPeakAmplitudeData
+    struct DSPDestroyData
     {
-        int m_mixGroupIndex = -1;
-        float m_amplitude = 0.0f;
+        DSPBase* m_dsp;
+    };
+
+    struct ImpulseResponseDeleteData
+    {
+        int m_index;
+    };
+
+    struct MixGroupFadeCompleteData
+    {
+        MixGroupHandle m_mixGroupHandle;
+        float m_amplitude;
     };
 
     struct MusicBarChangedData
@@ -145,6 +180,35 @@ struct Message
         int m_bottom;
     };
 
+    struct MusicStreamMissData
+    {
+        int m_audioDataIndex;
+    };
+
+    struct MusicStreamPrefetchData
+    {
+        int m_audioDataIndex;
+        unsigned int m_generation;
+    };
+
+    struct MusicStreamReleaseData
+    {
+        int m_audioDataIndex;
+        unsigned int m_generation;
+    };
+
+    struct MusicStreamStartData
+    {
+        int m_audioDataIndex;
+        float m_leadTimeMs;
+    };
+
+    struct MusicStreamUnderrunData
+    {
+        int m_audioDataIndex;
+        float m_durationMs;
+    };
+
     struct MusicTempoData
     {
         float m_tempo;
@@ -156,15 +220,32 @@ struct Message
         CueHandle m_fromCueHandle;
     };
 
+    struct ProfilerMixGroupData
+    {
+        int m_mixGroupIndex;
+        float m_cpuPercent;
+    };
+
+    struct ProfilerStageData
+    {
+        int m_stage;
+        float m_cpuPercent;
+    };
+
     static constexpr int k_maxDataSize = 8;
-    uint8_t m_data[k_maxDataSize];
+    // Messages carry pointers and 64 bit playheads, so the data is aligned for them.
+    static constexpr int k_dataAlignment = 8;
+    alignas(k_dataAlignment) uint8_t m_data[k_maxDataSize];
 
     RF_MESSAGE(AssetDeleteData, MessageType::AssetDelete);
     RF_MESSAGE(ContextNumVoicesData, MessageType::ContextNumVoices);
+    RF_MESSAGE(ContextPlayheadData, MessageType::ContextPlayhead);
     RF_MESSAGE(ContextVoiceStartData, MessageType::ContextVoiceStart);
     RF_MESSAGE(ContextVoiceStopData, MessageType::ContextVoiceStop);
+    RF_MESSAGE(ConvolverChannelsDestroyData, MessageType::ConvolverChannelsDestroy);
+    RF_MESSAGE(DSPDestroyData, MessageType::DSPDestroy);
+    RF_MESSAGE(ImpulseResponseDeleteData, MessageType::ImpulseResponseDelete);
     RF_MESSAGE(MixGroupFadeCompleteData, MessageType::MixGroupFadeComplete);
-    RF_MESSAGE(MixGroupPeakAmplitudeData, MessageType::MixGroupPeakAmplitude);
     RF_MESSAGE(MusicBarChangedData, MessageType::MusicBarChanged);
     RF_MESSAGE(MusicBeatChangedData, MessageType::MusicBeatChanged);
     RF_MESSAGE(MusicCurrentBarData, MessageType::MusicCurrentBar);
@@ -173,8 +254,15 @@ struct Message
     RF_MESSAGE(MusicDestroyStingerData, MessageType::MusicDestroyStinger);
     RF_MESSAGE(MusicDestroyTransitionData, MessageType::MusicDestroyTransition);
     RF_MESSAGE(MusicMeterData, MessageType::MusicMeter);
+    RF_MESSAGE(MusicStreamMissData, MessageType::MusicStreamMiss);
+    RF_MESSAGE(MusicStreamPrefetchData, MessageType::MusicStreamPrefetch);
+    RF_MESSAGE(MusicStreamReleaseData, MessageType::MusicStreamRelease);
+    RF_MESSAGE(MusicStreamStartData, MessageType::MusicStreamStart);
+    RF_MESSAGE(MusicStreamUnderrunData, MessageType::MusicStreamUnderrun);
     RF_MESSAGE(MusicTempoData, MessageType::MusicTempo);
     RF_MESSAGE(MusicTransitionedData, MessageType::MusicTransitioned);
+    RF_MESSAGE(ProfilerMixGroupData, MessageType::ProfilerMixGroup);
+    RF_MESSAGE(ProfilerStageData, MessageType::ProfilerStage);
 };
 
 #undef RF_MESSAGE
@@ -24,17 +24,42 @@
 
 #include "allocator.h"
 #include "assert.h"
+#include "realtimechecks.h"
 
-rf::Messenger::Messenger()
+rf::Messenger::Messenger(int maxPlayingSounds)
     : m_messages(RF_MAX_AUDIO_COMMANDS)
     , m_deleteMessagesToPost(RF_MAX_AUDIO_COMMANDS)
+    , m_maxPlayingSounds(maxPlayingSounds)
 {
+    m_freePlayingSoundIds = Allocator::AllocateArray<int>("FreePlayingSoundIds", m_maxPlayingSounds);
+
+    // Stored as a stack so the lowest ids are handed out first.
+    for (int i = 0; i < m_maxPlayingSounds; ++i)
+    {
+        m_freePlayingSoundIds[i] = m_maxPlayingSounds - 1 - i;
+    }
+    m_numFreePlayingSoundIds = m_maxPlayingSounds;
+}
+
+rf::Messenger::~Messenger()
+{
+    Allocator::DeallocateArray<int>(&m_freePlayingSoundIds, m_maxPlayingSounds);
 }
 
 void rf::Messenger::AddMessage(const Message& message)
 {
     RF_ASSERT(message.m_type != MessageType::Invalid, "Invalid message");
+    ++m_numMessages;
+#if RF_ENABLE_REALTIME_CHECKS
+    // try_enqueue never allocates, so failing means the queue has to grow.
+    if (!m_messages.try_enqueue(message))
+    {
+        RealtimeChecks::OnQueueGrowth();
+        m_messages.enqueue(message);
+    }
+#else
     m_messages.enqueue(message);
+#endif
 }
 
 void rf::Messenger::AddDeleteMessage(AudioHandle audioHandle)
@@ -49,6 +74,11 @@ bool rf::Messenger::Dequeue(Message& message)
     return m_messages.try_dequeue(message);
 }
 
+int rf::Messenger::DequeueBulk(Message* outMessages, int maxMessages)
+{
+    return static_cast<int>(m_messages.try_dequeue_bulk(outMessages, maxMessages));
+}
+
 void rf::Messenger::FlushMessages()
 {
     for (AudioHandle audioHandle : m_deleteMessagesToPost)
@@ -61,4 +91,27 @@ void rf::Messenger::FlushMessages()
     }
 
     m_deleteMessagesToPost.Clear();
-}
\ No newline at end of file
+}
+
+int rf::Messenger::GetNumMessages() const
+{
+    return m_numMessages;
+}
+
+int rf::Messenger::AcquirePlayingSoundId()
+{
+    RF_ASSERT(m_numFreePlayingSoundIds > 0, "Out of playing sound ids. Increase RF_MAX_VOICES, MusicConfig::m_maxCueLayers or MusicConfig::m_maxPlayingStingers");
+    if (m_numFreePlayingSoundIds == 0)
+    {
+        return -1;
+    }
+
+    return m_freePlayingSoundIds[--m_numFreePlayingSoundIds];
+}
+
+void rf::Messenger::ReleasePlayingSoundId(int playingSoundId)
+{
+    RF_ASSERT(playingSoundId >= 0 && playingSoundId < m_maxPlayingSounds, "Playing sound id out of bounds");
+    RF_ASSERT(m_numFreePlayingSoundIds < m_maxPlayingSounds, "Released more playing sound ids than were acquired");
+    m_freePlayingSoundIds[m_numFreePlayingSoundIds++] = playingSoundId;
+}
@@ -32,15 +32,31 @@ namespace rf
 class Messenger
 {
 public:
-    Messenger();
+    explicit Messenger(int maxPlayingSounds);
+    Messenger(const Messenger&) = delete;
+    Messenger(Messenger&&) = delete;
+    Messenger& operator=(const Messenger&) = delete;
+    Messenger& operator=(Messenger&&) = delete;
+    ~Messenger();
 
     void AddMessage(const Message& message);
     void AddDeleteMessage(AudioHandle audioHandle);
     bool Dequeue(Message& message);
+    int DequeueBulk(Message* outMessages, int maxMessages);
     void FlushMessages();
+    // The amount of messages added since construction.
+    int GetNumMessages() const;
+    // Ids that key a playing voice in ContextVoiceStart and ContextVoiceStop. Audio thread only. Returns -1 when every
+    // id is in use.
+    int AcquirePlayingSoundId();
+    void ReleasePlayingSoundId(int playingSoundId);
 
 private:
     moodycamel::ConcurrentQueue<Message> m_messages;
     NonAllocatingList<AudioHandle> m_deleteMessagesToPost;
+    int* m_freePlayingSoundIds = nullptr;
+    int m_numFreePlayingSoundIds = 0;
+    int m_maxPlayingSounds = 0;
+    int m_numMessages = 0;
 };
 }  // namespace rf
\ No newline at end of file
@@ -0,0 +1,120 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "meteringblock.h"
+
+#include "allocator.h"
+
+float rf::MixGroupMeter::GetPeakAmplitude() const
+{
+    float max = 0.0f;
+    for (int i = 0; i < m_numChannels; ++i)
+    {
+        if (m_peakAmplitude[i] > max)
+        {
+            max = m_peakAmplitude[i];
+        }
+    }
+    return max;
+}
+
+float rf::MixGroupMeter::GetRmsAmplitude() const
+{
+    float max = 0.0f;
+    for (int i = 0; i < m_numChannels; ++i)
+    {
+        if (m_rmsAmplitude[i] > max)
+        {
+            max = m_rmsAmplitude[i];
+        }
+    }
+    return max;
+}
+
+int rf::MixGroupMeter::GetNumClippedSamples() const
+{
+    int numClippedSamples = 0;
+    for (int i = 0; i < m_numChannels; ++i)
+    {
+        numClippedSamples += m_numClippedSamples[i];
+    }
+    return numClippedSamples;
+}
+
+rf::MeteringBlock::MeteringBlock()
+{
+    m_snapshots = Allocator::AllocateArray<Snapshot>("MeteringBlock", k_numSnapshots);
+}
+
+rf::MeteringBlock::~MeteringBlock()
+{
+    Allocator::DeallocateArray<Snapshot>(&m_snapshots, k_numSnapshots);
+}
+
+rf::MixGroupMeter* rf::MeteringBlock::GetWriteMeters()
+{
+    return m_snapshots[m_writeIndex].m_mixGroups;
+}
+
+void rf::MeteringBlock::Publish()
+{
+    // Hand the finished snapshot over and take back whichever one the game thread is not reading.
+    const int previous = m_sharedIndex.exchange(m_writeIndex | k_freshBit, std::memory_order_acq_rel);
+    m_writeIndex = previous & k_indexMask;
+}
+
+bool rf::MeteringBlock::Acquire()
+{
+    if ((m_sharedIndex.load(std::memory_order_relaxed) & k_freshBit) == 0)
+    {
+        return false;
+    }
+
+    const int previous = m_sharedIndex.exchange(m_readIndex, std::memory_order_acq_rel);
+    m_readIndex = previous & k_indexMask;
+    return true;
+}
+
+const rf::MixGroupMeter* rf::MeteringBlock::GetMeter(MixGroupHandle mixGroupHandle, int indexHint) const
+{
+    if (!mixGroupHandle)
+    {
+        return nullptr;
+    }
+
+    const MixGroupMeter* meters = m_snapshots[m_readIndex].m_mixGroups;
+    if (indexHint >= 0 && indexHint < RF_MAX_MIX_GROUPS && meters[indexHint].m_mixGroupHandle == mixGroupHandle)
+    {
+        return &meters[indexHint];
+    }
+
+    // The audio thread may not have applied the latest mix group changes yet, so the order can differ.
+    for (int i = 0; i < RF_MAX_MIX_GROUPS; ++i)
+    {
+        if (meters[i].m_mixGroupHandle == mixGroupHandle)
+        {
+            return &meters[i];
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,93 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <atomic>
+
+#include "defines.h"
+#include "identifiers.h"
+
+namespace rf
+{
+// The levels of one mix group's output for the most recent audio callback.
+struct MixGroupMeter
+{
+    static constexpr int k_maxChannels = 8;
+    // Loudness below the BS.1770 absolute gate reads as this.
+    static constexpr float k_minLufs = -70.0f;
+
+    MixGroupHandle m_mixGroupHandle;
+    float m_peakAmplitude[k_maxChannels] = {};
+    float m_rmsAmplitude[k_maxChannels] = {};
+    // Samples at or above full scale since the mix group was created.
+    int m_numClippedSamples[k_maxChannels] = {};
+    // Only measured while loudness metering is enabled on the mix group. Integrated loudness covers everything since
+    // it was enabled.
+    float m_momentaryLufs = k_minLufs;
+    float m_shortTermLufs = k_minLufs;
+    float m_integratedLufs = k_minLufs;
+    int m_numChannels = 0;
+    bool m_hasLoudness = false;
+
+    float GetPeakAmplitude() const;
+    float GetRmsAmplitude() const;
+    int GetNumClippedSamples() const;
+};
+
+// Hands the meters of every mix group from the audio thread to the game thread without going through the messenger.
+// The audio thread fills one snapshot per callback and publishes it, and the game thread acquires the newest one when
+// it wants to read. The three snapshots are swapped with a single atomic index, so neither side ever waits or sees a
+// snapshot that is being written.
+class MeteringBlock
+{
+public:
+    MeteringBlock();
+    MeteringBlock(const MeteringBlock&) = delete;
+    MeteringBlock(MeteringBlock&&) = delete;
+    MeteringBlock& operator=(const MeteringBlock&) = delete;
+    MeteringBlock& operator=(MeteringBlock&&) = delete;
+    ~MeteringBlock();
+
+    // Audio thread.
+    MixGroupMeter* GetWriteMeters();
+    void Publish();
+
+    // Game thread.
+    bool Acquire();
+    const MixGroupMeter* GetMeter(MixGroupHandle mixGroupHandle, int indexHint) const;
+
+private:
+    struct Snapshot
+    {
+        MixGroupMeter m_mixGroups[RF_MAX_MIX_GROUPS];
+    };
+
+    static constexpr int k_numSnapshots = 3;
+    static constexpr int k_indexMask = 3;
+    static constexpr int k_freshBit = 4;
+
+    Snapshot* m_snapshots = nullptr;
+    std::atomic<int> m_sharedIndex {2};
+    int m_writeIndex = 0;
+    int m_readIndex = 1;
+};
+}  // namespace rf
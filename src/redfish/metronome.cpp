@@ -34,11 +34,33 @@ rf::Metronome::Metronome(const AudioSpec& spec, const MusicDatabase* musicDataba
 {
 }
 
-void rf::Metronome::Set(float tempo, const Meter& meter)
+void rf::Metronome::SetCue(int cueIndex)
 {
-    m_tempo = tempo;
-    m_meter = meter;
-    m_samplesPerBeat = m_beatCalculator.BeatCalc(m_tempo, m_meter, m_spec);
+    const MusicDatabase::CueData& cue = m_musicDatabase->GetCueData(cueIndex);
+    m_tempoMap.Build(m_spec, cue.m_tempo, cue.m_meter, cue.m_tempoChanges, cue.m_numTempoChanges);
+    m_cueIndex = cueIndex;
+    m_segmentIndex = -1;
+    SetSegment(0);
+}
+
+void rf::Metronome::SetSegment(int segmentIndex)
+{
+    if (segmentIndex == m_segmentIndex)
+    {
+        return;
+    }
+
+    // Cues that share a tempo and meter do not need to tell anyone they changed.
+    const TempoMap::Segment& segment = m_tempoMap.GetSegment(segmentIndex);
+    const bool tempoChange = !Functions::FloatEquality(m_tempo, segment.m_tempo);
+    const bool meterChange = m_meter != segment.m_meter;
+    m_segmentIndex = segmentIndex;
+    m_tempo = segment.m_tempo;
+    m_meter = segment.m_meter;
+    if (!tempoChange && !meterChange)
+    {
+        return;
+    }
 
     Message tempoMsg;
     tempoMsg.m_type = MessageType::MusicTempo;
@@ -53,23 +75,20 @@ void rf::Metronome::Set(float tempo, const Meter& meter)
     m_messanger->AddMessage(meterMsg);
 }
 
-void rf::Metronome::Update(long long playhead, const MusicTransitionRequest& request, bool isPlaying)
+void rf::Metronome::Update(long long playhead, int bufferSize, const MusicTransitionRequest& request, bool isPlaying)
 {
     if (!isPlaying)
     {
         return;
     }
 
-    const bool firstWindow = Functions::InFirstWindow(playhead, request.m_startTime, m_spec.m_bufferSize);
+    const bool firstWindow = Functions::InFirstWindow(playhead, request.m_startTime, bufferSize);
     if (request.m_transitionDataIndex >= 0 && firstWindow)
     {
         const MusicDatabase::TransitionData& trans = m_musicDatabase->GetTransitionData(request.m_transitionDataIndex);
-        const MusicDatabase::CueData& cue = m_musicDatabase->GetCueData(trans.m_cueIndex);
-        const bool tempoChange = !Functions::FloatEquality(m_tempo, cue.m_tempo);
-        const bool meterChange = m_meter != cue.m_meter;
-        if (tempoChange || meterChange)
+        if (trans.m_cueIndex != m_cueIndex)
         {
-            Set(cue.m_tempo, cue.m_meter);
+            SetCue(trans.m_cueIndex);
         }
     }
 
@@ -84,31 +103,31 @@ void rf::Metronome::Update(long long playhead, const MusicTransitionRequest& req
     // That means when we add in the buffer size and do the subtraction, we get a negative number.
     // In practice, this means that the cue has not played yet.
     // So by zeroing out totalMusicPlaytime in that case, we get the correct intention.
-    long long totalMusicPlaytime = (playhead + m_spec.m_bufferSize) - request.m_startTime;
+    long long totalMusicPlaytime = (playhead + bufferSize) - request.m_startTime;
     if (totalMusicPlaytime < 0)
     {
         totalMusicPlaytime = 0;
     }
 
-    const double currentBeatInTermsOfTotalBeats = floor(totalMusicPlaytime / m_samplesPerBeat);
-    const double bars = floor(currentBeatInTermsOfTotalBeats / m_meter.m_top);
-    const double beats = currentBeatInTermsOfTotalBeats - (bars * m_meter.m_top);
+    if (m_tempoMap.GetNumSegments() == 0)
+    {
+        return;
+    }
+
+    const int bar = m_tempoMap.GetBar(totalMusicPlaytime);
+    SetSegment(m_tempoMap.FindSegment(bar));
 
     const int lastBar = m_barCounter;
     const int lastBeat = m_beatCounter;
-    m_barCounter = 1 + static_cast<int>(bars);
-    m_beatCounter = 1 + static_cast<int>(beats);
+    m_barCounter = 1 + bar;
+    m_beatCounter = 1 + m_tempoMap.GetBeat(totalMusicPlaytime, bar);
 
     RF_ASSERT(m_barCounter > 0, "Zero bars isn't correct");
     RF_ASSERT(m_beatCounter > 0, "Zero beats isn't correct");
 
+    // The changed messages carry the current bar and beat, so they also keep the music system's position up to date.
     if (m_barCounter != lastBar)
     {
-        Message barMsg;
-        barMsg.m_type = MessageType::MusicCurrentBar;
-        barMsg.GetMusicCurrentBarData()->m_currentBar = m_barCounter;
-        m_messanger->AddMessage(barMsg);
-
         Message barChangedMsg;
         barChangedMsg.m_type = MessageType::MusicBarChanged;
         Message::MusicBarChangedData* data = barChangedMsg.GetMusicBarChangedData();
@@ -118,11 +137,6 @@ void rf::Metronome::Update(long long playhead, const MusicTransitionRequest& req
     }
     if (m_beatCounter != lastBeat)
     {
-        Message beatMsg;
-        beatMsg.m_type = MessageType::MusicCurrentBeat;
-        beatMsg.GetMusicCurrentBeatData()->m_currentBeat = m_beatCounter;
-        m_messanger->AddMessage(beatMsg);
-
         Message beatChangedMsg;
         beatChangedMsg.m_type = MessageType::MusicBeatChanged;
         Message::MusicBeatChangedData* data = beatChangedMsg.GetMusicBeatChangedData();
@@ -134,10 +148,11 @@ void rf::Metronome::Update(long long playhead, const MusicTransitionRequest& req
 
 void rf::Metronome::Reset()
 {
-    m_beatCalculator = BeatCalculator();
+    m_tempoMap.Reset();
     m_meter = Meter();
     m_tempo = -1.0f;
-    m_samplesPerBeat = 0.0;
+    m_cueIndex = -1;
+    m_segmentIndex = -1;
     m_barCounter = 0;
     m_beatCounter = 0;
 
@@ -164,9 +179,19 @@ int rf::Metronome::GetSyncSamples(const AudioSpec& spec, const Sync& sync, float
     return beatCalc.BeatSwitch(sync);
 }
 
-double rf::Metronome::PreciseBeatSwitch(const Sync& sync) const
+int rf::Metronome::GetSyncSamples(const Sync& sync) const
+{
+    if (sync.m_mode == Sync::Mode::Time || m_segmentIndex < 0)
+    {
+        return GetSyncSamples(m_spec, sync, m_tempo, m_meter);
+    }
+
+    return m_tempoMap.GetSegment(m_segmentIndex).m_beatCalculator.BeatSwitch(sync);
+}
+
+const rf::TempoMap& rf::Metronome::GetTempoMap() const
 {
-    return m_beatCalculator.PreciseBeatSwitch(sync);
+    return m_tempoMap;
 }
 
 float rf::Metronome::GetTempo() const
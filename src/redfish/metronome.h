@@ -22,7 +22,7 @@
 
 #pragma once
 #include "audiospec.h"
-#include "beatcalculator.h"
+#include "tempomap.h"
 
 namespace rf
 {
@@ -35,11 +35,14 @@ class Metronome
 public:
     Metronome(const AudioSpec& spec, const MusicDatabase* musicDatabase, Messenger* messanger);
 
-    void Set(float tempo, const Meter& meter);
-    void Update(long long playhead, const MusicTransitionRequest& request, bool isPlaying);
+    // Builds the tempo map of a cue and takes the tempo and meter it starts with.
+    void SetCue(int cueIndex);
+    void Update(long long playhead, int bufferSize, const MusicTransitionRequest& request, bool isPlaying);
     void Reset();
     static int GetSyncSamples(const AudioSpec& spec, const Sync& sync, float tempo, const Meter& meter);
-    double PreciseBeatSwitch(const Sync& sync) const;
+    // Uses the note values of the current tempo and meter, which are worked out once per tempo change.
+    int GetSyncSamples(const Sync& sync) const;
+    const TempoMap& GetTempoMap() const;
     float GetTempo() const;
     Meter GetMeter() const;
     int GetBarCounter() const;
@@ -47,13 +50,16 @@ public:
 
 private:
     AudioSpec m_spec;
-    BeatCalculator m_beatCalculator;
+    TempoMap m_tempoMap;
     Messenger* m_messanger = nullptr;
     const MusicDatabase* m_musicDatabase = nullptr;
     Meter m_meter;
     float m_tempo = -1.0f;
-    double m_samplesPerBeat = 0.0;
+    int m_cueIndex = -1;
+    int m_segmentIndex = -1;
     int m_barCounter = 0;
     int m_beatCounter = 0;
+
+    void SetSegment(int segmentIndex);
 };
 }  // namespace rf
\ No newline at end of file
@@ -55,6 +55,25 @@ rf::AudioCommandCallback rf::SetMixGroupOutputCommand::s_callback = [](AudioTime
     mixer->Sort();
 };
 
+rf::AudioCommandCallback rf::SetMixGroupLoudnessMeteringCommand::s_callback = [](AudioTimeline* timeline, void* command) {
+    const SetMixGroupLoudnessMeteringCommand& cmd = *static_cast<SetMixGroupLoudnessMeteringCommand*>(command);
+    SummingMixer* mixer = &timeline->m_summingMixer;
+    SummingMixer::MixGroupInternal* mixGroup = mixer->MixGroupLookUp(cmd.m_mixGroupHandle);
+    if (!mixGroup)
+    {
+        return;
+    }
+    mixer->SetLoudnessMetering(mixGroup, cmd.m_enable);
+};
+
+rf::AudioCommandCallback rf::SetMixGroupPriorityCommand::s_callback = [](AudioTimeline* timeline, void* command) {
+    const SetMixGroupPriorityCommand& cmd = *static_cast<SetMixGroupPriorityCommand*>(command);
+    SummingMixer* mixer = &timeline->m_summingMixer;
+    SummingMixer::MixGroupInternal* mixGroup = mixer->MixGroupLookUp(cmd.m_mixGroupHandle);
+    mixGroup->m_state.m_priority = cmd.m_priority;
+    mixer->Sort();
+};
+
 rf::AudioCommandCallback rf::CreateSendCommand::s_callback = [](AudioTimeline* timeline, void* command) {
     const CreateSendCommand& cmd = *static_cast<CreateSendCommand*>(command);
     SummingMixer* mixer = &timeline->m_summingMixer;
@@ -59,6 +59,20 @@ struct SetMixGroupOutputCommand
     static AudioCommandCallback s_callback;
 };
 
+struct SetMixGroupLoudnessMeteringCommand
+{
+    bool m_enable = false;
+    MixGroupHandle m_mixGroupHandle;
+    static AudioCommandCallback s_callback;
+};
+
+struct SetMixGroupPriorityCommand
+{
+    float m_priority = 0.0f;
+    MixGroupHandle m_mixGroupHandle;
+    static AudioCommandCallback s_callback;
+};
+
 struct CreateSendCommand
 {
     int m_sendIndex = -1;
@@ -22,12 +22,17 @@
 
 #include "mixersystem.h"
 
+#include <algorithm>
+
 #include "butterworthhighpassfilterplugin.h"
 #include "butterworthlowpassfilterplugin.h"
 #include "commandprocessor.h"
 #include "compressorplugin.h"
+#include "convolverdsp.h"
 #include "convolverplugin.h"
 #include "delayplugin.h"
+#include "dspbase.h"
+#include "duckerplugin.h"
 #include "functions.h"
 #include "gainplugin.h"
 #include "iir2highpassfilterplugin.h"
@@ -101,6 +106,7 @@ rf::MixGroup* rf::MixerSystem::CreateMixGroup(const char* name)
 
     const MixGroupHandle mixGroupHandle = mixGroup->GetMixGroupHandle();
     CreateMixGroupInternal(mixGroupHandle);
+    mixGroup->m_readyPlayhead = m_readyPlayhead;
     return mixGroup;
 }
 
@@ -130,6 +136,15 @@ void rf::MixerSystem::DestroyMixGroup(MixGroup** mixGroup)
         }
     }
 
+    // Clear Sidechains
+    for (int i = 0; i < RF_MAX_MIX_GROUPS * RF_MAX_MIX_GROUP_PLUGINS; ++i)
+    {
+        if (m_plugins[i] && m_plugins[i]->GetSidechainMixGroupHandle() == mixGroupHandle)
+        {
+            m_plugins[i]->SetSidechainMixGroupHandle(MixGroupHandle());
+        }
+    }
+
     // Destroy Plug-ins
     {
         const MixGroupState& state = GetMixGroupState(mixGroupHandle);
@@ -166,7 +181,7 @@ void rf::MixerSystem::DestroyMixGroup(MixGroup** mixGroup)
     AudioCommand cmd;
     DestroyMixGroupCommand& data = EncodeAudioCommand<DestroyMixGroupCommand>(&cmd);
     data.m_mixGroupIndex = stateIndex;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 
     // Null Out Mix Group
     for (int i = 0; i < RF_MAX_MIX_GROUPS; ++i)
@@ -249,6 +264,12 @@ rf::MixGroup* rf::MixerSystem::GetMasterMixGroup() const
     return m_masterMixGroup;
 }
 
+bool rf::MixerSystem::CanSidechain(MixGroupHandle mixGroupHandle, MixGroupHandle sidechainMixGroupHandle) const
+{
+    // The sidechain is processed before the mix group reading it, which is impossible if the mix group feeds into it.
+    return !GetMixGroupState(sidechainMixGroupHandle).m_isMaster && !FeedsInto(mixGroupHandle, sidechainMixGroupHandle, 0);
+}
+
 void rf::MixerSystem::FadeMixGroups(const MixGroup** mixGroups,
                                     int numMixGroups,
                                     float volumeDb,
@@ -270,7 +291,7 @@ void rf::MixerSystem::FadeMixGroups(const MixGroup** mixGroups,
     {
         data.m_mixGroupIndices[i] = GetMixGroupIndex(mixGroups[i]->GetMixGroupHandle());
     }
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 void rf::MixerSystem::FadeMixGroups(const MixGroup** mixGroups, int numMixGroups, float volumeDb, const Sync& sync, const Sync& duration)
@@ -278,6 +299,11 @@ void rf::MixerSystem::FadeMixGroups(const MixGroup** mixGroups, int numMixGroups
     FadeMixGroups(mixGroups, numMixGroups, volumeDb, sync, duration, nullptr);
 }
 
+void rf::MixerSystem::AddCommand(const AudioCommand& cmd)
+{
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
+}
+
 void rf::MixerSystem::Allocate()
 {
     Free();
@@ -306,7 +332,7 @@ void rf::MixerSystem::Free()
 
     AudioCommand cmd;
     DestroyAllMixGroupsCommand& data = EncodeAudioCommand<DestroyAllMixGroupsCommand>(&cmd);
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 void rf::MixerSystem::CreateMasterMixGroup()
@@ -314,6 +340,7 @@ void rf::MixerSystem::CreateMasterMixGroup()
     // Create master mix group
     m_masterMixGroup = Allocator::Allocate<MixGroup>("MasterMixGroup", m_context, m_commands, this, "Master");
     CreateMixGroupInternal(m_masterMixGroup->GetMixGroupHandle());
+    m_masterMixGroup->m_readyPlayhead = m_readyPlayhead;
 }
 
 int rf::MixerSystem::GetMixGroupIndex(MixGroupHandle mixGroupHandle) const
@@ -359,7 +386,7 @@ void rf::MixerSystem::CreateMixGroupInternal(MixGroupHandle mixGroupHandle)
         AudioCommand cmd;
         CreateMixGroupCommand& data = EncodeAudioCommand<CreateMixGroupCommand>(&cmd);
         data.m_mixGroupState = state;
-        m_commands->Add(cmd);
+        AddCommand(cmd);
     }
 
     {
@@ -367,7 +394,7 @@ void rf::MixerSystem::CreateMixGroupInternal(MixGroupHandle mixGroupHandle)
         SetMixGroupAmplitudeCommand& data = EncodeAudioCommand<SetMixGroupAmplitudeCommand>(&cmd);
         data.m_mixGroupHandle = mixGroupHandle;
         data.m_amplitude = Functions::DecibelToAmplitude(state.m_volumeDb);
-        m_commands->Add(cmd);
+        AddCommand(cmd);
     }
 }
 
@@ -410,7 +437,16 @@ const rf::MixGroupState& rf::MixerSystem::GetMixGroupState(MixGroupHandle mixGro
 
 float rf::MixerSystem::UpdateMixGroupPriority(int index)
 {
-    // Ensures that the returned priority is larger than all of the sent-to mix groups and the output.
+    const MixGroupHandle mixGroupHandle = m_mixGroupState[index].m_mixGroupHandle;
+    const float priority = UpdateMixGroupPriorityInternal(index);
+    UpdateInputPriorities(mixGroupHandle, 0);
+    return priority;
+}
+
+float rf::MixerSystem::UpdateMixGroupPriorityInternal(int index)
+{
+    // Ensures that the returned priority is larger than all of the sent-to mix groups, the output and any mix group
+    // with a plug-in that uses this one as a sidechain.
     float priority = -1.0f;
 
     for (int i = 0; i < RF_MAX_MIX_GROUP_SENDS; ++i)
@@ -427,6 +463,17 @@ float rf::MixerSystem::UpdateMixGroupPriority(int index)
         priority = std::max(sendPriority, priority) + 0.001f;
     }
 
+    const MixGroupHandle mixGroupHandle = m_mixGroupState[index].m_mixGroupHandle;
+    for (int i = 0; i < RF_MAX_MIX_GROUPS * RF_MAX_MIX_GROUP_PLUGINS; ++i)
+    {
+        const PluginBase* plugin = m_plugins[i];
+        if (plugin && plugin->GetSidechainMixGroupHandle() == mixGroupHandle)
+        {
+            const float sidechainPriority = GetMixGroupState(plugin->GetMixGroupHandle()).m_priority;
+            priority = std::max(sidechainPriority, priority) + 0.001f;
+        }
+    }
+
     const int outputIndex = GetMixGroupIndex(m_mixGroupState[index].m_outputMixGroupHandle);
     const float outputPriority = m_mixGroupState[outputIndex].m_priority;
     priority = std::max(outputPriority, priority) + 0.001f;
@@ -438,6 +485,120 @@ float rf::MixerSystem::UpdateMixGroupPriority(int index)
     return priority;
 }
 
+void rf::MixerSystem::UpdateInputPriorities(MixGroupHandle mixGroupHandle, int depth)
+{
+    // Raising a mix group's priority can leave the mix groups that feed into it, or that it reads as a sidechain, behind
+    // it in the processing order. Raise those too and let the audio thread know.
+    if (depth >= RF_MAX_MIX_GROUPS)
+    {
+        RF_FAIL("Mix group routing contains a cycle");
+        return;
+    }
+
+    MixGroupHandle inputs[RF_MAX_MIX_GROUPS + RF_MAX_MIX_GROUP_PLUGINS];
+    int numInputs = 0;
+
+    for (int i = 0; i < m_numMixGroupState; ++i)
+    {
+        const MixGroupState& state = m_mixGroupState[i];
+        if (state.m_isMaster || state.m_mixGroupHandle == mixGroupHandle)
+        {
+            continue;
+        }
+
+        bool isInput = state.m_outputMixGroupHandle == mixGroupHandle;
+        for (int j = 0; j < RF_MAX_MIX_GROUP_SENDS && !isInput; ++j)
+        {
+            const int sendIndex = state.m_sendSlots[j];
+            isInput = sendIndex != -1 && m_sends[sendIndex].GetSendToMixGroupHandle() == mixGroupHandle;
+        }
+
+        if (isInput)
+        {
+            inputs[numInputs++] = state.m_mixGroupHandle;
+        }
+    }
+
+    {
+        const MixGroupState& state = GetMixGroupState(mixGroupHandle);
+        for (int i = 0; i < RF_MAX_MIX_GROUP_PLUGINS; ++i)
+        {
+            const int pluginIndex = state.m_pluginSlots[i];
+            if (pluginIndex < 0)
+            {
+                continue;
+            }
+
+            const MixGroupHandle sidechainMixGroupHandle = m_plugins[pluginIndex]->GetSidechainMixGroupHandle();
+            if (sidechainMixGroupHandle)
+            {
+                inputs[numInputs++] = sidechainMixGroupHandle;
+            }
+        }
+    }
+
+    for (int i = 0; i < numInputs; ++i)
+    {
+        // Sorting moves the state around, so look everything up by handle.
+        if (GetMixGroupState(inputs[i]).m_priority > GetMixGroupState(mixGroupHandle).m_priority)
+        {
+            continue;
+        }
+
+        const float priority = UpdateMixGroupPriorityInternal(GetMixGroupIndex(inputs[i]));
+
+        AudioCommand cmd;
+        SetMixGroupPriorityCommand& data = EncodeAudioCommand<SetMixGroupPriorityCommand>(&cmd);
+        data.m_mixGroupHandle = inputs[i];
+        data.m_priority = priority;
+        AddCommand(cmd);
+
+        UpdateInputPriorities(inputs[i], depth + 1);
+    }
+}
+
+bool rf::MixerSystem::FeedsInto(MixGroupHandle mixGroupHandle, MixGroupHandle otherMixGroupHandle, int depth) const
+{
+    // True if the mix group has to be processed before the other one, through its output, its sends or a plug-in that
+    // reads it as a sidechain.
+    if (mixGroupHandle == otherMixGroupHandle || depth >= RF_MAX_MIX_GROUPS)
+    {
+        return true;
+    }
+
+    const MixGroupState& state = GetMixGroupState(mixGroupHandle);
+    if (state.m_isMaster)
+    {
+        return false;
+    }
+
+    if (FeedsInto(state.m_outputMixGroupHandle, otherMixGroupHandle, depth + 1))
+    {
+        return true;
+    }
+
+    for (int i = 0; i < RF_MAX_MIX_GROUP_SENDS; ++i)
+    {
+        const int sendIndex = state.m_sendSlots[i];
+        if (sendIndex != -1 && FeedsInto(m_sends[sendIndex].GetSendToMixGroupHandle(), otherMixGroupHandle, depth + 1))
+        {
+            return true;
+        }
+    }
+
+    for (int i = 0; i < RF_MAX_MIX_GROUPS * RF_MAX_MIX_GROUP_PLUGINS; ++i)
+    {
+        const PluginBase* plugin = m_plugins[i];
+        if (plugin && plugin->GetSidechainMixGroupHandle() == mixGroupHandle &&
+            FeedsInto(plugin->GetMixGroupHandle(), otherMixGroupHandle, depth + 1))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 bool rf::MixerSystem::CanCreateSend() const
 {
     for (int i = 0; i < RF_MAX_MIX_GROUPS * RF_MAX_MIX_GROUP_SENDS; ++i)
@@ -480,6 +641,8 @@ int rf::MixerSystem::DestroySend(const Send* send)
     {
         if (m_sends[i].GetSendHandle() == sendHandle)
         {
+            // The slot can be reused straight away, so destroying it waits for the send's own commands.
+            m_readyPlayhead = std::max(m_readyPlayhead, send->m_readyPlayhead);
             new (m_sends + i) Send(nullptr, -1, MixGroupHandle());
             return i;
         }
@@ -502,6 +665,19 @@ bool rf::MixerSystem::CanCreatePlugin() const
     return false;
 }
 
+bool rf::MixerSystem::CanEnableLoudnessMetering() const
+{
+    int numLoudnessMeters = 0;
+    for (int i = 0; i < m_numMixGroupState; ++i)
+    {
+        if (m_mixGroupState[i].m_loudnessMetering)
+        {
+            ++numLoudnessMeters;
+        }
+    }
+    return numLoudnessMeters < RF_MAX_LOUDNESS_METERS;
+}
+
 rf::PluginBase** rf::MixerSystem::GetPluginBaseForCreation(int* outIndex)
 {
     for (int i = 0; i < RF_MAX_MIX_GROUPS * RF_MAX_MIX_GROUP_PLUGINS; ++i)
@@ -556,11 +732,11 @@ bool rf::MixerSystem::ProcessMessages(const Message& message)
 {
     switch (message.m_type)
     {
-        case MessageType::MixGroupPeakAmplitude:
+        case MessageType::ProfilerMixGroup:
         {
-            const Message::MixGroupPeakAmplitudeData& data = *message.GetMixGroupPeakAmplitudeData();
+            const Message::ProfilerMixGroupData& data = *message.GetProfilerMixGroupData();
             MixGroupState& mixGroupState = GetMixGroupState(data.m_mixGroupIndex);
-            mixGroupState.m_peakAmplitude = data.m_amplitude;
+            mixGroupState.m_cpuPercent = data.m_cpuPercent;
             return true;
         }
         case MessageType::MixGroupFadeComplete:
@@ -570,6 +746,20 @@ bool rf::MixerSystem::ProcessMessages(const Message& message)
             data.m_mixGroupHandle;
             return true;
         }
+        case MessageType::DSPDestroy:
+        {
+            // The audio thread has let go of the DSP, so it is freed here rather than on the audio thread.
+            DSPBase* dsp = message.GetDSPDestroyData()->m_dsp;
+            Allocator::Deallocate<DSPBase>(&dsp);
+            return true;
+        }
+        case MessageType::ConvolverChannelsDestroy:
+        {
+            // Replaced by a convolver that needed longer channels.
+            ConvolverChannels* channels = message.GetConvolverChannelsDestroyData()->m_channels;
+            Allocator::Deallocate<ConvolverChannels>(&channels);
+            return true;
+        }
         default: return false;
     }
 }
@@ -670,6 +860,10 @@ void rf::from_json(const nlohmann::ordered_json& json, MixerSystem& object)
 
         object.CreateMasterMixGroup();
         object.m_masterMixGroup->SetVolumeDb(volumeDb);
+        if (data.value("loudnessMetering", false))
+        {
+            object.m_masterMixGroup->SetLoudnessMetering(true);
+        }
         break;
     }
 
@@ -688,6 +882,10 @@ void rf::from_json(const nlohmann::ordered_json& json, MixerSystem& object)
 
         MixGroup* mixGroup = object.CreateMixGroup(name.c_str());
         mixGroup->SetVolumeDb(volumeDb);
+        if (data.value("loudnessMetering", false))
+        {
+            mixGroup->SetLoudnessMetering(true);
+        }
     }
 
     // 3. Assign Outputs
@@ -744,7 +942,7 @@ void rf::from_json(const nlohmann::ordered_json& json, MixerSystem& object)
             const PluginBase::Type pluginType = static_cast<PluginBase::Type>(type);
             PluginBase* plugin = nullptr;
 
-            static_assert(static_cast<int>(PluginBase::Type::Version) == 1, "Update switch");
+            static_assert(static_cast<int>(PluginBase::Type::Version) == 2, "Update switch");
 
             switch (pluginType)
             {
@@ -753,6 +951,7 @@ void rf::from_json(const nlohmann::ordered_json& json, MixerSystem& object)
                 case PluginBase::Type::Compressor: plugin = mixGroup->CreatePlugin<CompressorPlugin>(slot); break;
                 case PluginBase::Type::Convolver: plugin = mixGroup->CreatePlugin<ConvolverPlugin>(slot); break;
                 case PluginBase::Type::Delay: plugin = mixGroup->CreatePlugin<DelayPlugin>(slot); break;
+                case PluginBase::Type::Ducker: plugin = mixGroup->CreatePlugin<DuckerPlugin>(slot); break;
                 case PluginBase::Type::Gain: plugin = mixGroup->CreatePlugin<GainPlugin>(slot); break;
                 case PluginBase::Type::IIR2HighpassFilter: plugin = mixGroup->CreatePlugin<IIR2HighpassFilterPlugin>(slot); break;
                 case PluginBase::Type::IIR2LowpassFilter: plugin = mixGroup->CreatePlugin<IIR2LowpassFilterPlugin>(slot); break;
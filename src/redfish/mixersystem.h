@@ -27,6 +27,7 @@
 
 namespace rf
 {
+struct AudioCommand;
 class CommandProcessor;
 class Context;
 class MixGroup;
@@ -55,6 +56,7 @@ public:
     MixGroup* GetMixGroup(const char* name);
     MixGroup* GetMixGroup(int index);
     MixGroup* GetMasterMixGroup() const;
+    bool CanSidechain(MixGroupHandle mixGroupHandle, MixGroupHandle sidechainMixGroupHandle) const;
     void FadeMixGroups(const MixGroup** mixGroups, int numMixGroups, float volumeDb, const Sync& sync, const Sync& duration, const Stinger* stinger);
     void FadeMixGroups(const MixGroup** mixGroups, int numMixGroups, float volumeDb, const Sync& sync, const Sync& duration);
 
@@ -66,8 +68,11 @@ private:
     MixGroup* m_mixGroups = nullptr;
     Send* m_sends = nullptr;
     PluginBase** m_plugins = nullptr;
+    long long m_readyPlayhead = -1;
     int m_numMixGroupState = 0;
 
+    // Adds a command that changes the mixer's layout, which never overtakes an earlier change scheduled further ahead.
+    void AddCommand(const AudioCommand& cmd);
     void Allocate();
     void Free();
     void CreateMasterMixGroup();
@@ -78,11 +83,15 @@ private:
     MixGroupState& GetMixGroupState(int index);
     const MixGroupState& GetMixGroupState(int index) const;
     float UpdateMixGroupPriority(int index);
+    float UpdateMixGroupPriorityInternal(int index);
+    void UpdateInputPriorities(MixGroupHandle mixGroupHandle, int depth);
+    bool FeedsInto(MixGroupHandle mixGroupHandle, MixGroupHandle otherMixGroupHandle, int depth) const;
     bool CanCreateSend() const;
     Send* CreateSend(MixGroupHandle sendToMixGroupHandle, int* outIndex);
     Send* GetSend(int index);
     int DestroySend(const Send* send);
     bool CanCreatePlugin() const;
+    bool CanEnableLoudnessMetering() const;
     PluginBase** GetPluginBaseForCreation(int* outIndex);
     PluginBase** GetPluginBaseForDeletion(const PluginBase* plugin, int* outIndex);
     PluginBase* GetPlugin(int pluginIndex);
@@ -92,6 +101,7 @@ private:
 
     friend class Context;
     friend class MixGroup;
+    friend class PluginBase;
     friend void to_json(nlohmann::ordered_json& json, const MixerSystem& object);
     friend void from_json(const nlohmann::ordered_json& json, MixerSystem& object);
 };
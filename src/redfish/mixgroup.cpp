@@ -23,8 +23,10 @@
 #include "mixgroup.h"
 
 #include "commandprocessor.h"
+#include "context.h"
 #include "functions.h"
 #include "mixercommands.h"
+#include "send.h"
 
 rf::MixGroup::MixGroup(Context* context, CommandProcessor* commands, MixerSystem* mixerSystem, const char* name)
     : m_context(context)
@@ -68,7 +70,7 @@ void rf::MixGroup::SetVolumeDb(float volumeDb)
     SetMixGroupAmplitudeCommand& data = EncodeAudioCommand<SetMixGroupAmplitudeCommand>(&cmd);
     data.m_mixGroupHandle = m_mixGroupHandle;
     data.m_amplitude = Functions::DecibelToAmplitude(volumeDb);
-    m_commands->Add(cmd);
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
 }
 
 float rf::MixGroup::GetVolumeDb() const
@@ -88,7 +90,7 @@ void rf::MixGroup::SetOutputMixGroup(const MixGroup* mixGroup)
     data.m_mixGroupHandle = m_mixGroupHandle;
     data.m_priority = priority;
     data.m_outputMixGroupHandle = output;
-    m_commands->Add(cmd);
+    m_mixerSystem->AddCommand(cmd);
 
     m_output = m_mixerSystem->GetMixGroup(output);
 }
@@ -119,7 +121,8 @@ rf::Send* rf::MixGroup::CreateSend(const MixGroup* mixGroup, int slot)
     data.m_priority = priority;
     data.m_mixGroupHandle = m_mixGroupHandle;
     data.m_sendToMixGroupHandle = sendToHandle;
-    m_commands->Add(cmd);
+    m_mixerSystem->AddCommand(cmd);
+    send->m_readyPlayhead = m_mixerSystem->m_readyPlayhead;
 
     return send;
 }
@@ -183,14 +186,48 @@ void rf::MixGroup::DestroySend(Send** send)
     data.m_mixGroupSlot = mixGroupSlot;
     data.m_priority = priority;
     data.m_mixGroupHandle = m_mixGroupHandle;
-    m_commands->Add(cmd);
+    m_mixerSystem->AddCommand(cmd);
 
     *send = nullptr;
 }
 
 float rf::MixGroup::GetCurrentAmplitude() const
 {
-    return m_mixerSystem->GetMixGroupState(m_mixGroupHandle).m_peakAmplitude;
+    const MixGroupMeter* meter = GetMeter();
+    return meter ? meter->GetPeakAmplitude() : 0.0f;
+}
+
+const rf::MixGroupMeter* rf::MixGroup::GetMeter() const
+{
+    return m_context->GetMixGroupMeter(m_mixGroupHandle);
+}
+
+void rf::MixGroup::SetLoudnessMetering(bool enable)
+{
+    MixGroupState& state = m_mixerSystem->GetMixGroupState(m_mixGroupHandle);
+    if (enable && !state.m_loudnessMetering && !m_mixerSystem->CanEnableLoudnessMetering())
+    {
+        RF_FAIL("Too many mix groups with loudness metering. Increase RF_MAX_LOUDNESS_METERS");
+        return;
+    }
+
+    state.m_loudnessMetering = enable;
+
+    AudioCommand cmd;
+    SetMixGroupLoudnessMeteringCommand& data = EncodeAudioCommand<SetMixGroupLoudnessMeteringCommand>(&cmd);
+    data.m_mixGroupHandle = m_mixGroupHandle;
+    data.m_enable = enable;
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
+}
+
+bool rf::MixGroup::GetLoudnessMetering() const
+{
+    return m_mixerSystem->GetMixGroupState(m_mixGroupHandle).m_loudnessMetering;
+}
+
+float rf::MixGroup::GetCpuPercent() const
+{
+    return m_mixerSystem->GetMixGroupState(m_mixGroupHandle).m_cpuPercent;
 }
 
 rf::MixGroup* rf::MixGroup::GetOutputMixGroup()
@@ -25,6 +25,7 @@
 #include "assert.h"
 #include "defines.h"
 #include "identifiers.h"
+#include "meteringblock.h"
 #include "mixersystem.h"
 #include "mixgroupstate.h"
 
@@ -55,6 +56,11 @@ public:
     Send* GetSend(int slot) const;
     void DestroySend(Send** send);
     float GetCurrentAmplitude() const;
+    const MixGroupMeter* GetMeter() const;
+    // Measures BS.1770 loudness into the meter. Enabling it again restarts integrated loudness.
+    void SetLoudnessMetering(bool enable);
+    bool GetLoudnessMetering() const;
+    float GetCpuPercent() const;
     MixGroup* GetOutputMixGroup();
     const char* GetName() const;
     PluginBase* GetPlugin(int slot);
@@ -154,5 +160,9 @@ private:
     MixerSystem* m_mixerSystem = nullptr;
     MixGroup* m_output = nullptr;
     MixGroupHandle m_mixGroupHandle;
+    long long m_readyPlayhead = -1;
+
+    friend class MixerSystem;
+    friend class SoundEffect;
 };
 }  // namespace rf
\ No newline at end of file
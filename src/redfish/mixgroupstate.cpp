@@ -40,6 +40,7 @@ void rf::to_json(nlohmann::ordered_json& json, const MixGroupState& object)
     nlohmann::ordered_json j;
     j["volumeDb"] = object.m_volumeDb;
     j["isMaster"] = object.m_isMaster;
+    j["loudnessMetering"] = object.m_loudnessMetering;
     json = j;
 }
 
@@ -47,4 +48,5 @@ void rf::from_json(const nlohmann::ordered_json& json, MixGroupState& object)
 {
     object.m_volumeDb = json["volumeDb"];
     object.m_isMaster = json["isMaster"];
+    object.m_loudnessMetering = json.value("loudnessMetering", false);
 }
\ No newline at end of file
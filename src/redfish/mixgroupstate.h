@@ -21,8 +21,6 @@
 // SOFTWARE.
 
 #pragma once
-#include <float.h>
-
 #include <external/nlohmann/json.hpp>
 
 #include "defines.h"
@@ -36,10 +34,12 @@ struct MixGroupState
     MixGroupHandle m_outputMixGroupHandle;
     int m_sendSlots[RF_MAX_MIX_GROUP_SENDS];
     int m_pluginSlots[RF_MAX_MIX_GROUP_PLUGINS];
-    float m_peakAmplitude = -FLT_MAX;
+    // Share of the audio callback's time budget spent on this mix group's plug-ins and faders.
+    float m_cpuPercent = 0.0f;
     float m_priority = 0.0f;
     float m_volumeDb = 0.0f;
     bool m_isMaster = false;
+    bool m_loudnessMetering = false;
 
     MixGroupState();
 };
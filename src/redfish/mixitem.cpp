@@ -22,7 +22,10 @@
 
 #include "mixitem.h"
 
+#include <cstring>
+
 #include "allocator.h"
+#include "assert.h"
 #include "buffer.h"
 
 rf::MixItem::MixItem(int channels, int bufferSize)
@@ -108,6 +111,14 @@ void rf::MixItem::Multiply(const MixItem& item)
     }
 }
 
+void rf::MixItem::Multiply(const Buffer& buffer, int bufferSize)
+{
+    for (int i = 0; i < m_channels; ++i)
+    {
+        m_arrayOfChannels[i].Multiply(buffer, bufferSize);
+    }
+}
+
 void rf::MixItem::ZeroOut()
 {
     for (int i = 0; i < m_channels; ++i)
@@ -124,12 +135,13 @@ void rf::MixItem::Set(float value)
     }
 }
 
-void rf::MixItem::ToInterleavedBuffer(float* buffer)
+void rf::MixItem::ToInterleavedBuffer(float* buffer, int numFrames)
 {
+    RF_ASSERT(numFrames <= m_bufferSize, "Expected numFrames to fit in the mix item");
     for (int channel = 0; channel < m_channels; ++channel)
     {
         int index = channel;
-        for (int i = 0; i < m_bufferSize; ++i)
+        for (int i = 0; i < numFrames; ++i)
         {
             buffer[index] = m_arrayOfChannels[channel][i];
             index += m_channels;
@@ -156,6 +168,16 @@ float rf::MixItem::GetPeakAmplitudeForChannel(int channel) const
     return m_arrayOfChannels[channel].GetAbsoluteMax();
 }
 
+void rf::MixItem::GetLinkedPeaks(Buffer* outPeaks, int bufferSize) const
+{
+    // Per-sample absolute maximum across all channels. Only the frames being processed are touched.
+    memset(outPeaks->GetAsFloatBuffer(), 0, sizeof(float) * bufferSize);
+    for (int i = 0; i < m_channels; ++i)
+    {
+        outPeaks->MaxAbsolute(m_arrayOfChannels[i], bufferSize);
+    }
+}
+
 void rf::MixItem::Allocate(int channels, int bufferSize)
 {
     Free();
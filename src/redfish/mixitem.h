@@ -43,11 +43,13 @@ struct MixItem
 
     void Sum(const MixItem& item, float amplitude = 1.0f);
     void Multiply(const MixItem& item);
+    void Multiply(const Buffer& buffer, int bufferSize);
     void ZeroOut();
     void Set(float value);
-    void ToInterleavedBuffer(float* buffer);
+    void ToInterleavedBuffer(float* buffer, int numFrames);
     float GetPeakAmplitude() const;
     float GetPeakAmplitudeForChannel(int channel) const;
+    void GetLinkedPeaks(Buffer* outPeaks, int bufferSize) const;
 
 private:
     void Allocate(int channels, int bufferSize);
@@ -96,6 +96,12 @@ rf::AudioCommandCallback rf::FadeOutAndStopMusicCommand::s_callback = [](AudioTi
     musicManager.Fade(startTime, 0.0f, sampleDuration, playhead, true);
 };
 
+rf::AudioCommandCallback rf::SetMusicLayerVolumeCommand::s_callback = [](AudioTimeline* timeline, void* command) {
+    const SetMusicLayerVolumeCommand& cmd = *static_cast<SetMusicLayerVolumeCommand*>(command);
+    MusicManager& musicManager = timeline->m_musicManager;
+    musicManager.SetLayerAmplitude(cmd.m_layerIndex, cmd.m_amplitude, musicManager.GetSyncSamples(cmd.m_duration));
+};
+
 rf::AudioCommandCallback rf::PlayStingerCommand::s_callback = [](AudioTimeline* timeline, void* command) {
     const PlayStingerCommand& cmd = *static_cast<PlayStingerCommand*>(command);
     MusicDatabase* database = timeline->m_musicManager.GetMusicDatabase();
@@ -95,6 +95,14 @@ struct FadeOutAndStopMusicCommand
     static AudioCommandCallback s_callback;
 };
 
+struct SetMusicLayerVolumeCommand
+{
+    Sync m_duration;
+    float m_amplitude = 1.0f;
+    int m_layerIndex = -1;
+    static AudioCommandCallback s_callback;
+};
+
 struct PlayStingerCommand
 {
     int m_index = -1;
@@ -0,0 +1,48 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "defines.h"
+
+namespace rf
+{
+// Sizes the music system. Everything is allocated when the Context is constructed, so these only cost memory for the
+// music a title actually uses.
+struct MusicConfig
+{
+    int m_maxCues = RF_MAX_CUES;
+    int m_maxTransitions = RF_MAX_TRANSITIONS;
+    int m_maxStingers = RF_MAX_STINGERS;
+    // The most layers a cue can have. Every layer needs a music voice for the cue, and one for each stinger that can play
+    // at once. Can't be more than RF_MAX_CUE_LAYERS.
+    int m_maxCueLayers = 4;
+    // The most stingers that can play over each other.
+    int m_maxPlayingStingers = RF_MAX_STINGERS;
+    // How much of a streamed cue layer has to be decoded for it to start. It is decoded before the rest of the layer,
+    // and before the rest of any other streamed layer. See AssetSystem::LoadStreamed.
+    float m_streamPrefetchSeconds = 2.0f;
+    // How much of a streamed cue layer past its prefetched head is decoded ahead of playback. While a layer is queued or
+    // playing it holds m_streamPrefetchSeconds + m_streamBufferSeconds of samples for each of its channels, as 32-bit
+    // floats, however long the file is: 4 seconds of 48 kHz stereo is 1.5 MB. Shorter files are held in full.
+    float m_streamBufferSeconds = 2.0f;
+};
+}  // namespace rf
\ No newline at end of file
@@ -29,43 +29,105 @@
 #include "stinger.h"
 #include "transition.h"
 
-rf::MusicDatabase::MusicDatabase()
+template <class T>
+static void ReserveArray(size_t* size, int num)
 {
-    m_cueData = Allocator::AllocateArray<CueData>("MusicDatabaseCueData", RF_MAX_CUES);
-    m_transitionData = Allocator::AllocateArray<TransitionData>("MusicDatabaseTransitionData", RF_MAX_TRANSITIONS);
-    m_transitionHandles = Allocator::AllocateArray<TransitionHandle>("MusicDatabaseTransitionHandle", RF_MAX_TRANSITIONS);
-    m_transitionConditions = Allocator::AllocateArray<TransitionCondition>("MusicDatabaseTransitionConditions", RF_MAX_TRANSITIONS);
-    m_stingerData = Allocator::AllocateArray<StingerData>("MusicDatabaseStingerData", RF_MAX_STINGERS);
+    *size = (*size + alignof(T) - 1) / alignof(T) * alignof(T) + sizeof(T) * num;
+}
+
+template <class T>
+static T* ConstructArray(void* block, size_t* offset, int num)
+{
+    *offset = (*offset + alignof(T) - 1) / alignof(T) * alignof(T);
+    T* data = reinterpret_cast<T*>(static_cast<char*>(block) + *offset);
+    for (int i = 0; i < num; ++i)
+    {
+        new (data + i) T();
+    }
+    *offset += sizeof(T) * num;
+    return data;
+}
+
+template <class T>
+static void DestructArray(T* data, int num)
+{
+    for (int i = 0; i < num; ++i)
+    {
+        data[i].~T();
+    }
+}
+
+rf::MusicDatabase::MusicDatabase(const MusicConfig& config)
+    : m_config(config)
+{
+    RF_ASSERT(config.m_maxCueLayers > 0 && config.m_maxCueLayers <= RF_MAX_CUE_LAYERS, "MusicConfig::m_maxCueLayers can't be more than RF_MAX_CUE_LAYERS");
+    const int numLayers = config.m_maxCues * config.m_maxCueLayers;
+
+    size_t size = 0;
+    ReserveArray<CueData>(&size, config.m_maxCues);
+    ReserveArray<Layer>(&size, numLayers);
+    ReserveArray<TransitionData>(&size, config.m_maxTransitions);
+    ReserveArray<TransitionHandle>(&size, config.m_maxTransitions);
+    ReserveArray<TransitionCondition>(&size, config.m_maxTransitions);
+    ReserveArray<StingerData>(&size, config.m_maxStingers);
+    m_block = Allocator::AllocateMemory(size, "MusicDatabase", Allocator::k_maxAlignment);
+
+    size_t offset = 0;
+    m_cueData = ConstructArray<CueData>(m_block, &offset, config.m_maxCues);
+    m_layers = ConstructArray<Layer>(m_block, &offset, numLayers);
+    m_transitionData = ConstructArray<TransitionData>(m_block, &offset, config.m_maxTransitions);
+    m_transitionHandles = ConstructArray<TransitionHandle>(m_block, &offset, config.m_maxTransitions);
+    m_transitionConditions = ConstructArray<TransitionCondition>(m_block, &offset, config.m_maxTransitions);
+    m_stingerData = ConstructArray<StingerData>(m_block, &offset, config.m_maxStingers);
+    RF_ASSERT(offset == size, "Expected the tables to fill the block");
+
+    for (int i = 0; i < config.m_maxCues; ++i)
+    {
+        m_cueData[i].m_layers = m_layers + i * config.m_maxCueLayers;
+    }
 }
 
 rf::MusicDatabase::~MusicDatabase()
 {
-    Allocator::DeallocateArray<CueData>(&m_cueData, RF_MAX_CUES);
-    Allocator::DeallocateArray<TransitionData>(&m_transitionData, RF_MAX_TRANSITIONS);
-    Allocator::DeallocateArray<TransitionHandle>(&m_transitionHandles, RF_MAX_TRANSITIONS);
-    Allocator::DeallocateArray<TransitionCondition>(&m_transitionConditions, RF_MAX_TRANSITIONS);
-    Allocator::DeallocateArray<StingerData>(&m_stingerData, RF_MAX_STINGERS);
+    DestructArray<CueData>(m_cueData, m_config.m_maxCues);
+    DestructArray<Layer>(m_layers, m_config.m_maxCues * m_config.m_maxCueLayers);
+    DestructArray<TransitionData>(m_transitionData, m_config.m_maxTransitions);
+    DestructArray<TransitionHandle>(m_transitionHandles, m_config.m_maxTransitions);
+    DestructArray<TransitionCondition>(m_transitionConditions, m_config.m_maxTransitions);
+    DestructArray<StingerData>(m_stingerData, m_config.m_maxStingers);
+    Allocator::DeallocateMemory(m_block);
+    m_block = nullptr;
 }
 
 void rf::MusicDatabase::CreateCue(const Cue* cue, int index)
 {
-    RF_ASSERT(index >= 0 && index < RF_MAX_CUES, "Index out of bounds");
+    RF_ASSERT(index >= 0 && index < m_config.m_maxCues, "Index out of bounds");
     CueData& data = m_cueData[index];
     data.m_cueHandle = cue->GetCueHandle();
     data.m_meter = cue->GetMeter();
     data.m_tempo = cue->GetTempo();
     data.m_gainDb = cue->GetGainDb();
     data.m_numLayers = cue->GetNumLayers();
+    RF_ASSERT(data.m_numLayers <= m_config.m_maxCueLayers, "Too many layers. Increase MusicConfig::m_maxCueLayers");
     for (int i = 0; i < data.m_numLayers; ++i)
     {
         data.m_layers[i] = cue->GetLayer(i);
     }
+
+    data.m_numTempoChanges = cue->GetNumTempoChanges();
+    for (int i = 0; i < data.m_numTempoChanges; ++i)
+    {
+        data.m_tempoChanges[i] = cue->GetTempoChange(i);
+    }
 }
 
 void rf::MusicDatabase::DestroyCue(int index, Messenger* messenger)
 {
-    RF_ASSERT(index >= 0 && index < RF_MAX_CUES, "Index out of bounds");
+    RF_ASSERT(index >= 0 && index < m_config.m_maxCues, "Index out of bounds");
+    // The layers stay with the cue slot, ready for the next cue created in it.
+    Layer* layers = m_cueData[index].m_layers;
     m_cueData[index] = CueData();
+    m_cueData[index].m_layers = layers;
 
     Message msg;
     msg.m_type = MessageType::MusicDestroyCue;
@@ -75,13 +137,13 @@ void rf::MusicDatabase::DestroyCue(int index, Messenger* messenger)
 
 const rf::MusicDatabase::CueData& rf::MusicDatabase::GetCueData(int index) const
 {
-    RF_ASSERT(index >= 0 && index < RF_MAX_CUES, "Index out of bounds");
+    RF_ASSERT(index >= 0 && index < m_config.m_maxCues, "Index out of bounds");
     return m_cueData[index];
 }
 
 void rf::MusicDatabase::CreateTransition(const Transition* transition, int index)
 {
-    RF_ASSERT(index >= 0 && index < RF_MAX_TRANSITIONS, "Index out of bounds");
+    RF_ASSERT(index >= 0 && index < m_config.m_maxTransitions, "Index out of bounds");
     TransitionData& data = m_transitionData[index];
     data.m_transitionHandle = transition->GetTransitionHandle();
     data.m_sync = transition->GetSync();
@@ -94,7 +156,7 @@ void rf::MusicDatabase::CreateTransition(const Transition* transition, int index
 
     if (const Transition* followUp = transition->GetFollowUpTransition())
     {
-        for (int i = 0; i < RF_MAX_TRANSITIONS; ++i)
+        for (int i = 0; i < m_config.m_maxTransitions; ++i)
         {
             if (m_transitionData[i].m_transitionHandle == followUp->GetTransitionHandle())
             {
@@ -108,7 +170,7 @@ void rf::MusicDatabase::CreateTransition(const Transition* transition, int index
 
     if (const Stinger* stinger = transition->GetStinger())
     {
-        for (int i = 0; i < RF_MAX_STINGERS; ++i)
+        for (int i = 0; i < m_config.m_maxStingers; ++i)
         {
             if (m_stingerData[i].m_stingerHandle == stinger->GetStingerHandle())
             {
@@ -123,7 +185,7 @@ void rf::MusicDatabase::CreateTransition(const Transition* transition, int index
 
 void rf::MusicDatabase::DestroyTransition(int index, Messenger* messenger)
 {
-    RF_ASSERT(index >= 0 && index < RF_MAX_TRANSITIONS, "Index out of bounds");
+    RF_ASSERT(index >= 0 && index < m_config.m_maxTransitions, "Index out of bounds");
     m_transitionData[index] = TransitionData();
 
     Message msg;
@@ -134,13 +196,13 @@ void rf::MusicDatabase::DestroyTransition(int index, Messenger* messenger)
 
 const rf::MusicDatabase::TransitionData& rf::MusicDatabase::GetTransitionData(int index) const
 {
-    RF_ASSERT(index >= 0 && index < RF_MAX_TRANSITIONS, "Index out of bounds");
+    RF_ASSERT(index >= 0 && index < m_config.m_maxTransitions, "Index out of bounds");
     return m_transitionData[index];
 }
 
 int rf::MusicDatabase::GetTransitionIndexThatMeetsCondition(const void* userData, CueHandle cueHandle, int currentBar, int currentBeat) const
 {
-    for (int i = 0; i < RF_MAX_TRANSITIONS; ++i)
+    for (int i = 0; i < m_config.m_maxTransitions; ++i)
     {
         const TransitionHandle transitionHandle = m_transitionHandles[i];
         if (!transitionHandle)
@@ -159,12 +221,12 @@ int rf::MusicDatabase::GetTransitionIndexThatMeetsCondition(const void* userData
 
 void rf::MusicDatabase::CreateStinger(const Stinger* stinger, int index)
 {
-    RF_ASSERT(index >= 0 && index < RF_MAX_STINGERS, "Index out of bounds");
+    RF_ASSERT(index >= 0 && index < m_config.m_maxStingers, "Index out of bounds");
     StingerData& data = m_stingerData[index];
     data.m_stingerHandle = stinger->GetStingerHandle();
     data.m_sync = stinger->GetSync();
     data.m_gainDb = stinger->GetGainDb();
-    for (int i = 0; i < RF_MAX_CUES; ++i)
+    for (int i = 0; i < m_config.m_maxCues; ++i)
     {
         const CueHandle cueHandle = stinger->GetCueHandle();
         if (m_cueData[i].m_cueHandle == cueHandle)
@@ -179,7 +241,7 @@ void rf::MusicDatabase::CreateStinger(const Stinger* stinger, int index)
 
 void rf::MusicDatabase::DestroyStinger(int index, Messenger* messenger)
 {
-    RF_ASSERT(index >= 0 && index < RF_MAX_STINGERS, "Index out of bounds");
+    RF_ASSERT(index >= 0 && index < m_config.m_maxStingers, "Index out of bounds");
     m_stingerData[index] = StingerData();
 
     Message msg;
@@ -190,13 +252,13 @@ void rf::MusicDatabase::DestroyStinger(int index, Messenger* messenger)
 
 const rf::MusicDatabase::StingerData& rf::MusicDatabase::GetStingerData(int index) const
 {
-    RF_ASSERT(index >= 0 && index < RF_MAX_STINGERS, "Index out of bounds");
+    RF_ASSERT(index >= 0 && index < m_config.m_maxStingers, "Index out of bounds");
     return m_stingerData[index];
 }
 
 int rf::MusicDatabase::GetCueDataIndexByHandle(CueHandle cueHandle) const
 {
-    for (int i = 0; i < RF_MAX_CUES; ++i)
+    for (int i = 0; i < m_config.m_maxCues; ++i)
     {
         if (m_cueData[i].m_cueHandle == cueHandle)
         {
@@ -206,4 +268,4 @@ int rf::MusicDatabase::GetCueDataIndexByHandle(CueHandle cueHandle) const
 
     RF_FAIL("Could not find index for Cue");
     return -1;
-}
+}
\ No newline at end of file
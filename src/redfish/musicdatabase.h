@@ -24,7 +24,9 @@
 #include "defines.h"
 #include "layer.h"
 #include "meter.h"
+#include "musicconfig.h"
 #include "sync.h"
+#include "tempomap.h"
 
 namespace rf
 {
@@ -37,7 +39,7 @@ struct TransitionCondition;
 class MusicDatabase
 {
 public:
-    MusicDatabase();
+    explicit MusicDatabase(const MusicConfig& config);
     MusicDatabase(const MusicDatabase&) = delete;
     MusicDatabase(MusicDatabase&&) = delete;
     MusicDatabase& operator=(const MusicDatabase&) = delete;
@@ -46,8 +48,11 @@ public:
 
     struct CueData
     {
-        Layer m_layers[RF_MAX_CUE_LAYERS];
+        // Points at the cue's MusicConfig::m_maxCueLayers layers in the database block.
+        Layer* m_layers = nullptr;
+        TempoChange m_tempoChanges[RF_MAX_CUE_TEMPO_CHANGES];
         int m_numLayers = 0;
+        int m_numTempoChanges = 0;
         CueHandle m_cueHandle;
         Meter m_meter;
         float m_tempo = 0.0f;
@@ -87,7 +92,11 @@ public:
     const StingerData& GetStingerData(int index) const;
 
 private:
+    MusicConfig m_config;
+    // Every table below lives in this one allocation, so looking up music data stays in a small range of memory.
+    void* m_block = nullptr;
     CueData* m_cueData = nullptr;
+    Layer* m_layers = nullptr;
     TransitionData* m_transitionData = nullptr;
     TransitionHandle* m_transitionHandles = nullptr;
     TransitionCondition* m_transitionConditions = nullptr;
@@ -22,16 +22,19 @@
 
 #include "musicmanager.h"
 
+#include "audiodata.h"
 #include "audiotimeline.h"
+#include "musicconfig.h"
 
-rf::MusicManager::MusicManager(AudioTimeline* timeline, const AudioSpec& spec)
+rf::MusicManager::MusicManager(AudioTimeline* timeline, const AudioSpec& spec, const MusicConfig& config)
     : m_timeline(timeline)
-    , m_musicDatabase(Allocator::Allocate<MusicDatabase>("MusicDatabase"))
+    , m_musicDatabase(Allocator::Allocate<MusicDatabase>("MusicDatabase", config))
     , m_conductor(m_musicDatabase, spec, &timeline->m_messenger)
-    , m_sequencer(m_musicDatabase, spec, &timeline->m_messenger)
-    , m_cuesToDestory(RF_MAX_CUES)
-    , m_stingersToDestory(RF_MAX_STINGERS)
-    , m_transitionsToDestory(RF_MAX_TRANSITIONS)
+    , m_sequencer(m_musicDatabase, spec, config, &timeline->m_messenger)
+    , m_streamer(spec, &timeline->m_messenger)
+    , m_cuesToDestory(config.m_maxCues)
+    , m_stingersToDestory(config.m_maxStingers)
+    , m_transitionsToDestory(config.m_maxTransitions)
 {
 }
 
@@ -40,14 +43,14 @@ rf::MusicManager::~MusicManager()
     Allocator::Deallocate<MusicDatabase>(&m_musicDatabase);
 }
 
-void rf::MusicManager::Process(long long playhead, MixItem* outMixItems, int* outStartIndex)
+void rf::MusicManager::Process(long long playhead, int bufferSize, MixItem* outMixItems, int* outStartIndex)
 {
     // Process Sequencer
     outMixItems[*outStartIndex].ZeroOut();
-    const Sequencer::Result result = m_sequencer.Process(&m_conductor, playhead, outMixItems, outStartIndex, m_timeline->m_audioDataReferences);
+    const Sequencer::Result result = m_sequencer.Process(&m_conductor, playhead, bufferSize, outMixItems, outStartIndex, m_timeline->m_audioDataReferences);
     const MusicTransitionRequest& currentTransition = m_sequencer.GetCurrentTransition();
     const bool isPlaying = m_sequencer.IsPlaying();
-    m_conductor.Update(playhead, currentTransition, isPlaying);
+    m_conductor.Update(playhead, bufferSize, currentTransition, isPlaying);
 
     // Process Stops
     if (result == Sequencer::Result::Stop)
@@ -55,6 +58,11 @@ void rf::MusicManager::Process(long long playhead, MixItem* outMixItems, int* ou
         m_conductor.Reset();
     }
 
+    // Keep the streams of the music that is playing, scheduled or queued loaded.
+    m_streamer.Begin(playhead, bufferSize);
+    m_sequencer.RequireStreams(&m_streamer);
+    m_streamer.End();
+
     DeleteFromMusicDatabase();
 }
 
@@ -68,14 +76,25 @@ void rf::MusicManager::Fade(long long startTime, float amplitude, int sampleDura
     m_sequencer.Fade(startTime, amplitude, sampleDuration, playhead, stopOnDone);
 }
 
+void rf::MusicManager::SetLayerAmplitude(int layerIndex, float amplitude, int sampleDuration)
+{
+    m_sequencer.SetLayerAmplitude(layerIndex, amplitude, sampleDuration);
+}
+
 void rf::MusicManager::AddTransition(int transitionIndex)
 {
     m_sequencer.AddTransition(transitionIndex);
 }
 
+void rf::MusicManager::Load(int audioDataIndex, AudioHandle audioHandle, const AudioData* audioData)
+{
+    m_streamer.Load(audioDataIndex, audioHandle, audioData->m_stream);
+}
+
 void rf::MusicManager::Unload(AudioHandle audioHandle, long long playhead)
 {
     m_sequencer.Unload(audioHandle, playhead);
+    m_streamer.Unload(audioHandle);
 }
 
 rf::MusicDatabase* rf::MusicManager::GetMusicDatabase()
@@ -88,6 +107,11 @@ const rf::MusicDatabase* rf::MusicManager::GetMusicDatabase() const
     return m_musicDatabase;
 }
 
+const rf::Metronome& rf::MusicManager::GetMetronome() const
+{
+    return m_conductor.GetMetronome();
+}
+
 long long rf::MusicManager::CalculateStartTime(const Sync& sync, long long playhead) const
 {
     const bool syncToMusic = m_sequencer.IsPlaying() || m_sequencer.IsProcessingTransition();
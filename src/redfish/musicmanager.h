@@ -22,6 +22,7 @@
 
 #pragma once
 #include "conductor.h"
+#include "musicstreamer.h"
 #include "nonallocatinglist.h"
 #include "sequencer.h"
 
@@ -30,24 +31,28 @@ namespace rf
 class AudioTimeline;
 class MusicDatabase;
 struct AudioSpec;
+struct MusicConfig;
 
 class MusicManager
 {
 public:
-    MusicManager(AudioTimeline* timeline, const AudioSpec& spec);
+    MusicManager(AudioTimeline* timeline, const AudioSpec& spec, const MusicConfig& config);
     MusicManager(const MusicManager&) = delete;
     MusicManager(MusicManager&&) = delete;
     MusicManager& operator=(const MusicManager&) = delete;
     MusicManager& operator=(MusicManager&&) = delete;
     ~MusicManager();
 
-    void Process(long long playhead, MixItem* outMixItems, int* outStartIndex);
+    void Process(long long playhead, int bufferSize, MixItem* outMixItems, int* outStartIndex);
     void Stop(long long stopTime, long long playhead);
     void Fade(long long startTime, float amplitude, int sampleDuration, long long playhead, bool stopOnDone);
+    void SetLayerAmplitude(int layerIndex, float amplitude, int sampleDuration);
     void AddTransition(int transitionIndex);
+    void Load(int audioDataIndex, AudioHandle audioHandle, const AudioData* audioData);
     void Unload(AudioHandle audioHandle, long long playhead);
     MusicDatabase* GetMusicDatabase();
     const MusicDatabase* GetMusicDatabase() const;
+    const Metronome& GetMetronome() const;
     long long CalculateStartTime(const Sync& sync, long long playhead) const;
     int GetSyncSamples(const Sync& sync) const;
     bool IsPlaying() const;
@@ -63,6 +68,7 @@ private:
     MusicDatabase* m_musicDatabase = nullptr;
     Conductor m_conductor;
     Sequencer m_sequencer;
+    MusicStreamer m_streamer;
     MusicTransitionRequest m_lastTransition;
     NonAllocatingList<int> m_cuesToDestory;
     NonAllocatingList<int> m_stingersToDestory;
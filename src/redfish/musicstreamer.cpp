@@ -0,0 +1,176 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "musicstreamer.h"
+
+#include "assert.h"
+#include "audiospec.h"
+#include "audiostream.h"
+#include "functions.h"
+#include "messenger.h"
+
+rf::MusicStreamer::MusicStreamer(const AudioSpec& spec, Messenger* messenger)
+    : m_messenger(messenger)
+    , m_streamIndices(RF_MAX_AUDIO_DATA)
+    , m_msPerFrame(1000.0f / static_cast<float>(spec.m_sampleRate))
+{
+}
+
+void rf::MusicStreamer::Load(int audioDataIndex, AudioHandle audioHandle, AudioStream* stream)
+{
+    RF_ASSERT(audioDataIndex >= 0 && audioDataIndex < RF_MAX_AUDIO_DATA, "Index out of bounds");
+    if (!stream)
+    {
+        return;
+    }
+
+    Entry& entry = m_entries[audioDataIndex];
+    entry = Entry();
+    entry.m_stream = stream;
+    entry.m_audioHandle = audioHandle;
+    m_streamIndices.Append(audioDataIndex);
+}
+
+void rf::MusicStreamer::Unload(AudioHandle audioHandle)
+{
+    for (int i = 0; i < m_streamIndices.GetSize(); ++i)
+    {
+        Entry& entry = m_entries[m_streamIndices.Get(i)];
+        if (entry.m_audioHandle == audioHandle)
+        {
+            // The game thread frees the samples when it deletes the asset, so stop reading them now.
+            entry.m_stream->m_isRequested = false;
+            entry = Entry();
+            m_streamIndices.Erase(i);
+            return;
+        }
+    }
+}
+
+void rf::MusicStreamer::Begin(long long playhead, int bufferSize)
+{
+    m_playhead = playhead;
+    m_bufferSize = bufferSize;
+}
+
+void rf::MusicStreamer::Require(int audioDataIndex, long long startTime)
+{
+    if (audioDataIndex < 0)
+    {
+        return;
+    }
+
+    RF_ASSERT(audioDataIndex < RF_MAX_AUDIO_DATA, "Index out of bounds");
+    Entry& entry = m_entries[audioDataIndex];
+    if (!entry.m_stream)
+    {
+        return;
+    }
+
+    entry.m_isRequired = true;
+    if (Functions::InFirstWindow(m_playhead, startTime, m_bufferSize))
+    {
+        entry.m_startTime = startTime;
+    }
+}
+
+void rf::MusicStreamer::End()
+{
+    for (int index : m_streamIndices)
+    {
+        Entry& entry = m_entries[index];
+        AudioStream* stream = entry.m_stream;
+
+        if (entry.m_isRequired && !stream->m_isRequested)
+        {
+            // A new generation, so that nothing decoded for an earlier request is read.
+            ++stream->m_generation;
+            stream->m_isRequested = true;
+            stream->ResetReadPosition();
+            entry.m_readyTime = -1;
+
+            Message msg;
+            msg.m_type = MessageType::MusicStreamPrefetch;
+            Message::MusicStreamPrefetchData* data = msg.GetMusicStreamPrefetchData();
+            data->m_audioDataIndex = index;
+            data->m_generation = stream->m_generation;
+            m_messenger->AddMessage(msg);
+        }
+
+        // The stream has been read from this block, so it only counts as ready if it was ready before the block.
+        if (entry.m_startTime >= 0 && entry.m_startTime != entry.m_reportedStartTime)
+        {
+            entry.m_reportedStartTime = entry.m_startTime;
+
+            Message msg;
+            if (entry.m_readyTime >= 0)
+            {
+                msg.m_type = MessageType::MusicStreamStart;
+                Message::MusicStreamStartData* data = msg.GetMusicStreamStartData();
+                data->m_audioDataIndex = index;
+                data->m_leadTimeMs = static_cast<float>(entry.m_startTime - entry.m_readyTime) * m_msPerFrame;
+            }
+            else
+            {
+                msg.m_type = MessageType::MusicStreamMiss;
+                msg.GetMusicStreamMissData()->m_audioDataIndex = index;
+            }
+            m_messenger->AddMessage(msg);
+        }
+
+        if (stream->m_isRequested)
+        {
+            stream->UpdateReadPosition();
+        }
+
+        if (stream->m_isRequested && entry.m_readyTime < 0 && stream->IsReady())
+        {
+            entry.m_readyTime = m_playhead + m_bufferSize;
+        }
+
+        if (!entry.m_isRequired && stream->m_isRequested)
+        {
+            stream->m_isRequested = false;
+
+            Message msg;
+            msg.m_type = MessageType::MusicStreamRelease;
+            Message::MusicStreamReleaseData* data = msg.GetMusicStreamReleaseData();
+            data->m_audioDataIndex = index;
+            data->m_generation = stream->m_generation;
+            m_messenger->AddMessage(msg);
+        }
+
+        if (stream->m_numMissingFrames > 0)
+        {
+            Message msg;
+            msg.m_type = MessageType::MusicStreamUnderrun;
+            Message::MusicStreamUnderrunData* data = msg.GetMusicStreamUnderrunData();
+            data->m_audioDataIndex = index;
+            data->m_durationMs = static_cast<float>(stream->m_numMissingFrames) * m_msPerFrame;
+            m_messenger->AddMessage(msg);
+            stream->m_numMissingFrames = 0;
+        }
+
+        entry.m_startTime = -1;
+        entry.m_isRequired = false;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "defines.h"
+#include "identifiers.h"
+#include "nonallocatinglist.h"
+
+namespace rf
+{
+class Messenger;
+struct AudioSpec;
+struct AudioStream;
+
+// Keeps the streamed assets the music needs loaded. Every block the sequencer marks the streams of the cues that are
+// playing, scheduled or queued. Streams that become needed are prefetched, and streams that are no longer needed are
+// released. When a streamed cue starts, it reports how long before the start its prefetch was ready, or that it missed.
+class MusicStreamer
+{
+public:
+    MusicStreamer(const AudioSpec& spec, Messenger* messenger);
+    MusicStreamer(const MusicStreamer&) = delete;
+    MusicStreamer(MusicStreamer&&) = delete;
+    MusicStreamer& operator=(const MusicStreamer&) = delete;
+    MusicStreamer& operator=(MusicStreamer&&) = delete;
+    ~MusicStreamer() = default;
+
+    void Load(int audioDataIndex, AudioHandle audioHandle, AudioStream* stream);
+    void Unload(AudioHandle audioHandle);
+    void Begin(long long playhead, int bufferSize);
+    // Marks the stream as needed this block. startTime is when it starts to play, or -1 if it is not scheduled yet.
+    void Require(int audioDataIndex, long long startTime);
+    void End();
+
+private:
+    struct Entry
+    {
+        AudioStream* m_stream = nullptr;
+        AudioHandle m_audioHandle;
+        long long m_startTime = -1;
+        long long m_reportedStartTime = -1;
+        long long m_readyTime = -1;
+        bool m_isRequired = false;
+    };
+
+    Messenger* m_messenger = nullptr;
+    Entry m_entries[RF_MAX_AUDIO_DATA];
+    NonAllocatingList<int> m_streamIndices;
+    long long m_playhead = 0;
+    float m_msPerFrame = 0.0f;
+    int m_bufferSize = 0;
+};
+}  // namespace rf
\ No newline at end of file
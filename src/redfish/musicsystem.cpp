@@ -22,38 +22,43 @@
 
 #include "musicsystem.h"
 
+#include <algorithm>
+
 #include "allocator.h"
 #include "assert.h"
 #include "commandprocessor.h"
 #include "cue.h"
+#include "functions.h"
 #include "message.h"
 #include "musiccommands.h"
 #include "stinger.h"
 #include "transition.h"
 
-rf::MusicSystem::MusicSystem(CommandProcessor* commands, AssetSystem* assetSystem)
-    : m_commands(commands)
+rf::MusicSystem::MusicSystem(CommandProcessor* commands, AssetSystem* assetSystem, const MusicConfig& config)
+    : m_config(config)
+    , m_commands(commands)
     , m_assetSystem(assetSystem)
 {
-    m_cues = Allocator::AllocateArray<Cue>("MusicSystemCues", RF_MAX_CUES, CueParameters(), nullptr, -1);
-    m_transitions = Allocator::AllocateArray<Transition>("MusicSystemTransitions", RF_MAX_TRANSITIONS, TransitionParameters(), -1);
-    m_stingers = Allocator::AllocateArray<Stinger>("MusicSystemStingers", RF_MAX_STINGERS, StingerParameters(), -1);
+    m_cues = Allocator::AllocateArray<Cue>("MusicSystemCues", m_config.m_maxCues, CueParameters(), nullptr, -1);
+    m_transitions = Allocator::AllocateArray<Transition>("MusicSystemTransitions", m_config.m_maxTransitions, TransitionParameters(), -1);
+    m_stingers = Allocator::AllocateArray<Stinger>("MusicSystemStingers", m_config.m_maxStingers, StingerParameters(), -1);
 }
 
 rf::MusicSystem::~MusicSystem()
 {
-    Allocator::DeallocateArray<Cue>(&m_cues, RF_MAX_CUES);
-    Allocator::DeallocateArray<Transition>(&m_transitions, RF_MAX_TRANSITIONS);
-    Allocator::DeallocateArray<Stinger>(&m_stingers, RF_MAX_STINGERS);
+    Allocator::DeallocateArray<Cue>(&m_cues, m_config.m_maxCues);
+    Allocator::DeallocateArray<Transition>(&m_transitions, m_config.m_maxTransitions);
+    Allocator::DeallocateArray<Stinger>(&m_stingers, m_config.m_maxStingers);
 }
 
 rf::Cue* rf::MusicSystem::CreateCue(const CueParameters& parameters)
 {
-    for (int i = 0; i < RF_MAX_CUES; ++i)
+    for (int i = 0; i < m_config.m_maxCues; ++i)
     {
         if (!m_cues[i])
         {
             RF_ASSERT(parameters.m_numLayers > 0, "Expected layers");
+            RF_ASSERT(parameters.m_numLayers <= m_config.m_maxCueLayers, "Too many layers. Increase MusicConfig::m_maxCueLayers");
 
             Cue* cue = new (m_cues + i) Cue(parameters, m_assetSystem, i);
 
@@ -67,7 +72,7 @@ rf::Cue* rf::MusicSystem::CreateCue(const CueParameters& parameters)
         }
     }
 
-    RF_FAIL("Could not create Cue. Increase RF_MAX_CUES");
+    RF_FAIL("Could not create Cue. Increase MusicConfig::m_maxCues");
     return nullptr;
 }
 
@@ -84,7 +89,7 @@ void rf::MusicSystem::DestroyCue(Cue** cue)
     }
 
     const CueHandle cueHandle = (*cue)->GetCueHandle();
-    for (int i = 0; i < RF_MAX_CUES; ++i)
+    for (int i = 0; i < m_config.m_maxCues; ++i)
     {
         if (m_cues[i].GetCueHandle() == cueHandle)
         {
@@ -105,7 +110,7 @@ rf::Transition* rf::MusicSystem::CreateTransition(const TransitionParameters& pa
 {
     RF_ASSERT(parameters.m_cue, "Expected a valid cue");
 
-    for (int i = 0; i < RF_MAX_TRANSITIONS; ++i)
+    for (int i = 0; i < m_config.m_maxTransitions; ++i)
     {
         if (!m_transitions[i])
         {
@@ -123,7 +128,7 @@ rf::Transition* rf::MusicSystem::CreateTransition(const TransitionParameters& pa
         }
     }
 
-    RF_FAIL("Could not create Transition. Increase RF_MAX_TRANSITIONS");
+    RF_FAIL("Could not create Transition. Increase MusicConfig::m_maxTransitions");
     return nullptr;
 }
 
@@ -135,7 +140,7 @@ void rf::MusicSystem::DestroyTransition(Transition** transition)
     }
 
     const TransitionHandle transitionHandle = (*transition)->GetTransitionHandle();
-    for (int i = 0; i < RF_MAX_TRANSITIONS; ++i)
+    for (int i = 0; i < m_config.m_maxTransitions; ++i)
     {
         if (m_transitions[i].GetTransitionHandle() == transitionHandle)
         {
@@ -154,7 +159,7 @@ void rf::MusicSystem::DestroyTransition(Transition** transition)
 
 rf::Stinger* rf::MusicSystem::CreateStinger(const StingerParameters& parameters)
 {
-    for (int i = 0; i < RF_MAX_STINGERS; ++i)
+    for (int i = 0; i < m_config.m_maxStingers; ++i)
     {
         if (!m_stingers[i])
         {
@@ -172,7 +177,7 @@ rf::Stinger* rf::MusicSystem::CreateStinger(const StingerParameters& parameters)
         }
     }
 
-    RF_FAIL("Could not create Stinger. Increase RF_MAX_STINGERS");
+    RF_FAIL("Could not create Stinger. Increase MusicConfig::m_maxStingers");
     return nullptr;
 }
 
@@ -184,7 +189,7 @@ void rf::MusicSystem::DestroyStinger(Stinger** stinger)
     }
 
     const StingerHandle stingerHandle = (*stinger)->GetStingerHandle();
-    for (int i = 0; i < RF_MAX_STINGERS; ++i)
+    for (int i = 0; i < m_config.m_maxStingers; ++i)
     {
         if (m_stingers[i].GetStingerHandle() == stingerHandle)
         {
@@ -247,6 +252,26 @@ void rf::MusicSystem::FadeOutAndStop(const Sync& sync, const Sync& duration) con
     m_commands->Add(cmd);
 }
 
+void rf::MusicSystem::SetLayerVolumeDb(int layerIndex, float volumeDb, const Sync& duration)
+{
+    RF_ASSERT(layerIndex >= 0 && layerIndex < m_config.m_maxCueLayers, "Index out of bounds");
+    RF_ASSERT(duration.m_sync != Sync::Value::Queue, "Fades do not support Queue");
+    m_layerVolumesDb[layerIndex] = volumeDb;
+
+    AudioCommand cmd;
+    SetMusicLayerVolumeCommand& data = EncodeAudioCommand<SetMusicLayerVolumeCommand>(&cmd);
+    data.m_duration = duration;
+    data.m_amplitude = Functions::DecibelToAmplitude(volumeDb);
+    data.m_layerIndex = layerIndex;
+    m_commands->Add(cmd);
+}
+
+float rf::MusicSystem::GetLayerVolumeDb(int layerIndex) const
+{
+    RF_ASSERT(layerIndex >= 0 && layerIndex < m_config.m_maxCueLayers, "Index out of bounds");
+    return m_layerVolumesDb[layerIndex];
+}
+
 rf::CueHandle rf::MusicSystem::GetCurrentCueHandle() const
 {
     return m_currentCueHandle;
@@ -259,7 +284,7 @@ const char* rf::MusicSystem::GetCurrentCueName() const
         return "";
     }
 
-    for (int i = 0; i < RF_MAX_CUES; ++i)
+    for (int i = 0; i < m_config.m_maxCues; ++i)
     {
         if (m_cues[i].GetCueHandle() == m_currentCueHandle)
         {
@@ -291,6 +316,17 @@ float rf::MusicSystem::GetCurrentTempo() const
     return m_tempo;
 }
 
+void rf::MusicSystem::GetStreamingReport(MusicStreamingReport* outReport) const
+{
+    *outReport = m_streamingReport;
+}
+
+void rf::MusicSystem::ResetStreamingReport()
+{
+    m_streamingReport = MusicStreamingReport();
+    m_totalLeadTimeMs = 0.0f;
+}
+
 bool rf::MusicSystem::ProcessMessages(const Message& message)
 {
     switch (message.m_type)
@@ -328,15 +364,15 @@ bool rf::MusicSystem::ProcessMessages(const Message& message)
         case MessageType::MusicBarChanged:
         {
             const Message::MusicBarChangedData* data = message.GetMusicBarChangedData();
-            data->m_currentBar;
-            data->m_currentBeat;
+            m_bar = data->m_currentBar;
+            m_beat = data->m_currentBeat;
             return true;
         }
         case MessageType::MusicBeatChanged:
         {
             const Message::MusicBeatChangedData* data = message.GetMusicBeatChangedData();
-            data->m_currentBar;
-            data->m_currentBeat;
+            m_bar = data->m_currentBar;
+            m_beat = data->m_currentBeat;
             return true;
         }
         case MessageType::MusicTempo:
@@ -352,6 +388,30 @@ bool rf::MusicSystem::ProcessMessages(const Message& message)
             m_meter.m_bottom = data->m_bottom;
             return true;
         }
+        case MessageType::MusicStreamStart:
+        {
+            const float leadTimeMs = message.GetMusicStreamStartData()->m_leadTimeMs;
+            MusicStreamingReport& report = m_streamingReport;
+            ++report.m_numStarts;
+            const int numInTime = report.m_numStarts - report.m_numMisses;
+            report.m_minLeadTimeMs = numInTime == 1 ? leadTimeMs : std::min(report.m_minLeadTimeMs, leadTimeMs);
+            m_totalLeadTimeMs += leadTimeMs;
+            report.m_averageLeadTimeMs = m_totalLeadTimeMs / static_cast<float>(numInTime);
+            report.m_lastLeadTimeMs = leadTimeMs;
+            return true;
+        }
+        case MessageType::MusicStreamMiss:
+        {
+            ++m_streamingReport.m_numStarts;
+            ++m_streamingReport.m_numMisses;
+            return true;
+        }
+        case MessageType::MusicStreamUnderrun:
+        {
+            ++m_streamingReport.m_numUnderruns;
+            m_streamingReport.m_underrunMs += message.GetMusicStreamUnderrunData()->m_durationMs;
+            return true;
+        }
         case MessageType::MusicTransitioned:
         {
             const Message::MusicTransitionedData* data = message.GetMusicTransitionedData();
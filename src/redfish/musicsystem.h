@@ -21,8 +21,10 @@
 // SOFTWARE.
 
 #pragma once
+#include "defines.h"
 #include "identifiers.h"
 #include "meter.h"
+#include "musicconfig.h"
 #include "transitioncondition.h"
 
 namespace rf
@@ -38,10 +40,25 @@ struct StingerParameters;
 struct Sync;
 struct TransitionParameters;
 
+// What music streaming has done since the report was last reset. See AssetSystem::LoadStreamed.
+struct MusicStreamingReport
+{
+    // Streamed cue layers that started, and how many of them were not prefetched in time and started in silence.
+    int m_numStarts = 0;
+    int m_numMisses = 0;
+    // How long before their start the layers that were in time had their prefetch ready.
+    float m_minLeadTimeMs = 0.0f;
+    float m_averageLeadTimeMs = 0.0f;
+    float m_lastLeadTimeMs = 0.0f;
+    // Blocks in which a playing layer reached frames that were not decoded yet, and how much silence that added up to.
+    int m_numUnderruns = 0;
+    float m_underrunMs = 0.0f;
+};
+
 class MusicSystem
 {
 public:
-    MusicSystem(CommandProcessor* commands, AssetSystem* assetSystem);
+    MusicSystem(CommandProcessor* commands, AssetSystem* assetSystem, const MusicConfig& config);
     MusicSystem(const MusicSystem&) = delete;
     MusicSystem(MusicSystem&&) = delete;
     MusicSystem& operator=(const MusicSystem&) = delete;
@@ -64,14 +81,21 @@ public:
     void Play(const Stinger* stinger) const;
     void Stop() const;
     void FadeOutAndStop(const Sync& sync, const Sync& duration) const;
+    // Fades a layer of the music over duration, starting when the command reaches the audio thread. Layers are numbered
+    // in the order they were added to their cue, and the layer mix carries over to every cue played after it.
+    void SetLayerVolumeDb(int layerIndex, float volumeDb, const Sync& duration);
+    float GetLayerVolumeDb(int layerIndex) const;
     CueHandle GetCurrentCueHandle() const;
     const char* GetCurrentCueName() const;
     const Meter& GetCurrentMeter() const;
     int GetCurrentBar() const;
     int GetCurrentBeat() const;
     float GetCurrentTempo() const;
+    void GetStreamingReport(MusicStreamingReport* outReport) const;
+    void ResetStreamingReport();
 
 private:
+    MusicConfig m_config;
     CommandProcessor* m_commands = nullptr;
     AssetSystem* m_assetSystem = nullptr;
     Cue* m_cues = nullptr;
@@ -79,9 +103,12 @@ private:
     Stinger* m_stingers = nullptr;
     CueHandle m_currentCueHandle;
     Meter m_meter;
+    float m_layerVolumesDb[RF_MAX_CUE_LAYERS] = {};
     int m_bar = 0;
     int m_beat = 0;
     float m_tempo = 0.0f;
+    MusicStreamingReport m_streamingReport;
+    float m_totalLeadTimeMs = 0.0f;
 
     bool ProcessMessages(const Message& message);
 
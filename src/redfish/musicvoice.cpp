@@ -47,15 +47,22 @@ void rf::MusicVoice::Play(long long startTime,
     BaseVoice::PlayParams params;
     params.m_audioData = audioData[layer.m_audioDataIndex];
     params.m_audioHandle = layer.m_audioHandle;
+    params.m_audioDataIndex = layer.m_audioDataIndex;
     params.m_mixGroupHandle = layer.m_mixGroupHandle;
     params.m_startTime = startTime;
     params.m_playCount = playCount;
     params.m_pitch = 1.0f;
     params.m_amplitude = finalAmplitude;
     PlayBase(params);
+    m_amplitude = finalAmplitude;
 }
 
 void rf::MusicVoice::Play(long long startTime, const MusicDatabase::CueData& cueData, int playCount, int layerIndex, const AudioData** audioData)
 {
     Play(startTime, cueData, playCount, layerIndex, audioData, 1.0f);
-}
\ No newline at end of file
+}
+
+float rf::MusicVoice::GetAmplitude() const
+{
+    return m_amplitude;
+}
@@ -42,5 +42,10 @@ public:
               const AudioData** audioData,
               float amplitude);
     void Play(long long startTime, const MusicDatabase::CueData& cueData, int playCount, int layerIndex, const AudioData** audioData);
+    // The cue and layer gain the voice was played with.
+    float GetAmplitude() const;
+
+private:
+    float m_amplitude = 1.0f;
 };
 }  // namespace rf
\ No newline at end of file
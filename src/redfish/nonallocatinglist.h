@@ -32,12 +32,12 @@ public:
     NonAllocatingList(int maxNumObjects)
         : m_maxNumObjects(maxNumObjects)
     {
-        m_data = Allocator::s_allocate(m_maxNumObjects * sizeof(T), "NonAllocatingList", alignof(T));
+        m_data = Allocator::AllocateMemory(m_maxNumObjects * sizeof(T), "NonAllocatingList", alignof(T));
     }
 
     ~NonAllocatingList()
     {
-        Allocator::s_deallocate(m_data);
+        Allocator::DeallocateMemory(m_data);
         m_data = nullptr;
     }
 
@@ -24,15 +24,20 @@
 
 #include <cmath>
 
-#include "buffer.h"
 #include "defines.h"
 #include "functions.h"
 #include "mixitem.h"
 #include "pluginutils.h"
 
+const rf::PanDSP::PanTables rf::PanDSP::s_panTables = rf::PanDSP::BuildPanTables();
+
 rf::PanDSP::PanDSP(const AudioSpec& spec)
     : DSPBase(spec)
+    , m_leftGains(spec.m_bufferSize)
+    , m_rightGains(spec.m_bufferSize)
 {
+    SetPanLaw(PluginUtils::k_defaultPanLaw);
+    m_initialPosition = PositionMap(m_angle);
 }
 
 void rf::PanDSP::SetAngle(float angle, bool interpolate)
@@ -40,7 +45,7 @@ void rf::PanDSP::SetAngle(float angle, bool interpolate)
     m_angle = angle;
     if (!interpolate)
     {
-        m_initialRadians = RadianMap(m_angle);
+        m_initialPosition = PositionMap(m_angle);
     }
 }
 
@@ -49,6 +54,11 @@ void rf::PanDSP::SetAngle(float angle)
     SetAngle(angle, true);
 }
 
+void rf::PanDSP::SetPanLaw(PanLaw panLaw)
+{
+    m_table = s_panTables.m_gains[static_cast<int>(panLaw)];
+}
+
 void rf::PanDSP::Process(MixItem* mixItem, int bufferSize)
 {
     if (m_bypass)
@@ -56,38 +66,96 @@ void rf::PanDSP::Process(MixItem* mixItem, int bufferSize)
         return;
     }
 
-    const float radians = RadianMap(m_angle);
-    const float lerpInverse = 1.0f / static_cast<float>(bufferSize - 2);
+    float* left = mixItem->m_arrayOfChannels[0].GetAsFloatBuffer();
+    float* right = mixItem->m_arrayOfChannels[1].GetAsFloatBuffer();
+    const float position = PositionMap(m_angle);
+    int i = 0;
+
+    if (position == m_initialPosition)
+    {
+        // The angle isn't moving, so both gains are constant for the whole buffer.
+        const float leftGain = GetGain(position);
+        const float rightGain = GetGain(k_panTableSize - position);
+
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+        const __m128 leftGains = _mm_set1_ps(leftGain);
+        const __m128 rightGains = _mm_set1_ps(rightGain);
+        for (; i + 4 <= bufferSize; i += 4)
+        {
+            const __m128 sum = _mm_add_ps(_mm_loadu_ps(left + i), _mm_loadu_ps(right + i));
+            _mm_storeu_ps(left + i, _mm_mul_ps(sum, leftGains));
+            _mm_storeu_ps(right + i, _mm_mul_ps(sum, rightGains));
+        }
+#endif
+
+        for (; i < bufferSize; ++i)
+        {
+            const float sum = left[i] + right[i];
+            left[i] = sum * leftGain;
+            right[i] = sum * rightGain;
+        }
+
+        return;
+    }
+
+    float* leftGains = m_leftGains.GetAsFloatBuffer();
+    float* rightGains = m_rightGains.GetAsFloatBuffer();
+    const float step = (position - m_initialPosition) / static_cast<float>(bufferSize);
+    for (int j = 0; j < bufferSize; ++j)
+    {
+        const float lerpPosition = m_initialPosition + step * static_cast<float>(j + 1);
+        leftGains[j] = GetGain(lerpPosition);
+        rightGains[j] = GetGain(k_panTableSize - lerpPosition);
+    }
 
-    for (int i = 0; i < bufferSize; ++i)
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+    for (; i + 4 <= bufferSize; i += 4)
     {
-        const float lerp = i * lerpInverse;
-        const float lerpRadians = (m_initialRadians * (1.0f - (lerp)) + (radians * (lerp)));
-        float leftAmp = 0.0f;
-        float rightAmp = 0.0f;
-
-#if RF_PAN_LAW_MINUS_THREE == 1
-        leftAmp = cosf(lerpRadians);
-        rightAmp = sinf(lerpRadians);
-#elif RF_PAN_LAW_MINUS_FOUR_DOT_FIVE == 1
-        leftAmp = sqrtf(((PluginUtils::k_piOverTwo - lerpRadians) * PluginUtils::k_twoOverPi * cosf(lerpRadians)));
-        rightAmp = sqrtf((lerpRadians * PluginUtils::k_twoOverPi * sinf(lerpRadians)));
-#elif RF_PAN_LAW_MINUS_SIX == 1
-        leftAmp = (PluginUtils::k_piOverTwo - lerpRadians) * PluginUtils::k_twoOverPi;
-        rightAmp = lerpRadians * PluginUtils::k_twoOverPi;
+        const __m128 sum = _mm_add_ps(_mm_loadu_ps(left + i), _mm_loadu_ps(right + i));
+        _mm_storeu_ps(left + i, _mm_mul_ps(sum, _mm_loadu_ps(leftGains + i)));
+        _mm_storeu_ps(right + i, _mm_mul_ps(sum, _mm_loadu_ps(rightGains + i)));
+    }
 #endif
 
-        Buffer* mixItemBuffer = mixItem->m_arrayOfChannels;
-        const float tempLeft = (mixItemBuffer[0][i] * leftAmp) + (mixItemBuffer[1][i] * leftAmp);
-        const float tempRight = (mixItemBuffer[0][i] * rightAmp) + (mixItemBuffer[1][i] * rightAmp);
-        mixItemBuffer[0][i] = tempLeft;
-        mixItemBuffer[1][i] = tempRight;
+    for (; i < bufferSize; ++i)
+    {
+        const float sum = left[i] + right[i];
+        left[i] = sum * leftGains[i];
+        right[i] = sum * rightGains[i];
+    }
+
+    m_initialPosition = position;
+}
+
+rf::PanDSP::PanTables rf::PanDSP::BuildPanTables()
+{
+    PanTables tables;
+    for (int i = 0; i <= k_panTableSize; ++i)
+    {
+        const float radians = PluginUtils::k_piOverTwo * static_cast<float>(i) / static_cast<float>(k_panTableSize);
+        const float linear = (PluginUtils::k_piOverTwo - radians) * PluginUtils::k_twoOverPi;
+        tables.m_gains[static_cast<int>(PanLaw::MinusThree)][i] = cosf(radians);
+        tables.m_gains[static_cast<int>(PanLaw::MinusFourDotFive)][i] = sqrtf(linear * cosf(radians));
+        tables.m_gains[static_cast<int>(PanLaw::MinusSix)][i] = linear;
+    }
+
+    // cosf doesn't land exactly on 0 at pi / 2, hard panning should fully silence the other channel.
+    for (int law = 0; law < k_numPanLaws; ++law)
+    {
+        tables.m_gains[law][k_panTableSize] = 0.0f;
     }
 
-    m_initialRadians = radians;
+    return tables;
+}
+
+float rf::PanDSP::GetGain(float position) const
+{
+    const int index = Functions::Clamp(static_cast<int>(position), 0, k_panTableSize - 1);
+    const float fraction = position - static_cast<float>(index);
+    return m_table[index] + (m_table[index + 1] - m_table[index]) * fraction;
 }
 
-float rf::PanDSP::RadianMap(float angle)
+float rf::PanDSP::PositionMap(float angle) const
 {
-    return Functions::Map(angle, -1.0f, 1.0, 0.0f, PluginUtils::k_piOverTwo);
+    return Functions::Map(angle, -1.0f, 1.0f, 0.0f, static_cast<float>(k_panTableSize));
 }
@@ -1,27 +1,7 @@
-// MIT License
-
-// Copyright (c) 2023 Zach Chan
-
-// Permission is hereby granted, free of charge, to any person obtaining a copy
-// of this software and associated documentation files (the "Software"), to deal
-// in the Software without restriction, including without limitation the rights
-// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
-// copies of the Software, and to permit persons to whom the Software is
-// furnished to do so, subject to the following conditions:
-
-// The above copyright notice and this permission notice shall be included in all
-// copies or substantial portions of the Software.
-
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-// SOFTWARE.
-
 #pragma once
+#include "buffer.h"
 #include "dspbase.h"
+#include "panlaw.h"
 
 namespace rf
 {
@@ -32,12 +12,30 @@ public:
 
     void SetAngle(float angle, bool interpolate);
     void SetAngle(float angle);
+    void SetPanLaw(PanLaw panLaw);
     void Process(MixItem* mixItem, int bufferSize) override final;
 
 private:
-    float m_initialRadians = 0.0;
-    float m_angle = 0.0;
-
-    float RadianMap(float angle);
+    // Each pan law's left channel gain sampled from hard left to hard right. The laws are symmetric, so the right
+    // channel reads the same table mirrored.
+    static constexpr int k_panTableSize = 256;
+    static constexpr int k_numPanLaws = 3;
+
+    struct PanTables
+    {
+        float m_gains[k_numPanLaws][k_panTableSize + 1];
+    };
+
+    static const PanTables s_panTables;
+
+    static PanTables BuildPanTables();
+    float GetGain(float position) const;
+    float PositionMap(float angle) const;
+
+    Buffer m_leftGains;
+    Buffer m_rightGains;
+    const float* m_table = nullptr;
+    float m_initialPosition = 0.0f;
+    float m_angle = 0.0f;
 };
-}  // namespace rf
\ No newline at end of file
+}  // namespace rf
@@ -22,15 +22,18 @@
 
 #include "panplugin.h"
 
+#include "allocator.h"
 #include "commandprocessor.h"
+#include "context.h"
 #include "functions.h"
+#include "pandsp.h"
 #include "plugincommands.h"
 #include "pluginutils.h"
 
 rf::PanPlugin::PanPlugin(Context* context, CommandProcessor* commands, MixGroupHandle mixGroupHandle, int mixGroupSlot, int pluginIndex)
     : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::Pan)
 {
-    RF_SEND_PLUGIN_CREATE_COMMAND(CreatePanDSPCommand);
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreatePanDSPCommand, PanDSP);
 }
 
 rf::PanPlugin::~PanPlugin()
@@ -51,7 +54,7 @@ void rf::PanPlugin::SetAngle(float angle)
     SetPanDSPAngleCommand& data = EncodeAudioCommand<SetPanDSPAngleCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_angle = angle;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 float rf::PanPlugin::GetAngle() const
@@ -59,12 +62,35 @@ float rf::PanPlugin::GetAngle() const
     return m_angle;
 }
 
+void rf::PanPlugin::SetPanLaw(PanLaw panLaw)
+{
+    if (m_panLaw == panLaw)
+    {
+        return;
+    }
+
+    m_panLaw = panLaw;
+
+    AudioCommand cmd;
+    SetPanDSPPanLawCommand& data = EncodeAudioCommand<SetPanDSPPanLawCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_panLaw = m_panLaw;
+    AddCommand(cmd);
+}
+
+rf::PanLaw rf::PanPlugin::GetPanLaw() const
+{
+    return m_panLaw;
+}
+
 void rf::PanPlugin::ToJson(nlohmann::ordered_json& json) const
 {
     json["angle"] = GetAngle();
+    json["panLaw"] = static_cast<int>(GetPanLaw());
 }
 
 void rf::PanPlugin::FromJson(const nlohmann::ordered_json& json)
 {
     SetAngle(json.value("angle", GetAngle()));
+    SetPanLaw(static_cast<PanLaw>(json.value("panLaw", static_cast<int>(GetPanLaw()))));
 }
\ No newline at end of file
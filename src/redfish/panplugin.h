@@ -22,7 +22,9 @@
 
 #pragma once
 #include "identifiers.h"
+#include "panlaw.h"
 #include "pluginbase.h"
+#include "pluginutils.h"
 
 namespace rf
 {
@@ -38,11 +40,14 @@ public:
 
     void SetAngle(float angle);
     float GetAngle() const;
+    void SetPanLaw(PanLaw panLaw);
+    PanLaw GetPanLaw() const;
 
     void ToJson(nlohmann::ordered_json& json) const override;
     void FromJson(const nlohmann::ordered_json& json) override;
 
 private:
     float m_angle = 0.0;
+    PanLaw m_panLaw = PluginUtils::k_defaultPanLaw;
 };
 }  // namespace rf
\ No newline at end of file
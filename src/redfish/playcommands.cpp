@@ -53,6 +53,11 @@ rf::AudioCommandCallback rf::SoundEffectPositioningParamtersCommand::s_callback
     timeline->m_voiceSet.SetPositionBySoundEffectHandle(cmd.m_soundEffectHandle, cmd.m_positioningParameters, true);
 };
 
+rf::AudioCommandCallback rf::SoundEffectEmitterCommand::s_callback = [](AudioTimeline* timeline, void* command) {
+    const SoundEffectEmitterCommand& cmd = *static_cast<SoundEffectEmitterCommand*>(command);
+    timeline->m_voiceSet.SetEmitterBySoundEffectHandle(cmd.m_soundEffectHandle, cmd.m_emitterHandle);
+};
+
 rf::AudioCommandCallback rf::SoundEffectFadeCommondCommand::s_callback = [](AudioTimeline* timeline, void* command) {
     const SoundEffectFadeCommondCommand& cmd = *static_cast<SoundEffectFadeCommondCommand*>(command);
     const long long playhead = timeline->GetPlayhead();
@@ -33,6 +33,7 @@ struct PlayCommand
     AudioHandle m_audioHandle;
     SoundEffectHandle m_soundEffectHandle;
     MixGroupHandle m_mixGroupHandle;
+    EmitterHandle m_emitterHandle;
     PositioningParameters m_positioningParameters;
     Sync m_sync;
     int m_audioDataIndex = -1;
@@ -69,6 +70,13 @@ struct SoundEffectPositioningParamtersCommand
     static AudioCommandCallback s_callback;
 };
 
+struct SoundEffectEmitterCommand
+{
+    SoundEffectHandle m_soundEffectHandle;
+    EmitterHandle m_emitterHandle;
+    static AudioCommandCallback s_callback;
+};
+
 struct SoundEffectFadeCommondCommand
 {
     SoundEffectHandle m_soundEffectHandle;
@@ -0,0 +1,88 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "playingsoundset.h"
+
+#include "assert.h"
+#include "musicconfig.h"
+
+rf::PlayingSoundSet::PlayingSoundSet(int maxPlayingSounds)
+    : m_packedIndices(maxPlayingSounds, -1)
+    , m_playingSoundIds(maxPlayingSounds, 0)
+    , m_audioDataIndices(maxPlayingSounds, -1)
+    , m_maxPlayingSounds(maxPlayingSounds)
+{
+    m_playingSounds.reserve(maxPlayingSounds);
+}
+
+void rf::PlayingSoundSet::Add(int playingSoundId, int audioDataIndex, const PlayingSoundInfo& info)
+{
+    RF_ASSERT(playingSoundId >= 0 && playingSoundId < m_maxPlayingSounds, "Playing sound id out of bounds");
+    RF_ASSERT(audioDataIndex >= 0 && audioDataIndex < RF_MAX_AUDIO_DATA, "Audio data index out of bounds");
+    RF_ASSERT(m_packedIndices[playingSoundId] < 0, "Playing sound id is already in use");
+
+    // The id space is the size of the reserve, so this never reallocates.
+    const int packedIndex = static_cast<int>(m_playingSounds.size());
+    m_playingSounds.push_back(info);
+    m_packedIndices[playingSoundId] = packedIndex;
+    m_playingSoundIds[packedIndex] = playingSoundId;
+    m_audioDataIndices[playingSoundId] = audioDataIndex;
+    ++m_numPlaying[audioDataIndex];
+}
+
+void rf::PlayingSoundSet::Remove(int playingSoundId)
+{
+    RF_ASSERT(playingSoundId >= 0 && playingSoundId < m_maxPlayingSounds, "Playing sound id out of bounds");
+    const int packedIndex = m_packedIndices[playingSoundId];
+    RF_ASSERT(packedIndex >= 0, "Playing sound id is not in use");
+    if (packedIndex < 0)
+    {
+        return;
+    }
+
+    const int lastIndex = static_cast<int>(m_playingSounds.size()) - 1;
+    const int lastId = m_playingSoundIds[lastIndex];
+    m_playingSounds[packedIndex] = m_playingSounds[lastIndex];
+    m_playingSoundIds[packedIndex] = lastId;
+    m_packedIndices[lastId] = packedIndex;
+    m_playingSounds.pop_back();
+
+    --m_numPlaying[m_audioDataIndices[playingSoundId]];
+    m_packedIndices[playingSoundId] = -1;
+    m_audioDataIndices[playingSoundId] = -1;
+}
+
+const std::vector<rf::PlayingSoundInfo>& rf::PlayingSoundSet::GetPlayingSounds() const
+{
+    return m_playingSounds;
+}
+
+int rf::PlayingSoundSet::GetNumPlaying(int audioDataIndex) const
+{
+    RF_ASSERT(audioDataIndex >= 0 && audioDataIndex < RF_MAX_AUDIO_DATA, "Audio data index out of bounds");
+    return m_numPlaying[audioDataIndex];
+}
+
+int rf::PlayingSoundSet::GetMaxPlayingSounds(const MusicConfig& config)
+{
+    return RF_MAX_VOICES + config.m_maxCueLayers + config.m_maxCueLayers * config.m_maxPlayingStingers;
+}
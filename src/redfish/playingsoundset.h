@@ -0,0 +1,62 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <vector>
+
+#include "defines.h"
+#include "playingsoundinfo.h"
+
+namespace rf
+{
+struct MusicConfig;
+
+// The game thread's view of every playing voice, keyed by the id carried in ContextVoiceStart and ContextVoiceStop.
+// Sounds are kept packed so they can be iterated directly, and removal swaps the last sound into the hole.
+class PlayingSoundSet
+{
+public:
+    explicit PlayingSoundSet(int maxPlayingSounds);
+    PlayingSoundSet(const PlayingSoundSet&) = delete;
+    PlayingSoundSet(PlayingSoundSet&&) = delete;
+    PlayingSoundSet& operator=(const PlayingSoundSet&) = delete;
+    PlayingSoundSet& operator=(PlayingSoundSet&&) = delete;
+    ~PlayingSoundSet() = default;
+
+    void Add(int playingSoundId, int audioDataIndex, const PlayingSoundInfo& info);
+    void Remove(int playingSoundId);
+    const std::vector<PlayingSoundInfo>& GetPlayingSounds() const;
+    int GetNumPlaying(int audioDataIndex) const;
+
+    // Every voice that can be playing at once: the sound effect voices, a music voice for each layer of the current cue,
+    // and one for each layer of every stinger that can play over it. This is the size of the playing sound id space.
+    static int GetMaxPlayingSounds(const MusicConfig& config);
+
+private:
+    std::vector<PlayingSoundInfo> m_playingSounds;
+    std::vector<int> m_packedIndices;
+    std::vector<int> m_playingSoundIds;
+    std::vector<int> m_audioDataIndices;
+    int m_numPlaying[RF_MAX_AUDIO_DATA] = {};
+    int m_maxPlayingSounds = 0;
+};
+}  // namespace rf
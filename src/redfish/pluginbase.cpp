@@ -22,7 +22,12 @@
 
 #include "pluginbase.h"
 
+#include <algorithm>
+
+#include "assert.h"
 #include "commandprocessor.h"
+#include "context.h"
+#include "mixersystem.h"
 #include "plugincommands.h"
 
 rf::PluginBase::PluginBase(Context* context, CommandProcessor* commands, MixGroupHandle mixGroupHandle, int mixGroupSlot, int pluginIndex, Type type)
@@ -33,6 +38,7 @@ rf::PluginBase::PluginBase(Context* context, CommandProcessor* commands, MixGrou
     , m_type(type)
     , m_mixGroupSlot(mixGroupSlot)
     , m_pluginIndex(pluginIndex)
+    , m_readyPlayhead(m_context->GetMixerSystem()->m_readyPlayhead)
 {
 }
 
@@ -41,6 +47,16 @@ rf::PluginHandle rf::PluginBase::GetPluginHandle() const
     return m_pluginHandle;
 }
 
+rf::MixGroupHandle rf::PluginBase::GetMixGroupHandle() const
+{
+    return m_mixGroupHandle;
+}
+
+rf::MixGroupHandle rf::PluginBase::GetSidechainMixGroupHandle() const
+{
+    return m_sidechainMixGroupHandle;
+}
+
 rf::PluginBase::Type rf::PluginBase::GetType() const
 {
     return m_type;
@@ -59,10 +75,52 @@ void rf::PluginBase::SetBypass(bool bypass)
     SetDSPBypassCommand& data = EncodeAudioCommand<SetDSPBypassCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_bypass = m_bypass;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 bool rf::PluginBase::GetBypass() const
 {
     return m_bypass;
 }
+
+void rf::PluginBase::SetSidechainMixGroupHandle(MixGroupHandle mixGroupHandle)
+{
+    if (m_sidechainMixGroupHandle == mixGroupHandle)
+    {
+        return;
+    }
+
+    MixerSystem* mixerSystem = m_context->GetMixerSystem();
+    if (mixGroupHandle && !mixerSystem->CanSidechain(m_mixGroupHandle, mixGroupHandle))
+    {
+        RF_FAIL("Sidechain must not be the master mix group or a mix group this plug-in's mix group feeds into");
+        return;
+    }
+
+    m_sidechainMixGroupHandle = mixGroupHandle;
+
+    // The sidechain has to be processed first so it is complete by the time this plug-in reads it.
+    if (m_sidechainMixGroupHandle)
+    {
+        mixerSystem->UpdateInputPriorities(m_mixGroupHandle, 0);
+    }
+
+    AudioCommand cmd;
+    SetDSPSidechainCommand& data = EncodeAudioCommand<SetDSPSidechainCommand>(&cmd);
+    data.m_dspIndex = m_pluginIndex;
+    data.m_sidechainMixGroupHandle = m_sidechainMixGroupHandle;
+    AddMixerCommand(cmd);
+}
+
+
+void rf::PluginBase::AddCommand(const AudioCommand& cmd)
+{
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
+}
+
+void rf::PluginBase::AddMixerCommand(const AudioCommand& cmd)
+{
+    MixerSystem* mixerSystem = m_context->GetMixerSystem();
+    m_readyPlayhead = m_commands->Add(cmd, std::max(m_readyPlayhead, mixerSystem->m_readyPlayhead));
+    mixerSystem->m_readyPlayhead = m_readyPlayhead;
+}
\ No newline at end of file
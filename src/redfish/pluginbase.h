@@ -27,6 +27,7 @@
 
 namespace rf
 {
+struct AudioCommand;
 class CommandProcessor;
 class Context;
 
@@ -47,8 +48,9 @@ public:
         Limiter,
         Pan,
         Positioning,
+        Ducker,
 
-        Version = 1,
+        Version = 2,
     };
 
     PluginBase(Context* context, CommandProcessor* commands, MixGroupHandle mixGroupHandle, int mixGroupSlot, int pluginIndex, Type type);
@@ -59,6 +61,8 @@ public:
     virtual ~PluginBase() = default;
 
     PluginHandle GetPluginHandle() const;
+    MixGroupHandle GetMixGroupHandle() const;
+    MixGroupHandle GetSidechainMixGroupHandle() const;
     Type GetType() const;
     void SetBypass(bool bypass);
     bool GetBypass() const;
@@ -67,13 +71,23 @@ public:
     virtual void FromJson(const nlohmann::ordered_json& json) = 0;
 
 protected:
+    void SetSidechainMixGroupHandle(MixGroupHandle mixGroupHandle);
+    // Adds a command for this plug-in, which never overtakes an earlier one scheduled further ahead.
+    void AddCommand(const AudioCommand& cmd);
+    // Adds a command that also changes the mixer's layout, so it waits for earlier layout changes as well.
+    void AddMixerCommand(const AudioCommand& cmd);
+
     Context* m_context = nullptr;
     CommandProcessor* m_commands = nullptr;
     PluginHandle m_pluginHandle;
     MixGroupHandle m_mixGroupHandle;
+    MixGroupHandle m_sidechainMixGroupHandle;
     Type m_type = Type::Invalid;
     int m_mixGroupSlot = -1;
     int m_pluginIndex = -1;
+    long long m_readyPlayhead = -1;
     bool m_bypass = false;
+
+    friend class MixerSystem;
 };
 }  // namespace rf
\ No newline at end of file
@@ -28,6 +28,7 @@
 #include "compressordsp.h"
 #include "convolverdsp.h"
 #include "delaydsp.h"
+#include "duckerdsp.h"
 #include "gaindsp.h"
 #include "iir2highpassfilterdsp.h"
 #include "iir2lowpassfilterdsp.h"
@@ -40,7 +41,8 @@
         const Create##dspName##Command& cmd = *static_cast<Create##dspName##Command*>(command);                      \
         SummingMixer* mixer = &timeline->m_summingMixer;                                                             \
         RF_ASSERT(!mixer->m_dsp[cmd.m_dspIndex], "Expected nullptr");                                                \
-        mixer->m_dsp[cmd.m_dspIndex] = Allocator::Allocate<dspName>(#dspName, timeline->GetAudioSpec());             \
+        RF_ASSERT(cmd.m_dsp, "Expected the DSP to be constructed on the game thread");                               \
+        mixer->m_dsp[cmd.m_dspIndex] = cmd.m_dsp;                                                                    \
         SummingMixer::MixGroupInternal* mixGroup = mixer->MixGroupLookUp(cmd.m_mixGroupHandle);                      \
         mixGroup->m_state.m_pluginSlots[cmd.m_mixGroupSlot] = cmd.m_dspIndex;                                        \
     };
@@ -50,7 +52,11 @@
         const Destroy##dspName##Command& cmd = *static_cast<Destroy##dspName##Command*>(command);                     \
         SummingMixer* mixer = &timeline->m_summingMixer;                                                              \
         RF_ASSERT(mixer->m_dsp[cmd.m_dspIndex], "Expected a pointer");                                                \
-        Allocator::Deallocate<DSPBase>(&mixer->m_dsp[cmd.m_dspIndex]);                                                \
+        Message msg;                                                                                                  \
+        msg.m_type = MessageType::DSPDestroy;                                                                         \
+        msg.GetDSPDestroyData()->m_dsp = mixer->m_dsp[cmd.m_dspIndex];                                                \
+        timeline->m_messenger.AddMessage(msg);                                                                        \
+        mixer->m_dsp[cmd.m_dspIndex] = nullptr;                                                                       \
         SummingMixer::MixGroupInternal* mixGroup = mixer->MixGroupLookUp(cmd.m_mixGroupHandle);                       \
         mixGroup->m_state.m_pluginSlots[cmd.m_mixGroupSlot] = -1;                                                     \
     };
@@ -69,6 +75,12 @@ rf::AudioCommandCallback rf::SetDSPBypassCommand::s_callback = [](AudioTimeline*
     mixer->m_dsp[cmd.m_dspIndex]->SetBypass(cmd.m_bypass);
 };
 
+rf::AudioCommandCallback rf::SetDSPSidechainCommand::s_callback = [](AudioTimeline* timeline, void* command) {
+    const SetDSPSidechainCommand& cmd = *static_cast<SetDSPSidechainCommand*>(command);
+    SummingMixer* mixer = &timeline->m_summingMixer;
+    mixer->m_dsp[cmd.m_dspIndex]->SetSidechainMixGroup(cmd.m_sidechainMixGroupHandle);
+};
+
 RF_CREATE_DSP(GainDSP);
 RF_DESTROY_DSP(GainDSP);
 RF_SET_DSP_PARAMETER(GainDSP, Amplitude, m_amplitude);
@@ -76,6 +88,7 @@ RF_SET_DSP_PARAMETER(GainDSP, Amplitude, m_amplitude);
 RF_CREATE_DSP(PanDSP);
 RF_DESTROY_DSP(PanDSP);
 RF_SET_DSP_PARAMETER(PanDSP, Angle, m_angle);
+RF_SET_DSP_PARAMETER(PanDSP, PanLaw, m_panLaw);
 
 RF_CREATE_DSP(ButterworthHighpassFilterDSP);
 RF_DESTROY_DSP(ButterworthHighpassFilterDSP);
@@ -97,14 +110,30 @@ RF_DESTROY_DSP(IIR2HighpassFilterDSP);
 RF_SET_DSP_PARAMETER(IIR2HighpassFilterDSP, Q, m_q);
 RF_SET_DSP_PARAMETER(IIR2HighpassFilterDSP, Cutoff, m_cutoff);
 
-RF_CREATE_DSP(DelayDSP);
+rf::AudioCommandCallback rf::CreateDelayDSPCommand::s_callback = [](AudioTimeline* timeline, void* command) {
+    const CreateDelayDSPCommand& cmd = *static_cast<CreateDelayDSPCommand*>(command);
+    SummingMixer* mixer = &timeline->m_summingMixer;
+    RF_ASSERT(!mixer->m_dsp[cmd.m_dspIndex], "Expected nullptr");
+    RF_ASSERT(cmd.m_dsp, "Expected the DSP to be constructed on the game thread");
+    DelayDSP* dsp = static_cast<DelayDSP*>(cmd.m_dsp);
+    dsp->SetMetronome(&timeline->m_musicManager.GetMetronome());
+    mixer->m_dsp[cmd.m_dspIndex] = dsp;
+    SummingMixer::MixGroupInternal* mixGroup = mixer->MixGroupLookUp(cmd.m_mixGroupHandle);
+    mixGroup->m_state.m_pluginSlots[cmd.m_mixGroupSlot] = cmd.m_dspIndex;
+};
+
 RF_DESTROY_DSP(DelayDSP);
 RF_SET_DSP_PARAMETER(DelayDSP, Delay, m_delay);
 RF_SET_DSP_PARAMETER(DelayDSP, Feedback, m_feedback);
+RF_SET_DSP_PARAMETER(DelayDSP, TempoSync, m_tempoSync);
+RF_SET_DSP_PARAMETER(DelayDSP, SyncValue, m_syncValue);
 
 RF_CREATE_DSP(LimiterDSP);
 RF_DESTROY_DSP(LimiterDSP);
 RF_SET_DSP_PARAMETER(LimiterDSP, Threshold, m_threshold);
+RF_SET_DSP_PARAMETER(LimiterDSP, Lookahead, m_lookahead);
+RF_SET_DSP_PARAMETER(LimiterDSP, Release, m_release);
+RF_SET_DSP_PARAMETER(LimiterDSP, TruePeak, m_truePeak);
 
 RF_CREATE_DSP(CompressorDSP);
 RF_DESTROY_DSP(CompressorDSP);
@@ -113,6 +142,16 @@ RF_SET_DSP_PARAMETER(CompressorDSP, Ratio, m_ratio);
 RF_SET_DSP_PARAMETER(CompressorDSP, MakeUpGainAmplitude, m_amplitude);
 RF_SET_DSP_PARAMETER(CompressorDSP, Attack, m_attack);
 RF_SET_DSP_PARAMETER(CompressorDSP, Release, m_release);
+RF_SET_DSP_PARAMETER(CompressorDSP, Knee, m_knee);
+RF_SET_DSP_PARAMETER(CompressorDSP, DetectRMS, m_detectRMS);
+
+RF_CREATE_DSP(DuckerDSP);
+RF_DESTROY_DSP(DuckerDSP);
+RF_SET_DSP_PARAMETER(DuckerDSP, Threshold, m_threshold);
+RF_SET_DSP_PARAMETER(DuckerDSP, Depth, m_depth);
+RF_SET_DSP_PARAMETER(DuckerDSP, Attack, m_attack);
+RF_SET_DSP_PARAMETER(DuckerDSP, Release, m_release);
+RF_SET_DSP_PARAMETER(DuckerDSP, Hold, m_hold);
 
 RF_CREATE_DSP(ConvolverDSP);
 RF_DESTROY_DSP(ConvolverDSP);
@@ -122,7 +161,14 @@ rf::AudioCommandCallback rf::LoadConvolverDSPIRCommand::s_callback = [](AudioTim
     const LoadConvolverDSPIRCommand& cmd = *static_cast<LoadConvolverDSPIRCommand*>(command);
     SummingMixer* mixer = &timeline->m_summingMixer;
     ConvolverDSP* dsp = static_cast<ConvolverDSP*>(mixer->m_dsp[cmd.m_dspIndex]);
-    dsp->LoadIR(timeline->GetAudioData(cmd.m_audioDataIndex), cmd.m_amplitude, cmd.m_index);
+    ConvolverChannels* oldChannels = dsp->LoadIR(cmd.m_impulseResponse, cmd.m_amplitude, cmd.m_index, cmd.m_channels);
+    if (oldChannels)
+    {
+        Message msg;
+        msg.m_type = MessageType::ConvolverChannelsDestroy;
+        msg.GetConvolverChannelsDestroyData()->m_channels = oldChannels;
+        timeline->m_messenger.AddMessage(msg);
+    }
 };
 
 rf::AudioCommandCallback rf::UnloadConvolverDSPIRCommand::s_callback = [](AudioTimeline* timeline, void* command) {
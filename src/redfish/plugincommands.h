@@ -23,12 +23,20 @@
 #pragma once
 #include "audiocommand.h"
 #include "identifiers.h"
+#include "panlaw.h"
 #include "positioningparameters.h"
+#include "sync.h"
 
 namespace rf
 {
+class DSPBase;
+struct ConvolverChannels;
+struct ImpulseResponse;
+
 struct CreateCommand
 {
+    // Constructed on the game thread, so the audio thread only has to publish it.
+    DSPBase* m_dsp = nullptr;
     int m_dspIndex = -1;
     int m_mixGroupSlot = -1;
     MixGroupHandle m_mixGroupHandle;
@@ -41,6 +49,13 @@ struct SetDSPBypassCommand
     static AudioCommandCallback s_callback;
 };
 
+struct SetDSPSidechainCommand
+{
+    int m_dspIndex = -1;
+    MixGroupHandle m_sidechainMixGroupHandle;
+    static AudioCommandCallback s_callback;
+};
+
 struct CreateGainDSPCommand : public CreateCommand
 {
     static AudioCommandCallback s_callback;
@@ -75,6 +90,13 @@ struct SetPanDSPAngleCommand
     static AudioCommandCallback s_callback;
 };
 
+struct SetPanDSPPanLawCommand
+{
+    int m_dspIndex = -1;
+    PanLaw m_panLaw = PanLaw::MinusThree;
+    static AudioCommandCallback s_callback;
+};
+
 struct CreateButterworthHighpassFilterDSPCommand : public CreateCommand
 {
     static AudioCommandCallback s_callback;
@@ -195,6 +217,20 @@ struct SetDelayDSPFeedbackCommand
     static AudioCommandCallback s_callback;
 };
 
+struct SetDelayDSPTempoSyncCommand
+{
+    int m_dspIndex = -1;
+    bool m_tempoSync = false;
+    static AudioCommandCallback s_callback;
+};
+
+struct SetDelayDSPSyncValueCommand
+{
+    int m_dspIndex = -1;
+    Sync::Value m_syncValue = Sync::Value::Quarter;
+    static AudioCommandCallback s_callback;
+};
+
 struct CreateLimiterDSPCommand : public CreateCommand
 {
     static AudioCommandCallback s_callback;
@@ -212,6 +248,27 @@ struct SetLimiterDSPThresholdCommand
     static AudioCommandCallback s_callback;
 };
 
+struct SetLimiterDSPLookaheadCommand
+{
+    int m_dspIndex = -1;
+    int m_lookahead = -1;
+    static AudioCommandCallback s_callback;
+};
+
+struct SetLimiterDSPReleaseCommand
+{
+    int m_dspIndex = -1;
+    int m_release = -1;
+    static AudioCommandCallback s_callback;
+};
+
+struct SetLimiterDSPTruePeakCommand
+{
+    int m_dspIndex = -1;
+    bool m_truePeak = false;
+    static AudioCommandCallback s_callback;
+};
+
 struct CreateCompressorDSPCommand : public CreateCommand
 {
     static AudioCommandCallback s_callback;
@@ -257,6 +314,65 @@ struct SetCompressorDSPReleaseCommand
     static AudioCommandCallback s_callback;
 };
 
+struct SetCompressorDSPKneeCommand
+{
+    int m_dspIndex = -1;
+    float m_knee = -1;
+    static AudioCommandCallback s_callback;
+};
+
+struct SetCompressorDSPDetectRMSCommand
+{
+    int m_dspIndex = -1;
+    bool m_detectRMS = false;
+    static AudioCommandCallback s_callback;
+};
+
+struct CreateDuckerDSPCommand : public CreateCommand
+{
+    static AudioCommandCallback s_callback;
+};
+
+struct DestroyDuckerDSPCommand : public CreateCommand
+{
+    static AudioCommandCallback s_callback;
+};
+
+struct SetDuckerDSPThresholdCommand
+{
+    int m_dspIndex = -1;
+    float m_threshold = -1;
+    static AudioCommandCallback s_callback;
+};
+
+struct SetDuckerDSPDepthCommand
+{
+    int m_dspIndex = -1;
+    float m_depth = -1;
+    static AudioCommandCallback s_callback;
+};
+
+struct SetDuckerDSPAttackCommand
+{
+    int m_dspIndex = -1;
+    float m_attack = -1;
+    static AudioCommandCallback s_callback;
+};
+
+struct SetDuckerDSPReleaseCommand
+{
+    int m_dspIndex = -1;
+    float m_release = -1;
+    static AudioCommandCallback s_callback;
+};
+
+struct SetDuckerDSPHoldCommand
+{
+    int m_dspIndex = -1;
+    float m_hold = -1;
+    static AudioCommandCallback s_callback;
+};
+
 struct CreateConvolverDSPCommand : public CreateCommand
 {
     static AudioCommandCallback s_callback;
@@ -279,7 +395,9 @@ struct LoadConvolverDSPIRCommand
     int m_dspIndex = -1;
     int m_index = -1;
     float m_amplitude = 1.0f;
-    int m_audioDataIndex = -1;
+    const ImpulseResponse* m_impulseResponse = nullptr;
+    // Set when the IR is longer than the DSP's current channels can hold.
+    ConvolverChannels* m_channels = nullptr;
     static AudioCommandCallback s_callback;
 };
 
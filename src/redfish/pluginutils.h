@@ -21,10 +21,14 @@
 // SOFTWARE.
 
 #pragma once
+#include "defines.h"
+#include "panlaw.h"
 
 namespace rf::PluginUtils
 {
-static constexpr int k_maxChannels = 2;
+static constexpr int k_maxChannels = 8;
+static constexpr int k_impulseResponseChannels = 2;
+static constexpr int k_maxHRIRLength = 1024;
 static constexpr int k_maxConvolverIRs = 3;
 static constexpr float k_maxDelayTime = 5000.0f;
 static constexpr float k_maxDelayFeedback = 1.0f;
@@ -34,18 +38,38 @@ static constexpr float k_maxFilterCutoff = 20000.0f;
 static constexpr float k_minFilterCutoff = 20.0f;
 static constexpr float k_maxFilterQ = 1000.0f;
 static constexpr float k_minFilterQ = 0.1f;
+static constexpr float k_defaultDuckerThreshold = -30.0f;
+static constexpr float k_defaultDuckerDepth = -12.0f;
+static constexpr float k_defaultDuckerAttack = 10.0f;
+static constexpr float k_defaultDuckerRelease = 300.0f;
+static constexpr float k_defaultDuckerHold = 100.0f;
+static constexpr float k_maxDuckerHold = 2000.0f;
+static constexpr float k_maxLimiterLookahead = 5.0f;
+static constexpr float k_defaultLimiterLookahead = 1.5f;
+static constexpr float k_maxLimiterRelease = 1000.0f;
+static constexpr float k_minLimiterRelease = 1.0f;
+static constexpr float k_defaultLimiterRelease = 50.0f;
+#if RF_PAN_LAW_MINUS_FOUR_DOT_FIVE == 1
+static constexpr PanLaw k_defaultPanLaw = PanLaw::MinusFourDotFive;
+#elif RF_PAN_LAW_MINUS_SIX == 1
+static constexpr PanLaw k_defaultPanLaw = PanLaw::MinusSix;
+#else
+static constexpr PanLaw k_defaultPanLaw = PanLaw::MinusThree;
+#endif
 static float k_piOverTwo = 1.57079632679489661923f;
 static float k_twoOverPi = 0.63661977236758134307f;
 static float k_twoPi = 6.28318530717958647692f;
 static float k_sqrtTwo = 1.41421356237309504880f;
 
-#define RF_SEND_PLUGIN_CREATE_COMMAND(command)         \
-    AudioCommand cmd;                                  \
-    command& data = EncodeAudioCommand<command>(&cmd); \
-    data.m_mixGroupHandle = m_mixGroupHandle;          \
-    data.m_dspIndex = m_pluginIndex;                   \
-    data.m_mixGroupSlot = m_mixGroupSlot;              \
-    m_commands->Add(cmd);
+// The DSP is constructed here on the game thread, so the audio thread never allocates when a plugin is added.
+#define RF_SEND_PLUGIN_CREATE_COMMAND(command, dspName)                             \
+    AudioCommand cmd;                                                               \
+    command& data = EncodeAudioCommand<command>(&cmd);                              \
+    data.m_dsp = Allocator::Allocate<dspName>(#dspName, m_context->GetAudioSpec()); \
+    data.m_mixGroupHandle = m_mixGroupHandle;                                       \
+    data.m_dspIndex = m_pluginIndex;                                                \
+    data.m_mixGroupSlot = m_mixGroupSlot;                                           \
+    AddMixerCommand(cmd);
 
 #define RF_SEND_PLUGIN_DESTROY_COMMAND(command)        \
     AudioCommand cmd;                                  \
@@ -53,5 +77,5 @@ static float k_sqrtTwo = 1.41421356237309504880f;
     data.m_mixGroupHandle = m_mixGroupHandle;          \
     data.m_dspIndex = m_pluginIndex;                   \
     data.m_mixGroupSlot = m_mixGroupSlot;              \
-    m_commands->Add(cmd);
+    AddMixerCommand(cmd);
 }  // namespace rf::PluginUtils
\ No newline at end of file
@@ -0,0 +1,163 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "poolallocator.h"
+
+#include <new>
+
+#include "allocator.h"
+#include "assert.h"
+
+void rf::PoolAllocator::Create(int blockSize, int numBlocks)
+{
+    RF_ASSERT(!m_memory, "The pool has already been created.");
+    RF_ASSERT(blockSize > 0 && numBlocks > 0, "Expected a block size and block count greater than 0.");
+
+    // Every block starts on the max alignment, so any allocation that fits can be placed in any block.
+    const int mask = Allocator::k_maxAlignment - 1;
+    m_blockSize = (blockSize + mask) & ~mask;
+    m_numBlocks = numBlocks;
+    m_released = false;
+    m_numUsedBlocks = 0;
+    m_peakUsedBlocks = 0;
+
+    const size_t numBytes = static_cast<size_t>(m_blockSize) * static_cast<size_t>(m_numBlocks);
+    m_memory = static_cast<unsigned char*>(Allocator::s_allocate(numBytes, "AllocatorPool", Allocator::k_maxAlignment));
+    m_next = static_cast<std::atomic<int>*>(
+        Allocator::s_allocate(sizeof(std::atomic<int>) * m_numBlocks, "AllocatorPoolFreeList", alignof(std::atomic<int>)));
+
+    for (int i = 0; i < m_numBlocks; ++i)
+    {
+        new (m_next + i) std::atomic<int>(i + 1 < m_numBlocks ? i + 1 : k_invalidIndex);
+    }
+    m_head = PackHead(0, 0);
+}
+
+void rf::PoolAllocator::Release()
+{
+    if (!m_memory)
+    {
+        return;
+    }
+
+    m_released = true;
+    RF_ASSERT(m_numUsedBlocks == 0, "Memory from an allocator pool is still in use. It will be freed when it is returned.");
+    if (m_numUsedBlocks == 0)
+    {
+        Free();
+    }
+}
+
+void* rf::PoolAllocator::Allocate()
+{
+    if (!m_memory || m_released)
+    {
+        return nullptr;
+    }
+
+    unsigned long long head = m_head.load(std::memory_order_acquire);
+    while (true)
+    {
+        const int index = GetHeadIndex(head);
+        if (index == k_invalidIndex)
+        {
+            return nullptr;
+        }
+
+        const int next = m_next[index].load(std::memory_order_relaxed);
+        const unsigned long long newHead = PackHead(next, static_cast<unsigned int>(head >> 32));
+        if (m_head.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+        {
+            const int numUsedBlocks = m_numUsedBlocks.fetch_add(1, std::memory_order_relaxed) + 1;
+            int peakUsedBlocks = m_peakUsedBlocks.load(std::memory_order_relaxed);
+            while (numUsedBlocks > peakUsedBlocks
+                   && !m_peakUsedBlocks.compare_exchange_weak(peakUsedBlocks, numUsedBlocks, std::memory_order_relaxed))
+            {
+            }
+
+            return m_memory + static_cast<size_t>(index) * static_cast<size_t>(m_blockSize);
+        }
+    }
+}
+
+void rf::PoolAllocator::Deallocate(void* block)
+{
+    const size_t offset = static_cast<size_t>(static_cast<unsigned char*>(block) - m_memory);
+    RF_ASSERT(offset % m_blockSize == 0, "This memory was not allocated from this pool.");
+    const int index = static_cast<int>(offset / m_blockSize);
+    RF_ASSERT(index >= 0 && index < m_numBlocks, "This memory was not allocated from this pool.");
+
+    unsigned long long head = m_head.load(std::memory_order_relaxed);
+    while (true)
+    {
+        m_next[index].store(GetHeadIndex(head), std::memory_order_relaxed);
+        const unsigned long long newHead = PackHead(index, static_cast<unsigned int>(head >> 32) + 1);
+        if (m_head.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    const int numUsedBlocks = m_numUsedBlocks.fetch_sub(1, std::memory_order_relaxed) - 1;
+    if (m_released && numUsedBlocks == 0)
+    {
+        Free();
+    }
+}
+
+bool rf::PoolAllocator::IsCreated() const
+{
+    return m_memory != nullptr;
+}
+
+int rf::PoolAllocator::GetBlockSize() const
+{
+    return m_blockSize;
+}
+
+int rf::PoolAllocator::GetNumBlocks() const
+{
+    return m_numBlocks;
+}
+
+int rf::PoolAllocator::GetPeakUsedBlocks() const
+{
+    return m_peakUsedBlocks.load(std::memory_order_relaxed);
+}
+
+void rf::PoolAllocator::Free()
+{
+    Allocator::s_deallocate(m_memory);
+    Allocator::s_deallocate(m_next);
+    m_memory = nullptr;
+    m_next = nullptr;
+}
+
+unsigned long long rf::PoolAllocator::PackHead(int index, unsigned int count)
+{
+    return (static_cast<unsigned long long>(count) << 32) | static_cast<unsigned int>(index);
+}
+
+int rf::PoolAllocator::GetHeadIndex(unsigned long long head)
+{
+    return static_cast<int>(static_cast<unsigned int>(head & 0xFFFFFFFFull));
+}
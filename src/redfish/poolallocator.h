@@ -0,0 +1,69 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <atomic>
+
+namespace rf
+{
+// A fixed amount of fixed-size blocks. Blocks are handed out and returned through a lock-free free list, so the game and
+// audio threads can both allocate from the same pool without locking or calling into the system allocator.
+class PoolAllocator
+{
+public:
+    PoolAllocator() = default;
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator(PoolAllocator&&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(PoolAllocator&&) = delete;
+    ~PoolAllocator() = default;
+
+    void Create(int blockSize, int numBlocks);
+    // Frees the pool's memory. If blocks are still in use, the memory is freed when the last one is returned.
+    void Release();
+    // Returns nullptr if every block is in use.
+    void* Allocate();
+    void Deallocate(void* block);
+    bool IsCreated() const;
+    int GetBlockSize() const;
+    int GetNumBlocks() const;
+    int GetPeakUsedBlocks() const;
+
+private:
+    static constexpr int k_invalidIndex = -1;
+
+    unsigned char* m_memory = nullptr;
+    std::atomic<int>* m_next = nullptr;
+    // The low 32 bits are the index of the first free block. The high 32 bits count pushes, so a thread that was
+    // preempted in the middle of a pop can't succeed with a stale head.
+    std::atomic<unsigned long long> m_head {0};
+    std::atomic<int> m_numUsedBlocks {0};
+    std::atomic<int> m_peakUsedBlocks {0};
+    int m_blockSize = 0;
+    int m_numBlocks = 0;
+    bool m_released = false;
+
+    void Free();
+    static unsigned long long PackHead(int index, unsigned int count);
+    static int GetHeadIndex(unsigned long long head);
+};
+}  // namespace rf
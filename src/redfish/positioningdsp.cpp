@@ -23,6 +23,7 @@
 #include "positioningdsp.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "functions.h"
 
@@ -32,6 +33,7 @@ rf::PositioningDSP::PositioningDSP(const AudioSpec& spec)
     , m_hpf(spec)
     , m_lpf(spec)
     , m_pan(spec)
+    , m_vbap(spec)
 {
     m_hpf.SetOrder(2);
     m_lpf.SetOrder(2);
@@ -43,10 +45,16 @@ void rf::PositioningDSP::SetPositioningParameters(const PositioningParameters& p
 
     const float distanceCurvePercent = CalculateDistanceCurvePercent(m_parameters);
     const float percentDifference = 1.0f - distanceCurvePercent;
-    const float amp = GetAttenuatedAmplitude(m_parameters);
+    const float occlusionAmp = Functions::DecibelToAmplitude(m_parameters.m_occlusionAttenuationDb);
+    const float amp = GetAttenuatedAmplitude(m_parameters) * Functions::Lerp(m_parameters.m_occlusion, 1.0f, occlusionAmp);
 
     const float hpfCutoff = (m_parameters.m_maxHpfCutoff * distanceCurvePercent) + (PluginUtils::k_minFilterCutoff * percentDifference);
-    const float lpfCutoff = (m_parameters.m_maxLpfCutoff * distanceCurvePercent) + (PluginUtils::k_maxFilterCutoff * percentDifference);
+    float lpfCutoff = (m_parameters.m_maxLpfCutoff * distanceCurvePercent) + (PluginUtils::k_maxFilterCutoff * percentDifference);
+
+    // The air absorbs high frequencies more the further the sound travels.
+    const float airLpfCutoff = PluginUtils::k_maxFilterCutoff / (1.0f + m_parameters.m_airAbsorption * m_parameters.m_currentDistance);
+    lpfCutoff = std::min(lpfCutoff, airLpfCutoff);
+    lpfCutoff = Functions::Lerp(m_parameters.m_occlusion, lpfCutoff, std::min(lpfCutoff, m_parameters.m_occlusionLpfCutoff));
 
     if (!interpolate)
     {
@@ -59,6 +67,7 @@ void rf::PositioningDSP::SetPositioningParameters(const PositioningParameters& p
     }
 
     m_pan.SetAngle(m_parameters.m_panAngle, interpolate);
+    m_vbap.SetDirection(m_parameters.m_azimuth, m_parameters.m_elevation, interpolate);
     m_gain.SetAmplitude(amp, interpolate);
     m_hpf.SetCutoff(hpfCutoff);
     m_lpf.SetCutoff(lpfCutoff);
@@ -69,6 +78,21 @@ void rf::PositioningDSP::SetPositioningParameters(const PositioningParameters& p
     SetPositioningParameters(parameters, true);
 }
 
+const rf::PositioningParameters& rf::PositioningDSP::GetPositioningParameters() const
+{
+    return m_parameters;
+}
+
+void rf::PositioningDSP::SetPanBypass(bool bypass)
+{
+    m_panBypass = bypass;
+}
+
+void rf::PositioningDSP::SetNumSourceChannels(int numSourceChannels)
+{
+    m_vbap.SetNumSourceChannels(numSourceChannels);
+}
+
 void rf::PositioningDSP::Process(MixItem* mixItem, int bufferSize)
 {
     if (m_bypass || !m_parameters.m_enable)
@@ -79,7 +103,20 @@ void rf::PositioningDSP::Process(MixItem* mixItem, int bufferSize)
     m_gain.Process(mixItem, bufferSize);
     m_hpf.Process(mixItem, bufferSize);
     m_lpf.Process(mixItem, bufferSize);
-    m_pan.Process(mixItem, bufferSize);
+
+    if (m_panBypass)
+    {
+        return;
+    }
+
+    if (m_spec.m_channels > 2)
+    {
+        m_vbap.Process(mixItem, bufferSize);
+    }
+    else
+    {
+        m_pan.Process(mixItem, bufferSize);
+    }
 }
 
 float rf::PositioningDSP::GetAttenuatedAmplitude(const PositioningParameters& parameters)
@@ -28,6 +28,7 @@
 #include "gaindsp.h"
 #include "pandsp.h"
 #include "positioningparameters.h"
+#include "vbapdsp.h"
 
 namespace rf
 {
@@ -38,6 +39,9 @@ public:
 
     void SetPositioningParameters(const PositioningParameters& parameters, bool interpolate);
     void SetPositioningParameters(const PositioningParameters& parameters);
+    const PositioningParameters& GetPositioningParameters() const;
+    void SetPanBypass(bool bypass);
+    void SetNumSourceChannels(int numSourceChannels);
     void Process(MixItem* mixItem, int bufferSize) override final;
 
     static float GetAttenuatedAmplitude(const PositioningParameters& parameters);
@@ -48,6 +52,8 @@ private:
     ButterworthHighpassFilterDSP m_hpf;
     ButterworthLowpassFilterDSP m_lpf;
     PanDSP m_pan;
+    VBAPDSP m_vbap;
     PositioningParameters m_parameters;
+    bool m_panBypass = false;
 };
 }  // namespace rf
\ No newline at end of file
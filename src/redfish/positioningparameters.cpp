@@ -36,6 +36,16 @@ bool rf::PositioningParameters::operator==(const PositioningParameters& paramete
         return false;
     }
 
+    if (!Functions::FloatEquality(m_azimuth, parameters.m_azimuth))
+    {
+        return false;
+    }
+
+    if (!Functions::FloatEquality(m_elevation, parameters.m_elevation))
+    {
+        return false;
+    }
+
     if (!Functions::FloatEquality(m_currentDistance, parameters.m_currentDistance))
     {
         return false;
@@ -66,10 +76,40 @@ bool rf::PositioningParameters::operator==(const PositioningParameters& paramete
         return false;
     }
 
+    if (!Functions::FloatEquality(m_dopplerFactor, parameters.m_dopplerFactor))
+    {
+        return false;
+    }
+
+    if (!Functions::FloatEquality(m_airAbsorption, parameters.m_airAbsorption))
+    {
+        return false;
+    }
+
+    if (!Functions::FloatEquality(m_occlusion, parameters.m_occlusion))
+    {
+        return false;
+    }
+
+    if (!Functions::FloatEquality(m_occlusionAttenuationDb, parameters.m_occlusionAttenuationDb))
+    {
+        return false;
+    }
+
+    if (!Functions::FloatEquality(m_occlusionLpfCutoff, parameters.m_occlusionLpfCutoff))
+    {
+        return false;
+    }
+
     if (m_enable != parameters.m_enable)
     {
         return false;
     }
 
+    if (m_binaural != parameters.m_binaural)
+    {
+        return false;
+    }
+
     return true;
 }
\ No newline at end of file
@@ -37,6 +37,11 @@ struct PositioningParameters
     DistanceCurve m_distanceCurveType = DistanceCurve::Linear;
     // The pan angle of the sound. -1.0f is left, 0.0f is center, and 1.0f is right.
     float m_panAngle = 0.0f;
+    // The direction of the sound on a 5.1 or 7.1 output, in degrees clockwise from the front. -90.0f is left and 90.0f
+    // is right. Stereo outputs use the pan angle instead.
+    float m_azimuth = 0.0f;
+    // The height of the sound on a 5.1 or 7.1 output, in degrees from -90.0f (below) to 90.0f (above).
+    float m_elevation = 0.0f;
     // The current distance of the sound.
     float m_currentDistance = 0.0f;
     // The min distance used for distance attenuation.
@@ -52,8 +57,24 @@ struct PositioningParameters
     // The max amount of Butterworth high-end frequency attenuation applied to the sound when the sound is at or past
     // the max distance.
     float m_maxLpfCutoff = 20000.0f;
+    // How much the movement of an emitter and the listener shifts the pitch of the sound. 0.0f disables the doppler effect
+    // and 1.0f is physically accurate. Only applies to sound effects following an emitter.
+    float m_dopplerFactor = 1.0f;
+    // How quickly the air absorbs high frequencies as the sound gets further away. At a distance of 1.0f / m_airAbsorption
+    // the sound is low-passed at 10 kHz. 0.0f disables air absorption.
+    float m_airAbsorption = 0.0f;
+    // How occluded the sound is, from 0.0f (unoccluded) to 1.0f (fully occluded). Sound effects following an emitter
+    // take it from the emitter.
+    float m_occlusion = 0.0f;
+    // The amount of volume attenuation applied to the sound in decibels when it is fully occluded.
+    float m_occlusionAttenuationDb = -12.0f;
+    // The Butterworth high-end frequency attenuation applied to the sound when it is fully occluded.
+    float m_occlusionLpfCutoff = 2000.0f;
     // Enables positioning.
     bool m_enable = false;
+    // Renders the sound binaurally for headphones instead of panning it. Uses the azimuth and elevation, and needs an
+    // HRTF loaded with Context::LoadHRTF. Only applies to sound effects.
+    bool m_binaural = false;
 
     bool operator==(const PositioningParameters& parameters) const;
 };
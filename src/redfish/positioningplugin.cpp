@@ -22,10 +22,15 @@
 
 #include "positioningplugin.h"
 
+#include <algorithm>
+
+#include "allocator.h"
 #include "commandprocessor.h"
+#include "context.h"
 #include "functions.h"
 #include "plugincommands.h"
 #include "pluginutils.h"
+#include "positioningdsp.h"
 
 rf::PositioningPlugin::PositioningPlugin(Context* context,
                                          CommandProcessor* commands,
@@ -34,7 +39,7 @@ rf::PositioningPlugin::PositioningPlugin(Context* context,
                                          int pluginIndex)
     : PluginBase(context, commands, mixGroupHandle, mixGroupSlot, pluginIndex, PluginBase::Type::Positioning)
 {
-    RF_SEND_PLUGIN_CREATE_COMMAND(CreatePositioningDSPCommand);
+    RF_SEND_PLUGIN_CREATE_COMMAND(CreatePositioningDSPCommand, PositioningDSP);
 }
 
 rf::PositioningPlugin::~PositioningPlugin()
@@ -51,16 +56,21 @@ void rf::PositioningPlugin::SetPositioningParameters(const PositioningParameters
 
     m_positioningParameters = parameters;
     m_positioningParameters.m_panAngle = Functions::Clamp(m_positioningParameters.m_panAngle, -1.0f, 1.0f);
+    m_positioningParameters.m_elevation = Functions::Clamp(m_positioningParameters.m_elevation, -90.0f, 90.0f);
     m_positioningParameters.m_maxHpfCutoff =
         Functions::Clamp(m_positioningParameters.m_maxHpfCutoff, PluginUtils::k_minFilterCutoff, PluginUtils::k_maxFilterCutoff);
     m_positioningParameters.m_maxLpfCutoff =
         Functions::Clamp(m_positioningParameters.m_maxLpfCutoff, PluginUtils::k_minFilterCutoff, PluginUtils::k_maxFilterCutoff);
+    m_positioningParameters.m_airAbsorption = std::max(m_positioningParameters.m_airAbsorption, 0.0f);
+    m_positioningParameters.m_occlusion = Functions::Clamp(m_positioningParameters.m_occlusion, 0.0f, 1.0f);
+    m_positioningParameters.m_occlusionLpfCutoff =
+        Functions::Clamp(m_positioningParameters.m_occlusionLpfCutoff, PluginUtils::k_minFilterCutoff, PluginUtils::k_maxFilterCutoff);
 
     AudioCommand cmd;
     SetPositioningDSPPositioningParametersCommand& data = EncodeAudioCommand<SetPositioningDSPPositioningParametersCommand>(&cmd);
     data.m_dspIndex = m_pluginIndex;
     data.m_parameters = m_positioningParameters;
-    m_commands->Add(cmd);
+    AddCommand(cmd);
 }
 
 const rf::PositioningParameters& rf::PositioningPlugin::GetPositioningParameters() const
@@ -71,12 +81,18 @@ void rf::PositioningPlugin::ToJson(nlohmann::ordered_json& json) const
 {
     json["distanceCurveType"] = m_positioningParameters.m_distanceCurveType;
     json["panAngle"] = m_positioningParameters.m_panAngle;
+    json["azimuth"] = m_positioningParameters.m_azimuth;
+    json["elevation"] = m_positioningParameters.m_elevation;
     json["currentDistance"] = m_positioningParameters.m_currentDistance;
     json["minDistance"] = m_positioningParameters.m_minDistance;
     json["maxDistance"] = m_positioningParameters.m_maxDistance;
     json["maxAttenuationDb"] = m_positioningParameters.m_maxAttenuationDb;
     json["maxHpfCutoff"] = m_positioningParameters.m_maxHpfCutoff;
     json["maxLpfCutoff"] = m_positioningParameters.m_maxLpfCutoff;
+    json["airAbsorption"] = m_positioningParameters.m_airAbsorption;
+    json["occlusion"] = m_positioningParameters.m_occlusion;
+    json["occlusionAttenuationDb"] = m_positioningParameters.m_occlusionAttenuationDb;
+    json["occlusionLpfCutoff"] = m_positioningParameters.m_occlusionLpfCutoff;
     json["enable"] = m_positioningParameters.m_enable;
 }
 
@@ -84,11 +100,17 @@ void rf::PositioningPlugin::FromJson(const nlohmann::ordered_json& json)
 {
     m_positioningParameters.m_distanceCurveType = json.value("distanceCurveType", PositioningParameters::DistanceCurve::Linear);
     m_positioningParameters.m_panAngle = json.value("panAngle", 0.0f);
+    m_positioningParameters.m_azimuth = json.value("azimuth", 0.0f);
+    m_positioningParameters.m_elevation = json.value("elevation", 0.0f);
     m_positioningParameters.m_currentDistance = json.value("currentDistance", 0.0f);
     m_positioningParameters.m_minDistance = json.value("minDistance", 0.0f);
     m_positioningParameters.m_maxDistance = json.value("maxDistance", 0.0f);
     m_positioningParameters.m_maxAttenuationDb = json.value("maxAttenuationDb", 0.0f);
     m_positioningParameters.m_maxHpfCutoff = json.value("maxHpfCutoff", 20.0f);
     m_positioningParameters.m_maxLpfCutoff = json.value("maxLpfCutoff", 20000.0f);
+    m_positioningParameters.m_airAbsorption = json.value("airAbsorption", 0.0f);
+    m_positioningParameters.m_occlusion = json.value("occlusion", 0.0f);
+    m_positioningParameters.m_occlusionAttenuationDb = json.value("occlusionAttenuationDb", -12.0f);
+    m_positioningParameters.m_occlusionLpfCutoff = json.value("occlusionLpfCutoff", 2000.0f);
     m_positioningParameters.m_enable = json.value("enable", false);
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "message.h"
+#include "messenger.h"
+#include "tracecapture.h"
+
+rf::Profiler::Profiler(const AudioSpec& spec)
+{
+    m_nanosecondsPerFrame = 1000000000.0f / static_cast<float>(spec.m_sampleRate);
+    m_framesPerPublish = std::max(1, static_cast<int>(RF_PROFILER_PUBLISH_INTERVAL_MS * static_cast<float>(spec.m_sampleRate) / 1000.0f));
+}
+
+void rf::Profiler::BeginCallback()
+{
+    m_callbackStart = GetTime();
+}
+
+void rf::Profiler::EndCallback(int numFrames, Messenger* messenger)
+{
+    AddStageTime(Stage::Total, m_callbackStart, GetTime());
+
+    m_numFrames += numFrames;
+    if (m_numFrames < m_framesPerPublish)
+    {
+        return;
+    }
+
+    Publish(messenger);
+    std::fill(m_stageTimes, m_stageTimes + k_numStages, 0);
+    std::fill(m_mixGroupTimes, m_mixGroupTimes + RF_MAX_MIX_GROUPS, 0);
+    m_numFrames = 0;
+}
+
+void rf::Profiler::AddStageTime(Stage stage, long long start, long long end)
+{
+    m_stageTimes[static_cast<int>(stage)] += end - start;
+#if RF_ENABLE_TRACE_CAPTURE
+    TraceCapture::AddStage(stage, start, end);
+#endif
+}
+
+void rf::Profiler::AddMixGroupTime(int mixGroupIndex, long long nanoseconds)
+{
+    m_mixGroupTimes[mixGroupIndex] += nanoseconds;
+}
+
+long long rf::Profiler::GetTime()
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+void rf::Profiler::Publish(Messenger* messenger)
+{
+    const float toPercent = 100.0f / (m_nanosecondsPerFrame * static_cast<float>(m_numFrames));
+
+    for (int i = 0; i < k_numStages; ++i)
+    {
+        Message msg;
+        msg.m_type = MessageType::ProfilerStage;
+        Message::ProfilerStageData* data = msg.GetProfilerStageData();
+        data->m_stage = i;
+        data->m_cpuPercent = static_cast<float>(m_stageTimes[i]) * toPercent;
+        messenger->AddMessage(msg);
+    }
+
+    // A mix group that wasn't processed has no time. It is sent a zero once, so the game thread doesn't keep showing
+    // its last busy window, and nothing after that.
+    for (int i = 0; i < RF_MAX_MIX_GROUPS; ++i)
+    {
+        const bool isPublished = m_mixGroupTimes[i] != 0;
+        if (!isPublished && !m_isMixGroupPublished[i])
+        {
+            continue;
+        }
+
+        m_isMixGroupPublished[i] = isPublished;
+
+        Message msg;
+        msg.m_type = MessageType::ProfilerMixGroup;
+        Message::ProfilerMixGroupData* data = msg.GetProfilerMixGroupData();
+        data->m_mixGroupIndex = i;
+        data->m_cpuPercent = static_cast<float>(m_mixGroupTimes[i]) * toPercent;
+        messenger->AddMessage(msg);
+    }
+}
+
+rf::ProfilerScope::ProfilerScope(Profiler* profiler, Profiler::Stage stage)
+    : m_profiler(profiler)
+    , m_stage(stage)
+    , m_start(Profiler::GetTime())
+{
+}
+
+rf::ProfilerScope::~ProfilerScope()
+{
+    m_profiler->AddStageTime(m_stage, m_start, Profiler::GetTime());
+}
@@ -0,0 +1,92 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "audiospec.h"
+#include "defines.h"
+
+namespace rf
+{
+class Messenger;
+
+// Times the stages of the audio callback and the plug-in chain of every mix group. Times are summed on the audio thread
+// and sent to the game thread every RF_PROFILER_PUBLISH_INTERVAL_MS, as a percentage of the time the audio callback
+// had to render that much audio. Time is measured against the frames actually rendered, since hosts may call back with
+// a different number of frames every time.
+class Profiler
+{
+public:
+    enum class Stage
+    {
+        Commands,
+        Music,
+        Voices,
+        Mixing,
+        Output,
+        Total,
+    };
+
+    static constexpr int k_numStages = 6;
+
+    Profiler(const AudioSpec& spec);
+    Profiler(const Profiler&) = delete;
+    Profiler(Profiler&&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+    Profiler& operator=(Profiler&&) = delete;
+    ~Profiler() = default;
+
+    void BeginCallback();
+    void EndCallback(int numFrames, Messenger* messenger);
+    void AddStageTime(Stage stage, long long start, long long end);
+    void AddMixGroupTime(int mixGroupIndex, long long nanoseconds);
+    static long long GetTime();
+
+private:
+    long long m_stageTimes[k_numStages] = {};
+    long long m_mixGroupTimes[RF_MAX_MIX_GROUPS] = {};
+    // Mix groups whose last published time was not zero. They get one more message with zero once they go idle.
+    bool m_isMixGroupPublished[RF_MAX_MIX_GROUPS] = {};
+    long long m_callbackStart = 0;
+    float m_nanosecondsPerFrame = 0.0f;
+    int m_framesPerPublish = 1;
+    int m_numFrames = 0;
+
+    void Publish(Messenger* messenger);
+};
+
+// Adds the time between its construction and destruction to a stage.
+class ProfilerScope
+{
+public:
+    ProfilerScope(Profiler* profiler, Profiler::Stage stage);
+    ProfilerScope(const ProfilerScope&) = delete;
+    ProfilerScope(ProfilerScope&&) = delete;
+    ProfilerScope& operator=(const ProfilerScope&) = delete;
+    ProfilerScope& operator=(ProfilerScope&&) = delete;
+    ~ProfilerScope();
+
+private:
+    Profiler* m_profiler = nullptr;
+    Profiler::Stage m_stage = Profiler::Stage::Total;
+    long long m_start = 0;
+};
+}  // namespace rf
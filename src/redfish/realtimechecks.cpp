@@ -0,0 +1,147 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "realtimechecks.h"
+
+#include <chrono>
+
+#include "assert.h"
+
+std::atomic<int> rf::RealtimeChecks::s_numAllocations {0};
+std::atomic<int> rf::RealtimeChecks::s_numDeallocations {0};
+std::atomic<int> rf::RealtimeChecks::s_numQueueGrowths {0};
+std::atomic<int> rf::RealtimeChecks::s_numBlockingWaits {0};
+std::atomic<int> rf::RealtimeChecks::s_numCallbacks {0};
+std::atomic<int> rf::RealtimeChecks::s_numDeadlineMisses {0};
+std::atomic<float> rf::RealtimeChecks::s_maxCallbackMs {0.0f};
+std::atomic<float> rf::RealtimeChecks::s_deadlineMs {0.0f};
+thread_local long long rf::RealtimeChecks::s_callbackStart = 0;
+thread_local bool rf::RealtimeChecks::s_inCallback = false;
+
+static long long GetNanoseconds()
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+int rf::RealtimeReport::GetNumViolations() const
+{
+    return m_numAllocations + m_numDeallocations + m_numQueueGrowths + m_numBlockingWaits + m_numDeadlineMisses;
+}
+
+void rf::RealtimeChecks::BeginCallback()
+{
+    s_inCallback = true;
+    s_callbackStart = GetNanoseconds();
+}
+
+void rf::RealtimeChecks::EndCallback(float deadlineMs)
+{
+    const float callbackMs = static_cast<float>(GetNanoseconds() - s_callbackStart) / 1000000.0f;
+    s_inCallback = false;
+
+    s_numCallbacks.fetch_add(1, std::memory_order_relaxed);
+    s_deadlineMs.store(deadlineMs, std::memory_order_relaxed);
+    // Only the audio thread writes the max, so it doesn't need a compare and swap.
+    if (callbackMs > s_maxCallbackMs.load(std::memory_order_relaxed))
+    {
+        s_maxCallbackMs.store(callbackMs, std::memory_order_relaxed);
+    }
+
+    if (callbackMs > deadlineMs)
+    {
+        s_numDeadlineMisses.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool rf::RealtimeChecks::IsInCallback()
+{
+    return s_inCallback;
+}
+
+void rf::RealtimeChecks::OnAllocation()
+{
+    if (s_inCallback)
+    {
+        s_numAllocations.fetch_add(1, std::memory_order_relaxed);
+        OnViolation();
+    }
+}
+
+void rf::RealtimeChecks::OnDeallocation()
+{
+    if (s_inCallback)
+    {
+        s_numDeallocations.fetch_add(1, std::memory_order_relaxed);
+        OnViolation();
+    }
+}
+
+void rf::RealtimeChecks::OnQueueGrowth()
+{
+    // Growing a queue allocates, which is only a violation on the audio thread, but a queue that grows on the game
+    // thread is still too small for the amount of commands sent per callback.
+    s_numQueueGrowths.fetch_add(1, std::memory_order_relaxed);
+    if (s_inCallback)
+    {
+        OnViolation();
+    }
+}
+
+void rf::RealtimeChecks::OnBlockingWait()
+{
+    if (s_inCallback)
+    {
+        s_numBlockingWaits.fetch_add(1, std::memory_order_relaxed);
+        OnViolation();
+    }
+}
+
+void rf::RealtimeChecks::GetReport(RealtimeReport* outReport)
+{
+    outReport->m_numAllocations = s_numAllocations.load(std::memory_order_relaxed);
+    outReport->m_numDeallocations = s_numDeallocations.load(std::memory_order_relaxed);
+    outReport->m_numQueueGrowths = s_numQueueGrowths.load(std::memory_order_relaxed);
+    outReport->m_numBlockingWaits = s_numBlockingWaits.load(std::memory_order_relaxed);
+    outReport->m_numCallbacks = s_numCallbacks.load(std::memory_order_relaxed);
+    outReport->m_numDeadlineMisses = s_numDeadlineMisses.load(std::memory_order_relaxed);
+    outReport->m_maxCallbackMs = s_maxCallbackMs.load(std::memory_order_relaxed);
+    outReport->m_deadlineMs = s_deadlineMs.load(std::memory_order_relaxed);
+}
+
+void rf::RealtimeChecks::Reset()
+{
+    s_numAllocations = 0;
+    s_numDeallocations = 0;
+    s_numQueueGrowths = 0;
+    s_numBlockingWaits = 0;
+    s_numCallbacks = 0;
+    s_numDeadlineMisses = 0;
+    s_maxCallbackMs = 0.0f;
+}
+
+void rf::RealtimeChecks::OnViolation()
+{
+#if RF_ASSERT_ON_REALTIME_VIOLATIONS
+    RF_FAIL("The audio thread did something that is not realtime safe. Check the RealtimeReport.");
+#endif
+}
@@ -0,0 +1,79 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <atomic>
+
+#include "defines.h"
+
+namespace rf
+{
+struct RealtimeReport
+{
+    // Allocator calls made on the audio thread.
+    int m_numAllocations = 0;
+    int m_numDeallocations = 0;
+    // Lock-free queues that had to allocate a new block to fit a message or command.
+    int m_numQueueGrowths = 0;
+    // Calls from the audio thread into code that may block, such as the user's allocation callbacks.
+    int m_numBlockingWaits = 0;
+    int m_numCallbacks = 0;
+    // Audio callbacks that took longer than the buffer they rendered.
+    int m_numDeadlineMisses = 0;
+    float m_maxCallbackMs = 0.0f;
+    float m_deadlineMs = 0.0f;
+
+    int GetNumViolations() const;
+};
+
+// Records everything the audio thread does that is not realtime safe while it is inside Context::OnAudioCallback, and
+// times every callback against its deadline. Enabled with RF_ENABLE_REALTIME_CHECKS.
+class RealtimeChecks
+{
+public:
+    static void BeginCallback();
+    static void EndCallback(float deadlineMs);
+    static bool IsInCallback();
+
+    static void OnAllocation();
+    static void OnDeallocation();
+    static void OnQueueGrowth();
+    static void OnBlockingWait();
+
+    static void GetReport(RealtimeReport* outReport);
+    static void Reset();
+
+private:
+    static void OnViolation();
+
+    static std::atomic<int> s_numAllocations;
+    static std::atomic<int> s_numDeallocations;
+    static std::atomic<int> s_numQueueGrowths;
+    static std::atomic<int> s_numBlockingWaits;
+    static std::atomic<int> s_numCallbacks;
+    static std::atomic<int> s_numDeadlineMisses;
+    static std::atomic<float> s_maxCallbackMs;
+    static std::atomic<float> s_deadlineMs;
+    static thread_local long long s_callbackStart;
+    static thread_local bool s_inCallback;
+};
+}  // namespace rf
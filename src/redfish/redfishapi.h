@@ -30,10 +30,12 @@
 #include "convolverplugin.h"
 #include "cue.h"
 #include "delayplugin.h"
+#include "duckerplugin.h"
 #include "eventsystem.h"
 #include "gainplugin.h"
 #include "iir2highpassfilterplugin.h"
 #include "iir2lowpassfilterplugin.h"
+#include "irlibrary.h"
 #include "limiterplugin.h"
 #include "mixgroup.h"
 #include "musicsystem.h"
@@ -41,6 +43,8 @@
 #include "positioningplugin.h"
 #include "send.h"
 #include "soundeffect.h"
+#include "spatialsystem.h"
 #include "stinger.h"
+#include "tracecapture.h"
 #include "transition.h"
 #include "version.h"
\ No newline at end of file
@@ -58,7 +58,7 @@ void rf::Send::SetVolumeDb(float volumeDb)
     SetSendAmplitudeCommand& data = EncodeAudioCommand<SetSendAmplitudeCommand>(&cmd);
     data.m_sendIndex = m_sendIndex;
     data.m_amplitude = Functions::DecibelToAmplitude(volumeDb);
-    m_commands->Add(cmd);
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
 }
 
 float rf::Send::GetVolumeDb() const
@@ -49,5 +49,9 @@ private:
     int m_sendIndex = -1;
     SendHandle m_sendHandle;
     MixGroupHandle m_sendToMixGroupHandle;
+    long long m_readyPlayhead = -1;
+
+    friend class MixGroup;
+    friend class MixerSystem;
 };
 }  // namespace rf
\ No newline at end of file
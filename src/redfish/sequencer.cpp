@@ -22,35 +22,47 @@
 
 #include "sequencer.h"
 
+#include "allocator.h"
 #include "assert.h"
 #include "audiodata.h"
 #include "conductor.h"
 #include "functions.h"
 #include "messenger.h"
+#include "musicconfig.h"
+#include "musicstreamer.h"
 
-rf::Sequencer::Sequencer(const MusicDatabase* musicDatabase, const AudioSpec& spec, Messenger* messanger)
+rf::Sequencer::Sequencer(const MusicDatabase* musicDatabase, const AudioSpec& spec, const MusicConfig& config, Messenger* messanger)
     : m_spec(spec)
     , m_musicDatabase(musicDatabase)
     , m_messanger(messanger)
+    , m_maxTransitions(config.m_maxTransitions)
     , m_fader(spec.m_bufferSize)
     , m_transformationMixItem(spec.m_channels, spec.m_bufferSize)
-    , m_layerSet(spec, messanger)
-    , m_stingerSet(spec, messanger)
+    , m_layerSet(spec, config.m_maxCueLayers, messanger)
+    , m_stingerSet(spec, config.m_maxCueLayers * config.m_maxPlayingStingers, messanger)
 {
+    m_transitionIndices = Allocator::AllocateArray<int>("SequencerTransitionIndices", m_maxTransitions, -1);
     Reset(true);
 }
 
+rf::Sequencer::~Sequencer()
+{
+    Allocator::DeallocateArray<int>(&m_transitionIndices, m_maxTransitions);
+}
+
 rf::Sequencer::Result rf::Sequencer::Process(Conductor* conductor,
                                              long long playhead,
+                                             int bufferSize,
                                              MixItem* outMixItems,
                                              int* outstartIndex,
                                              const AudioData** audioData)
 {
     int mixItemStartIndex = *outstartIndex;
-    const int bufferSize = m_spec.m_bufferSize;
     BaseVoice::Info info;
     bool process = false;
 
+    m_layerSet.ProcessLayerAmplitudes(bufferSize);
+
     do
     {
         bool nothingToDo = false;
@@ -82,7 +94,7 @@ rf::Sequencer::Result rf::Sequencer::Process(Conductor* conductor,
             }
             case State::ProcessingTransition:
             {
-                if (Functions::InFirstWindow(playhead, m_pendingTransition.m_startTime, m_spec.m_bufferSize))
+                if (Functions::InFirstWindow(playhead, m_pendingTransition.m_startTime, bufferSize))
                 {
                     // We are in the first frame of the transition.
 
@@ -120,9 +132,9 @@ rf::Sequencer::Result rf::Sequencer::Process(Conductor* conductor,
                     const long long difference = m_currentTransition.m_startTime - playhead;
                     RF_ASSERT(difference <= bufferSize, "Expected this value to be <= bufferSize");
                     const int processLength = static_cast<int>(difference);
-                    info = m_layerSet.Process(playhead, 0, processLength, previousMusicWasInterrupted, outMixItems, outstartIndex);
+                    info = m_layerSet.Process(playhead, 0, processLength, bufferSize, previousMusicWasInterrupted, outMixItems, outstartIndex);
                     RF_ASSERT(!info.m_mixItemFullyFilled, "This mix item should not be filled at this point");
-                    RF_ASSERT(info.m_lastFilledFrame < m_spec.m_bufferSize - 1, "This should have never filled up to this index");
+                    RF_ASSERT(info.m_lastFilledFrame < bufferSize - 1, "This should have never filled up to this index");
 
                     // Play the new transition
                     m_layerSet.Play(m_currentTransition, transitionData, cueData, audioData);
@@ -187,7 +199,7 @@ rf::Sequencer::Result rf::Sequencer::Process(Conductor* conductor,
         const int fillLength = bufferSize - startingIndex;
         RF_ASSERT(startingIndex < bufferSize, "Starting index out of bounds");
         RF_ASSERT(fillLength <= bufferSize, "Fill length out of bounds");
-        info = m_layerSet.Process(playhead, startingIndex, fillLength, false, outMixItems, outstartIndex);
+        info = m_layerSet.Process(playhead, startingIndex, fillLength, bufferSize, false, outMixItems, outstartIndex);
 
         // Check for follow ups
         bool followUp = false;
@@ -251,7 +263,7 @@ rf::Sequencer::Result rf::Sequencer::Process(Conductor* conductor,
     }
 
     // Process DSP
-    const Result dspResult = UpdateDSP(outMixItems, mixItemStartIndex, *outstartIndex);
+    const Result dspResult = UpdateDSP(outMixItems, mixItemStartIndex, *outstartIndex, bufferSize);
 
     // Determine if the music has stopped.
     // This can be caused by asking the music system to stop. Or, the music can end naturally.
@@ -309,12 +321,17 @@ void rf::Sequencer::Fade(long long startTime, float amplitude, int sampleDuratio
     m_stopOnDoneFade = stopOnDone;
 }
 
+void rf::Sequencer::SetLayerAmplitude(int layerIndex, float amplitude, int sampleDuration)
+{
+    m_layerSet.SetLayerAmplitude(layerIndex, amplitude, sampleDuration);
+}
+
 void rf::Sequencer::Reset(bool resetStingers)
 {
     m_pendingTransition = MusicTransitionRequest();
     m_currentTransition = MusicTransitionRequest();
 
-    for (int i = 0; i < RF_MAX_TRANSITIONS; ++i)
+    for (int i = 0; i < m_maxTransitions; ++i)
     {
         m_transitionIndices[i] = -1;
     }
@@ -340,7 +357,7 @@ void rf::Sequencer::AddTransition(int transitionIndex)
     if (m_transitionIndices[m_transitionInsertIndex] == -1)
     {
         m_transitionIndices[m_transitionInsertIndex] = transitionIndex;
-        m_transitionInsertIndex = (m_transitionInsertIndex + 1) % RF_MAX_TRANSITIONS;
+        m_transitionInsertIndex = (m_transitionInsertIndex + 1) % m_maxTransitions;
         ++m_numTransitions;
     }
     else
@@ -364,6 +381,59 @@ const rf::MusicTransitionRequest& rf::Sequencer::GetCurrentTransition() const
     return m_currentTransition;
 }
 
+void rf::Sequencer::RequireStreams(MusicStreamer* streamer) const
+{
+    m_layerSet.RequireStreams(streamer);
+    m_stingerSet.RequireStreams(streamer);
+
+    // Transitions and stingers being destroyed can still be queued for a block, with their cue already cleared.
+    const auto RequireCue = [this, streamer](int cueIndex, long long startTime) {
+        if (cueIndex == -1)
+        {
+            return;
+        }
+
+        const MusicDatabase::CueData& cueData = m_musicDatabase->GetCueData(cueIndex);
+        for (int i = 0; i < cueData.m_numLayers; ++i)
+        {
+            streamer->Require(cueData.m_layers[i].m_audioDataIndex, startTime);
+        }
+    };
+
+    const auto RequireTransition = [this, &RequireCue](int transitionIndex, long long startTime, long long stingerStartTime) {
+        if (transitionIndex == -1)
+        {
+            return;
+        }
+
+        const MusicDatabase::TransitionData& transitionData = m_musicDatabase->GetTransitionData(transitionIndex);
+        RequireCue(transitionData.m_cueIndex, startTime);
+        if (transitionData.m_stingerIndex >= 0)
+        {
+            RequireCue(m_musicDatabase->GetStingerData(transitionData.m_stingerIndex).m_cueIndex, stingerStartTime);
+        }
+    };
+
+    // The scheduled transition, with the times its cue and stinger start.
+    RequireTransition(m_pendingTransition.m_transitionDataIndex, m_pendingTransition.m_startTime, m_pendingTransition.m_stingerStartTime);
+
+    // The follow up plays straight after the current cue, without a stinger.
+    if (m_currentTransition.m_transitionDataIndex >= 0)
+    {
+        const int followUpIndex = m_musicDatabase->GetTransitionData(m_currentTransition.m_transitionDataIndex).m_followUpTransitionIndex;
+        if (followUpIndex >= 0)
+        {
+            RequireCue(m_musicDatabase->GetTransitionData(followUpIndex).m_cueIndex, -1);
+        }
+    }
+
+    // Queued transitions are not scheduled yet, but are loaded as soon as they are queued.
+    for (int i = 0; i < m_maxTransitions; ++i)
+    {
+        RequireTransition(m_transitionIndices[i], -1, -1);
+    }
+}
+
 bool rf::Sequencer::Unload(AudioHandle audioHandle, long long playhead)
 {
     m_stingerSet.ResetIfPlayingAudioHandle(audioHandle);
@@ -394,7 +464,7 @@ bool rf::Sequencer::Unload(AudioHandle audioHandle, long long playhead)
         return true;
     }
 
-    for (int i = 0; i < RF_MAX_TRANSITIONS; ++i)
+    for (int i = 0; i < m_maxTransitions; ++i)
     {
         if (CheckForAudioHandle(m_transitionIndices[i], audioHandle, playhead))
         {
@@ -441,7 +511,7 @@ void rf::Sequencer::DestroyCue(int cueIndex, long long playhead)
         return;
     }
 
-    for (int i = 0; i < RF_MAX_TRANSITIONS; ++i)
+    for (int i = 0; i < m_maxTransitions; ++i)
     {
         if (CheckForCueIndex(m_transitionIndices[i], cueIndex, playhead))
         {
@@ -458,7 +528,7 @@ void rf::Sequencer::DestroyTransition(int transitionIndex, long long playhead)
         return;
     }
 
-    for (int i = 0; i < RF_MAX_TRANSITIONS; ++i)
+    for (int i = 0; i < m_maxTransitions; ++i)
     {
         if (m_transitionIndices[i] == transitionIndex)
         {
@@ -509,7 +579,7 @@ void rf::Sequencer::DestroyStinger(int stingerIndex, long long playhead)
         return;
     }
 
-    for (int i = 0; i < RF_MAX_TRANSITIONS; ++i)
+    for (int i = 0; i < m_maxTransitions; ++i)
     {
         if (CheckForStingerIndex(m_transitionIndices[i], stingerIndex, playhead))
         {
@@ -531,7 +601,7 @@ bool rf::Sequencer::GetRequest(long long playhead, Conductor* conductor, MusicTr
         *outRequest = conductor->CreateRequest(transitionIndex, playhead, IsPlaying(), audioData);
         RF_ASSERT(outRequest->m_transitionDataIndex >= 0, "Expected valid transition");
         m_transitionIndices[m_transitionGetIndex] = -1;
-        m_transitionGetIndex = (m_transitionGetIndex + 1) % RF_MAX_TRANSITIONS;
+        m_transitionGetIndex = (m_transitionGetIndex + 1) % m_maxTransitions;
         --m_numTransitions;
         return true;
     }
@@ -539,12 +609,12 @@ bool rf::Sequencer::GetRequest(long long playhead, Conductor* conductor, MusicTr
     return false;
 }
 
-rf::Sequencer::Result rf::Sequencer::UpdateDSP(MixItem* outMixItems, int startIndex, int endIndex)
+rf::Sequencer::Result rf::Sequencer::UpdateDSP(MixItem* outMixItems, int startIndex, int endIndex, int bufferSize)
 {
     m_transformationMixItem.Set(1.0f);
 
     const bool isFadingBefore = m_fader.IsFading();
-    const bool isFading = m_fader.Process(&m_transformationMixItem, m_spec.m_bufferSize);
+    const bool isFading = m_fader.Process(&m_transformationMixItem, bufferSize);
 
     for (int i = startIndex; i < endIndex; ++i)
     {
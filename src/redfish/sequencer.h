@@ -33,17 +33,19 @@ namespace rf
 class Conductor;
 class Messenger;
 class MusicDatabase;
+class MusicStreamer;
 struct AudioData;
+struct MusicConfig;
 
 class Sequencer
 {
 public:
-    Sequencer(const MusicDatabase* musicDatabase, const AudioSpec& spec, Messenger* messanger);
+    Sequencer(const MusicDatabase* musicDatabase, const AudioSpec& spec, const MusicConfig& config, Messenger* messanger);
     Sequencer(const Sequencer&) = delete;
     Sequencer(Sequencer&&) = delete;
     Sequencer& operator=(const Sequencer&) = delete;
     Sequencer& operator=(Sequencer&&) = delete;
-    ~Sequencer() = default;
+    ~Sequencer();
 
     enum class Result
     {
@@ -51,14 +53,17 @@ public:
         Stop,
     };
 
-    Result Process(Conductor* conductor, long long playhead, MixItem* outMixItems, int* outstartIndex, const AudioData** audioData);
+    Result Process(Conductor* conductor, long long playhead, int bufferSize, MixItem* outMixItems, int* outstartIndex, const AudioData** audioData);
     void Stop(long long stopTime, long long playhead);
     void Fade(long long startTime, float amplitude, int sampleDuration, long long playhead, bool stopOnDone);
+    void SetLayerAmplitude(int layerIndex, float amplitude, int sampleDuration);
     void Reset(bool resetStingers);
     void AddTransition(int transitionIndex);
     bool IsPlaying() const;
     bool IsProcessingTransition() const;
     const MusicTransitionRequest& GetCurrentTransition() const;
+    // Marks the streams of every cue that is playing, scheduled or queued, so they are loaded before they start.
+    void RequireStreams(MusicStreamer* streamer) const;
 
     bool Unload(AudioHandle audioHandle, long long playhead);
     void DestroyCue(int cueIndex, long long playhead);
@@ -78,7 +83,8 @@ private:
     Messenger* m_messanger = nullptr;
     MusicTransitionRequest m_pendingTransition;
     MusicTransitionRequest m_currentTransition;
-    int m_transitionIndices[RF_MAX_TRANSITIONS];
+    int* m_transitionIndices = nullptr;
+    int m_maxTransitions = 0;
     Fader m_fader;
     MixItem m_transformationMixItem;
     int m_transitionInsertIndex = 0;
@@ -92,6 +98,6 @@ private:
     bool m_stopOnDoneFade = false;
 
     bool GetRequest(long long playhead, Conductor* conductor, MusicTransitionRequest* outRequest, const AudioData** audioData);
-    Result UpdateDSP(MixItem* outMixItems, int startIndex, int endIndex);
+    Result UpdateDSP(MixItem* outMixItems, int startIndex, int endIndex, int bufferSize);
 };
 }  // namespace rf
\ No newline at end of file
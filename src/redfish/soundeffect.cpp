@@ -22,6 +22,8 @@
 
 #include "soundeffect.h"
 
+#include <algorithm>
+
 #include "assert.h"
 #include "assetsystem.h"
 #include "context.h"
@@ -35,6 +37,7 @@
     m_variations = soundEffect.m_variations;                                             \
     m_soundEffectHandle = soundEffect.m_soundEffectHandle;                               \
     m_mixGroup = soundEffect.m_mixGroup;                                                 \
+    m_emitterHandle = soundEffect.m_emitterHandle;                                       \
     m_playbackRule = soundEffect.m_playbackRule;                                         \
     m_lastSelectedRoundRobin = soundEffect.m_lastSelectedRoundRobin;                     \
     m_smartShuffleHistoryIndex = soundEffect.m_smartShuffleHistoryIndex;                 \
@@ -128,11 +131,13 @@ void rf::SoundEffect::Play(const rf::Sync sync)
     data.m_soundEffectHandle = m_soundEffectHandle;
     data.m_playCount = m_isLooping ? 0 : 1;
     data.m_mixGroupHandle = m_mixGroup->GetMixGroupHandle();
+    data.m_emitterHandle = m_emitterHandle;
     data.m_pitch = m_pitch * variationPitch;
     data.m_amplitude = m_amplitude * variationAmp;
     data.m_positioningParameters = m_positioningParamters;
     data.m_sync = sync;
-    m_commands->Add(cmd);
+    // Waits for the mix group too, in case it has only been scheduled to exist.
+    m_readyPlayhead = m_commands->Add(cmd, std::max(m_readyPlayhead, m_mixGroup->m_readyPlayhead));
 }
 
 void rf::SoundEffect::Play()
@@ -145,7 +150,7 @@ void rf::SoundEffect::Stop()
     AudioCommand cmd;
     StopSoundEffectCommand& data = EncodeAudioCommand<StopSoundEffectCommand>(&cmd);
     data.m_soundEffectHandle = m_soundEffectHandle;
-    m_commands->Add(cmd);
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
 }
 
 void rf::SoundEffect::Fade(float volumeDb, const Sync& sync, const Sync& duration)
@@ -156,7 +161,7 @@ void rf::SoundEffect::Fade(float volumeDb, const Sync& sync, const Sync& duratio
     data.m_sync = sync;
     data.m_duration = duration;
     data.m_amplitude = Functions::DecibelToAmplitude(volumeDb);
-    m_commands->Add(cmd);
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
 }
 
 void rf::SoundEffect::FadeOutAndStop(const Sync& sync, const Sync& duration)
@@ -168,7 +173,7 @@ void rf::SoundEffect::FadeOutAndStop(const Sync& sync, const Sync& duration)
     data.m_duration = duration;
     data.m_amplitude = 0.0f;
     data.m_stopOnDone = true;
-    m_commands->Add(cmd);
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
 }
 
 void rf::SoundEffect::SetVolumeDb(float volumeDb)
@@ -185,7 +190,7 @@ void rf::SoundEffect::SetVolumeDb(float volumeDb)
     SoundEffectAmplitudeCommand& data = EncodeAudioCommand<SoundEffectAmplitudeCommand>(&cmd);
     data.m_soundEffectHandle = m_soundEffectHandle;
     data.m_amplitude = m_amplitude;
-    m_commands->Add(cmd);
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
 }
 
 float rf::SoundEffect::GetVolumeDb() const
@@ -206,7 +211,7 @@ void rf::SoundEffect::SetPitch(float pitch)
     SoundEffectPitchCommand& data = EncodeAudioCommand<SoundEffectPitchCommand>(&cmd);
     data.m_soundEffectHandle = m_soundEffectHandle;
     data.m_pitch = m_pitch;
-    m_commands->Add(cmd);
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
 }
 
 float rf::SoundEffect::GetPitch() const
@@ -240,12 +245,16 @@ void rf::SoundEffect::SetPositioningParameters(const PositioningParameters& posi
 
     m_positioningParamters = positioningParameters;
     m_positioningParamters.m_panAngle = Functions::Clamp(m_positioningParamters.m_panAngle, -1.0f, 1.0f);
+    m_positioningParamters.m_elevation = Functions::Clamp(m_positioningParamters.m_elevation, -90.0f, 90.0f);
+    m_positioningParamters.m_dopplerFactor = Functions::Clamp(m_positioningParamters.m_dopplerFactor, 0.0f, 1.0f);
+    m_positioningParamters.m_airAbsorption = std::max(m_positioningParamters.m_airAbsorption, 0.0f);
+    m_positioningParamters.m_occlusion = Functions::Clamp(m_positioningParamters.m_occlusion, 0.0f, 1.0f);
 
     AudioCommand cmd;
     SoundEffectPositioningParamtersCommand& data = EncodeAudioCommand<SoundEffectPositioningParamtersCommand>(&cmd);
     data.m_soundEffectHandle = m_soundEffectHandle;
     data.m_positioningParameters = m_positioningParamters;
-    m_commands->Add(cmd);
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
 }
 
 const rf::PositioningParameters& rf::SoundEffect::GetPositioningParameters() const
@@ -273,6 +282,27 @@ rf::MixGroup* rf::SoundEffect::GetMixGroup() const
     return m_mixGroup;
 }
 
+void rf::SoundEffect::SetEmitter(EmitterHandle emitterHandle)
+{
+    if (m_emitterHandle == emitterHandle)
+    {
+        return;
+    }
+
+    m_emitterHandle = emitterHandle;
+
+    AudioCommand cmd;
+    SoundEffectEmitterCommand& data = EncodeAudioCommand<SoundEffectEmitterCommand>(&cmd);
+    data.m_soundEffectHandle = m_soundEffectHandle;
+    data.m_emitterHandle = m_emitterHandle;
+    m_readyPlayhead = m_commands->Add(cmd, m_readyPlayhead);
+}
+
+rf::EmitterHandle rf::SoundEffect::GetEmitter() const
+{
+    return m_emitterHandle;
+}
+
 const rf::SoundEffect::Variation& rf::SoundEffect::SelectVariation()
 {
     const int numVariations = static_cast<int>(m_variations.size());
@@ -339,7 +369,8 @@ void rf::SoundEffect::Reserve()
 
 void rf::SoundEffect::Free()
 {
-    m_variations.~vector();
+    // Releases the variations but leaves a valid empty vector, which is destroyed again with the sound effect.
+    std::vector<Variation>().swap(m_variations);
 }
 
 rf::SoundEffect::Variation& rf::SoundEffect::Variation::SetMinVolumeDb(float volumeDb)
@@ -82,6 +82,10 @@ public:
     bool GetIsLooping() const;
     void SetMixGroup(MixGroup* mixGroup);
     MixGroup* GetMixGroup() const;
+    // Makes the sound effect follow an emitter created by the SpatialSystem. Its distance, direction, doppler shift
+    // and occlusion are then derived from the emitter and the listener instead of the positioning parameters.
+    void SetEmitter(EmitterHandle emitterHandle);
+    EmitterHandle GetEmitter() const;
 
 private:
     static constexpr int k_maxHistorySize = 20;
@@ -90,11 +94,13 @@ private:
     std::vector<Variation> m_variations;
     SoundEffectHandle m_soundEffectHandle;
     MixGroup* m_mixGroup = nullptr;
+    EmitterHandle m_emitterHandle;
     PlaybackRule m_playbackRule = PlaybackRule::SmartShuffle;
     PositioningParameters m_positioningParamters;
     int m_smartShufflePlaybackHistory[k_maxHistorySize];
     int m_lastSelectedRoundRobin = 0;
     int m_smartShuffleHistoryIndex = 0;
+    long long m_readyPlayhead = -1;
     float m_pitch = 1.0f;
     float m_amplitude = 1.0f;
     bool m_isLooping = false;
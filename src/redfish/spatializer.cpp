@@ -0,0 +1,207 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "spatializer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "allocator.h"
+#include "functions.h"
+#include "pluginutils.h"
+#include "voice.h"
+
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+#    include <immintrin.h>
+#endif
+
+rf::Spatializer::Spatializer()
+{
+    m_frame = Allocator::Allocate<TransformTable::Frame>("SpatializerFrame");
+}
+
+rf::Spatializer::~Spatializer()
+{
+    Allocator::Deallocate<TransformTable::Frame>(&m_frame);
+}
+
+void rf::Spatializer::SetTransformTable(const TransformTable* transforms)
+{
+    m_transforms = transforms;
+}
+
+void rf::Spatializer::Process(Voice* voices, int numVoices)
+{
+    if (!m_transforms)
+    {
+        return;
+    }
+
+    // Every voice is updated when the game publishes new transforms. Otherwise, only voices that just started
+    // following an emitter are.
+    const bool newFrame = m_transforms->Read(m_frame, &m_sequence);
+    const TransformTable::Listener& listener = m_frame->m_listener;
+
+    int numSpatialVoices = 0;
+    for (int i = 0; i < numVoices; ++i)
+    {
+        Voice& voice = voices[i];
+        if (!voice.m_emitterHandle || !(newFrame || voice.m_emitterChanged))
+        {
+            continue;
+        }
+
+        // If the emitter was destroyed, the voice stays where the emitter was last seen.
+        const int slot = TransformTable::GetSlot(voice.m_emitterHandle);
+        if (slot >= m_frame->m_numEmitters || m_frame->m_emitterIds[slot] != voice.m_emitterHandle.m_id)
+        {
+            continue;
+        }
+
+        m_voiceIndices[numSpatialVoices] = i;
+        m_slots[numSpatialVoices] = slot;
+        m_x[numSpatialVoices] = m_frame->m_positionX[slot] - listener.m_position.m_x;
+        m_y[numSpatialVoices] = m_frame->m_positionY[slot] - listener.m_position.m_y;
+        m_z[numSpatialVoices] = m_frame->m_positionZ[slot] - listener.m_position.m_z;
+        m_velocityX[numSpatialVoices] = m_frame->m_velocityX[slot];
+        m_velocityY[numSpatialVoices] = m_frame->m_velocityY[slot];
+        m_velocityZ[numSpatialVoices] = m_frame->m_velocityZ[slot];
+        ++numSpatialVoices;
+    }
+
+    ProcessBatch(numSpatialVoices);
+
+    const float radiansToDegrees = 360.0f / PluginUtils::k_twoPi;
+    for (int i = 0; i < numSpatialVoices; ++i)
+    {
+        Voice& voice = voices[m_voiceIndices[i]];
+        PositioningParameters parameters = voice.m_positioning.GetPositioningParameters();
+
+        const float horizontalDistance = sqrtf(m_fronts[i] * m_fronts[i] + m_rights[i] * m_rights[i]);
+        parameters.m_currentDistance = m_distances[i];
+        parameters.m_panAngle = m_panAngles[i];
+        parameters.m_azimuth = atan2f(m_rights[i], m_fronts[i]) * radiansToDegrees;
+        parameters.m_elevation = atan2f(m_ups[i], horizontalDistance) * radiansToDegrees;
+        parameters.m_occlusion = m_frame->m_occlusion[m_slots[i]];
+
+        // A voice that has not started yet jumps straight to its position instead of sweeping there.
+        voice.m_positioning.SetPositioningParameters(parameters, voice.IsPlaying());
+        voice.SetDopplerPitch(Functions::Lerp(parameters.m_dopplerFactor, 1.0f, m_dopplerPitches[i]));
+        voice.m_emitterChanged = false;
+    }
+}
+
+void rf::Spatializer::ProcessBatch(int numVoices)
+{
+    const TransformTable::Listener& listener = m_frame->m_listener;
+    const Vector3& forward = listener.m_forward;
+    const Vector3& up = listener.m_up;
+    const Vector3 right = {forward.m_y * up.m_z - forward.m_z * up.m_y,
+                           forward.m_z * up.m_x - forward.m_x * up.m_z,
+                           forward.m_x * up.m_y - forward.m_y * up.m_x};
+    const float minDistance = 0.0001f;
+
+    int i = 0;
+
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+    const __m128 forwardX = _mm_set1_ps(forward.m_x);
+    const __m128 forwardY = _mm_set1_ps(forward.m_y);
+    const __m128 forwardZ = _mm_set1_ps(forward.m_z);
+    const __m128 rightX = _mm_set1_ps(right.m_x);
+    const __m128 rightY = _mm_set1_ps(right.m_y);
+    const __m128 rightZ = _mm_set1_ps(right.m_z);
+    const __m128 upX = _mm_set1_ps(up.m_x);
+    const __m128 upY = _mm_set1_ps(up.m_y);
+    const __m128 upZ = _mm_set1_ps(up.m_z);
+    const __m128 listenerVelocityX = _mm_set1_ps(listener.m_velocity.m_x);
+    const __m128 listenerVelocityY = _mm_set1_ps(listener.m_velocity.m_y);
+    const __m128 listenerVelocityZ = _mm_set1_ps(listener.m_velocity.m_z);
+    const __m128 speedOfSound = _mm_set1_ps(k_speedOfSound);
+    const __m128 minDistances = _mm_set1_ps(minDistance);
+    const __m128 minDenominator = _mm_set1_ps(1.0f);
+    const __m128 minPitch = _mm_set1_ps(k_minDopplerPitch);
+    const __m128 maxPitch = _mm_set1_ps(k_maxDopplerPitch);
+    const __m128 minPan = _mm_set1_ps(-1.0f);
+    const __m128 maxPan = _mm_set1_ps(1.0f);
+    const __m128 ones = _mm_set1_ps(1.0f);
+
+    for (; i + 4 <= numVoices; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(m_x + i);
+        const __m128 y = _mm_loadu_ps(m_y + i);
+        const __m128 z = _mm_loadu_ps(m_z + i);
+
+        const __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        const __m128 distance = _mm_sqrt_ps(distanceSquared);
+        const __m128 inverseDistance = _mm_div_ps(ones, _mm_max_ps(distance, minDistances));
+
+        const __m128 front = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, forwardX), _mm_mul_ps(y, forwardY)), _mm_mul_ps(z, forwardZ));
+        const __m128 side = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, rightX), _mm_mul_ps(y, rightY)), _mm_mul_ps(z, rightZ));
+        const __m128 height = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, upX), _mm_mul_ps(y, upY)), _mm_mul_ps(z, upZ));
+        const __m128 pan = _mm_min_ps(_mm_max_ps(_mm_mul_ps(side, inverseDistance), minPan), maxPan);
+
+        // Speeds along the line from the listener to the emitter, positive when moving towards the emitter's side.
+        const __m128 listenerSpeed = _mm_mul_ps(
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, listenerVelocityX), _mm_mul_ps(y, listenerVelocityY)), _mm_mul_ps(z, listenerVelocityZ)),
+            inverseDistance);
+        const __m128 emitterSpeed = _mm_mul_ps(
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_loadu_ps(m_velocityX + i)), _mm_mul_ps(y, _mm_loadu_ps(m_velocityY + i))),
+                       _mm_mul_ps(z, _mm_loadu_ps(m_velocityZ + i))),
+            inverseDistance);
+        const __m128 numerator = _mm_add_ps(speedOfSound, listenerSpeed);
+        const __m128 denominator = _mm_max_ps(_mm_add_ps(speedOfSound, emitterSpeed), minDenominator);
+        const __m128 pitch = _mm_min_ps(_mm_max_ps(_mm_div_ps(numerator, denominator), minPitch), maxPitch);
+
+        _mm_storeu_ps(m_distances + i, distance);
+        _mm_storeu_ps(m_panAngles + i, pan);
+        _mm_storeu_ps(m_fronts + i, front);
+        _mm_storeu_ps(m_rights + i, side);
+        _mm_storeu_ps(m_ups + i, height);
+        _mm_storeu_ps(m_dopplerPitches + i, pitch);
+    }
+#endif
+
+    for (; i < numVoices; ++i)
+    {
+        const float x = m_x[i];
+        const float y = m_y[i];
+        const float z = m_z[i];
+
+        const float distance = sqrtf(x * x + y * y + z * z);
+        const float inverseDistance = 1.0f / std::max(distance, minDistance);
+
+        const float front = x * forward.m_x + y * forward.m_y + z * forward.m_z;
+        const float side = x * right.m_x + y * right.m_y + z * right.m_z;
+        const float height = x * up.m_x + y * up.m_y + z * up.m_z;
+
+        const float listenerSpeed = (x * listener.m_velocity.m_x + y * listener.m_velocity.m_y + z * listener.m_velocity.m_z) * inverseDistance;
+        const float emitterSpeed = (x * m_velocityX[i] + y * m_velocityY[i] + z * m_velocityZ[i]) * inverseDistance;
+        const float pitch = (k_speedOfSound + listenerSpeed) / std::max(k_speedOfSound + emitterSpeed, 1.0f);
+
+        m_distances[i] = distance;
+        m_panAngles[i] = Functions::Clamp(side * inverseDistance, -1.0f, 1.0f);
+        m_fronts[i] = front;
+        m_rights[i] = side;
+        m_ups[i] = height;
+        m_dopplerPitches[i] = Functions::Clamp(pitch, k_minDopplerPitch, k_maxDopplerPitch);
+    }
+}
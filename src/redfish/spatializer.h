@@ -0,0 +1,74 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "defines.h"
+#include "transformtable.h"
+
+namespace rf
+{
+class Voice;
+
+// Derives the positioning of every voice that follows an emitter from the transforms published by the SpatialSystem.
+// Distances, directions and doppler shifts are computed for all of those voices in one SIMD batch.
+class Spatializer
+{
+public:
+    Spatializer();
+    Spatializer(const Spatializer&) = delete;
+    Spatializer(Spatializer&&) = delete;
+    Spatializer& operator=(const Spatializer&) = delete;
+    Spatializer& operator=(Spatializer&&) = delete;
+    ~Spatializer();
+
+    void SetTransformTable(const TransformTable* transforms);
+    void Process(Voice* voices, int numVoices);
+
+private:
+    // In meters per second, so positions are expected in meters and velocities in meters per second.
+    static constexpr float k_speedOfSound = 343.0f;
+    static constexpr float k_minDopplerPitch = 0.5f;
+    static constexpr float k_maxDopplerPitch = 2.0f;
+
+    const TransformTable* m_transforms = nullptr;
+    TransformTable::Frame* m_frame = nullptr;
+    unsigned int m_sequence = 0;
+
+    // The voices being updated this block, as a structure of arrays.
+    int m_voiceIndices[RF_MAX_VOICES] = {};
+    int m_slots[RF_MAX_VOICES] = {};
+    float m_x[RF_MAX_VOICES] = {};
+    float m_y[RF_MAX_VOICES] = {};
+    float m_z[RF_MAX_VOICES] = {};
+    float m_velocityX[RF_MAX_VOICES] = {};
+    float m_velocityY[RF_MAX_VOICES] = {};
+    float m_velocityZ[RF_MAX_VOICES] = {};
+    float m_distances[RF_MAX_VOICES] = {};
+    float m_panAngles[RF_MAX_VOICES] = {};
+    float m_fronts[RF_MAX_VOICES] = {};
+    float m_rights[RF_MAX_VOICES] = {};
+    float m_ups[RF_MAX_VOICES] = {};
+    float m_dopplerPitches[RF_MAX_VOICES] = {};
+
+    void ProcessBatch(int numVoices);
+};
+}  // namespace rf
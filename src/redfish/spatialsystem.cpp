@@ -0,0 +1,162 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "spatialsystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "allocator.h"
+#include "assert.h"
+#include "functions.h"
+
+rf::SpatialSystem::SpatialSystem(TransformTable* transforms)
+    : m_transforms(transforms)
+{
+    m_frame = Allocator::Allocate<TransformTable::Frame>("SpatialSystemFrame");
+
+    // Hand out the lowest slots first so the audio thread only has to look at the start of the table.
+    for (int i = 0; i < RF_MAX_EMITTERS; ++i)
+    {
+        m_freeSlots[i] = RF_MAX_EMITTERS - 1 - i;
+    }
+    m_numFreeSlots = RF_MAX_EMITTERS;
+}
+
+rf::SpatialSystem::~SpatialSystem()
+{
+    Allocator::Deallocate<TransformTable::Frame>(&m_frame);
+}
+
+rf::EmitterHandle rf::SpatialSystem::CreateEmitter()
+{
+    RF_ASSERT(m_numFreeSlots > 0, "Out of emitters. Increase RF_MAX_EMITTERS");
+    if (m_numFreeSlots == 0)
+    {
+        return EmitterHandle();
+    }
+
+    const int slot = m_freeSlots[--m_numFreeSlots];
+    const EmitterHandle emitterHandle = TransformTable::CreateEmitterHandle(slot, m_generations[slot]++);
+
+    m_frame->m_emitterIds[slot] = emitterHandle.m_id;
+    m_frame->m_positionX[slot] = 0.0f;
+    m_frame->m_positionY[slot] = 0.0f;
+    m_frame->m_positionZ[slot] = 0.0f;
+    m_frame->m_velocityX[slot] = 0.0f;
+    m_frame->m_velocityY[slot] = 0.0f;
+    m_frame->m_velocityZ[slot] = 0.0f;
+    m_frame->m_occlusion[slot] = 0.0f;
+    m_frame->m_numEmitters = std::max(m_frame->m_numEmitters, slot + 1);
+    ++m_numEmitters;
+    m_dirty = true;
+    return emitterHandle;
+}
+
+void rf::SpatialSystem::DestroyEmitter(EmitterHandle emitterHandle)
+{
+    if (!IsValid(emitterHandle))
+    {
+        return;
+    }
+
+    const int slot = TransformTable::GetSlot(emitterHandle);
+    m_frame->m_emitterIds[slot] = InvalidId;
+    m_freeSlots[m_numFreeSlots++] = slot;
+    --m_numEmitters;
+
+    while (m_frame->m_numEmitters > 0 && m_frame->m_emitterIds[m_frame->m_numEmitters - 1] == InvalidId)
+    {
+        --m_frame->m_numEmitters;
+    }
+
+    m_dirty = true;
+}
+
+void rf::SpatialSystem::SetEmitterPosition(EmitterHandle emitterHandle, const Vector3& position, const Vector3& velocity)
+{
+    RF_ASSERT(IsValid(emitterHandle), "Emitter does not exist.");
+    if (!IsValid(emitterHandle))
+    {
+        return;
+    }
+
+    const int slot = TransformTable::GetSlot(emitterHandle);
+    m_frame->m_positionX[slot] = position.m_x;
+    m_frame->m_positionY[slot] = position.m_y;
+    m_frame->m_positionZ[slot] = position.m_z;
+    m_frame->m_velocityX[slot] = velocity.m_x;
+    m_frame->m_velocityY[slot] = velocity.m_y;
+    m_frame->m_velocityZ[slot] = velocity.m_z;
+    m_dirty = true;
+}
+
+void rf::SpatialSystem::SetEmitterOcclusion(EmitterHandle emitterHandle, float occlusion)
+{
+    RF_ASSERT(IsValid(emitterHandle), "Emitter does not exist.");
+    if (!IsValid(emitterHandle))
+    {
+        return;
+    }
+
+    m_frame->m_occlusion[TransformTable::GetSlot(emitterHandle)] = Functions::Clamp(occlusion, 0.0f, 1.0f);
+    m_dirty = true;
+}
+
+void rf::SpatialSystem::SetListener(const Vector3& position, const Vector3& forward, const Vector3& up, const Vector3& velocity)
+{
+    const float forwardLength = sqrtf(forward.m_x * forward.m_x + forward.m_y * forward.m_y + forward.m_z * forward.m_z);
+    const float upLength = sqrtf(up.m_x * up.m_x + up.m_y * up.m_y + up.m_z * up.m_z);
+    RF_ASSERT(forwardLength > 0.0f && upLength > 0.0f, "The listener's forward and up vectors can't be zero.");
+    if (Functions::FloatEquality(forwardLength, 0.0f) || Functions::FloatEquality(upLength, 0.0f))
+    {
+        return;
+    }
+
+    TransformTable::Listener& listener = m_frame->m_listener;
+    listener.m_position = position;
+    listener.m_forward = {forward.m_x / forwardLength, forward.m_y / forwardLength, forward.m_z / forwardLength};
+    listener.m_up = {up.m_x / upLength, up.m_y / upLength, up.m_z / upLength};
+    listener.m_velocity = velocity;
+    m_dirty = true;
+}
+
+bool rf::SpatialSystem::IsValid(EmitterHandle emitterHandle) const
+{
+    return emitterHandle && m_frame->m_emitterIds[TransformTable::GetSlot(emitterHandle)] == emitterHandle.m_id;
+}
+
+int rf::SpatialSystem::GetNumEmitters() const
+{
+    return m_numEmitters;
+}
+
+void rf::SpatialSystem::Update()
+{
+    if (!m_dirty)
+    {
+        return;
+    }
+
+    m_transforms->Publish(*m_frame);
+    m_dirty = false;
+}
@@ -0,0 +1,67 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "defines.h"
+#include "identifiers.h"
+#include "transformtable.h"
+#include "vector3.h"
+
+namespace rf
+{
+// Positions the listener and the emitters that sound effects follow. Transforms are written here during the frame and
+// shared with the audio thread in one update by Context::Update, which derives each voice's distance, direction and
+// doppler shift from them.
+// Positions use right-handed coordinates (e.g. -Z forward and +Y up).
+class SpatialSystem
+{
+public:
+    SpatialSystem(TransformTable* transforms);
+    SpatialSystem(const SpatialSystem&) = delete;
+    SpatialSystem(SpatialSystem&&) = delete;
+    SpatialSystem& operator=(const SpatialSystem&) = delete;
+    SpatialSystem& operator=(SpatialSystem&&) = delete;
+    ~SpatialSystem();
+
+    EmitterHandle CreateEmitter();
+    void DestroyEmitter(EmitterHandle emitterHandle);
+    void SetEmitterPosition(EmitterHandle emitterHandle, const Vector3& position, const Vector3& velocity);
+    // 0.0f is unoccluded and 1.0f is fully occluded. How occlusion sounds is set in the PositioningParameters.
+    void SetEmitterOcclusion(EmitterHandle emitterHandle, float occlusion);
+    void SetListener(const Vector3& position, const Vector3& forward, const Vector3& up, const Vector3& velocity);
+    bool IsValid(EmitterHandle emitterHandle) const;
+    int GetNumEmitters() const;
+
+private:
+    TransformTable* m_transforms = nullptr;
+    TransformTable::Frame* m_frame = nullptr;
+    unsigned int m_generations[RF_MAX_EMITTERS] = {};
+    int m_freeSlots[RF_MAX_EMITTERS] = {};
+    int m_numFreeSlots = 0;
+    int m_numEmitters = 0;
+    bool m_dirty = false;
+
+    void Update();
+
+    friend class Context;
+};
+}  // namespace rf
@@ -27,20 +27,20 @@
 #include "audiotimeline.h"
 #include "functions.h"
 #include "mixitem.h"
+#include "musicstreamer.h"
 #include "musictransitionrequest.h"
 #include "musicvoice.h"
 
-static constexpr int k_maxStingerVoices = RF_MAX_CUE_LAYERS * RF_MAX_STINGERS;
-
-rf::StingerSet::StingerSet(const AudioSpec& spec, Messenger* messanger)
+rf::StingerSet::StingerSet(const AudioSpec& spec, int maxVoices, Messenger* messanger)
     : m_messanger(messanger)
+    , m_maxVoices(maxVoices)
 {
-    m_voices = Allocator::AllocateArray<MusicVoice>("StingerVoices", k_maxStingerVoices, spec);
+    m_voices = Allocator::AllocateArray<MusicVoice>("StingerVoices", m_maxVoices, spec);
 }
 
 rf::StingerSet::~StingerSet()
 {
-    Allocator::DeallocateArray<MusicVoice>(&m_voices, k_maxStingerVoices);
+    Allocator::DeallocateArray<MusicVoice>(&m_voices, m_maxVoices);
 }
 
 void rf::StingerSet::Play(const MusicTransitionRequest& request,
@@ -48,12 +48,12 @@ void rf::StingerSet::Play(const MusicTransitionRequest& request,
                           const MusicDatabase::CueData& cueData,
                           const AudioData** audioData)
 {
-    RF_ASSERT(m_numStingers < k_maxStingerVoices, "Out of voices");
+    RF_ASSERT(m_numStingers < m_maxVoices, "Out of voices");
     const float stingerAmp = Functions::DecibelToAmplitude(stingerData.m_gainDb);
     const int numLayers = cueData.m_numLayers;
     for (int i = 0; i < numLayers; ++i)
     {
-        if (m_numStingers < k_maxStingerVoices)
+        if (m_numStingers < m_maxVoices)
         {
             m_voices[m_numStingers++].Play(request.m_stingerStartTime, cueData, 1, i, audioData, stingerAmp);
         }
@@ -118,4 +118,12 @@ void rf::StingerSet::ResetIfPlayingAudioHandle(AudioHandle audioHandle)
             break;
         }
     }
+}
+
+void rf::StingerSet::RequireStreams(MusicStreamer* streamer) const
+{
+    for (int i = 0; i < m_numStingers; ++i)
+    {
+        streamer->Require(m_voices[i].GetAudioDataIndex(), m_voices[i].GetStartTime());
+    }
 }
\ No newline at end of file
@@ -26,6 +26,7 @@
 namespace rf
 {
 class Messenger;
+class MusicStreamer;
 class MusicVoice;
 struct AudioData;
 struct AudioSpec;
@@ -35,7 +36,8 @@ struct MusicTransitionRequest;
 class StingerSet
 {
 public:
-    StingerSet(const AudioSpec& spec, Messenger* messanger);
+    // Every layer of a playing stinger takes a voice, so maxVoices bounds the layers of all the stingers playing at once.
+    StingerSet(const AudioSpec& spec, int maxVoices, Messenger* messanger);
     ~StingerSet();
 
     void Play(const MusicTransitionRequest& request,
@@ -45,10 +47,12 @@ public:
     void Reset();
     void Process(long long playhead, int bufferSize, MixItem* outMixItems, int* outNumMixItems);
     void ResetIfPlayingAudioHandle(AudioHandle audioHandle);
+    void RequireStreams(MusicStreamer* streamer) const;
 
 private:
     Messenger* m_messanger = nullptr;
     MusicVoice* m_voices = nullptr;
+    int m_maxVoices = 0;
     int m_numStingers = 0;
 };
 }  // namespace rf
\ No newline at end of file
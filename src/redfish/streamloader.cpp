@@ -0,0 +1,410 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "streamloader.h"
+
+#include <external/dr_libs/dr_flac.h>
+#include <external/dr_libs/dr_wav.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+
+#include "assert.h"
+#include "audiostream.h"
+
+// How many frames are decoded each time the loader takes the lock.
+static constexpr int k_streamChunkFrames = 4096;
+// How long the loader sleeps when every ring is full, before checking how far the audio thread has read.
+static constexpr int k_streamPollMs = 5;
+
+rf::StreamLoader::StreamLoader(int maxStreams)
+    : m_loads(maxStreams)
+    , m_thread(&StreamLoader::Run, this)
+{
+}
+
+rf::StreamLoader::~StreamLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+
+    for (Load& load : m_loads)
+    {
+        Close(&load);
+    }
+    m_loads.Clear();
+    Allocator::DeallocateBytes(&m_scratch);
+}
+
+void rf::StreamLoader::Prefetch(AudioStream* stream, unsigned int generation)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (generation <= AudioStream::GetGeneration(stream->m_progress.load(std::memory_order_relaxed)))
+        {
+            return;
+        }
+
+        // Whatever the stream holds was decoded for an older request that the audio thread no longer reads.
+        Cancel(stream);
+        FreeSamples(stream);
+
+        Load load;
+        load.m_stream = stream;
+        load.m_generation = generation;
+        const bool added = m_loads.Append(load);
+        RF_ASSERT(added, "Too many streams loading at once");
+    }
+    m_condition.notify_one();
+}
+
+void rf::StreamLoader::Release(AudioStream* stream, unsigned int generation)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (int i = 0; i < m_loads.GetSize(); ++i)
+    {
+        Load* load = m_loads.begin() + i;
+        if (load->m_stream == stream && load->m_generation == generation)
+        {
+            Close(load);
+            m_loads.EraseOrdered(i);
+            break;
+        }
+    }
+
+    if (generation == AudioStream::GetGeneration(stream->m_progress.load(std::memory_order_relaxed)))
+    {
+        FreeSamples(stream);
+    }
+}
+
+void rf::StreamLoader::Remove(AudioStream* stream)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Cancel(stream);
+    FreeSamples(stream);
+}
+
+void rf::StreamLoader::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_condition.wait(lock, [this]() { return m_quit || m_loads.GetSize() > 0; });
+        if (m_quit)
+        {
+            return;
+        }
+
+        if (!DecodeNextChunk())
+        {
+            m_condition.wait_for(lock, std::chrono::milliseconds(k_streamPollMs));
+            continue;
+        }
+
+        // Let the game thread in between chunks.
+        lock.unlock();
+        std::this_thread::yield();
+        lock.lock();
+    }
+}
+
+bool rf::StreamLoader::DecodeNextChunk()
+{
+    const int index = FindNextLoad();
+    if (index < 0)
+    {
+        return false;
+    }
+
+    Load* load = m_loads.begin() + index;
+    AudioStream* stream = load->m_stream;
+    if (!load->m_decoder && !Open(load))
+    {
+        RF_FAIL("Could not open streamed file");
+        m_loads.EraseOrdered(index);
+        return true;
+    }
+
+    // The head is decoded up to its end. The ring is decoded at most one ring's length past the audio thread's read
+    // position, so frames it can still read are never overwritten.
+    int numFrames = std::min(k_streamChunkFrames, stream->m_numFrames - load->m_numDecodedFrames);
+    if (load->m_numDecodedFrames < stream->m_numPrefetchFrames)
+    {
+        numFrames = std::min(numFrames, stream->m_numPrefetchFrames - load->m_numDecodedFrames);
+    }
+    else
+    {
+        const unsigned long long readPosition = stream->m_readPosition.load(std::memory_order_acquire);
+        const unsigned int seekCount = AudioStream::GetGeneration(readPosition);
+        const int readFrame = AudioStream::GetNumFrames(readPosition);
+        if (seekCount != load->m_seekCount)
+        {
+            if (!Seek(load, readFrame))
+            {
+                RF_FAIL("Could not seek in streamed file");
+                Close(load);
+                m_loads.EraseOrdered(index);
+                return true;
+            }
+
+            load->m_seekCount = seekCount;
+            stream->m_tailProgress.store(AudioStream::PackProgress(seekCount, readFrame), std::memory_order_release);
+            numFrames = std::min(k_streamChunkFrames, stream->m_numFrames - load->m_numDecodedFrames);
+        }
+
+        if (!stream->IsResident())
+        {
+            numFrames = std::min(numFrames, readFrame + stream->m_numBufferFrames - load->m_numDecodedFrames);
+        }
+    }
+
+    const int numChannels = stream->m_numChannels;
+    if (m_scratchSize < numFrames * numChannels)
+    {
+        Allocator::DeallocateBytes(&m_scratch);
+        m_scratchSize = k_streamChunkFrames * numChannels;
+        m_scratch = Allocator::AllocateBytes<float>("StreamLoaderScratch", m_scratchSize * sizeof(float));
+    }
+
+    int numRead = 0;
+    if (stream->m_isFLAC)
+    {
+        numRead = static_cast<int>(drflac_read_pcm_frames_f32(static_cast<drflac*>(load->m_decoder), numFrames, m_scratch));
+    }
+    else
+    {
+        numRead = static_cast<int>(drwav_read_pcm_frames_f32(static_cast<drwav*>(load->m_decoder), numFrames, m_scratch));
+    }
+
+    // A file shorter than its header says is left silent past the end, like a stream that was never read.
+    if (numRead < numFrames)
+    {
+        memset(m_scratch + numRead * numChannels, 0, (numFrames - numRead) * numChannels * sizeof(float));
+    }
+
+    float** arrayOfChannels = stream->m_arrayOfChannels;
+    int frame = load->m_numDecodedFrames;
+    int offset = 0;
+    while (offset < numFrames)
+    {
+        const int numContiguousFrames = std::min(numFrames - offset, stream->GetNumContiguousFrames(frame));
+        const int bufferIndex = stream->GetBufferIndex(frame);
+        for (int i = 0; i < numContiguousFrames; ++i)
+        {
+            for (int j = 0; j < numChannels; ++j)
+            {
+                arrayOfChannels[j][bufferIndex + i] = m_scratch[(offset + i) * numChannels + j];
+            }
+        }
+        frame += numContiguousFrames;
+        offset += numContiguousFrames;
+    }
+
+    load->m_numDecodedFrames = frame;
+    if (frame <= stream->m_numPrefetchFrames)
+    {
+        stream->m_progress.store(AudioStream::PackProgress(load->m_generation, frame), std::memory_order_release);
+    }
+    else
+    {
+        stream->m_tailProgress.store(AudioStream::PackProgress(load->m_seekCount, frame), std::memory_order_release);
+    }
+
+    // A resident stream is done once it is decoded. The others keep their decoder to follow the audio thread.
+    if (stream->IsResident() && (numRead < numFrames || frame >= stream->m_numFrames))
+    {
+        Close(load);
+        m_loads.EraseOrdered(index);
+    }
+
+    return true;
+}
+
+int rf::StreamLoader::FindNextLoad() const
+{
+    // Stream heads first, in the order they were asked for.
+    for (int i = 0; i < m_loads.GetSize(); ++i)
+    {
+        const Load& load = m_loads.Get(i);
+        if (load.m_numDecodedFrames < load.m_stream->m_numPrefetchFrames)
+        {
+            return i;
+        }
+    }
+
+    // Then the ring that has the fewest frames ready ahead of the audio thread, if it has room for a chunk.
+    int index = -1;
+    int minNumBufferedFrames = INT_MAX;
+    for (int i = 0; i < m_loads.GetSize(); ++i)
+    {
+        const Load& load = m_loads.Get(i);
+        const AudioStream* stream = load.m_stream;
+        const unsigned long long readPosition = stream->m_readPosition.load(std::memory_order_acquire);
+        const int readFrame = AudioStream::GetNumFrames(readPosition);
+
+        int numBufferedFrames = -1;
+        if (AudioStream::GetGeneration(readPosition) == load.m_seekCount)
+        {
+            const int endFrame = stream->IsResident() ? stream->m_numFrames : std::min(stream->m_numFrames, readFrame + stream->m_numBufferFrames);
+            const int numFreeFrames = endFrame - load.m_numDecodedFrames;
+            if (numFreeFrames <= 0 || (numFreeFrames < std::min(k_streamChunkFrames, stream->m_numBufferFrames) && endFrame < stream->m_numFrames))
+            {
+                continue;
+            }
+            numBufferedFrames = load.m_numDecodedFrames - readFrame;
+        }
+
+        if (numBufferedFrames < minNumBufferedFrames)
+        {
+            index = i;
+            minNumBufferedFrames = numBufferedFrames;
+        }
+    }
+
+    return index;
+}
+
+bool rf::StreamLoader::Seek(Load* load, int frame)
+{
+    if (load->m_numDecodedFrames == frame)
+    {
+        return true;
+    }
+
+    bool seeked = false;
+    if (load->m_stream->m_isFLAC)
+    {
+        seeked = drflac_seek_to_pcm_frame(static_cast<drflac*>(load->m_decoder), frame);
+    }
+    else
+    {
+        seeked = drwav_seek_to_pcm_frame(static_cast<drwav*>(load->m_decoder), frame);
+    }
+
+    if (seeked)
+    {
+        load->m_numDecodedFrames = frame;
+    }
+    return seeked;
+}
+
+bool rf::StreamLoader::Open(Load* load)
+{
+    AudioStream* stream = load->m_stream;
+    if (stream->m_isFLAC)
+    {
+        load->m_decoder = drflac_open_file(stream->m_path, NULL);
+    }
+    else
+    {
+        drwav* wav = Allocator::AllocateBytes<drwav>("StreamLoaderDecoder", sizeof(drwav));
+        if (drwav_init_file(wav, stream->m_path, NULL))
+        {
+            load->m_decoder = wav;
+        }
+        else
+        {
+            Allocator::DeallocateBytes(&wav);
+        }
+    }
+
+    if (!load->m_decoder)
+    {
+        return false;
+    }
+
+    // The head and the ring, rather than the whole asset.
+    const int numBufferFrames = stream->m_numPrefetchFrames + stream->m_numBufferFrames;
+    stream->m_arrayOfChannels = Allocator::AllocateBytes<float*>("AudioStreamArrayOfChannels", stream->m_numChannels * sizeof(float*));
+    for (int i = 0; i < stream->m_numChannels; ++i)
+    {
+        stream->m_arrayOfChannels[i] = Allocator::AllocateBytes<float>("AudioStreamChannel", numBufferFrames * sizeof(float));
+    }
+
+    // The ring starts right after the head, at the seek count the audio thread set when it made this request.
+    load->m_seekCount = AudioStream::GetGeneration(stream->m_readPosition.load(std::memory_order_acquire));
+    stream->m_tailProgress.store(AudioStream::PackProgress(load->m_seekCount, stream->m_numPrefetchFrames), std::memory_order_release);
+
+    // The samples are published for the new generation before any of them are decoded, so the audio thread never sees
+    // the generation with samples that are not its own.
+    stream->m_progress.store(AudioStream::PackProgress(load->m_generation, 0), std::memory_order_release);
+    return true;
+}
+
+void rf::StreamLoader::Close(Load* load)
+{
+    if (!load->m_decoder)
+    {
+        return;
+    }
+
+    if (load->m_stream->m_isFLAC)
+    {
+        drflac_close(static_cast<drflac*>(load->m_decoder));
+    }
+    else
+    {
+        drwav* wav = static_cast<drwav*>(load->m_decoder);
+        drwav_uninit(wav);
+        Allocator::DeallocateBytes(&wav);
+    }
+
+    load->m_decoder = nullptr;
+}
+
+void rf::StreamLoader::Cancel(AudioStream* stream)
+{
+    for (int i = 0; i < m_loads.GetSize(); ++i)
+    {
+        Load* load = m_loads.begin() + i;
+        if (load->m_stream == stream)
+        {
+            Close(load);
+            m_loads.EraseOrdered(i);
+            return;
+        }
+    }
+}
+
+void rf::StreamLoader::FreeSamples(AudioStream* stream)
+{
+    if (!stream->m_arrayOfChannels)
+    {
+        return;
+    }
+
+    for (int i = 0; i < stream->m_numChannels; ++i)
+    {
+        Allocator::DeallocateBytes(&stream->m_arrayOfChannels[i]);
+    }
+    Allocator::DeallocateBytes(&stream->m_arrayOfChannels);
+
+    // Keep the generation, so that requests older than this one are still ignored.
+    const unsigned int generation = AudioStream::GetGeneration(stream->m_progress.load(std::memory_order_relaxed));
+    stream->m_progress.store(AudioStream::PackProgress(generation, 0), std::memory_order_release);
+}
\ No newline at end of file
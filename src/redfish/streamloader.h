@@ -0,0 +1,83 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "nonallocatinglist.h"
+
+namespace rf
+{
+struct AudioStream;
+
+// Decodes streamed assets on its own thread. The first m_numPrefetchFrames frames of every stream being loaded are
+// decoded before the rest of any stream, so the stream that is needed next is ready as soon as possible.
+class StreamLoader
+{
+public:
+    StreamLoader(int maxStreams);
+    StreamLoader(const StreamLoader&) = delete;
+    StreamLoader(StreamLoader&&) = delete;
+    StreamLoader& operator=(const StreamLoader&) = delete;
+    StreamLoader& operator=(StreamLoader&&) = delete;
+    ~StreamLoader();
+
+    // Starts decoding the stream for generation. Requests older than the samples already loaded are ignored.
+    void Prefetch(AudioStream* stream, unsigned int generation);
+    // Frees the samples of the stream if they were decoded for generation.
+    void Release(AudioStream* stream, unsigned int generation);
+    // Stops decoding the stream and frees its samples. Returns once the loader no longer uses the stream.
+    void Remove(AudioStream* stream);
+
+private:
+    struct Load
+    {
+        AudioStream* m_stream = nullptr;
+        void* m_decoder = nullptr;
+        unsigned int m_generation = 0;
+        // The seek count of the ring being decoded, and the next frame the decoder reads.
+        unsigned int m_seekCount = 0;
+        int m_numDecodedFrames = 0;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    NonAllocatingList<Load> m_loads;
+    float* m_scratch = nullptr;
+    int m_scratchSize = 0;
+    bool m_quit = false;
+    // Last, so that everything the thread uses exists before it starts.
+    std::thread m_thread;
+
+    void Run();
+    // Returns false when every stream is either fully decoded or its ring is full.
+    bool DecodeNextChunk();
+    int FindNextLoad() const;
+    bool Seek(Load* load, int frame);
+    bool Open(Load* load);
+    void Close(Load* load);
+    void Cancel(AudioStream* stream);
+    static void FreeSamples(AudioStream* stream);
+};
+}  // namespace rf
\ No newline at end of file
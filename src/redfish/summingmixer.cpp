@@ -22,23 +22,31 @@
 
 #include "summingmixer.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "allocator.h"
 #include "assert.h"
+#include "buffer.h"
 #include "dspbase.h"
 #include "functions.h"
+#include "loudnessmeter.h"
 #include "messenger.h"
+#include "profiler.h"
 
 rf::SummingMixer::SummingMixer(int numChannels, int bufferSize, int sampleRate)
 {
     m_mixGroups = Allocator::AllocateArray<MixGroupInternal>("MixGroupInternal", RF_MAX_MIX_GROUPS, numChannels, bufferSize, sampleRate);
     m_sends = Allocator::AllocateArray<SendInternal>("SendInternal", RF_MAX_MIX_GROUPS * RF_MAX_MIX_GROUP_SENDS);
     m_dsp = Allocator::AllocateArray<DSPBase*>("DSPBae", RF_MAX_MIX_GROUPS * RF_MAX_MIX_GROUP_PLUGINS);
+    m_loudnessMeters = Allocator::AllocateArray<LoudnessMeter>("LoudnessMeter", RF_MAX_LOUDNESS_METERS, numChannels, sampleRate);
 }
 
 rf::SummingMixer::~SummingMixer()
 {
     Allocator::DeallocateArray<MixGroupInternal>(&m_mixGroups, RF_MAX_MIX_GROUPS);
     Allocator::DeallocateArray<SendInternal>(&m_sends, RF_MAX_MIX_GROUPS * RF_MAX_MIX_GROUP_SENDS);
+    Allocator::DeallocateArray<LoudnessMeter>(&m_loudnessMeters, RF_MAX_LOUDNESS_METERS);
 
     for (int i = 0; i < RF_MAX_MIX_GROUPS * RF_MAX_MIX_GROUP_PLUGINS; ++i)
     {
@@ -52,24 +60,70 @@ void rf::SummingMixer::CreateMixGroup(const MixGroupState& state)
 {
     MixGroupInternal& mixGroup = m_mixGroups[m_numMixGroups++];
     mixGroup.m_state = state;
+    mixGroup.m_meter = MixGroupMeter();
+    std::fill(mixGroup.m_sumOfSquares, mixGroup.m_sumOfSquares + MixGroupMeter::k_maxChannels, 0.0f);
+    mixGroup.m_numMeasuredFrames = 0;
+    mixGroup.m_loudness = nullptr;
     mixGroup.m_isValid = true;
     Sort();
 }
 
 void rf::SummingMixer::DestroyMixGroup(int mixGroupIndex)
 {
+    SetLoudnessMetering(&m_mixGroups[mixGroupIndex], false);
     m_mixGroups[mixGroupIndex] = m_mixGroups[m_numMixGroups - 1];
     --m_numMixGroups;
+
+    // The last mix group moved into the destroyed one's place, so its old slot must not be mixed a second time.
+    m_mixGroups[m_numMixGroups].m_loudness = nullptr;
+    m_mixGroups[m_numMixGroups].m_isValid = false;
     Sort();
 }
 
 void rf::SummingMixer::DestroyAllMixGroups()
 {
+    for (int i = 0; i < m_numMixGroups; ++i)
+    {
+        SetLoudnessMetering(&m_mixGroups[i], false);
+        m_mixGroups[i].m_isValid = false;
+    }
+
     m_numMixGroups = 0;
 }
 
-void rf::SummingMixer::Sum(void* buffer, MixItem* mixItems, int numMixItems, int bufferSize, Messenger* messenger)
+void rf::SummingMixer::SetLoudnessMetering(MixGroupInternal* mixGroup, bool enable)
+{
+    mixGroup->m_state.m_loudnessMetering = enable;
+    if (mixGroup->m_loudness)
+    {
+        mixGroup->m_loudness->m_isInUse = false;
+        mixGroup->m_loudness = nullptr;
+    }
+
+    if (!enable)
+    {
+        return;
+    }
+
+    for (int i = 0; i < RF_MAX_LOUDNESS_METERS; ++i)
+    {
+        LoudnessMeter& loudness = m_loudnessMeters[i];
+        if (!loudness.m_isInUse)
+        {
+            loudness.Reset();
+            loudness.m_isInUse = true;
+            mixGroup->m_loudness = &loudness;
+            return;
+        }
+    }
+
+    RF_FAIL("Too many mix groups with loudness metering. Increase RF_MAX_LOUDNESS_METERS");
+}
+
+void rf::SummingMixer::Sum(void* buffer, MixItem* mixItems, int numMixItems, int bufferSize, Messenger* messenger, Profiler* profiler)
 {
+    const long long mixingStart = Profiler::GetTime();
+
     // Iterate through mix groups.
     for (int i = 0; i < RF_MAX_MIX_GROUPS; ++i)
     {
@@ -106,15 +160,29 @@ void rf::SummingMixer::Sum(void* buffer, MixItem* mixItems, int numMixItems, int
 
         MixItem* mixItem = &m_mixGroups[i].m_mixItem;
 
+        // Point sidechained plug-ins at their key. The key has a higher priority, so it was processed earlier in this loop.
+        for (int j = 0; j < RF_MAX_MIX_GROUP_PLUGINS; ++j)
+        {
+            const int pluginIndex = m_mixGroups[i].m_state.m_pluginSlots[j];
+            if (pluginIndex == -1)
+            {
+                continue;
+            }
+
+            DSPBase* dsp = m_dsp[pluginIndex];
+            if (const MixGroupHandle sidechainMixGroupHandle = dsp->GetSidechainMixGroup())
+            {
+                const MixGroupInternal* sidechain = MixGroupLookUp(sidechainMixGroupHandle);
+                dsp->SetSidechain(sidechain ? &sidechain->m_mixItem : nullptr);
+            }
+        }
+
         // Process plug-ins and fader.
+        const long long pluginStart = Profiler::GetTime();
         m_mixGroups[i].Process(mixItem, bufferSize, m_dsp, messenger);
+        profiler->AddMixGroupTime(i, Profiler::GetTime() - pluginStart);
 
-        Message msg;
-        msg.m_type = MessageType::MixGroupPeakAmplitude;
-        Message::MixGroupPeakAmplitudeData* data = msg.GetMixGroupPeakAmplitudeData();
-        data->m_mixGroupIndex = i;
-        data->m_amplitude = mixItem->GetPeakAmplitude();
-        messenger->AddMessage(msg);
+        mixGroup.Measure(bufferSize);
 
         // Route signal to sends.
         for (int j = 0; j < RF_MAX_MIX_GROUP_SENDS; ++j)
@@ -144,10 +212,32 @@ void rf::SummingMixer::Sum(void* buffer, MixItem* mixItems, int numMixItems, int
         }
     }
 
+    profiler->AddStageTime(Profiler::Stage::Mixing, mixingStart, Profiler::GetTime());
+
+    ProfilerScope scope(profiler, Profiler::Stage::Output);
     MixGroupInternal* masterMixGroup = MasterMixGroupLookUp();
 
     float* floatBuffer = reinterpret_cast<float*>(buffer);
-    masterMixGroup->m_mixItem.ToInterleavedBuffer(floatBuffer);
+    masterMixGroup->m_mixItem.ToInterleavedBuffer(floatBuffer, bufferSize);
+}
+
+void rf::SummingMixer::PublishMeters(MeteringBlock* metering)
+{
+    MixGroupMeter* meters = metering->GetWriteMeters();
+    for (int i = 0; i < RF_MAX_MIX_GROUPS; ++i)
+    {
+        MixGroupInternal& mixGroup = m_mixGroups[i];
+        if (mixGroup.m_isValid)
+        {
+            mixGroup.EndMeasure(&meters[i]);
+        }
+        else
+        {
+            meters[i].m_mixGroupHandle = MixGroupHandle();
+        }
+    }
+
+    metering->Publish();
 }
 
 rf::SummingMixer::MixGroupInternal* rf::SummingMixer::MixGroupLookUp(MixGroupHandle mixGroupHandle, int* outIndex)
@@ -246,3 +336,49 @@ void rf::SummingMixer::MixGroupInternal::Process(MixItem* mixItem, int bufferSiz
         dsp[pluginIndex]->Process(mixItem, bufferSize);
     }
 }
+
+void rf::SummingMixer::MixGroupInternal::Measure(int bufferSize)
+{
+    // Frames past bufferSize are silent, so measuring whole buffers only counts this call's frames.
+    for (int i = 0; i < m_mixItem.m_channels; ++i)
+    {
+        const Buffer& channel = m_mixItem.m_arrayOfChannels[i];
+        m_meter.m_peakAmplitude[i] = std::max(m_meter.m_peakAmplitude[i], channel.GetAbsoluteMax());
+        m_sumOfSquares[i] += channel.GetSumOfSquares();
+        m_meter.m_numClippedSamples[i] += channel.GetNumClipped();
+    }
+    m_numMeasuredFrames += bufferSize;
+
+    if (m_loudness)
+    {
+        m_loudness->Process(m_mixItem, bufferSize);
+    }
+}
+
+void rf::SummingMixer::MixGroupInternal::EndMeasure(MixGroupMeter* outMeter)
+{
+    m_meter.m_mixGroupHandle = m_state.m_mixGroupHandle;
+    m_meter.m_numChannels = m_mixItem.m_channels;
+    for (int i = 0; i < m_mixItem.m_channels; ++i)
+    {
+        m_meter.m_rmsAmplitude[i] = m_numMeasuredFrames > 0 ? sqrtf(m_sumOfSquares[i] / static_cast<float>(m_numMeasuredFrames)) : 0.0f;
+    }
+
+    if (m_loudness)
+    {
+        m_loudness->GetLoudness(&m_meter);
+    }
+    else
+    {
+        m_meter.m_hasLoudness = false;
+    }
+
+    *outMeter = m_meter;
+
+    for (int i = 0; i < m_mixItem.m_channels; ++i)
+    {
+        m_meter.m_peakAmplitude[i] = 0.0f;
+        m_sumOfSquares[i] = 0.0f;
+    }
+    m_numMeasuredFrames = 0;
+}
@@ -22,13 +22,16 @@
 
 #pragma once
 #include "fader.h"
+#include "meteringblock.h"
 #include "mixgroupstate.h"
 #include "mixitem.h"
 
 namespace rf
 {
 class DSPBase;
+class LoudnessMeter;
 class Messenger;
+class Profiler;
 
 class SummingMixer
 {
@@ -46,6 +49,10 @@ public:
         MixItem m_mixItem;
         Fader m_volume;
         Fader m_fader;
+        MixGroupMeter m_meter;
+        LoudnessMeter* m_loudness = nullptr;
+        float m_sumOfSquares[MixGroupMeter::k_maxChannels] = {};
+        int m_numMeasuredFrames = 0;
         int m_sampleRate;
         bool m_isValid = false;
 
@@ -53,6 +60,8 @@ public:
         void UpdateVolume(float amplitude, float seconds);
         void FadeVolume(float amplitude, long long playhead, long long startTime, int duration);
         void Process(MixItem* mixItem, int bufferSize, DSPBase** dsp, Messenger* messenger);
+        void Measure(int bufferSize);
+        void EndMeasure(MixGroupMeter* outMeter);
     };
 
     struct SendInternal
@@ -64,7 +73,11 @@ public:
     void CreateMixGroup(const MixGroupState& state);
     void DestroyMixGroup(int mixGroupIndex);
     void DestroyAllMixGroups();
-    void Sum(void* buffer, MixItem* mixItems, int numMixItems, int bufferSize, Messenger* messenger);
+    void SetLoudnessMetering(MixGroupInternal* mixGroup, bool enable);
+    // Mixes bufferSize frames, which can be fewer than the mix items hold when the audio callback is split, into the
+    // interleaved buffer. Meters add up across calls until PublishMeters.
+    void Sum(void* buffer, MixItem* mixItems, int numMixItems, int bufferSize, Messenger* messenger, Profiler* profiler);
+    void PublishMeters(MeteringBlock* metering);
     MixGroupInternal* MixGroupLookUp(MixGroupHandle mixGroupHandle, int* outIndex = nullptr);
     MixGroupInternal* MixGroupLookUp(int index);
     MixGroupInternal* MasterMixGroupLookUp(int* outIndex = nullptr);
@@ -76,6 +89,7 @@ public:
 
 private:
     MixGroupInternal* m_mixGroups = nullptr;
+    LoudnessMeter* m_loudnessMeters = nullptr;
     int m_numMixGroups = 0;
 };
 }  // namespace rf
\ No newline at end of file
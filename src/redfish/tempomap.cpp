@@ -0,0 +1,190 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "tempomap.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "assert.h"
+#include "audiospec.h"
+#include "sync.h"
+
+void rf::TempoMap::Build(const AudioSpec& spec, float tempo, const Meter& meter, const TempoChange* changes, int numChanges)
+{
+    RF_ASSERT(numChanges >= 0 && numChanges < k_maxSegments, "Too many tempo changes. Increase RF_MAX_CUE_TEMPO_CHANGES");
+
+    m_numSegments = 0;
+    for (int i = -1; i < numChanges; ++i)
+    {
+        Segment& segment = m_segments[m_numSegments];
+        segment.m_tempo = i < 0 ? tempo : changes[i].m_tempo;
+        segment.m_meter = i < 0 ? meter : changes[i].m_meter;
+        segment.m_startBar = i < 0 ? 0 : changes[i].m_bar;
+        segment.m_samplesPerBeat = segment.m_beatCalculator.BeatCalc(segment.m_tempo, segment.m_meter, spec);
+        segment.m_barSamples = segment.m_beatCalculator.m_beatPrecise.m_barSamplesPrecise;
+
+        if (m_numSegments > 0)
+        {
+            const Segment& previous = m_segments[m_numSegments - 1];
+            RF_ASSERT(segment.m_startBar > previous.m_startBar, "Expected tempo changes to be in order of bar");
+            segment.m_startFrame = previous.m_startFrame + (segment.m_startBar - previous.m_startBar) * previous.m_barSamples;
+        }
+        else
+        {
+            segment.m_startFrame = 0.0;
+        }
+
+        ++m_numSegments;
+    }
+}
+
+void rf::TempoMap::Reset()
+{
+    m_numSegments = 0;
+}
+
+int rf::TempoMap::GetNumSegments() const
+{
+    return m_numSegments;
+}
+
+const rf::TempoMap::Segment& rf::TempoMap::GetSegment(int index) const
+{
+    RF_ASSERT(index >= 0 && index < m_numSegments, "Index out of bounds");
+    return m_segments[index];
+}
+
+int rf::TempoMap::FindSegment(int bar) const
+{
+    RF_ASSERT(m_numSegments > 0, "Expected the tempo map to be built");
+    const Segment* segment = std::upper_bound(m_segments, m_segments + m_numSegments, bar, [](int value, const Segment& s) {
+        return value < s.m_startBar;
+    });
+    return std::max(0, static_cast<int>(segment - m_segments) - 1);
+}
+
+long long rf::TempoMap::GetBarStart(int bar) const
+{
+    return llround(GetPreciseBarStart(bar));
+}
+
+int rf::TempoMap::GetBar(long long frame) const
+{
+    RF_ASSERT(m_numSegments > 0, "Expected the tempo map to be built");
+    if (frame <= 0)
+    {
+        return 0;
+    }
+
+    const double position = static_cast<double>(frame);
+    const Segment* found = std::upper_bound(m_segments, m_segments + m_numSegments, position, [](double value, const Segment& s) {
+        return value < s.m_startFrame;
+    });
+    const Segment& segment = *(std::max(found, m_segments + 1) - 1);
+    if (segment.m_barSamples <= 0.0)
+    {
+        return segment.m_startBar;
+    }
+
+    // The division can land a bar out either way once the bar starts are rounded to frames.
+    int bar = segment.m_startBar + static_cast<int>(floor((position - segment.m_startFrame) / segment.m_barSamples));
+    if (GetBarStart(bar + 1) <= frame)
+    {
+        ++bar;
+    }
+    else if (bar > 0 && GetBarStart(bar) > frame)
+    {
+        --bar;
+    }
+
+    return bar;
+}
+
+int rf::TempoMap::GetBeat(long long frame, int bar) const
+{
+    const Segment& segment = m_segments[FindSegment(bar)];
+    if (segment.m_samplesPerBeat <= 0.0)
+    {
+        return 0;
+    }
+
+    const double intoBar = std::max(0.0, static_cast<double>(frame) - GetPreciseBarStart(bar));
+    const int beat = static_cast<int>(floor(intoBar / segment.m_samplesPerBeat));
+    return std::min(beat, static_cast<int>(segment.m_meter.m_top) - 1);
+}
+
+long long rf::TempoMap::GetSyncSamples(const Sync& sync, int bar) const
+{
+    return llround(m_segments[FindSegment(bar)].m_beatCalculator.PreciseBeatSwitch(sync));
+}
+
+long long rf::TempoMap::GetNextSyncPoint(const Sync& sync, int firstBar, long long frame) const
+{
+    int bar = std::max(firstBar, GetBar(frame));
+
+    // The last sync point of a bar can fall past its end, so it can still be the first one at or after frame.
+    if (bar > firstBar)
+    {
+        const Segment& segment = m_segments[FindSegment(bar - 1)];
+        const double syncSamples = segment.m_beatCalculator.PreciseBeatSwitch(sync);
+        if (syncSamples > 0.0)
+        {
+            const double numSyncPoints = ceil(segment.m_barSamples / syncSamples);
+            const long long last = llround(GetPreciseBarStart(bar - 1) + numSyncPoints * syncSamples);
+            if (last >= frame)
+            {
+                return last;
+            }
+        }
+    }
+
+    // Every sync point of a later bar is past the start of that bar, so this settles within two bars.
+    while (true)
+    {
+        const Segment& segment = m_segments[FindSegment(bar)];
+        const double syncSamples = segment.m_beatCalculator.PreciseBeatSwitch(sync);
+        if (syncSamples <= 0.0 || segment.m_barSamples <= 0.0)
+        {
+            return frame;
+        }
+
+        const double barStart = GetPreciseBarStart(bar);
+        const int numSyncPoints = static_cast<int>(ceil(segment.m_barSamples / syncSamples));
+        for (int i = std::max(1, static_cast<int>(ceil((frame - barStart) / syncSamples))); i <= numSyncPoints; ++i)
+        {
+            const long long syncPoint = llround(barStart + i * syncSamples);
+            if (syncPoint >= frame)
+            {
+                return syncPoint;
+            }
+        }
+
+        ++bar;
+    }
+}
+
+double rf::TempoMap::GetPreciseBarStart(int bar) const
+{
+    const Segment& segment = m_segments[FindSegment(bar)];
+    return segment.m_startFrame + (bar - segment.m_startBar) * segment.m_barSamples;
+}
@@ -0,0 +1,81 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "beatcalculator.h"
+#include "defines.h"
+#include "meter.h"
+
+namespace rf
+{
+struct AudioSpec;
+struct Sync;
+
+// A change of tempo and meter at the start of a bar of a music cue. Bars count from 0 at the start of the cue.
+struct TempoChange
+{
+    Meter m_meter;
+    float m_tempo = 0.0f;
+    int m_bar = 0;
+};
+
+// The bar grid of a music cue, in frames from the start of the cue. The cue is split into segments of constant tempo
+// and meter, each with its note values worked out once when the map is built. Bar positions are accumulated in double
+// precision and only rounded when they are looked up, so they do not drift however long the cue plays. Finding the bar
+// at a frame, or the next sync point after it, is a binary search over the segments.
+class TempoMap
+{
+public:
+    struct Segment
+    {
+        BeatCalculator m_beatCalculator;
+        Meter m_meter;
+        double m_startFrame = 0.0;
+        double m_barSamples = 0.0;
+        double m_samplesPerBeat = 0.0;
+        float m_tempo = 0.0f;
+        int m_startBar = 0;
+    };
+
+    static constexpr int k_maxSegments = RF_MAX_CUE_TEMPO_CHANGES + 1;
+
+    // Changes must be in order of bar, and each after the last.
+    void Build(const AudioSpec& spec, float tempo, const Meter& meter, const TempoChange* changes, int numChanges);
+    void Reset();
+    int GetNumSegments() const;
+    const Segment& GetSegment(int index) const;
+    int FindSegment(int bar) const;
+    long long GetBarStart(int bar) const;
+    int GetBar(long long frame) const;
+    int GetBeat(long long frame, int bar) const;
+    long long GetSyncSamples(const Sync& sync, int bar) const;
+    // The first sync point at or after frame, starting from firstBar. Sync points are every sync value from the start of
+    // a bar, up to and including the first one at or past the next bar.
+    long long GetNextSyncPoint(const Sync& sync, int firstBar, long long frame) const;
+
+private:
+    Segment m_segments[k_maxSegments];
+    int m_numSegments = 0;
+
+    double GetPreciseBarStart(int bar) const;
+};
+}  // namespace rf
@@ -0,0 +1,194 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "tracecapture.h"
+
+#include <fstream>
+#include <iomanip>
+
+#include "allocator.h"
+
+rf::TraceCapture::Callback* rf::TraceCapture::s_callbacks = nullptr;
+rf::TraceCapture::GameEvent* rf::TraceCapture::s_gameEvents = nullptr;
+int rf::TraceCapture::s_numCallbacks = 0;
+int rf::TraceCapture::s_numGameEvents = 0;
+int rf::TraceCapture::s_lastNumMessages = 0;
+bool rf::TraceCapture::s_isAudioCapturing = false;
+bool rf::TraceCapture::s_isGameCapturing = false;
+
+static const char* k_stageNames[rf::Profiler::k_numStages] = {"Commands", "Music", "Voices", "Mixing", "Output", "Callback"};
+
+void rf::TraceCapture::Create()
+{
+    s_callbacks = Allocator::AllocateArray<Callback>("TraceCaptureCallbacks", RF_TRACE_CAPTURE_MAX_CALLBACKS);
+    s_gameEvents = Allocator::AllocateArray<GameEvent>("TraceCaptureGameEvents", RF_TRACE_CAPTURE_MAX_GAME_EVENTS);
+}
+
+void rf::TraceCapture::Release()
+{
+    Allocator::DeallocateArray<Callback>(&s_callbacks, RF_TRACE_CAPTURE_MAX_CALLBACKS);
+    Allocator::DeallocateArray<GameEvent>(&s_gameEvents, RF_TRACE_CAPTURE_MAX_GAME_EVENTS);
+    s_numCallbacks = 0;
+    s_numGameEvents = 0;
+    s_isAudioCapturing = false;
+    s_isGameCapturing = false;
+}
+
+void rf::TraceCapture::BeginGameCapture()
+{
+    s_numGameEvents = 0;
+    s_isGameCapturing = true;
+}
+
+void rf::TraceCapture::EndGameCapture()
+{
+    s_isGameCapturing = false;
+}
+
+void rf::TraceCapture::AddGameEvent(const char* name, long long start, long long end)
+{
+    if (!s_isGameCapturing || s_numGameEvents == RF_TRACE_CAPTURE_MAX_GAME_EVENTS)
+    {
+        return;
+    }
+
+    GameEvent& event = s_gameEvents[s_numGameEvents++];
+    event.m_name = name;
+    event.m_start = start;
+    event.m_end = end;
+}
+
+bool rf::TraceCapture::Write(const char* path)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+
+    // Chrome trace timestamps are in microseconds. They are made relative to the first event to keep them short.
+    long long origin = s_numCallbacks > 0 ? s_callbacks[0].m_stageStart[static_cast<int>(Profiler::Stage::Total)] : 0;
+    if (s_numGameEvents > 0 && (s_numCallbacks == 0 || s_gameEvents[0].m_start < origin))
+    {
+        origin = s_gameEvents[0].m_start;
+    }
+
+    const auto ToMicroseconds = [origin](long long nanoseconds) { return static_cast<double>(nanoseconds - origin) / 1000.0; };
+    const auto WriteEvent = [&file, &ToMicroseconds](const char* name, int thread, long long start, long long end) {
+        file << ",\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread << ",\"ts\":" << ToMicroseconds(start)
+             << ",\"dur\":" << static_cast<double>(end - start) / 1000.0 << "}";
+    };
+
+    // Nanosecond precision in fixed notation. The default six significant digits would switch timestamps past one
+    // second to scientific notation and drop their fraction.
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Game\"}}";
+    file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"Audio\"}}";
+
+    for (int i = 0; i < s_numGameEvents; ++i)
+    {
+        const GameEvent& event = s_gameEvents[i];
+        WriteEvent(event.m_name, 1, event.m_start, event.m_end);
+    }
+
+    for (int i = 0; i < s_numCallbacks; ++i)
+    {
+        const Callback& callback = s_callbacks[i];
+        for (int j = 0; j < Profiler::k_numStages; ++j)
+        {
+            if (callback.m_stageEnd[j] > callback.m_stageStart[j])
+            {
+                WriteEvent(k_stageNames[j], 2, callback.m_stageStart[j], callback.m_stageEnd[j]);
+            }
+        }
+
+        const long long start = callback.m_stageStart[static_cast<int>(Profiler::Stage::Total)];
+        file << ",\n{\"name\":\"Counts\",\"ph\":\"C\",\"pid\":1,\"tid\":2,\"ts\":" << ToMicroseconds(start) << ",\"args\":{\"voices\":"
+             << callback.m_numVoices << ",\"commands\":" << callback.m_numCommands << ",\"messages\":" << callback.m_numMessages << "}}";
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
+
+void rf::TraceCapture::BeginAudioCapture()
+{
+    s_numCallbacks = 0;
+    s_callbacks[0] = Callback();
+    s_isAudioCapturing = true;
+}
+
+void rf::TraceCapture::EndAudioCapture()
+{
+    s_isAudioCapturing = false;
+}
+
+void rf::TraceCapture::AddStage(Profiler::Stage stage, long long start, long long end)
+{
+    if (!s_isAudioCapturing || s_numCallbacks == RF_TRACE_CAPTURE_MAX_CALLBACKS)
+    {
+        return;
+    }
+
+    // A stage can run more than once in a callback, so it spans from its first start to its last end.
+    Callback& callback = s_callbacks[s_numCallbacks];
+    const int index = static_cast<int>(stage);
+    if (callback.m_stageEnd[index] == 0)
+    {
+        callback.m_stageStart[index] = start;
+    }
+    callback.m_stageEnd[index] = end;
+}
+
+void rf::TraceCapture::EndCallback(int numVoices, int numCommands, int numMessages)
+{
+    const int numNewMessages = numMessages - s_lastNumMessages;
+    s_lastNumMessages = numMessages;
+
+    if (!s_isAudioCapturing || s_numCallbacks == RF_TRACE_CAPTURE_MAX_CALLBACKS)
+    {
+        return;
+    }
+
+    Callback& callback = s_callbacks[s_numCallbacks++];
+    callback.m_numVoices = numVoices;
+    callback.m_numCommands = numCommands;
+    callback.m_numMessages = numNewMessages;
+
+    // The next record may hold data from an earlier capture.
+    if (s_numCallbacks < RF_TRACE_CAPTURE_MAX_CALLBACKS)
+    {
+        s_callbacks[s_numCallbacks] = Callback();
+    }
+}
+
+rf::TraceScope::TraceScope(const char* name)
+    : m_name(name)
+    , m_start(Profiler::GetTime())
+{
+}
+
+rf::TraceScope::~TraceScope()
+{
+    TraceCapture::AddGameEvent(m_name, m_start, Profiler::GetTime());
+}
@@ -0,0 +1,97 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "defines.h"
+#include "profiler.h"
+
+namespace rf
+{
+// Records a timeline of every audio callback and of marked game thread work, and writes it as Chrome trace JSON that
+// chrome://tracing and Perfetto can open. Everything is stored in buffers allocated up front, and nothing is recorded
+// unless RF_ENABLE_TRACE_CAPTURE is enabled. Use Context::StartTraceCapture and Context::StopTraceCapture.
+class TraceCapture
+{
+public:
+    static void Create();
+    static void Release();
+
+    // Game thread.
+    static void BeginGameCapture();
+    static void EndGameCapture();
+    static void AddGameEvent(const char* name, long long start, long long end);
+    static bool Write(const char* path);
+
+    // Audio thread.
+    static void BeginAudioCapture();
+    static void EndAudioCapture();
+    static void AddStage(Profiler::Stage stage, long long start, long long end);
+    static void EndCallback(int numVoices, int numCommands, int numMessages);
+
+private:
+    struct Callback
+    {
+        long long m_stageStart[Profiler::k_numStages] = {};
+        long long m_stageEnd[Profiler::k_numStages] = {};
+        int m_numVoices = 0;
+        int m_numCommands = 0;
+        int m_numMessages = 0;
+    };
+
+    struct GameEvent
+    {
+        const char* m_name = nullptr;
+        long long m_start = 0;
+        long long m_end = 0;
+    };
+
+    static Callback* s_callbacks;
+    static GameEvent* s_gameEvents;
+    static int s_numCallbacks;
+    static int s_numGameEvents;
+    static int s_lastNumMessages;
+    static bool s_isAudioCapturing;
+    static bool s_isGameCapturing;
+};
+
+// Adds the time between its construction and destruction to the trace as a game thread event.
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name);
+    TraceScope(const TraceScope&) = delete;
+    TraceScope(TraceScope&&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    TraceScope& operator=(TraceScope&&) = delete;
+    ~TraceScope();
+
+private:
+    const char* m_name = nullptr;
+    long long m_start = 0;
+};
+}  // namespace rf
+
+#if RF_ENABLE_TRACE_CAPTURE
+#    define RF_TRACE_SCOPE(name) rf::TraceScope rfTraceScope(name);
+#else
+#    define RF_TRACE_SCOPE(name)
+#endif
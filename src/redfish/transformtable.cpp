@@ -0,0 +1,92 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "transformtable.h"
+
+#include <cstring>
+
+void rf::TransformTable::Publish(const Frame& frame)
+{
+    // The audio thread may still be reading the buffer that this write goes into, if it started before the previous
+    // publish. The fence keeps these writes from becoming visible before the sequence number of the previous publish,
+    // which is what the audio thread checks to detect that case.
+    const unsigned int sequence = m_sequence.load(std::memory_order_relaxed) + 1;
+    std::atomic_thread_fence(std::memory_order_release);
+    CopyFrame(frame, &m_frames[sequence & 1]);
+    m_sequence.store(sequence, std::memory_order_release);
+}
+
+bool rf::TransformTable::Read(Frame* outFrame, unsigned int* lastSequence) const
+{
+    for (int i = 0; i < k_maxReadAttempts; ++i)
+    {
+        const unsigned int sequence = m_sequence.load(std::memory_order_acquire);
+        if (sequence == *lastSequence)
+        {
+            return false;
+        }
+
+        CopyFrame(m_frames[sequence & 1], outFrame);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // If another frame was published during the copy, the game thread may have started writing into the buffer we
+        // were copying from.
+        if (m_sequence.load(std::memory_order_relaxed) == sequence)
+        {
+            *lastSequence = sequence;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int rf::TransformTable::GetSlot(EmitterHandle emitterHandle)
+{
+    return static_cast<int>((emitterHandle.m_id - 1) % RF_MAX_EMITTERS);
+}
+
+rf::EmitterHandle rf::TransformTable::CreateEmitterHandle(int slot, unsigned int generation)
+{
+    // Ids encode their slot, so handles can be looked up without searching. The generation keeps ids unique when a
+    // slot is reused.
+    EmitterHandle emitterHandle;
+    emitterHandle.m_id = generation * RF_MAX_EMITTERS + static_cast<unsigned int>(slot) + 1;
+    return emitterHandle;
+}
+
+void rf::TransformTable::CopyFrame(const Frame& frame, Frame* outFrame)
+{
+    const int numEmitters = frame.m_numEmitters;
+    const size_t numBytes = sizeof(float) * numEmitters;
+
+    outFrame->m_listener = frame.m_listener;
+    memcpy(outFrame->m_emitterIds, frame.m_emitterIds, sizeof(unsigned int) * numEmitters);
+    memcpy(outFrame->m_positionX, frame.m_positionX, numBytes);
+    memcpy(outFrame->m_positionY, frame.m_positionY, numBytes);
+    memcpy(outFrame->m_positionZ, frame.m_positionZ, numBytes);
+    memcpy(outFrame->m_velocityX, frame.m_velocityX, numBytes);
+    memcpy(outFrame->m_velocityY, frame.m_velocityY, numBytes);
+    memcpy(outFrame->m_velocityZ, frame.m_velocityZ, numBytes);
+    memcpy(outFrame->m_occlusion, frame.m_occlusion, numBytes);
+    outFrame->m_numEmitters = numEmitters;
+}
@@ -0,0 +1,87 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <atomic>
+
+#include "defines.h"
+#include "identifiers.h"
+#include "vector3.h"
+
+namespace rf
+{
+// Shares emitter and listener transforms from the game thread with the audio thread without locking.
+// The game thread publishes a whole frame at once into one of two buffers. The audio thread copies the most recently
+// published buffer and uses a sequence number to detect if the game thread started overwriting it during the copy.
+class TransformTable
+{
+public:
+    TransformTable() = default;
+    TransformTable(const TransformTable&) = delete;
+    TransformTable(TransformTable&&) = delete;
+    TransformTable& operator=(const TransformTable&) = delete;
+    TransformTable& operator=(TransformTable&&) = delete;
+    ~TransformTable() = default;
+
+    struct Listener
+    {
+        Vector3 m_position;
+        Vector3 m_forward = {0.0f, 0.0f, -1.0f};
+        Vector3 m_up = {0.0f, 1.0f, 0.0f};
+        Vector3 m_velocity;
+    };
+
+    // Emitters are stored as a structure of arrays, indexed by slot, so they can be processed in SIMD batches.
+    struct Frame
+    {
+        Listener m_listener;
+        unsigned int m_emitterIds[RF_MAX_EMITTERS] = {};
+        float m_positionX[RF_MAX_EMITTERS] = {};
+        float m_positionY[RF_MAX_EMITTERS] = {};
+        float m_positionZ[RF_MAX_EMITTERS] = {};
+        float m_velocityX[RF_MAX_EMITTERS] = {};
+        float m_velocityY[RF_MAX_EMITTERS] = {};
+        float m_velocityZ[RF_MAX_EMITTERS] = {};
+        float m_occlusion[RF_MAX_EMITTERS] = {};
+        // One past the highest slot in use.
+        int m_numEmitters = 0;
+    };
+
+    // Called on the game thread.
+    void Publish(const Frame& frame);
+    // Called on the audio thread. Copies the latest frame if one was published after lastSequence, and updates
+    // lastSequence. Returns false if there is no new frame, or if it could not be copied without tearing. The audio
+    // thread then keeps using its previous copy.
+    bool Read(Frame* outFrame, unsigned int* lastSequence) const;
+
+    static int GetSlot(EmitterHandle emitterHandle);
+    static EmitterHandle CreateEmitterHandle(int slot, unsigned int generation);
+
+private:
+    static constexpr int k_maxReadAttempts = 4;
+
+    Frame m_frames[2];
+    std::atomic<unsigned int> m_sequence {0};
+
+    static void CopyFrame(const Frame& frame, Frame* outFrame);
+};
+}  // namespace rf
@@ -0,0 +1,209 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "vbapdsp.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "functions.h"
+#include "mixitem.h"
+
+const rf::VBAPDSP::Speaker rf::VBAPDSP::s_surround51[5] = {{4, -110.0f}, {0, -30.0f}, {2, 0.0f}, {1, 30.0f}, {5, 110.0f}};
+const rf::VBAPDSP::Speaker rf::VBAPDSP::s_surround71[7] = {{4, -150.0f}, {6, -90.0f}, {0, -30.0f}, {2, 0.0f}, {1, 30.0f}, {7, 90.0f}, {5, 150.0f}};
+
+rf::VBAPDSP::VBAPDSP(const AudioSpec& spec)
+    : DSPBase(spec)
+    , m_mono(spec.m_bufferSize)
+{
+    const Speaker* speakers = nullptr;
+    switch (spec.m_channels)
+    {
+        case 6:
+            speakers = s_surround51;
+            m_numPairs = 5;
+            break;
+        case 8:
+            speakers = s_surround71;
+            m_numPairs = 7;
+            break;
+        default: return;
+    }
+
+    // Each speaker pairs with its clockwise neighbour, the last one wrapping around the back to the first.
+    const float degreesToRadians = PluginUtils::k_twoPi / 360.0f;
+    for (int i = 0; i < m_numPairs; ++i)
+    {
+        const Speaker& first = speakers[i];
+        const Speaker& second = speakers[(i + 1) % m_numPairs];
+        const float x1 = sinf(first.m_azimuth * degreesToRadians);
+        const float y1 = cosf(first.m_azimuth * degreesToRadians);
+        const float x2 = sinf(second.m_azimuth * degreesToRadians);
+        const float y2 = cosf(second.m_azimuth * degreesToRadians);
+        const float inverseDeterminant = 1.0f / (x1 * y2 - x2 * y1);
+
+        SpeakerPair& pair = m_pairs[i];
+        pair.m_first = first.m_channel;
+        pair.m_second = second.m_channel;
+        pair.m_inverse[0] = y2 * inverseDeterminant;
+        pair.m_inverse[1] = -y1 * inverseDeterminant;
+        pair.m_inverse[2] = -x2 * inverseDeterminant;
+        pair.m_inverse[3] = x1 * inverseDeterminant;
+    }
+
+    SetDirection(0.0f, 0.0f, false);
+}
+
+void rf::VBAPDSP::SetDirection(float azimuth, float elevation, bool interpolate)
+{
+    m_azimuth = azimuth;
+    m_elevation = elevation;
+    CalculateGains(m_targetGains);
+
+    if (!interpolate)
+    {
+        for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
+        {
+            m_gains[i] = m_targetGains[i];
+        }
+    }
+}
+
+void rf::VBAPDSP::SetDirection(float azimuth, float elevation)
+{
+    SetDirection(azimuth, elevation, true);
+}
+
+void rf::VBAPDSP::SetNumSourceChannels(int numSourceChannels)
+{
+    m_numSourceChannels = numSourceChannels;
+}
+
+void rf::VBAPDSP::Process(MixItem* mixItem, int bufferSize)
+{
+    if (m_bypass || m_numPairs == 0)
+    {
+        return;
+    }
+
+    // Positioned sounds are treated as point sources, so every source channel is folded into one signal first. The
+    // fold-down averages (1/N) rather than using 1/sqrt(N): source channels are usually correlated (dual mono or
+    // closely miked stereo), and averaging keeps those at their original level instead of boosting them.
+    const int numChannels = mixItem->m_channels;
+    const int numSourceChannels = std::min(m_numSourceChannels, numChannels);
+    m_mono.ZeroOut();
+    if (numSourceChannels > 0)
+    {
+        const float foldDownGain = 1.0f / static_cast<float>(numSourceChannels);
+        for (int c = 0; c < numSourceChannels; ++c)
+        {
+            m_mono.Sum(mixItem->m_arrayOfChannels[c], foldDownGain);
+        }
+    }
+
+    // Every channel gets its own gain ramp towards the target. A static source has a step of 0, so the same loop
+    // covers both cases without branching per sample.
+    const float* mono = m_mono.GetAsFloatBuffer();
+    const float inverseBufferSize = 1.0f / static_cast<float>(bufferSize);
+    for (int c = 0; c < numChannels; ++c)
+    {
+        float* output = mixItem->m_arrayOfChannels[c].GetAsFloatBuffer();
+        const float start = m_gains[c];
+        const float step = (m_targetGains[c] - start) * inverseBufferSize;
+        int i = 0;
+
+#if RF_USE_SSE || RF_USE_AVX || RF_USE_AVX_512
+        const __m128 starts = _mm_set1_ps(start);
+        const __m128 steps = _mm_set1_ps(step);
+        const __m128 offsets = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+        for (; i + 4 <= bufferSize; i += 4)
+        {
+            const __m128 indices = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), offsets);
+            const __m128 gains = _mm_add_ps(starts, _mm_mul_ps(steps, indices));
+            _mm_storeu_ps(output + i, _mm_mul_ps(_mm_loadu_ps(mono + i), gains));
+        }
+#endif
+
+        for (; i < bufferSize; ++i)
+        {
+            output[i] = mono[i] * (start + step * static_cast<float>(i + 1));
+        }
+
+        m_gains[c] = m_targetGains[c];
+    }
+}
+
+bool rf::VBAPDSP::IsLayoutSupported(int channels)
+{
+    return channels == 2 || channels == 6 || channels == 8;
+}
+
+void rf::VBAPDSP::CalculateGains(float* outGains) const
+{
+    for (int i = 0; i < PluginUtils::k_maxChannels; ++i)
+    {
+        outGains[i] = 0.0f;
+    }
+
+    if (m_numPairs == 0)
+    {
+        return;
+    }
+
+    const float degreesToRadians = PluginUtils::k_twoPi / 360.0f;
+    const float x = sinf(m_azimuth * degreesToRadians);
+    const float y = cosf(m_azimuth * degreesToRadians);
+
+    // The source sits between the pair where both gains are positive. Rounding can leave a source sitting exactly on a
+    // speaker slightly negative, so allow a little slack.
+    for (int i = 0; i < m_numPairs; ++i)
+    {
+        const SpeakerPair& pair = m_pairs[i];
+        const float first = x * pair.m_inverse[0] + y * pair.m_inverse[2];
+        const float second = x * pair.m_inverse[1] + y * pair.m_inverse[3];
+        if (first >= -0.0001f && second >= -0.0001f)
+        {
+            const float normalize = 1.0f / sqrtf(first * first + second * second);
+            outGains[pair.m_first] = std::max(first, 0.0f) * normalize;
+            outGains[pair.m_second] = std::max(second, 0.0f) * normalize;
+            break;
+        }
+    }
+
+    // There are no height speakers, so elevation spreads the source over the whole ring. A source directly overhead (or
+    // below) plays equally from every speaker.
+    const float spread = fabsf(sinf(Functions::Clamp(m_elevation, -90.0f, 90.0f) * degreesToRadians));
+    const float spreadGain = spread / sqrtf(static_cast<float>(m_numPairs));
+    float power = 0.0f;
+    for (int i = 0; i < m_numPairs; ++i)
+    {
+        float& gain = outGains[m_pairs[i].m_first];
+        gain = gain * (1.0f - spread) + spreadGain;
+        power += gain * gain;
+    }
+
+    const float normalize = 1.0f / sqrtf(power);
+    for (int i = 0; i < m_numPairs; ++i)
+    {
+        outGains[m_pairs[i].m_first] *= normalize;
+    }
+}
@@ -0,0 +1,77 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "buffer.h"
+#include "dspbase.h"
+#include "pluginutils.h"
+
+namespace rf
+{
+// Vector base amplitude panning over the horizontal speaker ring of a 5.1 or 7.1 output. Channels follow the SMPTE
+// order (L, R, C, LFE, then the surrounds). The LFE never receives a positioned signal.
+class VBAPDSP : public DSPBase
+{
+public:
+    VBAPDSP(const AudioSpec& spec);
+
+    // Azimuth is in degrees clockwise from the front, so -90.0f is left and 90.0f is right. Elevation is in degrees
+    // above (or below) the horizon.
+    void SetDirection(float azimuth, float elevation, bool interpolate);
+    void SetDirection(float azimuth, float elevation);
+    // Number of channels the source actually fills, which may be fewer than the output layout has.
+    void SetNumSourceChannels(int numSourceChannels);
+    void Process(MixItem* mixItem, int bufferSize) override final;
+
+    static bool IsLayoutSupported(int channels);
+
+private:
+    struct Speaker
+    {
+        int m_channel = -1;
+        float m_azimuth = 0.0f;
+    };
+
+    struct SpeakerPair
+    {
+        // Inverse of the 2x2 matrix whose rows are the unit vectors of the two speakers, row major.
+        float m_inverse[4] = {};
+        int m_first = -1;
+        int m_second = -1;
+    };
+
+    // Ring speakers sorted by azimuth, so neighbours in the array are neighbours in the room.
+    static const Speaker s_surround51[5];
+    static const Speaker s_surround71[7];
+
+    void CalculateGains(float* outGains) const;
+
+    Buffer m_mono;
+    SpeakerPair m_pairs[PluginUtils::k_maxChannels];
+    float m_gains[PluginUtils::k_maxChannels] = {};
+    float m_targetGains[PluginUtils::k_maxChannels] = {};
+    int m_numPairs = 0;
+    int m_numSourceChannels = PluginUtils::k_maxChannels;
+    float m_azimuth = 0.0f;
+    float m_elevation = 0.0f;
+};
+}  // namespace rf
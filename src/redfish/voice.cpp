@@ -23,6 +23,7 @@
 #include "voice.h"
 
 #include "assert.h"
+#include "audiodata.h"
 #include "functions.h"
 #include "layer.h"
 #include "playcommands.h"
@@ -36,8 +37,14 @@ rf::Voice::Voice(const AudioSpec& spec)
 
 void rf::Voice::Play(const AudioData* audioData, const PlayCommand& command, long long startTime)
 {
+    RF_ASSERT(!audioData->m_stream, "Streamed assets can only be played as cue layers");
     m_fader.Reset();
     m_positioning.SetPositioningParameters(command.m_positioningParameters, false);
+    m_binaural = BinauralVoiceState();
+    m_emitterHandle = command.m_emitterHandle;
+    m_basePitch = command.m_pitch;
+    m_dopplerPitch = 1.0f;
+    m_emitterChanged = static_cast<bool>(command.m_emitterHandle);
     m_isStopping = false;
     m_stopOnDoneFade = false;
 
@@ -45,6 +52,7 @@ void rf::Voice::Play(const AudioData* audioData, const PlayCommand& command, lon
     params.m_audioData = audioData;
     params.m_audioHandle = command.m_audioHandle;
     params.m_soundEffectHandle = command.m_soundEffectHandle;
+    params.m_audioDataIndex = command.m_audioDataIndex;
     params.m_mixGroupHandle = command.m_mixGroupHandle;
     params.m_startTime = startTime;
     params.m_playCount = command.m_playCount;
@@ -55,8 +63,14 @@ void rf::Voice::Play(const AudioData* audioData, const PlayCommand& command, lon
 
 void rf::Voice::Play(const AudioData* audioData, const Layer& layer, StingerHandle stingerHandle, long long startTime, float amplitude)
 {
+    RF_ASSERT(!audioData->m_stream, "Streamed assets can only be played as cue layers");
     m_fader.Reset();
     m_positioning.SetPositioningParameters(PositioningParameters(), false);
+    m_binaural = BinauralVoiceState();
+    m_emitterHandle = EmitterHandle();
+    m_basePitch = 1.0f;
+    m_dopplerPitch = 1.0f;
+    m_emitterChanged = false;
     m_isStopping = false;
     m_stopOnDoneFade = false;
 
@@ -64,6 +78,7 @@ void rf::Voice::Play(const AudioData* audioData, const Layer& layer, StingerHand
     params.m_audioData = audioData;
     params.m_audioHandle = layer.m_audioHandle;
     params.m_stingerHandle = stingerHandle;
+    params.m_audioDataIndex = layer.m_audioDataIndex;
     params.m_mixGroupHandle = layer.m_mixGroupHandle;
     params.m_startTime = startTime;
     params.m_playCount = 1;
@@ -92,12 +107,26 @@ void rf::Voice::SetAmplitude(float amplitude)
 
 void rf::Voice::SetPitch(float pitch)
 {
-    m_pitch = pitch;
+    m_basePitch = pitch;
+    m_pitch = m_basePitch * m_dopplerPitch;
 }
 
 void rf::Voice::SetPosition(const PositioningParameters& positioningParameters, bool interpolate)
 {
     m_positioning.SetPositioningParameters(positioningParameters, interpolate);
+
+    // Voices that follow an emitter get their distance and direction back from it on the next block.
+    m_emitterChanged = static_cast<bool>(m_emitterHandle);
+}
+
+void rf::Voice::SetEmitter(EmitterHandle emitterHandle)
+{
+    m_emitterHandle = emitterHandle;
+    m_emitterChanged = static_cast<bool>(emitterHandle);
+    if (!m_emitterHandle)
+    {
+        SetDopplerPitch(1.0f);
+    }
 }
 
 rf::BaseVoice::Info rf::Voice::FillMixItem(long long playhead, MixItem* outMixItem, int bufferSize, Messenger* messenger)
@@ -128,6 +157,10 @@ void rf::Voice::Reset(Messenger* messenger)
     ResetBase(messenger);
     m_fader.Reset();
     m_positioning.SetPositioningParameters(PositioningParameters(), false);
+    m_emitterHandle = EmitterHandle();
+    m_basePitch = 1.0f;
+    m_dopplerPitch = 1.0f;
+    m_emitterChanged = false;
     m_isStopping = false;
     m_stopOnDoneFade = false;
 }
@@ -138,6 +171,7 @@ rf::Voice::Result rf::Voice::UpdateDSP(MixItem* mixItem, int bufferSize)
     const bool isFading = m_fader.Process(mixItem, bufferSize);
     const bool isFadingAfter = m_fader.IsFading();
 
+    m_positioning.SetNumSourceChannels(m_channels);
     m_positioning.Process(mixItem, bufferSize);
 
     const bool fadeIsComplete = !m_isStopping && isFadingBefore && !isFadingAfter;
@@ -150,4 +184,10 @@ rf::Voice::Result rf::Voice::UpdateDSP(MixItem* mixItem, int bufferSize)
     }
 
     return Result::None;
+}
+
+void rf::Voice::SetDopplerPitch(float dopplerPitch)
+{
+    m_dopplerPitch = dopplerPitch;
+    m_pitch = m_basePitch * m_dopplerPitch;
 }
\ No newline at end of file
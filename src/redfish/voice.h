@@ -22,6 +22,7 @@
 
 #pragma once
 #include "basevoice.h"
+#include "binauralvoicestate.h"
 #include "fader.h"
 #include "positioningdsp.h"
 
@@ -45,12 +46,18 @@ public:
     void SetAmplitude(float amplitude);
     void SetPitch(float pitch);
     void SetPosition(const PositioningParameters& positioningParameters, bool interpolate);
+    void SetEmitter(EmitterHandle emitterHandle);
     BaseVoice::Info FillMixItem(long long playhead, MixItem* outMixItem, int bufferSize, Messenger* messenger);
     void Reset(Messenger* messenger);
 
 private:
     Fader m_fader;
     PositioningDSP m_positioning;
+    BinauralVoiceState m_binaural;
+    EmitterHandle m_emitterHandle;
+    float m_basePitch = 1.0f;
+    float m_dopplerPitch = 1.0f;
+    bool m_emitterChanged = false;
     bool m_isStopping = false;
     bool m_stopOnDoneFade = false;
 
@@ -61,5 +68,9 @@ private:
     };
 
     Result UpdateDSP(MixItem* mixItem, int bufferSize);
+    void SetDopplerPitch(float dopplerPitch);
+
+    friend class BinauralRenderer;
+    friend class Spatializer;
 };
 }  // namespace rf
\ No newline at end of file
@@ -26,21 +26,26 @@
 #include "assert.h"
 #include "audiospec.h"
 #include "audiotimeline.h"
+#include "binauralrenderer.h"
 #include "functions.h"
 #include "messenger.h"
 #include "mixitem.h"
+#include "spatializer.h"
 #include "voice.h"
 
 rf::VoiceSet::VoiceSet(Messenger* messenger, const AudioSpec& spec)
     : m_messenger(messenger)
-    , m_bufferSize(spec.m_bufferSize)
 {
     m_voices = Allocator::AllocateArray<Voice>("VoiceSetVoices", RF_MAX_VOICES, spec);
+    m_binaural = Allocator::Allocate<BinauralRenderer>("BinauralRenderer", spec);
+    m_spatializer = Allocator::Allocate<Spatializer>("Spatializer");
 }
 
 rf::VoiceSet::~VoiceSet()
 {
     Allocator::DeallocateArray<Voice>(&m_voices, RF_MAX_VOICES);
+    Allocator::Deallocate<BinauralRenderer>(&m_binaural);
+    Allocator::Deallocate<Spatializer>(&m_spatializer);
 }
 
 void rf::VoiceSet::CreateVoice(const AudioData* audioData, const PlayCommand& command, long long startTime)
@@ -74,8 +79,11 @@ void rf::VoiceSet::CreateVoice(const AudioData** audioData,
     }
 }
 
-void rf::VoiceSet::Process(long long playhead, MixItem* outMixItems, int* outNumMixItems)
+void rf::VoiceSet::Process(long long playhead, int bufferSize, MixItem* outMixItems, int* outNumMixItems)
 {
+    m_spatializer->Process(m_voices, m_numVoices);
+    m_binaural->AssignDirectSlots(m_voices, m_numVoices);
+
     for (int i = 0; i < m_numVoices; ++i)
     {
         RF_ASSERT(i >= 0, "Expected positive i");
@@ -83,19 +91,33 @@ void rf::VoiceSet::Process(long long playhead, MixItem* outMixItems, int* outNum
 
         MixItem* item = &outMixItems[(*outNumMixItems)++];
         RF_ASSERT(*outNumMixItems < AudioTimeline::GetMaxNumMixItems(), "Too many mix items will be generated. Increase RF_MAX_VOICES");
-        const BaseVoice::Info info = m_voices[i].FillMixItem(playhead, item, m_bufferSize, m_messenger);
+        const BaseVoice::Info info = m_voices[i].FillMixItem(playhead, item, bufferSize, m_messenger);
         RF_ASSERT(item->m_mixGroupHandle, "Mix item has no mix group. This is incorrect.");
 
+        // Voices encoded into an ambisonic bus reach the mixer through the bus instead.
+        if (m_binaural->Render(&m_voices[i], item, bufferSize))
+        {
+            --(*outNumMixItems);
+        }
+
         if (info.m_done || info.m_stopped)
         {
+            m_binaural->Release(&m_voices[i]);
             m_voices[i--] = m_voices[--m_numVoices];
         }
     }
 
-    Message msg;
-    msg.m_type = MessageType::ContextNumVoices;
-    msg.GetContextNumVoicesData()->m_numVoices = m_numVoices;
-    m_messenger->AddMessage(msg);
+    m_binaural->Decode(outMixItems, outNumMixItems, bufferSize);
+
+    // The game thread only needs to hear about the count when it changes.
+    if (m_numVoices != m_numVoicesSent)
+    {
+        Message msg;
+        msg.m_type = MessageType::ContextNumVoices;
+        msg.GetContextNumVoicesData()->m_numVoices = m_numVoices;
+        m_messenger->AddMessage(msg);
+        m_numVoicesSent = m_numVoices;
+    }
 }
 
 void rf::VoiceSet::Unload(AudioHandle audioHandle, long long playhead)
@@ -206,6 +228,27 @@ void rf::VoiceSet::SetPositionBySoundEffectHandle(SoundEffectHandle soundEffectH
     }
 }
 
+void rf::VoiceSet::SetEmitterBySoundEffectHandle(SoundEffectHandle soundEffectHandle, EmitterHandle emitterHandle)
+{
+    for (int i = 0; i < m_numVoices; ++i)
+    {
+        if (m_voices[i].GetSoundEffectHandle() == soundEffectHandle)
+        {
+            m_voices[i].SetEmitter(emitterHandle);
+        }
+    }
+}
+
+void rf::VoiceSet::SetHRTF(const HRTF* hrtf)
+{
+    m_binaural->SetHRTF(hrtf);
+}
+
+void rf::VoiceSet::SetTransformTable(const TransformTable* transforms)
+{
+    m_spatializer->SetTransformTable(transforms);
+}
+
 int rf::VoiceSet::GetNumVoices() const
 {
     return m_numVoices;
@@ -26,7 +26,11 @@
 
 namespace rf
 {
+class BinauralRenderer;
+class HRTF;
 class Messenger;
+class Spatializer;
+class TransformTable;
 class Voice;
 struct AudioData;
 struct AudioSpec;
@@ -49,7 +53,7 @@ public:
                      const MusicDatabase::StingerData& stingerData,
                      long long startTime,
                      const MusicDatabase* musicDatabase);
-    void Process(long long playhead, MixItem* outMixItems, int* outNumMixItems);
+    void Process(long long playhead, int bufferSize, MixItem* outMixItems, int* outNumMixItems);
     void Unload(AudioHandle audioHandle, long long playhead);
     void StopAll(long long stopTime, long long playhead);
     void StopBySoundEffectHandle(SoundEffectHandle soundEffectHandle, long long stopTime, long long playhead);
@@ -60,12 +64,17 @@ public:
     void SetAmplitudeBySoundEffectHandle(SoundEffectHandle soundEffectHandle, float amplitude);
     void SetPitchBySoundEffectHandle(SoundEffectHandle soundEffectHandle, float pitch);
     void SetPositionBySoundEffectHandle(SoundEffectHandle soundEffectHandle, const PositioningParameters& positioningParameters, bool interpolate);
+    void SetEmitterBySoundEffectHandle(SoundEffectHandle soundEffectHandle, EmitterHandle emitterHandle);
+    void SetHRTF(const HRTF* hrtf);
+    void SetTransformTable(const TransformTable* transforms);
     int GetNumVoices() const;
 
 private:
     Voice* m_voices = nullptr;
+    BinauralRenderer* m_binaural = nullptr;
+    Spatializer* m_spatializer = nullptr;
     Messenger* m_messenger = nullptr;
-    int m_bufferSize = 0;
     int m_numVoices = 0;
+    int m_numVoicesSent = -1;
 };
 }  // namespace rf
\ No newline at end of file
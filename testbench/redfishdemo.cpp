@@ -883,6 +883,7 @@ void RedFishDemo::Example8_ViewPlayingSounds()
             ImGui::Separator();
             ImGui::Text("Name: %s", sound.m_name);
             ImGui::Text("Audio Handle: %i", sound.m_audioHandle.m_id);
+            ImGui::Text("Instances   : %i", m_context->GetNumPlayingSounds(sound.m_audioHandle));
             ImGui::Separator();
         }
     }
@@ -0,0 +1,320 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Checks CompressorDSP against a double precision reference of the same design (linked peak or RMS
+// detection, quadratic soft knee and one-pole attack/release smoothing of the gain reduction in dB),
+// checks its static curve, and times it. Build it with the RedFish sources and src/external on the
+// include path, using the same SIMD flags as the engine.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include <redfish/buffer.h>
+#include <redfish/compressordsp.h>
+#include <redfish/mixitem.h>
+
+namespace
+{
+    constexpr int k_sampleRate = 48000;
+    constexpr int k_bufferSize = 512;
+    constexpr int k_channels = 2;
+    constexpr double k_minDecibels = -144.0;
+
+    struct Settings
+    {
+        const char* m_name = nullptr;
+        float m_threshold = -24.0f;
+        float m_ratio = 4.0f;
+        float m_knee = 0.0f;
+        float m_makeUpGain = 1.0f;
+        float m_attack = 10.0f;
+        float m_release = 100.0f;
+        bool m_detectRMS = false;
+    };
+
+    class ReferenceCompressor
+    {
+    public:
+        explicit ReferenceCompressor(const Settings& settings)
+            : m_settings(settings)
+            , m_attackCoefficient(Coefficient(settings.m_attack))
+            , m_releaseCoefficient(Coefficient(settings.m_release))
+            , m_rmsCoefficient(Coefficient(10.0))
+        {
+        }
+
+        void Process(std::vector<std::vector<float>>& channels)
+        {
+            const double slope = 1.0 - 1.0 / m_settings.m_ratio;
+            const double knee = m_settings.m_knee;
+            const double makeUpGainDb = 20.0 * log10(m_settings.m_makeUpGain);
+            const size_t numFrames = channels[0].size();
+            for (size_t i = 0; i < numFrames; ++i)
+            {
+                double level = 0.0;
+                if (m_settings.m_detectRMS)
+                {
+                    double sum = 0.0;
+                    for (const std::vector<float>& channel : channels)
+                    {
+                        sum += static_cast<double>(channel[i]) * channel[i];
+                    }
+                    const double meanSquare = sum / static_cast<double>(channels.size());
+                    m_meanSquare = meanSquare + (m_meanSquare - meanSquare) * m_rmsCoefficient;
+                    level = sqrt(m_meanSquare);
+                }
+                else
+                {
+                    for (const std::vector<float>& channel : channels)
+                    {
+                        level = std::max(level, fabs(static_cast<double>(channel[i])));
+                    }
+                }
+
+                const double levelDb = level > 0.0 ? std::max(20.0 * log10(level), k_minDecibels) : k_minDecibels;
+                const double over = levelDb - m_settings.m_threshold;
+                double gainReduction = 0.0;
+                if (2.0 * over >= knee)
+                {
+                    gainReduction = slope * over;
+                }
+                else if (2.0 * over > -knee)
+                {
+                    gainReduction = slope * (over + 0.5 * knee) * (over + 0.5 * knee) / (2.0 * knee);
+                }
+
+                const double coefficient = gainReduction > m_gainReductionDb ? m_attackCoefficient : m_releaseCoefficient;
+                m_gainReductionDb = gainReduction + (m_gainReductionDb - gainReduction) * coefficient;
+
+                const double gain = pow(10.0, (makeUpGainDb - m_gainReductionDb) / 20.0);
+                for (std::vector<float>& channel : channels)
+                {
+                    channel[i] = static_cast<float>(channel[i] * gain);
+                }
+            }
+        }
+
+    private:
+        static double Coefficient(double ms)
+        {
+            const double samples = ms * 0.001 * k_sampleRate;
+            return samples > 1.0 ? exp(-1.0 / samples) : 0.0;
+        }
+
+        Settings m_settings;
+        double m_attackCoefficient = 0.0;
+        double m_releaseCoefficient = 0.0;
+        double m_rmsCoefficient = 0.0;
+        double m_meanSquare = 0.0;
+        double m_gainReductionDb = 0.0;
+    };
+
+    rf::AudioSpec CreateSpec()
+    {
+        rf::AudioSpec spec;
+        spec.m_bufferSize = k_bufferSize;
+        spec.m_sampleRate = k_sampleRate;
+        spec.m_channels = k_channels;
+        return spec;
+    }
+
+    void Configure(rf::CompressorDSP* compressor, const Settings& settings)
+    {
+        compressor->SetThreshold(settings.m_threshold);
+        compressor->SetRatio(settings.m_ratio);
+        compressor->SetKnee(settings.m_knee);
+        compressor->SetMakeUpGainAmplitude(settings.m_makeUpGain);
+        compressor->SetAttack(settings.m_attack);
+        compressor->SetRelease(settings.m_release);
+        compressor->SetDetectRMS(settings.m_detectRMS);
+    }
+
+    // A tone whose level steps between quiet, loud and very loud passages so every part of the curve and both
+    // smoothing directions are exercised. The right channel is quieter and detuned so linking matters.
+    std::vector<std::vector<float>> CreateSignal(int numFrames)
+    {
+        std::vector<std::vector<float>> channels(k_channels, std::vector<float>(numFrames));
+        const float levels[] = { 0.01f, 0.5f, 0.05f, 1.0f, 0.2f };
+        const int numLevels = static_cast<int>(sizeof(levels) / sizeof(levels[0]));
+        for (int i = 0; i < numFrames; ++i)
+        {
+            const float level = levels[(i / (k_sampleRate / 4)) % numLevels];
+            const float t = static_cast<float>(i) / static_cast<float>(k_sampleRate);
+            channels[0][i] = level * sinf(2.0f * 3.14159265f * 220.0f * t);
+            channels[1][i] = 0.7f * level * sinf(2.0f * 3.14159265f * 331.0f * t);
+        }
+        return channels;
+    }
+
+    void ProcessBlocks(rf::CompressorDSP* compressor, std::vector<std::vector<float>>& channels)
+    {
+        rf::MixItem mixItem(k_channels, k_bufferSize);
+        const int numFrames = static_cast<int>(channels[0].size());
+        for (int start = 0; start < numFrames; start += k_bufferSize)
+        {
+            const int numBlockFrames = std::min(k_bufferSize, numFrames - start);
+            for (int c = 0; c < k_channels; ++c)
+            {
+                std::copy_n(channels[c].data() + start, numBlockFrames, mixItem.m_arrayOfChannels[c].GetAsFloatBuffer());
+            }
+            compressor->Process(&mixItem, numBlockFrames);
+            for (int c = 0; c < k_channels; ++c)
+            {
+                std::copy_n(mixItem.m_arrayOfChannels[c].GetAsFloatBuffer(), numBlockFrames, channels[c].data() + start);
+            }
+        }
+    }
+
+    bool TestAgainstReference(const Settings& settings)
+    {
+        const int numFrames = 2 * k_sampleRate + 100;
+        std::vector<std::vector<float>> expected = CreateSignal(numFrames);
+        std::vector<std::vector<float>> actual = expected;
+
+        ReferenceCompressor reference(settings);
+        reference.Process(expected);
+
+        rf::CompressorDSP compressor(CreateSpec());
+        Configure(&compressor, settings);
+        ProcessBlocks(&compressor, actual);
+
+        // Errors are measured in dB of gain, so quiet and loud passages are held to the same standard.
+        double maxErrorDb = 0.0;
+        const std::vector<std::vector<float>> input = CreateSignal(numFrames);
+        for (int c = 0; c < k_channels; ++c)
+        {
+            for (int i = 0; i < numFrames; ++i)
+            {
+                if (fabsf(input[c][i]) < 1e-4f)
+                {
+                    continue;
+                }
+                const double expectedGain = expected[c][i] / input[c][i];
+                const double actualGain = actual[c][i] / input[c][i];
+                maxErrorDb = std::max(maxErrorDb, fabs(20.0 * log10(actualGain / expectedGain)));
+            }
+        }
+
+        const bool passed = maxErrorDb < 0.01;
+        std::printf("%-28s max gain error %.6f dB%s\n", settings.m_name, maxErrorDb, passed ? "" : "  FAILED");
+        return passed;
+    }
+
+    // A constant magnitude signal settles on the static curve, which is known in closed form.
+    bool TestStaticCurve(const char* name, float inputDb, float knee, float expectedOutputDb)
+    {
+        Settings settings;
+        settings.m_threshold = -20.0f;
+        settings.m_ratio = 4.0f;
+        settings.m_knee = knee;
+        settings.m_attack = 1.0f;
+        settings.m_release = 1.0f;
+
+        const float amplitude = powf(10.0f, inputDb / 20.0f);
+        std::vector<std::vector<float>> channels(k_channels, std::vector<float>(k_sampleRate / 2));
+        for (int i = 0; i < k_sampleRate / 2; ++i)
+        {
+            channels[0][i] = (i & 1) ? amplitude : -amplitude;
+            channels[1][i] = channels[0][i];
+        }
+
+        rf::CompressorDSP compressor(CreateSpec());
+        Configure(&compressor, settings);
+        ProcessBlocks(&compressor, channels);
+
+        const float outputDb = 20.0f * log10f(fabsf(channels[0].back()));
+        const bool passed = fabsf(outputDb - expectedOutputDb) < 0.01f;
+        std::printf("%-28s %6.2f dB in -> %7.3f dB out (expected %7.3f)%s\n", name, inputDb, outputDb,
+            expectedOutputDb, passed ? "" : "  FAILED");
+        return passed;
+    }
+
+    void Benchmark(const char* name, bool detectRMS)
+    {
+        constexpr int k_iterations = 20000;
+
+        Settings settings;
+        settings.m_detectRMS = detectRMS;
+        rf::CompressorDSP compressor(CreateSpec());
+        Configure(&compressor, settings);
+
+        std::vector<std::vector<float>> signal = CreateSignal(k_bufferSize);
+        rf::MixItem mixItem(k_channels, k_bufferSize);
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < k_iterations; ++i)
+        {
+            for (int c = 0; c < k_channels; ++c)
+            {
+                std::copy_n(signal[c].data(), k_bufferSize, mixItem.m_arrayOfChannels[c].GetAsFloatBuffer());
+            }
+            compressor.Process(&mixItem, k_bufferSize);
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+        std::printf("%-28s %8.2f ns/frame (%d channels, %d frame blocks)\n", name,
+            nanoseconds / (static_cast<double>(k_iterations) * k_bufferSize), k_channels, k_bufferSize);
+    }
+}
+
+int main(int, char**)
+{
+    bool passed = true;
+
+    Settings peakHard;
+    peakHard.m_name = "peak, hard knee";
+    passed = TestAgainstReference(peakHard) && passed;
+
+    Settings peakSoft;
+    peakSoft.m_name = "peak, 12 dB knee, make-up";
+    peakSoft.m_knee = 12.0f;
+    peakSoft.m_makeUpGain = 2.0f;
+    passed = TestAgainstReference(peakSoft) && passed;
+
+    Settings rms;
+    rms.m_name = "RMS, 6 dB knee";
+    rms.m_detectRMS = true;
+    rms.m_knee = 6.0f;
+    passed = TestAgainstReference(rms) && passed;
+
+    Settings fast;
+    fast.m_name = "peak, 8:1, fast";
+    fast.m_ratio = 8.0f;
+    fast.m_attack = 0.5f;
+    fast.m_release = 20.0f;
+    passed = TestAgainstReference(fast) && passed;
+
+    // Threshold -20 dB, ratio 4:1.
+    passed = TestStaticCurve("below threshold", -30.0f, 0.0f, -30.0f) && passed;
+    passed = TestStaticCurve("above threshold", -8.0f, 0.0f, -17.0f) && passed;
+    passed = TestStaticCurve("knee centre", -20.0f, 10.0f, -20.9375f) && passed;
+    passed = TestStaticCurve("above knee", -8.0f, 10.0f, -17.0f) && passed;
+
+    Benchmark("peak cost", false);
+    Benchmark("RMS cost", true);
+
+    std::printf(passed ? "PASSED\n" : "FAILED\n");
+    return passed ? 0 : 1;
+}
\ No newline at end of file
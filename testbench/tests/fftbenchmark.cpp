@@ -0,0 +1,107 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Times the radix-4 FFT backend against the compile-time library backend for the partition sizes the
+// convolver uses, and checks both produce the same spectrum. Build it with the RedFish sources and
+// src/external on the include path, using the same SIMD flags as the engine.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include <fftconvolver/AudioFFT.h>
+
+namespace
+{
+    constexpr int k_iterations = 2000;
+
+    struct Result
+    {
+        double m_nanoseconds = 0.0;
+        std::vector<float> m_re;
+        std::vector<float> m_im;
+    };
+
+    Result Measure(audiofft::AudioFFT::Backend backend, const std::vector<float>& signal)
+    {
+        audiofft::AudioFFT::SetBackend(backend);
+        audiofft::AudioFFT fft;
+        fft.init(signal.size());
+
+        const size_t complexSize = audiofft::AudioFFT::ComplexSize(signal.size());
+        Result result;
+        result.m_re.resize(complexSize);
+        result.m_im.resize(complexSize);
+        std::vector<float> output(signal.size());
+
+        fft.fft(signal.data(), result.m_re.data(), result.m_im.data());
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < k_iterations; ++i)
+        {
+            fft.fft(signal.data(), result.m_re.data(), result.m_im.data());
+            fft.ifft(output.data(), result.m_re.data(), result.m_im.data());
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        result.m_nanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / k_iterations;
+        return result;
+    }
+}
+
+int main(int, char**)
+{
+    std::printf("%8s %16s %16s %10s %12s\n", "size", "library (ns)", "radix-4 (ns)", "speedup", "max error");
+
+    bool passed = true;
+    for (size_t size = 256; size <= 8192; size *= 2)
+    {
+        std::vector<float> signal(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            const float t = static_cast<float>(i);
+            signal[i] = sinf(t * 0.013f) + 0.5f * cosf(t * 0.71f) + 0.25f * sinf(t * 2.3f);
+        }
+
+        const Result library = Measure(audiofft::AudioFFT::Backend::Library, signal);
+        const Result radix4 = Measure(audiofft::AudioFFT::Backend::Radix4, signal);
+
+        float maxError = 0.0f;
+        for (size_t i = 0; i < library.m_re.size(); ++i)
+        {
+            maxError = std::max(maxError, fabsf(library.m_re[i] - radix4.m_re[i]));
+            maxError = std::max(maxError, fabsf(library.m_im[i] - radix4.m_im[i]));
+        }
+
+        // Relative to the spectrum's scale, which grows with the transform size.
+        const bool accurate = maxError <= 1e-5f * static_cast<float>(size);
+        passed = passed && accurate;
+
+        std::printf("%8zu %16.0f %16.0f %9.2fx %12g%s\n", size, library.m_nanoseconds, radix4.m_nanoseconds,
+            library.m_nanoseconds / radix4.m_nanoseconds, maxError, accurate ? "" : "  FAILED");
+    }
+
+    audiofft::AudioFFT::SetBackend(audiofft::AudioFFT::Backend::Radix4);
+    return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,205 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Creates, drives and destroys every plug-in type while audio is rendering, and fails if the audio callback
+// allocated or freed memory along the way. Plug-in DSPs, and the convolver's channels for ever longer impulse
+// responses, are built on the game thread and only published to the audio thread, so the RealtimeChecks counters must
+// stay at zero. Build it and the RedFish sources as a debug build
+// (or with RF_ENABLE_REALTIME_CHECKS defined to true), with src/external on the include path.
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <redfish/redfishapi.h>
+
+#if !RF_ENABLE_REALTIME_CHECKS
+#    error "realtimetest needs RF_ENABLE_REALTIME_CHECKS"
+#endif
+
+namespace
+{
+    constexpr int k_sampleRate = 48000;
+    constexpr int k_bufferSize = 512;
+    constexpr int k_channels = 2;
+    constexpr int k_numFrames = k_sampleRate;
+
+    std::mutex s_audioDeviceMutex;
+
+    void LockAudioDevice()
+    {
+        s_audioDeviceMutex.lock();
+    }
+
+    void UnlockAudioDevice()
+    {
+        s_audioDeviceMutex.unlock();
+    }
+
+    // Ticks the game thread and renders one buffer, the way an application drives RedFish.
+    void Render(rf::Context* context, rf::AudioCallback* callback, std::vector<float>* output, int numBuffers)
+    {
+        for (int i = 0; i < numBuffers; ++i)
+        {
+            context->Update();
+            std::lock_guard<std::mutex> lock(s_audioDeviceMutex);
+            callback->Update(output->data(), k_bufferSize);
+        }
+    }
+}
+
+int main(int, char**)
+{
+    rf::Config config(k_bufferSize, k_channels, k_sampleRate, LockAudioDevice, UnlockAudioDevice);
+    rf::Context* context = new rf::Context(config);
+    rf::AudioCallback* callback = new rf::AudioCallback(context);
+    std::vector<float> output(k_bufferSize * k_channels);
+
+    std::vector<float> tone(k_numFrames * k_channels);
+    for (int i = 0; i < k_numFrames; ++i)
+    {
+        tone[i * k_channels] = 0.5f * sinf(static_cast<float>(i) * 0.05f);
+        tone[i * k_channels + 1] = tone[i * k_channels];
+    }
+    const rf::AudioHandle audioHandle = context->GetAssetSystem()->Load(tone.data(), k_numFrames, k_channels, "tone");
+
+    // A short and a long impulse response, so loading the second one needs longer convolver channels.
+    std::vector<float> shortIR(k_sampleRate / 10 * k_channels);
+    std::vector<float> longIR(k_sampleRate * k_channels);
+    for (size_t i = 0; i < longIR.size(); ++i)
+    {
+        const float decay = expf(-static_cast<float>(i / k_channels) / (0.02f * k_sampleRate));
+        const float noise = static_cast<float>((i * 7919) % 2003) / 1001.5f - 1.0f;
+        longIR[i] = 0.1f * decay * noise;
+        if (i < shortIR.size())
+        {
+            shortIR[i] = longIR[i];
+        }
+    }
+    const int numShortFrames = static_cast<int>(shortIR.size()) / k_channels;
+    const int numLongFrames = static_cast<int>(longIR.size()) / k_channels;
+    const rf::AudioHandle shortIRHandle = context->GetAssetSystem()->Load(shortIR.data(), numShortFrames, k_channels, "shortIR");
+    const rf::AudioHandle longIRHandle = context->GetAssetSystem()->Load(longIR.data(), numLongFrames, k_channels, "longIR");
+    Render(context, callback, &output, 4);
+
+    rf::MixGroup* mixGroup = context->GetMixerSystem()->CreateMixGroup("Effects");
+    rf::MixGroup* filterGroup = context->GetMixerSystem()->CreateMixGroup("Filters");
+    rf::MixGroup* keyGroup = context->GetMixerSystem()->CreateMixGroup("Key");
+    filterGroup->SetOutputMixGroup(keyGroup);
+
+    rf::SoundEffect soundEffect(context);
+    soundEffect.AddVariation(audioHandle);
+    soundEffect.SetIsLooping(true);
+    soundEffect.SetMixGroup(mixGroup);
+    soundEffect.Play();
+    Render(context, callback, &output, 4);
+
+    // Everything from here on has to leave the audio thread alone.
+    context->ResetRealtimeReport();
+
+    rf::GainPlugin* gain = mixGroup->CreatePlugin<rf::GainPlugin>();
+    rf::DelayPlugin* delay = mixGroup->CreatePlugin<rf::DelayPlugin>();
+    rf::CompressorPlugin* compressor = mixGroup->CreatePlugin<rf::CompressorPlugin>();
+    rf::DuckerPlugin* ducker = mixGroup->CreatePlugin<rf::DuckerPlugin>();
+    rf::LimiterPlugin* limiter = mixGroup->CreatePlugin<rf::LimiterPlugin>();
+    Render(context, callback, &output, 8);
+
+    rf::ButterworthHighpassFilterPlugin* butterworthHighpass = filterGroup->CreatePlugin<rf::ButterworthHighpassFilterPlugin>();
+    rf::ButterworthLowpassFilterPlugin* butterworthLowpass = filterGroup->CreatePlugin<rf::ButterworthLowpassFilterPlugin>();
+    rf::IIR2HighpassFilterPlugin* iir2Highpass = filterGroup->CreatePlugin<rf::IIR2HighpassFilterPlugin>();
+    rf::IIR2LowpassFilterPlugin* iir2Lowpass = filterGroup->CreatePlugin<rf::IIR2LowpassFilterPlugin>();
+    rf::PanPlugin* pan = filterGroup->CreatePlugin<rf::PanPlugin>();
+    rf::ConvolverPlugin* convolver = keyGroup->CreatePlugin<rf::ConvolverPlugin>();
+    rf::PositioningPlugin* positioning = keyGroup->CreatePlugin<rf::PositioningPlugin>();
+    Render(context, callback, &output, 8);
+
+    gain->SetGainDb(-6.0f);
+    delay->SetDelay(100.0f);
+    delay->SetFeedback(0.5f);
+    compressor->SetThreshold(-30.0f);
+    compressor->SetRatio(4.0f);
+    compressor->SetSidechain(keyGroup);
+    ducker->SetSidechain(keyGroup);
+    Render(context, callback, &output, 32);
+
+    convolver->SetIRVolumeDb(-6.0f, 1);
+    convolver->LoadIR(shortIRHandle, 0);
+    Render(context, callback, &output, 8);
+    convolver->LoadIR(longIRHandle, 1);
+    Render(context, callback, &output, 8);
+    convolver->UnloadIR(0);
+    convolver->UnloadIR(1);
+    Render(context, callback, &output, 4);
+    convolver->LoadIR(shortIRHandle, 0);
+    Render(context, callback, &output, 8);
+
+    mixGroup->DestroyPlugin(&gain);
+    mixGroup->DestroyPlugin(&delay);
+    mixGroup->DestroyPlugin(&compressor);
+    mixGroup->DestroyPlugin(&ducker);
+    mixGroup->DestroyPlugin(&limiter);
+    filterGroup->DestroyPlugin(&butterworthHighpass);
+    filterGroup->DestroyPlugin(&butterworthLowpass);
+    filterGroup->DestroyPlugin(&iir2Highpass);
+    filterGroup->DestroyPlugin(&iir2Lowpass);
+    filterGroup->DestroyPlugin(&pan);
+    keyGroup->DestroyPlugin(&convolver);
+    keyGroup->DestroyPlugin(&positioning);
+    Render(context, callback, &output, 8);
+
+    rf::RealtimeReport report;
+    context->GetRealtimeReport(&report);
+    std::printf("callbacks %d, allocations %d, deallocations %d, queue growths %d, blocking waits %d\n",
+        report.m_numCallbacks, report.m_numAllocations, report.m_numDeallocations, report.m_numQueueGrowths,
+        report.m_numBlockingWaits);
+
+    soundEffect.Stop();
+    Render(context, callback, &output, 4);
+    context->GetMixerSystem()->DestroyMixGroup(&filterGroup);
+    context->GetMixerSystem()->DestroyMixGroup(&keyGroup);
+    context->GetMixerSystem()->DestroyMixGroup(&mixGroup);
+    Render(context, callback, &output, 4);
+
+    // The context waits for the audio thread to acknowledge its shutdown, so keep rendering while it is destroyed.
+    std::atomic<bool> isRendering(true);
+    std::thread audioThread([&]() {
+        while (isRendering)
+        {
+            {
+                std::lock_guard<std::mutex> lock(s_audioDeviceMutex);
+                callback->Update(output.data(), k_bufferSize);
+            }
+            std::this_thread::yield();
+        }
+    });
+    delete context;
+    isRendering = false;
+    audioThread.join();
+    delete callback;
+
+    const bool passed = report.m_numCallbacks > 0 && report.m_numAllocations == 0 && report.m_numDeallocations == 0;
+    std::printf(passed ? "PASSED\n" : "FAILED\n");
+    return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Sends scheduled audio commands followed by unscheduled commands that depend on them, and checks that they run in
+// the order they were sent: a plug-in created at a later playhead has to exist before its parameters are set, and a
+// scheduled mix group before a sound plays into it. It then holds a plug-in create far ahead, checks that an unrelated
+// sound played afterwards still starts in the next audio callback, and that destroying the context neither hangs nor
+// leaks the held plug-in's DSP. Build it with the RedFish sources and src/external on the include path.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#    include <malloc.h>
+#endif
+
+#include <redfish/redfishapi.h>
+
+namespace
+{
+    constexpr int k_sampleRate = 48000;
+    constexpr int k_bufferSize = 512;
+    constexpr int k_channels = 2;
+    constexpr int k_numFrames = k_sampleRate;
+
+    std::mutex s_audioDeviceMutex;
+    std::atomic<int> s_numLiveAllocations(0);
+
+    void LockAudioDevice()
+    {
+        s_audioDeviceMutex.lock();
+    }
+
+    void UnlockAudioDevice()
+    {
+        s_audioDeviceMutex.unlock();
+    }
+
+    void* Allocate(size_t numBytes, const char*, int alignment)
+    {
+        const size_t align = alignment < 16 ? 16 : static_cast<size_t>(alignment);
+        ++s_numLiveAllocations;
+#if defined(_WIN32)
+        return _aligned_malloc(numBytes, align);
+#else
+        return std::aligned_alloc(align, (numBytes + align - 1) / align * align);
+#endif
+    }
+
+    void Deallocate(void* ptr)
+    {
+        if (ptr != nullptr)
+        {
+            --s_numLiveAllocations;
+        }
+#if defined(_WIN32)
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    void Render(rf::Context* context, rf::AudioCallback* callback, std::vector<float>* output, int numBuffers)
+    {
+        for (int i = 0; i < numBuffers; ++i)
+        {
+            context->Update();
+            std::lock_guard<std::mutex> lock(s_audioDeviceMutex);
+            callback->Update(output->data(), k_bufferSize);
+        }
+    }
+
+    float Peak(const std::vector<float>& output)
+    {
+        float peak = 0.0f;
+        for (const float sample : output)
+        {
+            peak = std::max(peak, std::fabs(sample));
+        }
+        return peak;
+    }
+}
+
+int main(int, char**)
+{
+    bool passed = true;
+
+    rf::Config config(k_bufferSize, k_channels, k_sampleRate, LockAudioDevice, UnlockAudioDevice);
+    config.m_onAllocate = Allocate;
+    config.m_onDeallocate = Deallocate;
+    rf::Context* context = new rf::Context(config);
+    rf::AudioCallback* callback = new rf::AudioCallback(context);
+    std::vector<float> output(k_bufferSize * k_channels);
+
+    std::vector<float> tone(k_numFrames * k_channels);
+    for (int i = 0; i < k_numFrames; ++i)
+    {
+        tone[i * k_channels] = 0.5f * sinf(static_cast<float>(i) * 0.05f);
+        tone[i * k_channels + 1] = tone[i * k_channels];
+    }
+    const rf::AudioHandle audioHandle = context->GetAssetSystem()->Load(tone.data(), k_numFrames, k_channels, "tone");
+    Render(context, callback, &output, 4);
+
+    // A scheduled mix group, then an unscheduled sound that plays into it.
+    context->BeginScheduledCommands(context->GetPlayhead() + 4 * k_bufferSize);
+    rf::MixGroup* mixGroup = context->GetMixerSystem()->CreateMixGroup("Effects");
+    context->EndScheduledCommands();
+
+    rf::SoundEffect soundEffect(context);
+    soundEffect.AddVariation(audioHandle);
+    soundEffect.SetIsLooping(true);
+    soundEffect.SetMixGroup(mixGroup);
+    soundEffect.Play();
+    Render(context, callback, &output, 8);
+
+    const float unityPeak = Peak(output);
+    if (unityPeak < 0.4f)
+    {
+        std::printf("sound did not play into the scheduled mix group, peak %f\n", unityPeak);
+        passed = false;
+    }
+
+    // A scheduled plug-in, then unscheduled parameter changes on it.
+    context->BeginScheduledCommands(context->GetPlayhead() + 4 * k_bufferSize);
+    rf::GainPlugin* gain = mixGroup->CreatePlugin<rf::GainPlugin>();
+    context->EndScheduledCommands();
+    gain->SetGainDb(-12.0f);
+    Render(context, callback, &output, 16);
+
+    const float gainPeak = Peak(output);
+    if (std::fabs(gainPeak - unityPeak * 0.25f) > 0.01f)
+    {
+        std::printf("parameter change did not reach the scheduled plug-in, peak %f, expected %f\n", gainPeak,
+            unityPeak * 0.25f);
+        passed = false;
+    }
+
+    // A plug-in create that is still held when the context shuts down, then a sound that doesn't depend on it.
+    context->BeginScheduledCommands(context->GetPlayhead() + 1000 * k_sampleRate);
+    mixGroup->CreatePlugin<rf::DelayPlugin>();
+    context->EndScheduledCommands();
+
+    rf::SoundEffect otherSoundEffect(context);
+    otherSoundEffect.AddVariation(audioHandle);
+    otherSoundEffect.SetIsLooping(true);
+    otherSoundEffect.Play();
+    Render(context, callback, &output, 1);
+
+    const float otherPeak = Peak(output);
+    if (otherPeak < 0.3f)
+    {
+        std::printf("sound sent after a held command did not start in the next audio callback, peak %f\n", otherPeak);
+        passed = false;
+    }
+    Render(context, callback, &output, 4);
+
+    // The context waits for the audio thread to acknowledge its shutdown, so keep rendering while it is destroyed.
+    std::atomic<bool> isRendering(true);
+    std::thread audioThread([&]() {
+        while (isRendering)
+        {
+            {
+                std::lock_guard<std::mutex> lock(s_audioDeviceMutex);
+                callback->Update(output.data(), k_bufferSize);
+            }
+            std::this_thread::yield();
+        }
+    });
+    delete context;
+    isRendering = false;
+    audioThread.join();
+    delete callback;
+
+    const int numLiveAllocations = s_numLiveAllocations;
+    std::printf("unity peak %f, gain peak %f, other peak %f, live allocations after shutdown %d\n", unityPeak, gainPeak,
+        otherPeak, numLiveAllocations);
+    if (numLiveAllocations != 0)
+    {
+        passed = false;
+    }
+
+    std::printf(passed ? "PASSED\n" : "FAILED\n");
+    return passed ? 0 : 1;
+}
\ No newline at end of file
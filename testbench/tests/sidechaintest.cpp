@@ -0,0 +1,158 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Checks linked sidechain detection: a key that is loud in only one channel must drive the compressor and the
+// ducker to the same gain on every channel of the signal, and processing a short block must leave the frames past
+// it untouched. Build it with the RedFish sources and src/external on the include path, using the same SIMD
+// flags as the engine.
+
+#include <cmath>
+#include <cstdio>
+
+#include <redfish/buffer.h>
+#include <redfish/compressordsp.h>
+#include <redfish/duckerdsp.h>
+#include <redfish/mixitem.h>
+
+namespace
+{
+    constexpr int k_sampleRate = 48000;
+    constexpr int k_bufferSize = 512;
+    constexpr int k_channels = 2;
+    constexpr int k_numBlocks = 50;
+
+    rf::AudioSpec CreateSpec()
+    {
+        rf::AudioSpec spec;
+        spec.m_bufferSize = k_bufferSize;
+        spec.m_sampleRate = k_sampleRate;
+        spec.m_channels = k_channels;
+        return spec;
+    }
+
+    // Constant magnitude with alternating sign, so peak detection sees the same level every frame.
+    void Fill(rf::MixItem* mixItem, int channel, float amplitude)
+    {
+        for (int i = 0; i < k_bufferSize; ++i)
+        {
+            mixItem->m_arrayOfChannels[channel][i] = (i & 1) ? amplitude : -amplitude;
+        }
+    }
+
+    float GainDb(const rf::MixItem& mixItem, int channel, int frame, float inputAmplitude)
+    {
+        return 20.0f * log10f(fabsf(mixItem.m_arrayOfChannels[channel][frame]) / inputAmplitude);
+    }
+
+    bool Check(const char* name, float actualDb, float expectedDb)
+    {
+        const bool passed = fabsf(actualDb - expectedDb) < 0.01f;
+        std::printf("%-44s %8.3f dB (expected %8.3f)%s\n", name, actualDb, expectedDb, passed ? "" : "  FAILED");
+        return passed;
+    }
+
+    // Runs the plugin on a constant signal until its gain settles.
+    void Settle(rf::DSPBase* dsp, rf::MixItem* signal, float signalAmplitude)
+    {
+        for (int block = 0; block < k_numBlocks; ++block)
+        {
+            Fill(signal, 0, signalAmplitude);
+            Fill(signal, 1, signalAmplitude);
+            dsp->Process(signal, k_bufferSize);
+        }
+    }
+
+    bool TestCompressor()
+    {
+        const float signalAmplitude = 0.1f;
+        rf::MixItem signal(k_channels, k_bufferSize);
+        rf::MixItem key(k_channels, k_bufferSize);
+        Fill(&key, 0, 0.0f);
+        Fill(&key, 1, 1.0f);
+
+        rf::CompressorDSP compressor(CreateSpec());
+        compressor.SetThreshold(-20.0f);
+        compressor.SetRatio(4.0f);
+        compressor.SetAttack(1.0f);
+        compressor.SetRelease(1.0f);
+        compressor.SetSidechain(&key);
+        Settle(&compressor, &signal, signalAmplitude);
+
+        // The key is 20 dB over the threshold, so a 4:1 ratio takes 15 dB off the signal, which is itself below
+        // the threshold. Both channels follow the right channel of the key.
+        const int last = k_bufferSize - 1;
+        bool passed = Check("compressor, left channel", GainDb(signal, 0, last, signalAmplitude), -15.0f);
+        passed = Check("compressor, right channel", GainDb(signal, 1, last, signalAmplitude), -15.0f) && passed;
+
+        // A block shorter than the buffer only touches its own frames.
+        const int shortBlock = 100;
+        Fill(&signal, 0, signalAmplitude);
+        Fill(&signal, 1, signalAmplitude);
+        compressor.Process(&signal, shortBlock);
+        passed = Check("compressor, short block, inside", GainDb(signal, 0, shortBlock - 1, signalAmplitude), -15.0f) && passed;
+        passed = Check("compressor, short block, past the end", GainDb(signal, 0, shortBlock, signalAmplitude), 0.0f) && passed;
+        return passed;
+    }
+
+    bool TestDucker()
+    {
+        const float signalAmplitude = 0.1f;
+        rf::MixItem signal(k_channels, k_bufferSize);
+        rf::MixItem key(k_channels, k_bufferSize);
+        Fill(&key, 0, 0.0f);
+        Fill(&key, 1, 1.0f);
+
+        rf::DuckerDSP ducker(CreateSpec());
+        ducker.SetThreshold(-30.0f);
+        ducker.SetDepth(-12.0f);
+        ducker.SetAttack(1.0f);
+        ducker.SetRelease(1.0f);
+        ducker.SetHold(0.0f);
+        ducker.SetSidechain(&key);
+        Settle(&ducker, &signal, signalAmplitude);
+
+        const int last = k_bufferSize - 1;
+        bool passed = Check("ducker, left channel", GainDb(signal, 0, last, signalAmplitude), -12.0f);
+        passed = Check("ducker, right channel", GainDb(signal, 1, last, signalAmplitude), -12.0f) && passed;
+
+        const int shortBlock = 100;
+        Fill(&signal, 0, signalAmplitude);
+        Fill(&signal, 1, signalAmplitude);
+        ducker.Process(&signal, shortBlock);
+        passed = Check("ducker, short block, past the end", GainDb(signal, 1, shortBlock, signalAmplitude), 0.0f) && passed;
+
+        // Once the key goes quiet the ducker lets go.
+        Fill(&key, 1, 0.0f);
+        Settle(&ducker, &signal, signalAmplitude);
+        passed = Check("ducker, key released", GainDb(signal, 0, last, signalAmplitude), 0.0f) && passed;
+        return passed;
+    }
+}
+
+int main(int, char**)
+{
+    bool passed = TestCompressor();
+    passed = TestDucker() && passed;
+
+    std::printf(passed ? "PASSED\n" : "FAILED\n");
+    return passed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,257 @@
+// MIT License
+
+// Copyright (c) 2023 Zach Chan
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Streams a music layer that is several times longer than the buffers it is streamed through, lets the cue loop over
+// it, and checks that the output is the continuous sine the file holds: no underruns once it has started, no stale or
+// misplaced frames from the ring, and no more memory for its samples than the head and the ring. Build it with the
+// RedFish sources and src/external on the include path. It writes streamingtest.wav to the working directory.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#    include <malloc.h>
+#endif
+
+#include <redfish/redfishapi.h>
+
+namespace
+{
+    constexpr int k_sampleRate = 48000;
+    constexpr int k_bufferSize = 512;
+    constexpr int k_channels = 2;
+    // A whole number of periods, so the loop is seamless, that does not divide the head or the ring, so a frame read
+    // from the wrong place in them shows up as a jump in phase.
+    constexpr int k_period = 72;
+    constexpr int k_numFileFrames = 12 * k_sampleRate;
+    constexpr float k_prefetchSeconds = 2.0f;
+    constexpr float k_bufferSeconds = 1.0f;
+    constexpr float k_amplitude = 0.5f;
+    const char* k_path = "streamingtest.wav";
+
+    std::mutex s_audioDeviceMutex;
+    std::mutex s_allocationMutex;
+    std::unordered_map<void*, size_t> s_channelAllocations;
+    size_t s_numChannelBytes = 0;
+    size_t s_maxNumChannelBytes = 0;
+
+    void LockAudioDevice()
+    {
+        s_audioDeviceMutex.lock();
+    }
+
+    void UnlockAudioDevice()
+    {
+        s_audioDeviceMutex.unlock();
+    }
+
+    void* Allocate(size_t numBytes, const char* name, int alignment)
+    {
+        const size_t align = alignment < 16 ? 16 : static_cast<size_t>(alignment);
+#if defined(_WIN32)
+        void* ptr = _aligned_malloc(numBytes, align);
+#else
+        void* ptr = std::aligned_alloc(align, (numBytes + align - 1) / align * align);
+#endif
+        if (name && strcmp(name, "AudioStreamChannel") == 0)
+        {
+            std::lock_guard<std::mutex> lock(s_allocationMutex);
+            s_channelAllocations[ptr] = numBytes;
+            s_numChannelBytes += numBytes;
+            s_maxNumChannelBytes = std::max(s_maxNumChannelBytes, s_numChannelBytes);
+        }
+        return ptr;
+    }
+
+    void Deallocate(void* ptr)
+    {
+        {
+            std::lock_guard<std::mutex> lock(s_allocationMutex);
+            auto it = s_channelAllocations.find(ptr);
+            if (it != s_channelAllocations.end())
+            {
+                s_numChannelBytes -= it->second;
+                s_channelAllocations.erase(it);
+            }
+        }
+#if defined(_WIN32)
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    void WriteWAV()
+    {
+        FILE* file = std::fopen(k_path, "wb");
+        const auto write32 = [file](int value) { std::fwrite(&value, 4, 1, file); };
+        const auto write16 = [file](short value) { std::fwrite(&value, 2, 1, file); };
+        const int numDataBytes = k_numFileFrames * k_channels * 2;
+        std::fwrite("RIFF", 1, 4, file);
+        write32(36 + numDataBytes);
+        std::fwrite("WAVEfmt ", 1, 8, file);
+        write32(16);
+        write16(1);
+        write16(k_channels);
+        write32(k_sampleRate);
+        write32(k_sampleRate * k_channels * 2);
+        write16(k_channels * 2);
+        write16(16);
+        std::fwrite("data", 1, 4, file);
+        write32(numDataBytes);
+        for (int i = 0; i < k_numFileFrames; ++i)
+        {
+            const float phase = 2.0f * 3.14159265f * static_cast<float>(i % k_period) / static_cast<float>(k_period);
+            const short sample = static_cast<short>(32767.0f * k_amplitude * sinf(phase));
+            for (int j = 0; j < k_channels; ++j)
+            {
+                write16(sample);
+            }
+        }
+        std::fclose(file);
+    }
+
+    // Renders in real time on an audio thread would take as long as the music, so blocks are rendered faster, with a
+    // pause between them that still leaves the loader more than enough time.
+    void Render(rf::Context* context, rf::AudioCallback* callback, std::vector<float>* output, int numBuffers)
+    {
+        std::vector<float> buffer(k_bufferSize * k_channels);
+        for (int i = 0; i < numBuffers; ++i)
+        {
+            context->Update();
+            {
+                std::lock_guard<std::mutex> lock(s_audioDeviceMutex);
+                callback->Update(buffer.data(), k_bufferSize);
+            }
+            for (int j = 0; j < k_bufferSize; ++j)
+            {
+                output->push_back(buffer[j * k_channels]);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+int main(int, char**)
+{
+    WriteWAV();
+
+    rf::Config config(k_bufferSize, k_channels, k_sampleRate, LockAudioDevice, UnlockAudioDevice);
+    config.m_onAllocate = Allocate;
+    config.m_onDeallocate = Deallocate;
+    config.m_music.m_streamPrefetchSeconds = k_prefetchSeconds;
+    config.m_music.m_streamBufferSeconds = k_bufferSeconds;
+    rf::Context* context = new rf::Context(config);
+    rf::AudioCallback* callback = new rf::AudioCallback(context);
+
+    rf::MixGroup* mixGroup = context->GetMixerSystem()->CreateMixGroup("Music");
+    const rf::AudioHandle audioHandle = context->GetAssetSystem()->LoadStreamed(k_path);
+
+    rf::CueParameters cueParameters;
+    cueParameters.m_name = "Streamed";
+    cueParameters.m_tempo = 120.0f;
+    cueParameters.m_meter = rf::Meter(4, 4);
+    cueParameters.AddLayer(audioHandle, mixGroup);
+    rf::Cue* cue = context->GetMusicSystem()->CreateCue(cueParameters);
+
+    rf::TransitionParameters transitionParameters;
+    transitionParameters.m_name = "ToStreamed";
+    transitionParameters.m_cue = cue;
+    rf::Transition* transition = context->GetMusicSystem()->CreateTransition(transitionParameters);
+
+    std::vector<float> output;
+    Render(context, callback, &output, 4);
+    context->GetMusicSystem()->Play(transition);
+
+    // Let it start, then play the file through three times.
+    const int numStartBuffers = 3 * k_sampleRate / k_bufferSize;
+    Render(context, callback, &output, numStartBuffers);
+    context->GetMusicSystem()->ResetStreamingReport();
+    const size_t firstCheckedFrame = output.size();
+    Render(context, callback, &output, 3 * k_numFileFrames / k_bufferSize);
+
+    rf::MusicStreamingReport report;
+    context->GetMusicSystem()->GetStreamingReport(&report);
+
+    // Any sum of sines at this frequency meets the recurrence. Silence, a jump in phase or a stale frame does not.
+    const float twoCos = 2.0f * cosf(2.0f * 3.14159265f / static_cast<float>(k_period));
+    float peak = 0.0f;
+    int numBrokenFrames = 0;
+    for (size_t i = firstCheckedFrame + 1; i + 1 < output.size(); ++i)
+    {
+        peak = std::max(peak, std::fabs(output[i]));
+        if (std::fabs(output[i + 1] - twoCos * output[i] + output[i - 1]) > 0.002f)
+        {
+            ++numBrokenFrames;
+        }
+    }
+
+    context->GetMusicSystem()->Stop();
+    Render(context, callback, &output, 16);
+    context->GetAssetSystem()->Unload(audioHandle);
+    Render(context, callback, &output, 16);
+
+    // The context waits for the audio thread to acknowledge its shutdown, so keep rendering while it is destroyed.
+    bool isRendering = true;
+    std::thread audioThread([&]() {
+        std::vector<float> buffer(k_bufferSize * k_channels);
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(s_audioDeviceMutex);
+                if (!isRendering)
+                {
+                    break;
+                }
+                callback->Update(buffer.data(), k_bufferSize);
+            }
+            std::this_thread::yield();
+        }
+    });
+    delete context;
+    {
+        std::lock_guard<std::mutex> lock(s_audioDeviceMutex);
+        isRendering = false;
+    }
+    audioThread.join();
+    delete callback;
+    std::remove(k_path);
+
+    // The head and the ring for each channel, plus the allocator's header in front of each of them.
+    const size_t maxChannelBytes = static_cast<size_t>((k_prefetchSeconds + k_bufferSeconds) * k_sampleRate) * k_channels * sizeof(float) + k_channels * 64;
+    std::printf("peak %f, broken frames %d, underruns %d (%.1f ms), misses %d, sample memory %zu bytes (limit %zu, file %zu)\n", peak,
+        numBrokenFrames, report.m_numUnderruns, report.m_underrunMs, report.m_numMisses, s_maxNumChannelBytes, maxChannelBytes,
+        static_cast<size_t>(k_numFileFrames) * k_channels * sizeof(float));
+
+    const bool passed = peak > 0.4f && numBrokenFrames == 0 && report.m_numUnderruns == 0 && s_maxNumChannelBytes <= maxChannelBytes;
+    std::printf(passed ? "PASSED\n" : "FAILED\n");
+    return passed ? 0 : 1;
+}
\ No newline at end of file